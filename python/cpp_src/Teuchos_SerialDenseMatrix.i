@@ -66,6 +66,58 @@ using Teuchos::SerialDenseMatrix;
 // SWIG directives.
 %include "numpy.i"
 
+////////////////////////////////////////////////////////////////////////
+// Helpers that expose the storage of a SerialDenseMatrix to NumPy without
+// copying.  A NumPy array viewing a matrix keeps its owner (if any) alive
+// through its base object.  When the owner is a capsule holding a heap
+// allocated matrix, the matrix is deleted once the last array referencing
+// it is garbage collected.
+%fragment("Teuchos_SDM_Views", "header",
+          fragment="NumPy_Backward_Compatibility")
+%{
+template< typename SCALAR_TYPE >
+PyObject * teuchos_sdm_numpy_view(
+  Teuchos::SerialDenseMatrix<int,SCALAR_TYPE> & tmat, int typecode,
+  PyObject * owner)
+{
+  npy_intp dims[2]    = { tmat.numRows(), tmat.numCols() };
+  npy_intp strides[2] = { (npy_intp)sizeof(SCALAR_TYPE),
+			  (npy_intp)(tmat.stride() * sizeof(SCALAR_TYPE)) };
+  PyObject * npArray = PyArray_New( &PyArray_Type, 2, dims, typecode, strides,
+				    (void*)tmat.values(), 0,
+				    NPY_ARRAY_WRITEABLE, NULL );
+  if ( npArray == NULL || owner == NULL ) return npArray;
+  // PyArray_SetBaseObject steals the reference, also on failure
+  Py_INCREF(owner);
+  if ( PyArray_SetBaseObject( (PyArrayObject*)npArray, owner ) < 0 ) {
+    Py_DECREF(npArray);
+    return NULL;
+  }
+  return npArray;
+}
+
+template< typename SCALAR_TYPE >
+void teuchos_sdm_capsule_destructor(PyObject * capsule)
+{
+  delete (Teuchos::SerialDenseMatrix<int,SCALAR_TYPE>*)
+    PyCapsule_GetPointer( capsule, NULL );
+}
+
+// Take ownership of a heap allocated matrix.  The matrix is deleted
+// here if the array cannot be created.
+template< typename SCALAR_TYPE >
+PyObject * teuchos_sdm_numpy_owner(
+  Teuchos::SerialDenseMatrix<int,SCALAR_TYPE> * tmat, int typecode)
+{
+  PyObject * capsule = PyCapsule_New( (void*)tmat, NULL,
+    teuchos_sdm_capsule_destructor<SCALAR_TYPE> );
+  if ( capsule == NULL ) { delete tmat; return NULL; }
+  PyObject * npArray = teuchos_sdm_numpy_view( *tmat, typecode, capsule );
+  Py_DECREF(capsule);
+  return npArray;
+}
+%}
+
 ////////////////////////////////////////////////////////////////////////
 // Define a macro that takes a C++ data ordinal and scalar type
 // (ORDINAL_TYPE,SCALAR_TYPE) and a
@@ -113,8 +165,10 @@ using Teuchos::SerialDenseMatrix;
     stride = (ORDINAL_TYPE)( PyArray_STRIDE(npArray,1) /
 				 PyArray_ITEMSIZE(npArray) );
 
+  // A converted array is released by freearg, so its data are copied
+  // rather than viewed, in case the matrix is retained by the callee
   $1 = Teuchos::SerialDenseMatrix<const ORDINAL_TYPE,const SCALAR_TYPE>(
-		Teuchos::View,
+		( is_new ) ? Teuchos::Copy : Teuchos::View,
 		(SCALAR_TYPE*)PyArray_DATA(npArray),
 		 stride, m, n);
 }
@@ -171,8 +225,10 @@ using Teuchos::SerialDenseMatrix;
     stride = (ORDINAL_TYPE)( PyArray_STRIDE(npArray,1) /
 				 PyArray_ITEMSIZE(npArray) );
 
+  // A converted array is released by freearg, so its data are copied
+  // rather than viewed, in case the matrix is retained by the callee
   temp = Teuchos::SerialDenseMatrix<const ORDINAL_TYPE, const SCALAR_TYPE>(
-		  Teuchos::View,
+		  ( is_new ) ? Teuchos::Copy : Teuchos::View,
 		  (SCALAR_TYPE*)PyArray_DATA(npArray),
 		  stride, m, n);
 
@@ -201,11 +257,12 @@ using Teuchos::SerialDenseMatrix;
 }
 
 %typemap(in) Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE>
+(PyObject * npArray = NULL)
 {
   // ENFORCE that $input is contiguous and has fortran (column-major ordering)
   // If it is not the matrix is copied into fortran format, else a view is taken
   // and the reference count is incremented
-  PyObject *npArray = PyArray_FROM_OTF($input, TYPECODE, NPY_ARRAY_F_CONTIGUOUS);
+  npArray = PyArray_FROM_OTF($input, TYPECODE, NPY_ARRAY_F_CONTIGUOUS);
   if ( npArray == NULL ) SWIG_fail;
 
   // Now we need to check that the NumPy array that we have is 2D.
@@ -220,12 +277,19 @@ using Teuchos::SerialDenseMatrix;
     stride = (ORDINAL_TYPE)( PyArray_STRIDE((PyArrayObject*)npArray,1) /
 				 PyArray_ITEMSIZE((PyArrayObject*)npArray) );
 
+  // A converted array is released by freearg, so its data are copied
+  // rather than viewed, in case the matrix is retained by the callee
   $1 = Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE>(
-		Teuchos::View,
+		( npArray == $input ) ? Teuchos::View : Teuchos::Copy,
 		(SCALAR_TYPE*)PyArray_DATA((PyArrayObject*)npArray),
 		stride, m, n);
 }
 
+%typemap(freearg) Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE>
+{
+  Py_XDECREF(npArray$argnum);
+}
+
 %typemap(out) Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE>
 {
   ORDINAL_TYPE m = $1->numRows(), n = $1->numCols();
@@ -251,12 +315,13 @@ using Teuchos::SerialDenseMatrix;
 }
 
 %typemap(in) Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE> const &
-(Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE> temp)
+(Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE> temp,
+ PyObject * npArray = NULL)
 {
   // ENFORCE that $input is contiguous and has fortran (column-major ordering)
   // If it is not the matrix is copied into fortran format, else a view is taken
   // and the reference count is incremented
-  PyObject *npArray = PyArray_FROM_OTF($input, TYPECODE, NPY_ARRAY_F_CONTIGUOUS);
+  npArray = PyArray_FROM_OTF($input, TYPECODE, NPY_ARRAY_F_CONTIGUOUS);
   if ( npArray == NULL ) SWIG_fail;
 
   // Now we need to check that the NumPy array that we have is 2D.
@@ -271,8 +336,10 @@ using Teuchos::SerialDenseMatrix;
     stride = (ORDINAL_TYPE)( PyArray_STRIDE((PyArrayObject*)npArray,1) /
 				 PyArray_ITEMSIZE((PyArrayObject*)npArray) );
 
+  // A converted array is released by freearg, so its data are copied
+  // rather than viewed, in case the matrix is retained by the callee
   temp = Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE>(
-		Teuchos::View,
+		( npArray == $input ) ? Teuchos::View : Teuchos::Copy,
 		(SCALAR_TYPE*)PyArray_DATA((PyArrayObject*)npArray),
 		stride, m, n);
 
@@ -280,6 +347,11 @@ using Teuchos::SerialDenseMatrix;
   $1 = &temp;
 }
 
+%typemap(freearg) Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE> const &
+{
+  Py_XDECREF(npArray$argnum);
+}
+
 %typemap(out) Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE> const &
 {
   ORDINAL_TYPE m = $1->numRows(), n = $1->numCols();
@@ -300,48 +372,37 @@ using Teuchos::SerialDenseMatrix;
 // Teuchos::SerialDenseMatrix<ORDINAL_TYPE, SCALAR_TYPE> & result//
 ////////////////////////////////
 
-// Specify how to return result to python
-%typemap(argout) Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE> &argout
+// Specify how to return result to python.  The matrix is heap allocated
+// by the in typemap and its ownership is transferred to the returned array,
+// such that no copy is made.
+%typemap(argout, fragment="Teuchos_SDM_Views")
+  Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE> &argout
 {
-  ORDINAL_TYPE m = $1->numRows(), n = $1->numCols();
-  npy_intp dims[2] = { m, n };
-  PyObject *npArray = PyArray_EMPTY( 2, dims, TYPECODE, 1 );
+  PyObject *npArray = teuchos_sdm_numpy_owner( $1, TYPECODE );
+  $1 = NULL;
   if (!npArray) SWIG_fail;
-  SCALAR_TYPE *buffer = (SCALAR_TYPE *)PyArray_DATA( (PyArrayObject*)npArray );
-  for ( int j = 0; j < n; j++ ){
-    for ( int i = 0; i < m; i++ ){
-      buffer[j*m+i] = $1->operator()(i,j);
-    }
-  }
   $result = SWIG_Python_AppendOutput($result,npArray);
 }
 
 // Remove result from the python function call.
 %typemap(in,numinputs=0) Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE> &argout
-  ( Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE> TSDM )
 {
-  // Must declare the variable that needs to be passed to the c++ function
-  TSDM = Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE>();
-  $1 = &TSDM;
+  // Allocate the matrix that is passed to the c++ function
+  $1 = new Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE>();
 };
 
 %typemap(freearg) Teuchos::SerialDenseMatrix<ORDINAL_TYPE,SCALAR_TYPE> &argout
 {
-  // Do nothing. Needed so that default free arg is not used
-  // Check with Bill Spotz
+  // NULL unless the call failed before ownership was transferred
+  delete $1;
 };
 
-//Allow serial dense matrix be passed back to a python class derived from a c++ director class
-%typemap(directorin) Teuchos::SerialDenseMatrix<int,double> &%{
-  npy_intp dims$argnum[2] = { $1_name.numRows(),$1_name.numCols() };
-  double * data$argnum = $1_name.values();
-  PyArray_Descr * dtype$argnum = PyArray_DescrFromType( NPY_DOUBLE );
-  PyArrayObject* py_array$argnum =
-    (PyArrayObject*) PyArray_NewFromDescr( &PyArray_Type, dtype$argnum, 2,
-					   dims$argnum, NULL, (void*)data$argnum,
-					   NPY_ARRAY_F_CONTIGUOUS, NULL );
-  // Cast to (PyObject*) is necessary
-  $input = (PyObject*)py_array$argnum;
+// Allow serial dense matrix be passed back to a python class derived from a
+// c++ director class.  The array is a view of the C++ matrix, which is valid
+// only for the duration of the call into python.
+%typemap(directorin, fragment="Teuchos_SDM_Views")
+  Teuchos::SerialDenseMatrix<int,double> &%{
+  $input = teuchos_sdm_numpy_view( $1_name, NPY_DOUBLE, (PyObject*)NULL );
   %}
 
 %typemap(directorargout) Teuchos::SerialDenseMatrix<int,double> &argout%{
@@ -355,6 +416,7 @@ using Teuchos::SerialDenseMatrix;
 
   // Now we need to check that the NumPy array that we have is 2D.
   if ( PyArray_NDIM( (PyArrayObject*)npArray$argnum ) != 2 ) {
+    Py_DECREF(npArray$argnum);
     throw( std::runtime_error( " Values out must be 2 dimensional" ) );
     //PyErr_SetString(PyExc_ValueError, "Array data must be two dimensional");
     //SWIG_fail;
@@ -373,6 +435,7 @@ using Teuchos::SerialDenseMatrix;
 
   $1.shapeUninitialized(m$argnum,n$argnum);
   $1.assign(temp$argnum);
+  Py_DECREF(npArray$argnum);
 %}
 
 %enddef
@@ -150,7 +150,7 @@ def __reduce__(self):
 %pythoncode %{
 import numpy
 class PyFunction(Function):
-    def __init__(self,target_function):
+    def __init__(self,target_function,vectorized=False):
         """
         Parameters
         ----------
@@ -158,9 +158,17 @@ class PyFunction(Function):
             Calls to target funcation are assumed to follow
             vals = target_function(sample). Where vals
             is a 1D array and sample is a 1D array or scalar.
+
+        vectorized : boolean
+            If True, the target function is called once with the
+            entire (num_vars x num_samples) sample matrix and must
+            return a (num_samples x num_qoi) matrix or a 1D array
+            of num_samples values. This avoids a python call per
+            sample.
         """
         Function.__init__(self)
         self.target_function = target_function
+        self.vectorized = vectorized
 
     def value(self,samples):
         """
@@ -168,7 +176,7 @@ class PyFunction(Function):
 
         The number of QoI of the vectored_valued function is determined
         by probing the target_function with the first sample in the set
-        of samples.
+        of samples, unless the target function is vectorized.
 
         Parameters
         ----------
@@ -183,16 +191,26 @@ class PyFunction(Function):
         values : (num_samples x num_qoi) matrix
             The vector-valued function value at the samples
         """
-	if samples.ndim==1:
+        if samples.ndim==1:
             samples = samples.reshape(samples.shape[0],1)
         num_samples = samples.shape[1]
-        values = numpy.empty((num_samples),float)
+        if self.vectorized:
+            values = numpy.asarray(self.target_function(samples),dtype=float)
+            if values.ndim==1:
+                values = values.reshape(num_samples,1)
+            if values.ndim!=2 or values.shape[0]!=num_samples:
+                raise ValueError(
+                    "vectorized target_function must return %d values "
+                    "or a (%d x num_qoi) matrix, not shape %s"
+                    % (num_samples,num_samples,str(values.shape)))
+            # fortran ordering allows values to be read without a copy
+            return numpy.asfortranarray(values)
         values_0 = self.target_function(samples[:,0])
         if numpy.isscalar(values_0):
             values_0 = numpy.array([values_0])
         assert values_0.ndim==1
         num_qoi = values_0.shape[0]
-        values = numpy.empty((num_samples,num_qoi),float)
+        values = numpy.empty((num_samples,num_qoi),float,order='F')
         values[0,:] = values_0
         for i in xrange(1,samples.shape[1]):
             values_i = self.target_function(samples[:,i])
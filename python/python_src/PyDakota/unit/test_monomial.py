@@ -50,6 +50,22 @@ class TestMonomialApproximation(unittest.TestCase):
                 samples[:,i])
         assert numpy.allclose(true_values, values)
 
+        # check that a vectorized function is called once with the
+        # entire sample matrix
+        num_calls = [0]
+        def vectorized_function(x):
+            num_calls[0] += 1
+            return numpy.sum(x**2,axis=0) + numpy.sum(x,axis=0)*2 + 1.
+        function = PyFunction(vectorized_function, vectorized=True)
+        values = function.value(samples)
+        assert num_calls[0]==1
+        assert numpy.allclose(true_values, values)
+
+        # check that a vectorized function returning the wrong number of
+        # values is reported as an error
+        function = PyFunction(lambda x: numpy.sum(x), vectorized=True)
+        self.assertRaises(ValueError, function.value, samples)
+
     def test_define_homogeneous_ranges(self):
         """Generate a hypercube with the same bounds for each dimension"""
         num_vars = 3
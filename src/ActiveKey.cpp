@@ -0,0 +1,89 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 ActiveKey
+//- Description: Implementation code for ActiveKey hashing and interning
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "ActiveKey.hpp"
+#include "boost/functional/hash.hpp"
+
+//#define DEBUG
+
+namespace Pecos {
+
+std::unordered_map<ActiveKey, size_t, ActiveKeyRegistry::KeyHash>
+                        ActiveKeyRegistry::keyIndices;
+std::vector<ActiveKey>  ActiveKeyRegistry::internedKeys;
+std::mutex              ActiveKeyRegistry::registryMutex;
+
+
+size_t ActiveKeyData::hash() const
+{
+  size_t seed = 0;
+  const UShortArray& indices = keyDataRep->modelIndices;
+  boost::hash_range(seed, indices.begin(), indices.end());
+
+  const RealVector&   c_params = keyDataRep->continuousHyperParams;
+  const IntVector&   di_params = keyDataRep->discreteIntHyperParams;
+  const SizetVector& ds_params = keyDataRep->discreteSetHyperParams;
+  // lengths delimit the vectors such that empty vectors contribute
+  boost::hash_combine(seed, c_params.length());
+  boost::hash_range(seed, c_params.values(),
+		    c_params.values() + c_params.length());
+  boost::hash_combine(seed, di_params.length());
+  boost::hash_range(seed, di_params.values(),
+		    di_params.values() + di_params.length());
+  boost::hash_combine(seed, ds_params.length());
+  boost::hash_range(seed, ds_params.values(),
+		    ds_params.values() + ds_params.length());
+  return seed;
+}
+
+
+size_t ActiveKey::hash() const
+{
+  if (keyRep->internIndex != SZ_MAX)
+    return keyRep->hashValue;
+
+  size_t i, num_data = keyRep->activeKeyDataArray.size(), seed = 0;
+  boost::hash_combine(seed, keyRep->dataSetId);
+  boost::hash_combine(seed, keyRep->reductionType);
+  for (i=0; i<num_data; ++i)
+    boost::hash_combine(seed, keyRep->activeKeyDataArray[i].hash());
+  return seed;
+}
+
+
+ActiveKey ActiveKeyRegistry::intern(const ActiveKey& key)
+{
+  if (key.keyRep->internIndex != SZ_MAX)
+    return key;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  std::unordered_map<ActiveKey, size_t, KeyHash>::iterator it
+    = keyIndices.find(key);
+  if (it != keyIndices.end())
+    return internedKeys[it->second];
+
+  ActiveKey key_copy = key.copy();
+  key_copy.keyRep->hashValue   = key.hash();
+  key_copy.keyRep->internIndex = internedKeys.size();
+  internedKeys.push_back(key_copy);
+  keyIndices.insert(std::pair<ActiveKey, size_t>(key_copy,
+						 key_copy.keyRep->internIndex));
+#ifdef DEBUG
+  PCout << "ActiveKeyRegistry::intern(): registered key "
+	<< key_copy.keyRep->internIndex << std::endl;
+#endif // DEBUG
+  return key_copy;
+}
+
+} // namespace Pecos
@@ -10,6 +10,8 @@
 #define ACTIVE_KEY_HPP
 
 #include "pecos_data_types.hpp"
+#include <mutex>
+#include <unordered_map>
 
 
 namespace Pecos {
@@ -162,6 +164,8 @@ public:
 
   /// return deep copy of ActiveKeyData instance
   ActiveKeyData copy() const;
+  /// return a hash of the model indices and hyper-parameters
+  size_t hash() const;
 
   /// set i^{th} entry within modelIndices
   void model_index(unsigned short mi, size_t i);
@@ -559,6 +563,8 @@ class ActiveKeyRep
 
   /// the handle class can access attributes of the body class directly
   friend class ActiveKey;
+  /// the registry assigns the interned index and hash
+  friend class ActiveKeyRegistry;
 
 public:
 
@@ -644,31 +650,38 @@ private:
   // reflect the complete inactive state, only the subset identified as part of
   // solution control
   //ActiveKeyData sharedState;
+
+  /// index assigned by ActiveKeyRegistry for an interned rep (SZ_MAX if
+  /// this rep is not interned)
+  size_t internIndex;
+  /// hash of the key contents, precomputed for an interned rep
+  size_t hashValue;
 };
 
 
 inline ActiveKeyRep::ActiveKeyRep():
-  dataSetId(USHRT_MAX), reductionType(NO_DATA)
+  dataSetId(USHRT_MAX), reductionType(NO_DATA), internIndex(SZ_MAX),
+  hashValue(0)
 { } // leave activeKeyDataArray empty
 
 
 inline ActiveKeyRep::
 ActiveKeyRep(unsigned short set_id, short r_type):
-  dataSetId(set_id), reductionType(r_type)
+  dataSetId(set_id), reductionType(r_type), internIndex(SZ_MAX), hashValue(0)
 { }
 
 
 inline ActiveKeyRep::
 ActiveKeyRep(unsigned short set_id, short r_type,
 	     const std::vector<ActiveKeyData>& key_data_vec, short copy_mode):
-  dataSetId(set_id), reductionType(r_type)
+  dataSetId(set_id), reductionType(r_type), internIndex(SZ_MAX), hashValue(0)
 { data(key_data_vec, copy_mode); }
 
 
 inline ActiveKeyRep::
 ActiveKeyRep(unsigned short set_id, short r_type,
 	     const ActiveKeyData& key_data, short copy_mode):
-  dataSetId(set_id), reductionType(r_type)
+  dataSetId(set_id), reductionType(r_type), internIndex(SZ_MAX), hashValue(0)
 { data(key_data, copy_mode); }
 
 
@@ -769,6 +782,15 @@ public:
   /// return deep copy of ActiveKey instance
   ActiveKey copy() const;
 
+  /// return a hash of the key contents (precomputed for interned keys)
+  size_t hash() const;
+  /// return the shared instance of this key from ActiveKeyRegistry,
+  /// registering a deep copy if not yet present
+  ActiveKey interned() const;
+  /// return the index of an interned key within ActiveKeyRegistry
+  /// (SZ_MAX if this instance is not interned)
+  size_t interned_index() const;
+
   // function to check keyRep (does this handle contain a body)
   //bool is_null() const;
   /// function to check for a valid key definition (at least 1 ActiveKeyData)
@@ -839,6 +861,13 @@ public:
 
 private:
 
+  //
+  //- Heading: Friends
+  //
+
+  /// the registry creates and tags the interned reps
+  friend class ActiveKeyRegistry;
+
   //
   //- Heading: Member functions
   //
@@ -869,6 +898,10 @@ private:
   /// append a model key to create a data combination (e.g., a discrepancy)
   void aggregate_key(const ActiveKey& key);
 
+  /// replace an interned keyRep with a private deep copy prior to its
+  /// modification (copy on write), leaving the registered instance intact
+  void detach_interned();
+
   //
   //- Heading: Private data members
   //
@@ -929,6 +962,9 @@ inline bool ActiveKey::operator==(const ActiveKey& key) const
   std::shared_ptr<ActiveKeyRep> kr = key.keyRep;
   if      (keyRep == kr)                       return true; // same (incl. null)
   else if (keyRep == nullptr || kr == nullptr) return false;
+  // distinct interned reps are distinct keys
+  else if (keyRep->internIndex != SZ_MAX && kr->internIndex != SZ_MAX)
+    return false;
   else
     return ( keyRep->dataSetId          == kr->dataSetId &&
 	     keyRep->reductionType      == kr->reductionType &&
@@ -942,7 +978,9 @@ inline bool ActiveKey::operator!=(const ActiveKey& key) const
 
 inline bool ActiveKey::operator<(const ActiveKey& key) const
 {
-  std::shared_ptr<ActiveKeyRep> kr = key.keyRep;
+  const std::shared_ptr<ActiveKeyRep>& kr = key.keyRep;
+  if (keyRep == kr)
+    return false; // same rep
   if (keyRep->dataSetId < kr->dataSetId)
     return true;
   else if (kr->dataSetId < keyRep->dataSetId)
@@ -968,6 +1006,7 @@ inline unsigned short ActiveKey::id() const
 
 inline void ActiveKey::id(unsigned short set_id)
 {
+  detach_interned();
   if (shared()) {
     PCerr << "Error: keyRep count protection violated in ActiveKey::id()"
 	  << std::endl;
@@ -983,6 +1022,7 @@ inline short ActiveKey::type() const
 
 inline void ActiveKey::type(short r_type)
 {
+  detach_interned();
   if (shared()) {
     PCerr << "Error: keyRep count protection violated in ActiveKey::type()"
 	  << std::endl;
@@ -1005,16 +1045,16 @@ inline const ActiveKeyData& ActiveKey::data(size_t i) const
 
 
 inline ActiveKeyData& ActiveKey::data(size_t i)
-{ return keyRep->activeKeyDataArray[i]; }
+{ detach_interned(); return keyRep->activeKeyDataArray[i]; }
 
 
 inline void ActiveKey::
 data(const std::vector<ActiveKeyData>& key_data_vec, short copy_mode)
-{ keyRep->data(key_data_vec, copy_mode); }
+{ detach_interned(); keyRep->data(key_data_vec, copy_mode); }
 
 
 inline void ActiveKey::data(const ActiveKeyData& key_data, short copy_mode)
-{ keyRep->data(key_data, copy_mode); }
+{ detach_interned(); keyRep->data(key_data, copy_mode); }
 
 
 inline void ActiveKey::
@@ -1032,6 +1072,7 @@ assign(unsigned short set_id, short r_type, const ActiveKeyData& key_data,
 inline void ActiveKey::
 append(const std::vector<ActiveKeyData>& key_data_vec, short copy_mode)
 {
+  detach_interned();
   std::vector<ActiveKeyData>& act_key_data = keyRep->activeKeyDataArray;
   if (copy_mode == DEEP_COPY) {
     size_t i, len = key_data_vec.size();
@@ -1046,6 +1087,7 @@ append(const std::vector<ActiveKeyData>& key_data_vec, short copy_mode)
 
 inline void ActiveKey::append(const ActiveKeyData& key_data, short copy_mode)
 {
+  detach_interned();
   if (copy_mode == DEEP_COPY)
     keyRep->activeKeyDataArray.push_back(key_data.copy());
   else
@@ -1054,7 +1096,15 @@ inline void ActiveKey::append(const ActiveKeyData& key_data, short copy_mode)
 
 
 inline void ActiveKey::clear_data()
-{ keyRep->activeKeyDataArray.clear(); }
+{ detach_interned(); keyRep->activeKeyDataArray.clear(); }
+
+
+inline void ActiveKey::detach_interned()
+{
+  // the deep copy is not interned; the registry retains the original rep
+  if (keyRep->internIndex != SZ_MAX)
+    keyRep = copy().keyRep;
+}
 
 
 inline void ActiveKey::clear()
@@ -1085,6 +1135,10 @@ inline ActiveKey ActiveKey::copy() const
 }
 
 
+inline size_t ActiveKey::interned_index() const
+{ return keyRep->internIndex; }
+
+
 //inline bool ActiveKey::is_null() const
 //{ return (keyRep) ? false : true; }
 
@@ -1408,6 +1462,75 @@ template <typename Stream>
 Stream& operator<<(Stream& s, const Pecos::ActiveKey& key)
 { key.write(s); return s; }
 
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+/// Process-wide registry of interned ActiveKey instances.
+
+/** Each distinct key is registered once as a deep copy that is tagged
+    with a dense index and a precomputed hash.  Handles sharing an
+    interned rep compare equal through the shared rep and distinct
+    interned reps compare unequal by index, such that active key
+    switching among interned keys requires no element-wise comparison of
+    model indices and hyper-parameters.  Interned reps are never modified:
+    each ActiveKey modifier (including non-const access through
+    ActiveKey::data(size_t)) first replaces an interned rep with a private
+    deep copy that is not interned.  Registered keys are never evicted, so
+    the registry grows with the number of distinct keys interned over the
+    life of the process; current usage interns only the keys of the model
+    hierarchy (model forms, resolution levels and their aggregations),
+    which bounds its size. */
+
+class ActiveKeyRegistry
+{
+public:
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// return the interned instance of key, registering a deep copy if
+  /// not yet present
+  static ActiveKey intern(const ActiveKey& key);
+  /// return the interned key for an index
+  static ActiveKey key(size_t index);
+  /// return the number of interned keys
+  static size_t size();
+
+private:
+
+  //
+  //- Heading: Data
+  //
+
+  /// hash functor for unordered containers of ActiveKey
+  struct KeyHash
+  { size_t operator()(const ActiveKey& key) const { return key.hash(); } };
+
+  /// mapping from key contents to index within internedKeys
+  static std::unordered_map<ActiveKey, size_t, KeyHash> keyIndices;
+  /// interned keys, ordered by index
+  static std::vector<ActiveKey> internedKeys;
+  /// serializes access to keyIndices and internedKeys
+  static std::mutex registryMutex;
+};
+
+
+inline ActiveKey ActiveKey::interned() const
+{
+  return (keyRep->internIndex == SZ_MAX) ?
+    ActiveKeyRegistry::intern(*this) : *this;
+}
+
+
+inline ActiveKey ActiveKeyRegistry::key(size_t index)
+{ std::lock_guard<std::mutex> lock(registryMutex); return internedKeys[index]; }
+
+
+inline size_t ActiveKeyRegistry::size()
+{ std::lock_guard<std::mutex> lock(registryMutex); return internedKeys.size(); }
+
 } // namespace Pecos
 
 #endif
@@ -229,6 +229,20 @@ Real BasisPolynomial::type1_hessian(Real x, unsigned short n)
 }
 
 
+void BasisPolynomial::
+type1_values(const RealVector& x, unsigned short max_order, short deriv_order,
+	     RealMatrix& t1_vals, RealMatrix& t1_grads, RealMatrix& t1_hessians)
+{
+  if (!polyRep) {
+    PCerr << "Error: type1_values() not available for this basis polynomial "
+	  << "type." << std::endl;
+    abort_handler(-1);
+  }
+  polyRep->type1_values(x, max_order, deriv_order, t1_vals, t1_grads,
+			t1_hessians);
+}
+
+
 Real BasisPolynomial::norm_squared(unsigned short n)
 {
   if (!polyRep) {
@@ -386,6 +400,37 @@ Real BasisPolynomial::barycentric_difference_product() const
 }
 
 
+void BasisPolynomial::
+barycentric_value_factors(const Real* x, size_t num_x,
+			  RealMatrix& value_factors,
+			  RealVector& value_factor_sums,
+			  SizetArray& exact_indices) const
+{
+  if (!polyRep) {
+    PCerr << "Error: barycentric_value_factors(Real*) not available for this "
+	  << "basis polynomial type." << std::endl;
+    abort_handler(-1);
+  }
+  polyRep->barycentric_value_factors(x, num_x, value_factors,
+				     value_factor_sums, exact_indices);
+}
+
+
+void BasisPolynomial::
+barycentric_factors(const Real* x, size_t num_x, RealMatrix& value_factors,
+		    RealVector& value_factor_sums, RealMatrix& grad_factors,
+		    RealVector& diff_products, SizetArray& exact_indices) const
+{
+  if (!polyRep) {
+    PCerr << "Error: barycentric_factors() not available for this basis "
+	  << "polynomial type." << std::endl;
+    abort_handler(-1);
+  }
+  polyRep->barycentric_factors(x, num_x, value_factors, value_factor_sums,
+			       grad_factors, diff_products, exact_indices);
+}
+
+
 void BasisPolynomial::reset_gauss()
 {
   if (polyRep)
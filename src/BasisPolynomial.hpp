@@ -102,6 +102,16 @@ public:
       whereas for interpolation polynomials, it identifies the interpolant
       for the n-th point. */
   virtual Real type1_hessian(Real x, unsigned short n);
+  /// retrieve the values of the type 1 polynomials of orders 0 through
+  /// max_order, and optionally their gradients and Hessians, for a set
+  /// of parameter values using a single recurrence pass
+  /** Results are returned as (max_order+1) x num_x matrices, such that
+      all orders for a parameter value are contiguous.  Gradients are
+      computed for deriv_order >= 1 and Hessians for deriv_order >= 2.
+      This is defined only for orthogonal polynomials. */
+  virtual void type1_values(const RealVector& x, unsigned short max_order,
+			    short deriv_order, RealMatrix& t1_vals,
+			    RealMatrix& t1_grads, RealMatrix& t1_hessians);
 
   /// returns the norm-squared of the n_th order polynomial defined by the
   /// inner product <Poly_n, Poly_n> = ||Poly_n||^2
@@ -147,6 +157,20 @@ public:
   /// return the product of all differences between the interpolation
   /// points and a current point
   virtual Real barycentric_difference_product() const;
+  /// stateless evaluation of the barycentric value factors for a block
+  /// of points (see LagrangeInterpPolynomial)
+  virtual void barycentric_value_factors(const Real* x, size_t num_x,
+					 RealMatrix& value_factors,
+					 RealVector& value_factor_sums,
+					 SizetArray& exact_indices) const;
+  /// stateless evaluation of the barycentric value and gradient factors
+  /// for a block of points (see LagrangeInterpPolynomial)
+  virtual void barycentric_factors(const Real* x, size_t num_x,
+				   RealMatrix& value_factors,
+				   RealVector& value_factor_sums,
+				   RealMatrix& grad_factors,
+				   RealVector& diff_products,
+				   SizetArray& exact_indices) const;
 
   /// destroy history of Gauss pts/wts (due to distribution parameter changes)
   /** This is defined only for orthogonal polynomials. */
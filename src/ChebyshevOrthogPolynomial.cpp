@@ -180,6 +180,19 @@ Real ChebyshevOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 }
 
 
+bool ChebyshevOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  // T_1 = x, T_{n+1} = 2x T_n - T_{n-1}
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  for (unsigned short n=0; n<max_order; ++n)
+    { a[n] = (n) ? 2. : 1.; b[n] = 0.; c[n] = (n) ? 1. : 0.; }
+  return true;
+}
+
+
 Real ChebyshevOrthogPolynomial::norm_squared(unsigned short order)
 { return (order) ? PI/2. : PI; }
 
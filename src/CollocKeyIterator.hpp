@@ -0,0 +1,157 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 CollocKeyIterator
+//- Description: On-the-fly enumeration of tensor-product collocation keys
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef COLLOC_KEY_ITERATOR_HPP
+#define COLLOC_KEY_ITERATOR_HPP
+
+#include "pecos_data_types.hpp"
+
+namespace Pecos {
+
+
+/// Lightweight iterator over the collocation keys of a tensor-product grid
+
+/** Enumerates the 1D point indices for each point within a tensor-product
+    grid of given quadrature orders, in the same ordering as
+    SharedPolyApproxData::tensor_product_multi_index(orders, key, false)
+    (first variable varies fastest).  This allows the points of a sparse
+    grid to be traversed from its Smolyak multi-index and 1D rules without
+    materializing a UShort3DArray collocation key. */
+
+class CollocKeyIterator
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  CollocKeyIterator();
+  /// constructor from the quadrature orders of the tensor grid
+  CollocKeyIterator(const UShortArray& quad_order);
+  /// destructor
+  ~CollocKeyIterator();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// define the quadrature orders of the tensor grid and rewind
+  void reset(const UShortArray& quad_order);
+  /// rewind to the first point in the tensor grid
+  void reset();
+
+  /// advance to the next point in the tensor grid
+  CollocKeyIterator& operator++();
+  /// return true once all points in the tensor grid have been traversed
+  bool done() const;
+
+  /// return the 1D point indices for the current tensor point
+  const UShortArray& key() const;
+  /// return the 1D point index for variable v of the current tensor point
+  unsigned short operator[](size_t v) const;
+  /// return the ordinal of the current point within the tensor grid
+  size_t index() const;
+  /// return the number of points in the tensor grid
+  size_t size() const;
+
+  /// return the number of points in a tensor grid of given quadrature orders
+  static size_t num_points(const UShortArray& quad_order);
+
+private:
+
+  //
+  //- Heading: Data
+  //
+
+  /// quadrature orders (number of 1D points) for each variable
+  UShortArray quadOrder;
+  /// 1D point indices for the current tensor point
+  UShortArray currKey;
+  /// ordinal of the current tensor point
+  size_t currIndex;
+  /// number of points in the tensor grid
+  size_t numPoints;
+};
+
+
+inline CollocKeyIterator::CollocKeyIterator():
+  currIndex(0), numPoints(0)
+{ }
+
+
+inline CollocKeyIterator::CollocKeyIterator(const UShortArray& quad_order)
+{ reset(quad_order); }
+
+
+inline CollocKeyIterator::~CollocKeyIterator()
+{ }
+
+
+inline size_t CollocKeyIterator::num_points(const UShortArray& quad_order)
+{
+  size_t v, num_v = quad_order.size(), num_pts = 1;
+  for (v=0; v<num_v; ++v)
+    num_pts *= quad_order[v];
+  return num_pts;
+}
+
+
+inline void CollocKeyIterator::reset(const UShortArray& quad_order)
+{
+  quadOrder = quad_order;
+  numPoints = num_points(quad_order);
+  reset();
+}
+
+
+inline void CollocKeyIterator::reset()
+{ currKey.assign(quadOrder.size(), 0); currIndex = 0; }
+
+
+inline CollocKeyIterator& CollocKeyIterator::operator++()
+{
+  // increment with carry, consistent with SharedPolyApproxData::
+  // increment_indices() when excluding the upper bound
+  size_t v = 0, num_v = quadOrder.size();
+  ++currIndex;
+  while (v < num_v && ++currKey[v] >= quadOrder[v])
+    { currKey[v] = 0; ++v; }
+  return *this;
+}
+
+
+inline bool CollocKeyIterator::done() const
+{ return (currIndex >= numPoints); }
+
+
+inline const UShortArray& CollocKeyIterator::key() const
+{ return currKey; }
+
+
+inline unsigned short CollocKeyIterator::operator[](size_t v) const
+{ return currKey[v]; }
+
+
+inline size_t CollocKeyIterator::index() const
+{ return currIndex; }
+
+
+inline size_t CollocKeyIterator::size() const
+{ return numPoints; }
+
+} // namespace Pecos
+
+#endif
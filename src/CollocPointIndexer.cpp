@@ -0,0 +1,168 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 CollocPointIndexer
+//- Description: Implementation code for CollocPointIndexer class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "CollocPointIndexer.hpp"
+
+//#define DEBUG
+
+namespace Pecos {
+
+
+int CollocPointIndexer::
+point_id_1d(size_t v, unsigned short lev, unsigned short j,
+	    const Real3DArray& colloc_pts_1d)
+{
+  if (lev >= pointIds1D.size()) {
+    size_t i, size_1d = pointIds1D.size();
+    pointIds1D.resize(lev+1);
+    for (i=size_1d; i<=lev; ++i)
+      pointIds1D[i].resize(numVars);
+  }
+
+  IntArray& ids_1d = pointIds1D[lev][v];
+  const RealArray& pts_1d = colloc_pts_1d[lev][v];
+  size_t i, num_pts = pts_1d.size();
+  if (ids_1d.size() != num_pts) {
+    // bucket the 1D abscissae for this level against all abscissae seen
+    // previously for variable v: nested rules reproduce prior ids exactly,
+    // while non-nested rules only match to within the duplication tolerance
+    std::map<Real, int>& abscissa_ids = abscissaIds[v];
+    std::map<Real, int>::iterator it;
+    ids_1d.resize(num_pts);
+    for (i=0; i<num_pts; ++i) {
+      Real x = pts_1d[i];
+      it = abscissa_ids.lower_bound(x - duplicateTol);
+      if (it != abscissa_ids.end() && it->first <= x + duplicateTol)
+	ids_1d[i] = it->second;
+      else {
+	int new_id = abscissa_ids.size();
+	abscissa_ids.insert(std::pair<Real, int>(x, new_id));
+	ids_1d[i] = new_id;
+      }
+    }
+  }
+  return ids_1d[j];
+}
+
+
+int CollocPointIndexer::
+reference_unique(const UShort2DArray& sm_mi, const UShort2DArray& tp_orders,
+		 const Real3DArray& colloc_pts_1d, BitArray& is_unique1,
+		 IntArray& unique_index_map)
+{
+  referenceIds.clear();  incrementIds.clear();
+
+  size_t i, num_sm_mi = sm_mi.size(), n1 = 0, cntr;
+  for (i=0; i<num_sm_mi; ++i)
+    n1 += CollocKeyIterator::num_points(tp_orders[i]);
+  is_unique1.resize(n1);  is_unique1.reset();
+  unique_index_map.resize(n1);
+
+  int num_u1 = 0;  IntArray pt_key;  CollocKeyIterator key_it;
+  std::pair<boost::unordered_map<IntArray, int>::iterator, bool> ins;
+  for (i=0, cntr=0; i<num_sm_mi; ++i) {
+    const UShortArray& sm_index = sm_mi[i];
+    for (key_it.reset(tp_orders[i]); !key_it.done(); ++key_it, ++cntr) {
+      point_key(sm_index, key_it.key(), colloc_pts_1d, pt_key);
+      ins = referenceIds.insert(
+	std::pair<IntArray, int>(pt_key, num_u1));
+      if (ins.second) // first appearance: new unique point
+	{ is_unique1.set(cntr); unique_index_map[cntr] = num_u1++; }
+      else
+	unique_index_map[cntr] = ins.first->second;
+    }
+  }
+
+#ifdef DEBUG
+  PCout << "CollocPointIndexer::reference_unique(): num_unique1 = " << num_u1
+	<< "\nReference map:\n" << unique_index_map << std::endl;
+#endif // DEBUG
+
+  return num_u1;
+}
+
+
+int CollocPointIndexer::
+increment_unique(size_t start_index, const UShort2DArray& sm_mi,
+		 const UShort2DArray& tp_orders,
+		 const Real3DArray& colloc_pts_1d, int num_unique1,
+		 BitArray& is_unique2, IntArray& unique_index_map)
+{
+  // any previous (popped or merged) increment is replaced
+  incrementIds.clear();
+
+  size_t i, num_sm_mi = sm_mi.size(), n1 = 0, n2 = 0, cntr;
+  for (i=0; i<start_index; ++i)
+    n1 += CollocKeyIterator::num_points(tp_orders[i]);
+  for (i=start_index; i<num_sm_mi; ++i)
+    n2 += CollocKeyIterator::num_points(tp_orders[i]);
+  is_unique2.resize(n2);  is_unique2.reset();
+  unique_index_map.resize(n1+n2);
+
+  int num_u2 = 0;  IntArray pt_key;  CollocKeyIterator key_it;
+  boost::unordered_map<IntArray, int>::const_iterator cit;
+  std::pair<boost::unordered_map<IntArray, int>::iterator, bool> ins;
+  for (i=start_index, cntr=0; i<num_sm_mi; ++i) {
+    const UShortArray& sm_index = sm_mi[i];
+    for (key_it.reset(tp_orders[i]); !key_it.done(); ++key_it, ++cntr) {
+      point_key(sm_index, key_it.key(), colloc_pts_1d, pt_key);
+      cit = referenceIds.find(pt_key);
+      if (cit != referenceIds.end()) // duplicates a reference point
+	unique_index_map[n1+cntr] = cit->second;
+      else {
+	ins = incrementIds.insert(
+	  std::pair<IntArray, int>(pt_key, num_unique1 + num_u2));
+	if (ins.second) // first appearance within increment
+	  { is_unique2.set(cntr); unique_index_map[n1+cntr] = ins.first->second;
+	    ++num_u2; }
+	else
+	  unique_index_map[n1+cntr] = ins.first->second;
+      }
+    }
+  }
+
+#ifdef DEBUG
+  PCout << "CollocPointIndexer::increment_unique(): num_unique2 = " << num_u2
+	<< "\nIncremented map:\n" << unique_index_map << std::endl;
+#endif // DEBUG
+
+  return num_u2;
+}
+
+
+void CollocPointIndexer::merge_unique()
+{
+  referenceIds.insert(incrementIds.begin(), incrementIds.end());
+  incrementIds.clear();
+}
+
+
+int CollocPointIndexer::
+count_unique(const UShort2DArray& sm_mi, const UShort2DArray& tp_orders,
+	     const Real3DArray& colloc_pts_1d)
+{
+  boost::unordered_map<IntArray, int> count_ids;
+  size_t i, num_sm_mi = sm_mi.size();
+  IntArray pt_key;  CollocKeyIterator key_it;
+  for (i=0; i<num_sm_mi; ++i) {
+    const UShortArray& sm_index = sm_mi[i];
+    for (key_it.reset(tp_orders[i]); !key_it.done(); ++key_it) {
+      point_key(sm_index, key_it.key(), colloc_pts_1d, pt_key);
+      count_ids.insert(std::pair<IntArray, int>(pt_key, count_ids.size()));
+    }
+  }
+  return count_ids.size();
+}
+
+} // namespace Pecos
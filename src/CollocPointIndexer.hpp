@@ -0,0 +1,149 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 CollocPointIndexer
+//- Description: Symbolic identification of unique sparse grid points
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef COLLOC_POINT_INDEXER_HPP
+#define COLLOC_POINT_INDEXER_HPP
+
+#include "CollocKeyIterator.hpp"
+#include <boost/unordered_map.hpp>
+
+namespace Pecos {
+
+
+/// Utility class for identifying the unique collocation points within
+/// a set of tensor-product grids.
+
+/** Rather than detecting duplication among the N-dimensional points
+    (as in webbur::point_radial_tol_unique_index_inc{1,2,3}()), each
+    (level, 1D point index) pair is first mapped to an integer id for
+    the distinct 1D abscissa it represents.  For nested rules, these
+    ids coincide across levels; for non-nested rules, the distinct
+    abscissae are bucketed to within the duplication tolerance.  An
+    N-dimensional point is then identified by hashing its vector of 1D
+    ids, such that identification of N points in d dimensions is O(N d).
+    Unique ids are assigned in order of first appearance, for
+    consistency with CombinedSparseGridDriver::assign_sparse_points(). */
+
+class CollocPointIndexer
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  CollocPointIndexer();
+  /// destructor
+  ~CollocPointIndexer();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// clear all 1D and N-dimensional point ids and define the number
+  /// of variables and the 1D duplication tolerance
+  void reset(size_t num_v, Real tol);
+
+  /// identify the unique points within the reference grid defined by
+  /// sm_mi and the tensor quadrature orders tp_orders (replaces
+  /// point_radial_tol_unique_index_inc1())
+  int reference_unique(const UShort2DArray& sm_mi,
+		       const UShort2DArray& tp_orders,
+		       const Real3DArray& colloc_pts_1d, BitArray& is_unique1,
+		       IntArray& unique_index_map);
+  /// identify the unique points within the increment defined by trailing
+  /// index sets (from start_index) that are not present in the reference
+  /// grid (replaces point_radial_tol_unique_index_inc2())
+  int increment_unique(size_t start_index, const UShort2DArray& sm_mi,
+		       const UShort2DArray& tp_orders,
+		       const Real3DArray& colloc_pts_1d, int num_unique1,
+		       BitArray& is_unique2, IntArray& unique_index_map);
+  /// promote the increment into the reference grid
+  /// (replaces point_radial_tol_unique_index_inc3())
+  void merge_unique();
+
+  /// count the unique points within the grid defined by sm_mi and
+  /// tp_orders without updating the reference grid
+  int count_unique(const UShort2DArray& sm_mi,
+		   const UShort2DArray& tp_orders,
+		   const Real3DArray& colloc_pts_1d);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// return the id of the 1D abscissa for point index j within the
+  /// level lev rule for variable v
+  int point_id_1d(size_t v, unsigned short lev, unsigned short j,
+		  const Real3DArray& colloc_pts_1d);
+  /// define the N-dimensional key for a tensor point from its index set
+  /// and collocation key
+  void point_key(const UShortArray& sm_index, const UShortArray& key,
+		 const Real3DArray& colloc_pts_1d, IntArray& pt_key);
+
+  //
+  //- Heading: Data
+  //
+
+  /// number of variables in the grid
+  size_t numVars;
+  /// duplication tolerance applied to 1D abscissae
+  Real duplicateTol;
+
+  /// for each variable, the distinct 1D abscissae and their ids
+  std::vector< std::map<Real, int> > abscissaIds;
+  /// cached ids of the 1D abscissae, indexed as [level][variable][point]
+  std::vector<Int2DArray> pointIds1D;
+
+  /// N-dimensional keys for the unique points in the reference grid,
+  /// mapped to their unique index
+  boost::unordered_map<IntArray, int> referenceIds;
+  /// N-dimensional keys for the unique points in the current increment,
+  /// mapped to their unique index
+  boost::unordered_map<IntArray, int> incrementIds;
+};
+
+
+inline CollocPointIndexer::CollocPointIndexer():
+  numVars(0), duplicateTol(1.e-15)
+{ }
+
+
+inline CollocPointIndexer::~CollocPointIndexer()
+{ }
+
+
+inline void CollocPointIndexer::reset(size_t num_v, Real tol)
+{
+  numVars = num_v;  duplicateTol = tol;
+  abscissaIds.clear();  abscissaIds.resize(num_v);
+  pointIds1D.clear();  referenceIds.clear();  incrementIds.clear();
+}
+
+
+inline void CollocPointIndexer::
+point_key(const UShortArray& sm_index, const UShortArray& key,
+	  const Real3DArray& colloc_pts_1d, IntArray& pt_key)
+{
+  pt_key.resize(numVars);
+  for (size_t v=0; v<numVars; ++v)
+    pt_key[v] = point_id_1d(v, sm_index[v], key[v], colloc_pts_1d);
+}
+
+} // namespace Pecos
+
+#endif
@@ -334,13 +334,30 @@ update_smolyak_coefficients(size_t start_index, const UShort2DArray& sm_mi,
 
 
 void CombinedSparseGridDriver::
-assign_collocation_key(const UShort2DArray& sm_mi, UShort3DArray& colloc_key)
+assign_collocation_key(const UShort2DArray& sm_mi,
+		       UShort3DArray& colloc_key) const
 {
   // define mapping from collocation pts to set of 1d interpolation indices
-  size_t i, num_sm_mi = sm_mi.size();
+  colloc_key.clear();
+  update_collocation_key(sm_mi, colloc_key);
+}
+
+
+void CombinedSparseGridDriver::
+update_collocation_key(const UShort2DArray& sm_mi,
+		       UShort3DArray& colloc_key) const
+{
+  // Leading index sets within sm_mi are retained across grid increments,
+  // such that only trailing sets not yet covered by colloc_key require
+  // expansion (trailing removals are managed by truncate_collocation_key())
+  size_t i, start_index = colloc_key.size(), num_sm_mi = sm_mi.size();
+  if (start_index >= num_sm_mi) {
+    if (start_index > num_sm_mi) colloc_key.resize(num_sm_mi);
+    return;
+  }
   colloc_key.resize(num_sm_mi);
-  UShortArray quad_order(numVars); //, collocation_indices(numVars);
-  for (i=0; i<num_sm_mi; ++i) {
+  UShortArray quad_order(numVars);
+  for (i=start_index; i<num_sm_mi; ++i) {
     level_to_order(sm_mi[i], quad_order);
     SharedPolyApproxData::
       tensor_product_multi_index(quad_order, colloc_key[i], false);
@@ -349,25 +366,29 @@ assign_collocation_key(const UShort2DArray& sm_mi, UShort3DArray& colloc_key)
 
 
 void CombinedSparseGridDriver::
-assign_collocation_indices(const UShort3DArray& colloc_key,
+assign_collocation_indices(const UShort2DArray& sm_mi,
 			   const IntArray& unique_index_map,
 			   Sizet2DArray& colloc_ind, size_t start_index)
 {
-  // define mapping from collocation pts to set of 1d interpolation indices
-  size_t i, j, num_tp_pts, cntr = 0, num_sm_indices = colloc_key.size();
+  // define mapping from tensor grid pts to unique collocation pts; tensor
+  // grid sizes are defined from the quadrature orders, without collocKey
+  size_t i, j, num_tp_pts, cntr = 0, num_sm_indices = sm_mi.size();
   colloc_ind.resize(num_sm_indices);
+  UShortArray quad_order(numVars);
   // unique_index_map covers both reference and increment from start_index
-  for (i=0; i<start_index; ++i)
-    cntr += colloc_key[i].size();
+  for (i=0; i<start_index; ++i) {
+    level_to_order(sm_mi[i], quad_order);
+    cntr += CollocKeyIterator::num_points(quad_order);
+  }
   for (i=start_index; i<num_sm_indices; ++i) {
-    num_tp_pts = colloc_key[i].size();
+    level_to_order(sm_mi[i], quad_order);
+    num_tp_pts = CollocKeyIterator::num_points(quad_order);
     SizetArray& indices_i = colloc_ind[i];
     indices_i.resize(num_tp_pts);
     for (j=0; j<num_tp_pts; ++j, ++cntr) {
       indices_i[j] = unique_index_map[cntr];
 #ifdef DEBUG
-      PCout << "collocKey[" << i << "][" << j << "]:\n" << colloc_key[i][j]
-	    << "collocIndices[" << i << "][" << j << "] = " << indices_i[j]
+      PCout << "collocIndices[" << i << "][" << j << "] = " << indices_i[j]
 	    << '\n';
 #endif // DEBUG
     }
@@ -464,9 +485,6 @@ void CombinedSparseGridDriver::compute_grid()
 {
   assign_smolyak_arrays();
 
-  // ensure active numCollocPts is up to date
-  grid_size();
-
   // ---------------------------------
   // Compute unique sparse grid points
   // ---------------------------------
@@ -474,22 +492,34 @@ void CombinedSparseGridDriver::compute_grid()
   // than sgmg/sgmga (approach below).  Therefore, the Combined implementation
   // below is overridden for Incremental (reference grids are kept separate).
   IntArray& unique_index_map = uniqIndMapIter->second;
-  compute_unique_points_weights(ssgLevIter->second, anisoWtsIter->second,
-				numPtsIter->second, unique_index_map,
-				varSetsIter->second, t1WtIter->second,
-				t2WtIter->second);
-
-  // update sparse grid collocation data, if tracking is active
-  // > this is for Pecos; sgmg/sgmga does not use any of this data
-  // > ordering: collocIndices requires unique_index_map from above
+  // any prior collocKey is invalidated; it is rebuilt on demand
+  clear_collocation_key();
   if (trackCollocDetails) {
-    UShort3DArray& colloc_key = collocKeyIter->second;
-    assign_collocation_key(smolMIIter->second, colloc_key); // define collocKey
-    assign_collocation_indices(colloc_key, unique_index_map,
-			       collocIndIter->second);  // define collocIndices
+    // collocation details are required for Pecos, so identify unique points
+    // symbolically rather than relying on sgmg/sgmga duplicate detection
+    // (webbur::sgmg_size() and webbur::sgmg_unique_index() both perform
+    // tolerance-based point comparisons that dominate for large grids).
+    // Tensor points are enumerated on the fly from smolyakMultiIndex.
+    // > ordering: collocIndices defined together with unique_index_map
+    RealMatrix a1_pts, a1_t2w;  RealVector a1_t1w;  CollocPointIndexer indexer;
+    BitArray isu1;  int num_u1;
+    compute_unique_points_weights(smolMIIter->second, smolCoeffsIter->second,
+				  collocIndIter->second,
+				  numPtsIter->second, a1_pts, a1_t1w, a1_t2w,
+				  indexer, isu1, num_u1, unique_index_map, true,
+				  varSetsIter->second, t1WtIter->second,
+				  t2WtIter->second);
     // 1D pt/wt assignments are now managed in initialize_grid_parameters()
     //assign_1d_collocation_points_weights();
   }
+  else {
+    // ensure active numCollocPts is up to date
+    grid_size();
+    compute_unique_points_weights(ssgLevIter->second, anisoWtsIter->second,
+				  numPtsIter->second, unique_index_map,
+				  varSetsIter->second, t1WtIter->second,
+				  t2WtIter->second);
+  }
 
 #ifdef DEBUG
   PCout << "CombinedSparseGridDriver::compute_grid() results:\n"
@@ -557,11 +587,11 @@ void CombinedSparseGridDriver::combine_grid()
   // prune inactive index sets
   prune_inactive(combinedSmolyakMultiIndex, combinedSmolyakCoeffs);
 
-  // recompute combinedCollocKey from scratch
-  assign_collocation_key(combinedSmolyakMultiIndex, combinedCollocKey);
+  // combinedCollocKey is rebuilt on demand from combinedSmolyakMultiIndex
+  combinedCollocKey.clear();
   // Define combined points and weights to support expectation() calls
   compute_unique_points_weights(combinedSmolyakMultiIndex,
-				combinedSmolyakCoeffs,  combinedCollocKey,
+				combinedSmolyakCoeffs,
 				combinedUniqueIndexMap, false, combinedVarSets,
 				combinedT1WeightSets,   combinedT2WeightSets);
   // colloc indices are only regenerated for promotions in combined_to_active()
@@ -609,7 +639,7 @@ void CombinedSparseGridDriver::combined_to_active(bool clear_combined)
   // corresponding combined grids involve overlays of data that no longer
   // reflect individual evaluations (to match restoration of collocIndices,
   // {Nodal,Hierarch,Project}Approx invoke synthetic_surrogate_data())
-  assign_collocation_indices(collocKeyIter->second, uniqIndMapIter->second,
+  assign_collocation_indices(smolMIIter->second, uniqIndMapIter->second,
 			     collocIndIter->second);
 }
 
@@ -704,90 +734,75 @@ compute_unique_points_weights(unsigned short ssg_lev,
 void CombinedSparseGridDriver::
 compute_unique_points_weights(const UShort2DArray& sm_mi,
 			      const IntArray& sm_coeffs,
-			      const UShort3DArray& colloc_key,
 			      Sizet2DArray& colloc_ind, int& num_colloc_pts,
 			      RealMatrix& a1_pts, RealVector& a1_t1w,
-			      RealMatrix& a1_t2w, RealVector& zv,
-			      RealVector& r1v, IntArray& sind1, BitArray& isu1,
-			      IntArray& uind1, IntArray& uset1, int& num_u1,
+			      RealMatrix& a1_t2w, CollocPointIndexer& indexer,
+			      BitArray& isu1, int& num_u1,
 			      IntArray& unique_index_map,
 			      bool update_1d_pts_wts, RealMatrix& var_sets,
 			      RealVector& t1_wts, RealMatrix& t2_wts)
 {
-  // define a1 pts/wts
-  compute_tensor_points_weights(sm_mi, colloc_key, 0, sm_mi.size(),
-				update_1d_pts_wts, a1_pts, a1_t1w, a1_t2w);
+  // define a1 pts/wts (also updates collocPts1D, as needed)
+  compute_tensor_points_weights(sm_mi, 0, sm_mi.size(), update_1d_pts_wts,
+				a1_pts, a1_t1w, a1_t2w);
   // ----
   // INC1
   // ----
-  int m = numVars, n1 = a1_pts.numCols(), seed = 1234567;
-  zv.sizeUninitialized(m);  r1v.sizeUninitialized(n1);
-  sind1.resize(n1);  uind1.resize(n1);
-  uset1.resize(n1); // numUnique1 if count_inc1 used
-  bool* is_unique1 = new bool[n1];
-
-  webbur::point_radial_tol_unique_index_inc1(m, n1, a1_pts.values(),
-    duplicateTol, &seed, zv.values(), r1v.values(), &sind1[0], is_unique1,
-    &num_u1, &uset1[0], &uind1[0]);
-
-  copy_data(is_unique1, n1, isu1);
-  delete [] is_unique1;
+  // Symbolic identification from (level, 1D index) keys replaces
+  // webbur::point_radial_tol_unique_index_inc1(), which sorts the full set
+  // of N-dimensional points by their distance from a random reference point.
+  // A reset is required as the 1D rules may have been updated.
+  indexer.reset(numVars, duplicateTol);
+  UShort2DArray tp_orders;  assign_tensor_orders(sm_mi, tp_orders);
+  num_u1 = indexer.reference_unique(sm_mi, tp_orders, collocPts1D, isu1,
+				    unique_index_map);
 
 #ifdef DEBUG
   PCout << "Reference unique: numUnique1 = " << num_u1 << "\na1 =\n";
   write_data(PCout, a1_pts, false, true, true);
-  PCout << "               r1   indx1 unique1   undx1   xdnu1:\n";
-  for (size_t i=0; i<num_u1; ++i)
-    PCout << std::setw(17) << r1v[i]   << std::setw(8) << sind1[i]
-	  << std::setw(8)  << isu1[i]  << std::setw(8) << uset1[i]
-	  << std::setw(8)  << uind1[i] << '\n';
-  for (size_t i=num_u1; i<n1; ++i)
-    PCout << std::setw(17) << r1v[i]  << std::setw(8)  << sind1[i]
-	  << std::setw(8)  << isu1[i] << std::setw(16) << uind1[i] << '\n';
-  PCout << std::endl;
+  PCout << "isUnique1:\n" << isu1 << std::endl;
 #endif // DEBUG
 
   num_colloc_pts = num_u1;
-  assign_unique_indices(isu1, uind1, uset1, unique_index_map);
-  assign_collocation_indices(colloc_key, unique_index_map, colloc_ind);
+  assign_collocation_indices(sm_mi, unique_index_map, colloc_ind);
   assign_sparse_points(colloc_ind, 0, isu1, 0, a1_pts, var_sets);
   if (trackUniqueProdWeights)
-    assign_sparse_weights(colloc_key, colloc_ind, num_colloc_pts, sm_coeffs,
-			  a1_t1w, a1_t2w, t1_wts, t2_wts);
+    assign_sparse_weights(colloc_ind, num_colloc_pts, sm_coeffs, a1_t1w,
+			  a1_t2w, t1_wts, t2_wts);
 }
 
 
 void CombinedSparseGridDriver::
 compute_tensor_points_weights(const UShort2DArray& sm_mi,
-			      const UShort3DArray& colloc_key,
 			      size_t start_index, size_t num_indices,
 			      bool update_1d_pts_wts, RealMatrix& pts,
 			      RealVector& t1_wts, RealMatrix& t2_wts)
 {
-  // Requirements: updated sm_mi,colloc_key for [start,start+num_indices].
+  // Requirements: updated sm_mi for [start,start+num_indices].
   // 1D Pts/Wts will be updated as indicated by update_1d_pts_wts
 
-  size_t i, j, k, l, cntr, num_tp_pts, num_colloc_pts = 0,
-    end = start_index + num_indices;
+  size_t i, k, l, cntr, num_colloc_pts = 0, end = start_index + num_indices;
   // define num_colloc_pts
-  for (i=start_index; i<end; ++i)
-    num_colloc_pts += colloc_key[i].size();
+  UShort2DArray tp_orders(num_indices);
+  for (i=start_index; i<end; ++i) {
+    UShortArray& quad_order = tp_orders[i-start_index];
+    level_to_order(sm_mi[i], quad_order);
+    num_colloc_pts += CollocKeyIterator::num_points(quad_order);
+  }
   // define pts/wts: wts are raw product weights; Smolyak combinatorial
   // coefficient applied in compute_grid()/compute_trial_grid()
   pts.shapeUninitialized(numVars, num_colloc_pts);
   t1_wts.sizeUninitialized(num_colloc_pts);
   if (computeType2Weights)
     t2_wts.shapeUninitialized(numVars, num_colloc_pts);
+  CollocKeyIterator key_it;
   for (i=start_index, cntr=0; i<end; ++i) {
-    const UShortArray& sm_index = sm_mi[i];
-    if (update_1d_pts_wts) { // update collocPts1D, {type1,type2}CollocWts1D
-      UShortArray quad_order(numVars);
-      level_to_order(sm_index, quad_order);
+    const UShortArray& sm_index   = sm_mi[i];
+    const UShortArray& quad_order = tp_orders[i-start_index];
+    if (update_1d_pts_wts) // update collocPts1D, {type1,type2}CollocWts1D
       assign_1d_collocation_points_weights(quad_order, sm_index);
-    }
-    num_tp_pts = colloc_key[i].size();
-    for (j=0; j<num_tp_pts; ++j, ++cntr) {
-      const UShortArray& key_ij = colloc_key[i][j];
+    for (key_it.reset(quad_order); !key_it.done(); ++key_it, ++cntr) {
+      const UShortArray& key_ij = key_it.key();
       Real* pt    =    pts[cntr]; // column vector
       Real& t1_wt = t1_wts[cntr]; t1_wt = 1.;
       for (k=0; k<numVars; ++k) {
@@ -813,44 +828,6 @@ compute_tensor_points_weights(const UShort2DArray& sm_mi,
 }
 
 
-void CombinedSparseGridDriver::
-assign_unique_indices(const BitArray& isu1, const IntArray& xdnu1,
-		      const IntArray& undx1, IntArray& unique_index_map)
-{
-  //const BitArray& isu1  = isUniq1Iter->second;
-  //const IntArray& xdnu1 = uniqInd1Iter->second;
-  //const IntArray& undx1 = uniqSet1Iter->second;
-  //IntArray& unique_index_map = uniqIndMapIter->second;
-
-  size_t i, n1 = xdnu1.size();
-  int xdnu_j, a1_index, new_cntr = 0;
-
-  unique_index_map.resize(n1);
-
-  // first pass assigns unique indices
-  for (i=0; i<n1; ++i)
-    if (isu1[i])
-      unique_index_map[i] = new_cntr++;
-  // second pass refers back to unique indices and can be a forward reference
-  // (dictating two passes)
-  for (i=0; i<n1; ++i)
-    if (!isu1[i]) {
-      // XDNU1[N1] in point_radial_tol_unique_index_inc1() [sandia_rules.cpp]:
-      //   the index, in UNDX1, of the tolerably unique point that
-      //   "represents" this point.
-      xdnu_j = xdnu1[i];
-      // UNDX1[UNIQUE_NUM1] in point_radial_tol_unique_index_inc1():
-      //   the index, in A1, of the tolerably unique points.
-      a1_index = undx1[xdnu_j]; // appears to reproduce i
-      unique_index_map[i] = unique_index_map[a1_index];
-    }
-
-#ifdef DEBUG
-  PCout << "Reference map:\n" << unique_index_map;
-#endif // DEBUG
-}
-
-
 void CombinedSparseGridDriver::
 assign_sparse_points(const Sizet2DArray& colloc_ind, size_t start_index,
 		     const BitArray& raw_is_unique,
@@ -876,8 +853,7 @@ assign_sparse_points(const Sizet2DArray& colloc_ind, size_t start_index,
 
 
 void CombinedSparseGridDriver::
-assign_sparse_weights(const UShort3DArray& colloc_key,
-		      const Sizet2DArray& colloc_ind, int num_colloc_pts,
+assign_sparse_weights(const Sizet2DArray& colloc_ind, int num_colloc_pts,
 		      const IntArray& sm_coeffs, const RealVector& a1_t1_wts,
 		      const RealMatrix& a1_t2_wts, RealVector& unique_t1_wts,
 		      RealMatrix& unique_t2_wts)
@@ -889,8 +865,8 @@ assign_sparse_weights(const UShort3DArray& colloc_key,
 
   int uniq_index, delta_coeff, sm_coeff;
   // add contributions for new index sets
-  add_sparse_weights(0, colloc_key, colloc_ind, sm_coeffs, a1_t1_wts,
-		     a1_t2_wts, unique_t1_wts, unique_t2_wts);
+  add_sparse_weights(0, colloc_ind, sm_coeffs, a1_t1_wts, a1_t2_wts,
+		     unique_t1_wts, unique_t2_wts);
 
 #ifdef DEBUG
   PCout << "reference type1 weight sets:\n" << unique_t1_wts;
@@ -903,18 +879,18 @@ assign_sparse_weights(const UShort3DArray& colloc_key,
 
 
 void CombinedSparseGridDriver::
-add_sparse_weights(size_t start_index, const UShort3DArray& colloc_key,
-		   const Sizet2DArray& colloc_ind, const IntArray& sm_coeffs,
-		   const RealVector& raw_t1w, const RealMatrix& raw_t2w,
-		   RealVector& unique_t1w, RealMatrix& unique_t2w)
+add_sparse_weights(size_t start_index, const Sizet2DArray& colloc_ind,
+		   const IntArray& sm_coeffs, const RealVector& raw_t1w,
+		   const RealMatrix& raw_t2w, RealVector& unique_t1w,
+		   RealMatrix& unique_t2w)
 {
   // add contributions for new index sets
-  size_t i, j, k, num_sm_mi = colloc_key.size(), uniq_index, num_tp_pts, cntr;
+  size_t i, j, k, num_sm_mi = colloc_ind.size(), uniq_index, num_tp_pts, cntr;
   for (i=start_index, cntr=0; i<num_sm_mi; ++i) {
     int sm_coeff = sm_coeffs[i];
+    const SizetArray& colloc_ind_i = colloc_ind[i];
+    num_tp_pts = colloc_ind_i.size();
     if (sm_coeff) {
-      num_tp_pts = colloc_key[i].size();
-      const SizetArray& colloc_ind_i = colloc_ind[i];
       for (j=0; j<num_tp_pts; ++j, ++cntr) {
 	uniq_index = colloc_ind_i[j];
 	// assign tensor weights to unique weights
@@ -928,7 +904,7 @@ add_sparse_weights(size_t start_index, const UShort3DArray& colloc_key,
       }
     }
     else
-      cntr += colloc_key[i].size();
+      cntr += num_tp_pts;
   }
 }
 
@@ -16,6 +16,7 @@
 #define COMBINED_SPARSE_GRID_DRIVER_HPP
 
 #include "SparseGridDriver.hpp"
+#include "CollocPointIndexer.hpp"
 
 namespace Pecos {
 
@@ -108,11 +109,15 @@ public:
   void assign_smolyak_arrays();
   /// initialize collocKey from smolyakMultiIndex
   void assign_collocation_key();
-  /// initialize collocIndices from collocKey and unique_index_map
-  void assign_collocation_indices(const UShort3DArray& colloc_key,
+  /// initialize collocIndices from the tensor grids defined by sm_mi
+  /// and unique_index_map
+  void assign_collocation_indices(const UShort2DArray& sm_mi,
 				  const IntArray& unique_index_map,
 				  Sizet2DArray& colloc_indices,
 				  size_t start_index = 0);
+  /// define the quadrature orders of each tensor grid within sm_mi
+  void assign_tensor_orders(const UShort2DArray& sm_mi,
+			    UShort2DArray& tp_orders) const;
 
   /// set duplicateTol based on the content of collocRules: table lookups will
   /// generally be more precise/repeatable than numerically-generated rules
@@ -139,10 +144,13 @@ public:
   /// get trackUniqueProdWeights
   bool track_unique_product_weights() const;
 
-  /// return collocKey[activeKey]
+  /// return collocKey[activeKey], building it on demand
   const UShort3DArray& collocation_key() const;
-  /// return collocKey[key]
+  /// return collocKey[key], building it on demand
   const UShort3DArray& collocation_key(const ActiveKey& key) const;
+  /// return an iterator over the collocation key of the i-th tensor grid
+  /// in smolyakMultiIndex[activeKey], without requiring collocKey
+  CollocKeyIterator collocation_key_iterator(size_t i) const;
   /// return collocIndices[activeKey]
   const Sizet2DArray& collocation_indices() const;
   /// return collocIndices[key]
@@ -172,7 +180,17 @@ protected:
   void assign_smolyak_arrays(UShort2DArray& multi_index, IntArray& coeffs);
   /// initialize a collocation key from a smolyak multi-index
   void assign_collocation_key(const UShort2DArray& sm_mi,
-			      UShort3DArray& colloc_key);
+			      UShort3DArray& colloc_key) const;
+  /// append to a collocation key for any trailing index sets within
+  /// sm_mi that it does not yet cover
+  void update_collocation_key(const UShort2DArray& sm_mi,
+			      UShort3DArray& colloc_key) const;
+  /// truncate a cached collocation key to (at most) num_sets index sets,
+  /// e.g. following removal of trailing sets from smolyakMultiIndex
+  void truncate_collocation_key(size_t num_sets);
+  /// invalidate the cached collocation key of the active key, e.g.
+  /// following recomputation of leading sets within smolyakMultiIndex
+  void clear_collocation_key();
 
   /// overloaded form updates smolyakCoeffs from smolyakMultiIndex
   void update_smolyak_coefficients(size_t start_index);
@@ -197,31 +215,24 @@ protected:
   /// by an arbitrary multi-index (more general than level + aniso weights)
   void compute_unique_points_weights(const UShort2DArray& sm_mi,
 				     const IntArray& sm_coeffs,
-				     const UShort3DArray& colloc_key,
 				     IntArray& unique_index_map,
 				     bool update_1d_pts_wts,
 				     RealMatrix& var_sets, RealVector& t1_wts,
 				     RealMatrix& t2_wts);
   /// modular helper for public reference_unique(RealMatrix&)
   void compute_unique_points_weights(const UShort2DArray& sm_mi,
-    const IntArray& sm_coeffs, const UShort3DArray& colloc_key,
-    Sizet2DArray& colloc_ind, int& num_colloc_pts, RealMatrix& a1_pts,
-    RealVector& a1_t1w, RealMatrix& a1_t2w, RealVector& zv, RealVector& r1v,
-    IntArray& sind1, BitArray& isu1, IntArray& uind1, IntArray& uset1,
-    int& num_u1, IntArray& unique_index_map, bool update_1d_pts_wts,
-    RealMatrix& var_sets, RealVector& t1_wts, RealMatrix& t2_wts);
+    const IntArray& sm_coeffs, Sizet2DArray& colloc_ind, int& num_colloc_pts, RealMatrix& a1_pts,
+    RealVector& a1_t1w, RealMatrix& a1_t2w, CollocPointIndexer& indexer,
+    BitArray& isu1, int& num_u1, IntArray& unique_index_map,
+    bool update_1d_pts_wts, RealMatrix& var_sets, RealVector& t1_wts,
+    RealMatrix& t2_wts);
 
   /// aggregate point and weight sets across one or more tensor products
   void compute_tensor_points_weights(const UShort2DArray& sm_mi,
-				     const UShort3DArray& colloc_key,
 				     size_t start_index, size_t num_indices,
 				     bool update_1d_pts_wts, RealMatrix& pts,
 				     RealVector& t1_wts, RealMatrix& t2_wts);
 
-  /// define the reference collocation indices
-  void assign_unique_indices(const BitArray& isu1, const IntArray& xdnu1,
-			     const IntArray& undx1, IntArray& unique_index_map);
-
   /// convenience function for updating sparse (unique) points from a set of
   /// aggregated (non-unique) tensor points
   void assign_sparse_points(const Sizet2DArray& colloc_ind, size_t start_index,
@@ -231,8 +242,8 @@ protected:
 
   /// convenience function for assigning sparse weights from a set of
   /// tensor weights
-  void assign_sparse_weights(const UShort3DArray& colloc_key,
-			     const Sizet2DArray& colloc_ind, int num_colloc_pts,
+  void assign_sparse_weights(const Sizet2DArray& colloc_ind,
+			     int num_colloc_pts,
 			     const IntArray& sm_coeffs,
 			     const RealVector& a1_t1_wts,
 			     const RealMatrix& a1_t2_wts,
@@ -240,8 +251,7 @@ protected:
 			     RealMatrix& unique_t2_wts);
   /// convenience function for updating sparse weights from overlaying
   /// a set of tensor weights
-  void add_sparse_weights(size_t start_index, const UShort3DArray& colloc_key,
-			  const Sizet2DArray& colloc_ind,
+  void add_sparse_weights(size_t start_index, const Sizet2DArray& colloc_ind,
 			  const IntArray& sm_coeffs, const RealVector& raw_t1w,
 			  const RealMatrix& raw_t2w, RealVector& unique_t1w,
 			  RealMatrix& unique_t2w);
@@ -268,7 +278,10 @@ protected:
 
   /// numSmolyakIndices-by-numTensorProductPts-by-numVars array for identifying
   /// the 1-D point indices for sets of tensor-product collocation points
-  std::map<ActiveKey, UShort3DArray> collocKey;
+  /** This flat form is fully determined by smolyakMultiIndex and the 1D
+      rules, and is not required for grid generation (see
+      CollocKeyIterator).  It is built on demand by collocation_key(). */
+  mutable std::map<ActiveKey, UShort3DArray> collocKey;
   /// iterator for active entry within collocKey
   std::map<ActiveKey, UShort3DArray>::iterator collocKeyIter;
 
@@ -316,8 +329,8 @@ protected:
   /// Smolyak coefficients corresponding to combinedSmolyakMultiIndex
   IntArray combinedSmolyakCoeffs;
   /// collocation key for maximal grid that is the result of combining a
-  /// set of level expansions (defined from combinedSmolyakMultiIndex)
-  UShort3DArray combinedCollocKey;
+  /// set of level expansions (built on demand from combinedSmolyakMultiIndex)
+  mutable UShort3DArray combinedCollocKey;
   /// mapping from combined sparse grid points to unique collocation points
   IntArray combinedUniqueIndexMap;
 
@@ -434,7 +447,7 @@ inline void CombinedSparseGridDriver::update_active_iterators()
       varSetsIter    == variableSets.end()       ||
       t1WtIter       == type1WeightSets.end()    ||
       t2WtIter       == type2WeightSets.end())
-    active_copy = activeKey.copy();
+    active_copy = activeKey.interned();
   */
 
   if (smolMIIter == smolyakMultiIndex.end()) {
@@ -559,20 +572,32 @@ inline bool CombinedSparseGridDriver::track_unique_product_weights() const
 
 
 inline const UShort3DArray& CombinedSparseGridDriver::collocation_key() const
-{ return collocKeyIter->second; }
+{
+  update_collocation_key(smolMIIter->second, collocKeyIter->second);
+  return collocKeyIter->second;
+}
 
 
 inline const UShort3DArray& CombinedSparseGridDriver::
 collocation_key(const ActiveKey& key) const
 {
-  std::map<ActiveKey, UShort3DArray>::const_iterator cit
-    = collocKey.find(key);
-  if (cit == collocKey.end()) {
+  std::map<ActiveKey, UShort3DArray>::iterator it = collocKey.find(key);
+  if (it == collocKey.end()) {
     PCerr << "Error: key not found in CombinedSparseGridDriver::"
 	  << "collocation_key()." << std::endl;
     abort_handler(-1);
   }
-  return cit->second;
+  update_collocation_key(smolyak_multi_index(key), it->second);
+  return it->second;
+}
+
+
+inline CollocKeyIterator CombinedSparseGridDriver::
+collocation_key_iterator(size_t i) const
+{
+  UShortArray quad_order(numVars);
+  level_to_order(smolMIIter->second[i], quad_order);
+  return CollocKeyIterator(quad_order);
 }
 
 
@@ -648,22 +673,40 @@ inline void CombinedSparseGridDriver::assign_collocation_key()
 { assign_collocation_key(smolMIIter->second, collocKeyIter->second); }
 
 
+inline void CombinedSparseGridDriver::
+assign_tensor_orders(const UShort2DArray& sm_mi, UShort2DArray& tp_orders) const
+{
+  size_t i, num_sm_mi = sm_mi.size();
+  tp_orders.resize(num_sm_mi);
+  for (i=0; i<num_sm_mi; ++i)
+    level_to_order(sm_mi[i], tp_orders[i]);
+}
+
+
+inline void CombinedSparseGridDriver::truncate_collocation_key(size_t num_sets)
+{
+  UShort3DArray& colloc_key = collocKeyIter->second;
+  if (colloc_key.size() > num_sets) colloc_key.resize(num_sets);
+}
+
+
+inline void CombinedSparseGridDriver::clear_collocation_key()
+{ collocKeyIter->second.clear(); }
+
+
 inline void CombinedSparseGridDriver::
 compute_unique_points_weights(const UShort2DArray& sm_mi,
 			      const IntArray& sm_coeffs,
-			      const UShort3DArray& colloc_key,
 			      IntArray& unique_index_map,
 			      bool update_1d_pts_wts, RealMatrix& var_sets,
 			      RealVector& t1_wts, RealMatrix& t2_wts)
 {
-  RealMatrix a1_pts, a1_t2w;  RealVector a1_t1w, zv, r1v;
-  Sizet2DArray colloc_ind;    int num_colloc_pts, num_u1;
-  BitArray isu1;              IntArray sind1, uind1, uset1;
-  compute_unique_points_weights(sm_mi, sm_coeffs, colloc_key, colloc_ind,
-				num_colloc_pts, a1_pts, a1_t1w, a1_t2w, zv,
-				r1v, sind1, isu1, uind1, uset1, num_u1,
-				unique_index_map, update_1d_pts_wts,
-				var_sets, t1_wts, t2_wts);
+  RealMatrix a1_pts, a1_t2w;  RealVector a1_t1w;  CollocPointIndexer indexer;
+  Sizet2DArray colloc_ind;    int num_colloc_pts, num_u1;  BitArray isu1;
+  compute_unique_points_weights(sm_mi, sm_coeffs, colloc_ind,
+				num_colloc_pts, a1_pts, a1_t1w, a1_t2w, indexer,
+				isu1, num_u1, unique_index_map,
+				update_1d_pts_wts, var_sets, t1_wts, t2_wts);
 }
 
 
@@ -740,7 +783,10 @@ combined_smolyak_multi_index() const
 
 inline const UShort3DArray& CombinedSparseGridDriver::
 combined_collocation_key() const
-{ return combinedCollocKey; }
+{
+  update_collocation_key(combinedSmolyakMultiIndex, combinedCollocKey);
+  return combinedCollocKey;
+}
 
 
 inline const RealMatrix& CombinedSparseGridDriver::
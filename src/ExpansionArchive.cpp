@@ -0,0 +1,570 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 ExpansionArchive
+//- Description: Implementation code for ExpansionArchive class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "ExpansionArchive.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PECOS_ARCHIVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//#define DEBUG
+
+namespace Pecos {
+
+namespace {
+
+/// current version of the archive layout
+const uint32_t ARCHIVE_VERSION    = 1;
+/// byte order marker, read as SWAPPED_ORDER on a host of opposite endianness
+const uint32_t NATIVE_ORDER       = 0x01020304;
+/// byte order marker as written on a host of opposite endianness
+const uint32_t SWAPPED_ORDER      = 0x04030201;
+/// file identifier
+const char     ARCHIVE_MAGIC[8]   = { 'P','E','C','O','S','E','X','P' };
+/// number of distribution parameters stored per basis record
+const size_t   NUM_BASIS_PARAMS   = 3;
+
+/// leading record of the archive; all sections that follow are aligned
+/// to 8 bytes and located by byte offsets from the start of the file
+struct ArchiveHeader
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t numVars;
+  uint64_t numExpansions;
+  uint64_t basisOffset;
+  uint64_t directoryOffset;
+};
+
+/// univariate basis record: polynomial type, collocation rule and the
+/// distribution parameters of parameterized types
+struct BasisRecord
+{
+  int16_t basisType;
+  int16_t collocRule;
+  int32_t reserved;
+  double  params[NUM_BASIS_PARAMS];
+};
+
+/// directory record locating the sections of an expansion; the key is
+/// stored as keyWords 8-byte words, the multi-index as numTerms x numVars
+/// uint16, the coefficients as numTerms doubles and the coefficient
+/// gradients as numGradRows x numTerms column-major doubles
+struct DirectoryEntry
+{
+  uint64_t keyOffset;
+  uint64_t keyWords;
+  uint64_t numTerms;
+  uint64_t numGradRows;
+  uint64_t multiIndexOffset;
+  uint64_t coeffOffset;
+  uint64_t gradOffset;
+};
+
+
+inline size_t align8(size_t bytes)
+{ return (bytes + 7) & ~(size_t)7; }
+
+
+/// return true if a section of rows x cols items of item_bytes each,
+/// starting at offset, lies within a buffer of size bytes; the counts are
+/// compared by division such that corrupt values cannot overflow
+inline bool section_fits(uint64_t offset, uint64_t rows, uint64_t cols,
+			 size_t item_bytes, size_t size)
+{
+  if (offset > size) return false;
+  uint64_t avail = (size - offset) / item_bytes;
+  return (!rows || cols <= avail / rows);
+}
+
+
+template <typename T> inline void swap_bytes(T& val)
+{
+  char* b = reinterpret_cast<char*>(&val);
+  std::reverse(b, b + sizeof(T));
+}
+
+
+template <typename T> inline void swap_array(char* data, size_t len)
+{
+  T* vals = reinterpret_cast<T*>(data);
+  for (size_t i=0; i<len; ++i)
+    swap_bytes(vals[i]);
+}
+
+
+inline uint64_t real_to_word(Real val)
+{ uint64_t w; std::memcpy(&w, &val, sizeof(w)); return w; }
+
+
+inline Real word_to_real(uint64_t w)
+{ Real val; std::memcpy(&val, &w, sizeof(val)); return val; }
+
+
+void archive_error(const String& msg)
+{
+  PCerr << "Error: " << msg << " in ExpansionArchive." << std::endl;
+  abort_handler(-1);
+}
+
+
+/** Parameter assignments follow BasisPolynomial::push_parameter() for
+    each parameterized orthogonal polynomial type. */
+void pack_basis(const BasisPolynomial& poly, BasisRecord& rec)
+{
+  short type = poly.basis_type();
+  rec.basisType = (int16_t)type;  rec.reserved = 0;
+  rec.collocRule = (int16_t)poly.collocation_rule();
+  std::fill(rec.params, rec.params + NUM_BASIS_PARAMS, 0.);
+  Real r;  unsigned int u;
+  switch (type) {
+  case HERMITE_ORTHOG:   case LEGENDRE_ORTHOG:
+  case LAGUERRE_ORTHOG:  case CHEBYSHEV_ORTHOG:
+    break;
+  case JACOBI_ORTHOG:
+    poly.pull_parameter(JACOBI_ALPHA, r);  rec.params[0] = r;
+    poly.pull_parameter(JACOBI_BETA,  r);  rec.params[1] = r;  break;
+  case GEN_LAGUERRE_ORTHOG:
+    poly.pull_parameter(GENLAG_ALPHA, r);  rec.params[0] = r;  break;
+  case KRAWTCHOUK_DISCRETE:
+    poly.pull_parameter(BI_P_PER_TRIAL, r);  rec.params[0] = r;
+    poly.pull_parameter(BI_TRIALS,      u);  rec.params[1] = u;  break;
+  case MEIXNER_DISCRETE:
+    poly.pull_parameter(NBI_P_PER_TRIAL, r);  rec.params[0] = r;
+    poly.pull_parameter(NBI_TRIALS,      u);  rec.params[1] = u;  break;
+  case CHARLIER_DISCRETE:
+    poly.pull_parameter(P_LAMBDA, r);  rec.params[0] = r;  break;
+  case HAHN_DISCRETE:
+    poly.pull_parameter(HGE_TOT_POP, u);  rec.params[0] = u;
+    poly.pull_parameter(HGE_SEL_POP, u);  rec.params[1] = u;
+    poly.pull_parameter(HGE_DRAWN,   u);  rec.params[2] = u;  break;
+  default:
+    archive_error("unsupported basis type " + std::to_string(type)); break;
+  }
+}
+
+
+void unpack_basis(const BasisRecord& rec, BasisPolynomial& poly)
+{
+  short type = rec.basisType;
+  switch (type) {
+  case HERMITE_ORTHOG:      case LEGENDRE_ORTHOG:     case LAGUERRE_ORTHOG:
+  case JACOBI_ORTHOG:       case GEN_LAGUERRE_ORTHOG: case CHEBYSHEV_ORTHOG:
+  case KRAWTCHOUK_DISCRETE: case MEIXNER_DISCRETE:    case CHARLIER_DISCRETE:
+  case HAHN_DISCRETE:
+    poly = BasisPolynomial(type, rec.collocRule);  break;
+  default:
+    archive_error("unsupported basis type " + std::to_string(type)); break;
+  }
+  switch (type) {
+  case JACOBI_ORTHOG:
+    poly.push_parameter(JACOBI_ALPHA, rec.params[0]);
+    poly.push_parameter(JACOBI_BETA,  rec.params[1]);  break;
+  case GEN_LAGUERRE_ORTHOG:
+    poly.push_parameter(GENLAG_ALPHA, rec.params[0]);  break;
+  case KRAWTCHOUK_DISCRETE:
+    poly.push_parameter(BI_P_PER_TRIAL, rec.params[0]);
+    poly.push_parameter(BI_TRIALS, (unsigned int)rec.params[1]);  break;
+  case MEIXNER_DISCRETE:
+    poly.push_parameter(NBI_P_PER_TRIAL, rec.params[0]);
+    poly.push_parameter(NBI_TRIALS, (unsigned int)rec.params[1]);  break;
+  case CHARLIER_DISCRETE:
+    poly.push_parameter(P_LAMBDA, rec.params[0]);  break;
+  case HAHN_DISCRETE:
+    poly.push_parameter(HGE_TOT_POP, (unsigned int)rec.params[0]);
+    poly.push_parameter(HGE_SEL_POP, (unsigned int)rec.params[1]);
+    poly.push_parameter(HGE_DRAWN,   (unsigned int)rec.params[2]);  break;
+  }
+}
+
+
+/** Keys are flattened to 8-byte words: set id, reduction type and number
+    of key data, followed for each key data by the length-prefixed model
+    indices, continuous, discrete int and discrete set hyper-parameters.
+    Real hyper-parameters are stored by bit pattern. */
+void pack_key(const ActiveKey& key, std::vector<uint64_t>& words)
+{
+  words.clear();
+  words.push_back(key.id());
+  words.push_back((uint64_t)(int64_t)key.type());
+  size_t d, i, num_d = key.data_size(), len;
+  words.push_back(num_d);
+  for (d=0; d<num_d; ++d) {
+    const ActiveKeyData& kd = key.data(d);
+    const UShortArray& mi = kd.model_indices();
+    len = mi.size();  words.push_back(len);
+    for (i=0; i<len; ++i) words.push_back(mi[i]);
+    const RealVector& chp = kd.continuous_parameters();
+    len = chp.length();  words.push_back(len);
+    for (i=0; i<len; ++i) words.push_back(real_to_word(chp[i]));
+    const IntVector& dihp = kd.discrete_int_parameters();
+    len = dihp.length();  words.push_back(len);
+    for (i=0; i<len; ++i) words.push_back((uint64_t)(int64_t)dihp[i]);
+    const SizetVector& dshp = kd.discrete_set_indices();
+    len = dshp.length();  words.push_back(len);
+    for (i=0; i<len; ++i) words.push_back(dshp[i]);
+  }
+}
+
+
+/// return the next key word, guarding against truncated key records
+inline uint64_t next_word(const uint64_t* words, size_t num_words, size_t& w)
+{
+  if (w >= num_words) archive_error("truncated active key");
+  return words[w++];
+}
+
+
+/// return the next key word as the length of a sequence of words that
+/// follows, guarding against lengths exceeding the remaining key record
+inline size_t
+next_length(const uint64_t* words, size_t num_words, size_t& w)
+{
+  uint64_t len = next_word(words, num_words, w);
+  if (len > num_words - w) archive_error("truncated active key");
+  return (size_t)len;
+}
+
+
+void unpack_key(const uint64_t* words, size_t num_words, ActiveKey& key)
+{
+  size_t w = 0, d, i, len;
+  unsigned short set_id = (unsigned short)next_word(words, num_words, w);
+  short r_type = (short)(int64_t)next_word(words, num_words, w);
+  size_t num_d = next_length(words, num_words, w);
+  std::vector<ActiveKeyData> key_data(num_d);
+  for (d=0; d<num_d; ++d) {
+    len = next_length(words, num_words, w);
+    UShortArray mi(len);
+    for (i=0; i<len; ++i) mi[i] = (unsigned short)next_word(words,num_words,w);
+    len = next_length(words, num_words, w);
+    RealVector chp((int)len, false);
+    for (i=0; i<len; ++i) chp[i] = word_to_real(next_word(words,num_words,w));
+    len = next_length(words, num_words, w);
+    IntVector dihp((int)len, false);
+    for (i=0; i<len; ++i) dihp[i] = (int)(int64_t)next_word(words,num_words,w);
+    len = next_length(words, num_words, w);
+    SizetVector dshp((int)len, false);
+    for (i=0; i<len; ++i) dshp[i] = (size_t)next_word(words, num_words, w);
+    key_data[d] = ActiveKeyData(mi, chp, dihp, dshp, SHALLOW_COPY);
+  }
+  key = ActiveKey(set_id, r_type, key_data, SHALLOW_COPY);
+}
+
+
+/// validate the locations of the basis and directory sections
+void check_header(const ArchiveHeader& header, size_t size)
+{
+  if (!section_fits(header.basisOffset, 1, header.numVars,
+		    sizeof(BasisRecord), size) ||
+      !section_fits(header.directoryOffset, 1, header.numExpansions,
+		    sizeof(DirectoryEntry), size))
+    archive_error("truncated basis or directory");
+  if (header.basisOffset % 8 || header.directoryOffset % 8)
+    archive_error("misaligned basis or directory");
+}
+
+
+/// validate the locations of the sections of an expansion, each of which
+/// must be aligned to its element size
+void check_entry(const DirectoryEntry& de, size_t num_v, size_t size)
+{
+  if (!section_fits(de.keyOffset, 1, de.keyWords, 8, size) ||
+      !section_fits(de.multiIndexOffset, de.numTerms, num_v, 2, size) ||
+      !section_fits(de.coeffOffset, 1, de.numTerms, 8, size) ||
+      !section_fits(de.gradOffset, de.numGradRows, de.numTerms, 8, size) ||
+      de.keyOffset % 8 || de.multiIndexOffset % 2 || de.coeffOffset % 8 ||
+      de.gradOffset % 8)
+    archive_error("corrupt expansion directory");
+}
+
+
+/** Converts a buffer written on a host of opposite endianness in place,
+    such that it may subsequently be parsed as native. */
+void swap_buffer(char* data, size_t size)
+{
+  if (size < sizeof(ArchiveHeader)) archive_error("truncated header");
+  ArchiveHeader* header = reinterpret_cast<ArchiveHeader*>(data);
+  swap_bytes(header->version);         swap_bytes(header->byteOrder);
+  swap_bytes(header->numVars);         swap_bytes(header->numExpansions);
+  swap_bytes(header->basisOffset);     swap_bytes(header->directoryOffset);
+
+  check_header(*header, size);
+  size_t v, e, num_v = header->numVars, num_exp = header->numExpansions;
+  BasisRecord* basis
+    = reinterpret_cast<BasisRecord*>(data + header->basisOffset);
+  for (v=0; v<num_v; ++v) {
+    BasisRecord& rec = basis[v];
+    swap_bytes(rec.basisType);  swap_bytes(rec.collocRule);
+    swap_array<double>(reinterpret_cast<char*>(rec.params), NUM_BASIS_PARAMS);
+  }
+  DirectoryEntry* dir
+    = reinterpret_cast<DirectoryEntry*>(data + header->directoryOffset);
+  swap_array<uint64_t>(reinterpret_cast<char*>(dir), num_exp * 7);
+  for (e=0; e<num_exp; ++e) {
+    const DirectoryEntry& de = dir[e];
+    check_entry(de, num_v, size);
+    swap_array<uint64_t>(data + de.keyOffset, de.keyWords);
+    swap_array<uint16_t>(data + de.multiIndexOffset, de.numTerms * num_v);
+    swap_array<double>(data + de.coeffOffset, de.numTerms);
+    swap_array<double>(data + de.gradOffset, de.numGradRows * de.numTerms);
+  }
+}
+
+
+void write_padding(std::ofstream& out, size_t& pos)
+{
+  static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  size_t aligned = align8(pos);
+  out.write(zeros, aligned - pos);  pos = aligned;
+}
+
+} // anonymous namespace
+
+
+void ExpansionArchive::
+add_expansion(const ActiveKey& key, const UShort2DArray& multi_index,
+	      const RealVector& exp_coeffs, const RealMatrix& exp_coeff_grads)
+{
+  size_t t, num_terms = multi_index.size(), num_v = polyBasis.size();
+  if (exp_coeffs.length() != num_terms ||
+      (exp_coeff_grads.numCols() && exp_coeff_grads.numCols() != num_terms))
+    archive_error("inconsistent expansion term counts");
+  for (t=0; t<num_terms; ++t)
+    if (multi_index[t].size() != num_v)
+      archive_error("multi-index length inconsistent with basis");
+  archiveKeys.push_back(key.interned());
+  pendingMultiIndices.push_back(multi_index);
+  pendingCoeffs.push_back(exp_coeffs);
+  pendingCoeffGrads.push_back(exp_coeff_grads);
+}
+
+
+void ExpansionArchive::write(const std::string& filename) const
+{
+  size_t v, e, t, num_v = polyBasis.size(), num_exp = pendingCoeffs.size();
+
+  // layout: header, basis, directory, then per-expansion sections
+  ArchiveHeader header;
+  std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+  header.version = ARCHIVE_VERSION;   header.byteOrder = NATIVE_ORDER;
+  header.numVars = num_v;             header.numExpansions = num_exp;
+  header.basisOffset     = sizeof(ArchiveHeader);
+  header.directoryOffset = header.basisOffset + num_v * sizeof(BasisRecord);
+  size_t pos = header.directoryOffset + num_exp * sizeof(DirectoryEntry);
+
+  std::vector<std::vector<uint64_t> > key_words(num_exp);
+  std::vector<DirectoryEntry> dir(num_exp);
+  for (e=0; e<num_exp; ++e) {
+    DirectoryEntry& de = dir[e];
+    pack_key(archiveKeys[e], key_words[e]);
+    de.numTerms    = pendingCoeffs[e].length();
+    de.numGradRows = pendingCoeffGrads[e].numRows();
+    de.keyWords    = key_words[e].size();
+    de.keyOffset   = pos = align8(pos);  pos += de.keyWords * 8;
+    de.multiIndexOffset = pos;           pos += de.numTerms * num_v * 2;
+    de.coeffOffset = pos = align8(pos);  pos += de.numTerms * 8;
+    de.gradOffset  = pos;                pos += de.numGradRows*de.numTerms*8;
+  }
+
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out)
+    archive_error("unable to open " + filename + " for writing");
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  BasisRecord rec;
+  for (v=0; v<num_v; ++v) {
+    pack_basis(polyBasis[v], rec);
+    out.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+  }
+  out.write(reinterpret_cast<const char*>(dir.data()),
+	    num_exp * sizeof(DirectoryEntry));
+  pos = header.directoryOffset + num_exp * sizeof(DirectoryEntry);
+  std::vector<uint16_t> packed_mi;
+  for (e=0; e<num_exp; ++e) {
+    const DirectoryEntry& de = dir[e];
+    write_padding(out, pos);
+    out.write(reinterpret_cast<const char*>(key_words[e].data()),
+	      de.keyWords * 8);
+    const UShort2DArray& mi = pendingMultiIndices[e];
+    packed_mi.resize(de.numTerms * num_v);
+    for (t=0; t<de.numTerms; ++t)
+      std::copy(mi[t].begin(), mi[t].end(), packed_mi.begin() + t * num_v);
+    out.write(reinterpret_cast<const char*>(packed_mi.data()),
+	      packed_mi.size() * 2);
+    pos = de.multiIndexOffset + packed_mi.size() * 2;
+    write_padding(out, pos);
+    out.write(reinterpret_cast<const char*>(pendingCoeffs[e].values()),
+	      de.numTerms * 8);
+    // RealMatrix may have a leading dimension exceeding its row count
+    const RealMatrix& grads = pendingCoeffGrads[e];
+    for (t=0; t<de.numTerms && de.numGradRows; ++t)
+      out.write(reinterpret_cast<const char*>(grads[t]), de.numGradRows * 8);
+    pos = de.gradOffset + de.numGradRows * de.numTerms * 8;
+  }
+  if (!out)
+    archive_error("failure writing " + filename);
+#ifdef DEBUG
+  PCout << "ExpansionArchive::write(): " << num_exp << " expansions ("
+	<< pos << " bytes) written to " << filename << std::endl;
+#endif // DEBUG
+}
+
+
+void ExpansionArchive::open(const std::string& filename)
+{
+  close();
+
+#ifdef PECOS_ARCHIVE_MMAP
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    archive_error("unable to open " + filename);
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    ::close(fd);  archive_error("unable to size " + filename);
+  }
+  mappedSize = (size_t)file_stat.st_size;
+  // private writable mapping: pages are shared with other processes
+  // mapping the same file until written (e.g., by byte order conversion)
+  void* addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+		    fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    mappedSize = 0;  archive_error("unable to map " + filename);
+  }
+  mappedData = addr;
+  bufferData = static_cast<char*>(addr);  bufferSize = mappedSize;
+#else
+  std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!in)
+    archive_error("unable to open " + filename);
+  in.seekg(0, std::ios::end);
+  ownedData.resize((size_t)in.tellg());
+  in.seekg(0, std::ios::beg);
+  in.read(ownedData.data(), ownedData.size());
+  if (!in)
+    archive_error("failure reading " + filename);
+  bufferData = ownedData.data();  bufferSize = ownedData.size();
+#endif
+
+  parse();
+#ifdef DEBUG
+  PCout << "ExpansionArchive::open(): " << archiveKeys.size()
+	<< " expansions loaded from " << filename << std::endl;
+#endif // DEBUG
+}
+
+
+void ExpansionArchive::close()
+{
+  expansionRecords.clear();  archiveKeys.clear();  polyBasis.clear();
+  pendingMultiIndices.clear();  pendingCoeffs.clear();
+  pendingCoeffGrads.clear();
+#ifdef PECOS_ARCHIVE_MMAP
+  if (mappedData)
+    munmap(mappedData, mappedSize);
+#endif
+  mappedData = nullptr;  mappedSize = 0;
+  ownedData.clear();  bufferData = nullptr;  bufferSize = 0;
+}
+
+
+void ExpansionArchive::parse()
+{
+  if (bufferSize < sizeof(ArchiveHeader))
+    archive_error("truncated header");
+  ArchiveHeader* header = reinterpret_cast<ArchiveHeader*>(bufferData);
+  if (std::memcmp(header->magic, ARCHIVE_MAGIC, sizeof(header->magic)))
+    archive_error("unrecognized file format");
+  if (header->byteOrder == SWAPPED_ORDER)
+    swap_buffer(bufferData, bufferSize);
+  else if (header->byteOrder != NATIVE_ORDER)
+    archive_error("unrecognized byte order");
+  if (header->version > ARCHIVE_VERSION)
+    archive_error("unsupported version " + std::to_string(header->version));
+
+  check_header(*header, bufferSize);
+  size_t v, e, t, num_v = header->numVars,
+    num_exp = header->numExpansions;
+
+  const BasisRecord* basis
+    = reinterpret_cast<const BasisRecord*>(bufferData + header->basisOffset);
+  polyBasis.resize(num_v);
+  for (v=0; v<num_v; ++v)
+    unpack_basis(basis[v], polyBasis[v]);
+
+  const DirectoryEntry* dir = reinterpret_cast<const DirectoryEntry*>
+    (bufferData + header->directoryOffset);
+  archiveKeys.resize(num_exp);  expansionRecords.resize(num_exp);
+  for (e=0; e<num_exp; ++e) {
+    const DirectoryEntry& de = dir[e];
+    check_entry(de, num_v, bufferSize);
+    ActiveKey key;
+    unpack_key(reinterpret_cast<const uint64_t*>(bufferData + de.keyOffset),
+	       de.keyWords, key);
+    archiveKeys[e] = key.interned();
+
+    ExpansionRecord& rec = expansionRecords[e];
+    rec.numTerms    = de.numTerms;
+    rec.numGradRows = de.numGradRows;
+    rec.multiIndex  = reinterpret_cast<const unsigned short*>
+      (bufferData + de.multiIndexOffset);
+    rec.coeffs      = reinterpret_cast<Real*>(bufferData + de.coeffOffset);
+    rec.coeffGrads  = reinterpret_cast<Real*>(bufferData + de.gradOffset);
+    rec.maxOrders.assign(num_v, 0);
+    for (t=0; t<rec.numTerms; ++t) {
+      const unsigned short* mi_t = rec.multiIndex + t * num_v;
+      for (v=0; v<num_v; ++v)
+	if (mi_t[v] > rec.maxOrders[v])
+	  rec.maxOrders[v] = mi_t[v];
+    }
+  }
+}
+
+
+/** Univariate values for all orders are generated by a single recurrence
+    pass per variable, after which each term requires num_variables()
+    multiplies. */
+Real ExpansionArchive::value(const RealVector& x, size_t i)
+{
+  const ExpansionRecord& rec = expansionRecords[i];
+  size_t t, v, num_v = polyBasis.size();
+  std::vector<RealMatrix> t1_vals(num_v);
+  RealVector x_v(1, false);  RealMatrix t1_grads, t1_hess;
+  for (v=0; v<num_v; ++v) {
+    x_v[0] = x[v];
+    polyBasis[v].type1_values(x_v, rec.maxOrders[v], 0, t1_vals[v],
+			      t1_grads, t1_hess);
+  }
+
+  Real sum = 0., prod;
+  for (t=0; t<rec.numTerms; ++t) {
+    const unsigned short* mi_t = rec.multiIndex + t * num_v;
+    prod = rec.coeffs[t];
+    for (v=0; v<num_v; ++v)
+      prod *= t1_vals[v](mi_t[v], 0);
+    sum += prod;
+  }
+  return sum;
+}
+
+} // namespace Pecos
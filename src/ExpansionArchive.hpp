@@ -0,0 +1,225 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 ExpansionArchive
+//- Description: Binary persistence of orthogonal polynomial expansions
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef EXPANSION_ARCHIVE_HPP
+#define EXPANSION_ARCHIVE_HPP
+
+#include "pecos_data_types.hpp"
+#include "ActiveKey.hpp"
+#include "BasisPolynomial.hpp"
+
+namespace Pecos {
+
+
+/// Versioned binary archive of orthogonal polynomial expansions.
+
+/** An archive holds the univariate basis (types and distribution
+    parameters) shared by a set of expansions, together with the active
+    key, packed multi-index, coefficients and coefficient gradients of
+    each expansion.  Archives are written with add_expansion() and
+    write(), and are loaded with open(), which memory-maps the file where
+    supported such that the coefficient views returned by coefficients()
+    and coefficient_gradients() reference the mapped pages without
+    copying and are shared among processes mapping the same file.  The
+    mapping is private: writes through a view are not propagated to the
+    file.  Files record their byte order and are converted on load when
+    written on a host of opposite endianness (in which case the views
+    reference converted private pages).  Numerically generated bases are
+    not supported, since they are not defined by a finite parameter set. */
+
+class ExpansionArchive
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  ExpansionArchive();
+  /// destructor
+  ~ExpansionArchive();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// define the univariate basis shared by the expansions to be written
+  void polynomial_basis(const std::vector<BasisPolynomial>& poly_basis);
+  /// append an expansion to be written, following polynomial_basis()
+  /// (exp_coeff_grads may be empty)
+  void add_expansion(const ActiveKey& key, const UShort2DArray& multi_index,
+		     const RealVector& exp_coeffs,
+		     const RealMatrix& exp_coeff_grads);
+  /// write the basis and the appended expansions to filename
+  void write(const std::string& filename) const;
+
+  /// load an archive from filename, replacing any current contents
+  void open(const std::string& filename);
+  /// release the loaded (or appended) contents
+  void close();
+
+  /// return the number of variables
+  size_t num_variables() const;
+  /// return the number of expansions
+  size_t num_expansions() const;
+  /// return the active key of the i-th expansion (interned)
+  const ActiveKey& key(size_t i) const;
+  /// return the index of the expansion for key (SZ_MAX if not present)
+  size_t find(const ActiveKey& key) const;
+
+  /// return the number of terms in the i-th expansion
+  size_t num_terms(size_t i) const;
+  /// return the packed multi-index of the i-th expansion, with the
+  /// num_variables() indices of each term stored contiguously
+  const unsigned short* multi_index(size_t i) const;
+  /// return a view of the coefficients of the i-th expansion
+  RealVector coefficients(size_t i) const;
+  /// return a view of the coefficient gradients of the i-th expansion
+  /// (gradient components by terms; empty if not archived)
+  RealMatrix coefficient_gradients(size_t i) const;
+
+  /// return the univariate basis reconstructed from the archive
+  std::vector<BasisPolynomial>& polynomial_basis();
+
+  /// evaluate the i-th expansion at x
+  Real value(const RealVector& x, size_t i);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// validate the buffer contents and define expansionRecords
+  void parse();
+
+  /// disallow copies of the mapped region and owned buffer
+  ExpansionArchive(const ExpansionArchive&);
+  /// disallow copies of the mapped region and owned buffer
+  ExpansionArchive& operator=(const ExpansionArchive&);
+
+  //
+  //- Heading: Data
+  //
+
+  /// location of an expansion within the archive buffer
+  struct ExpansionRecord
+  {
+    /// number of expansion terms
+    size_t numTerms;
+    /// number of rows in the coefficient gradients
+    size_t numGradRows;
+    /// maximal order per variable within multiIndex
+    UShortArray maxOrders;
+    /// packed multi-index (numTerms x num variables)
+    const unsigned short* multiIndex;
+    /// coefficients (numTerms)
+    Real* coeffs;
+    /// column-major coefficient gradients (numGradRows x numTerms)
+    Real* coeffGrads;
+  };
+
+  /// univariate basis, reconstructed on open() or assigned for write()
+  std::vector<BasisPolynomial> polyBasis;
+  /// active keys of the expansions
+  std::vector<ActiveKey> archiveKeys;
+  /// multi-indices of expansions appended for write()
+  std::vector<UShort2DArray> pendingMultiIndices;
+  /// coefficients of expansions appended for write()
+  RealVectorArray pendingCoeffs;
+  /// coefficient gradients of expansions appended for write()
+  RealMatrixArray pendingCoeffGrads;
+
+  /// expansions within the loaded buffer
+  std::vector<ExpansionRecord> expansionRecords;
+  /// start of the memory-mapped file (nullptr if not mapped)
+  void* mappedData;
+  /// size of the memory-mapped file
+  size_t mappedSize;
+  /// file contents when memory mapping is not available
+  std::vector<char> ownedData;
+  /// start of the loaded buffer (mappedData or ownedData)
+  char* bufferData;
+  /// size of the loaded buffer
+  size_t bufferSize;
+};
+
+
+inline ExpansionArchive::ExpansionArchive():
+  mappedData(nullptr), mappedSize(0), bufferData(nullptr), bufferSize(0)
+{ }
+
+
+inline ExpansionArchive::~ExpansionArchive()
+{ close(); }
+
+
+inline void ExpansionArchive::
+polynomial_basis(const std::vector<BasisPolynomial>& poly_basis)
+{ polyBasis = poly_basis; }
+
+
+inline std::vector<BasisPolynomial>& ExpansionArchive::polynomial_basis()
+{ return polyBasis; }
+
+
+inline size_t ExpansionArchive::num_variables() const
+{ return polyBasis.size(); }
+
+
+inline size_t ExpansionArchive::num_expansions() const
+{ return archiveKeys.size(); }
+
+
+inline const ActiveKey& ExpansionArchive::key(size_t i) const
+{ return archiveKeys[i]; }
+
+
+inline size_t ExpansionArchive::find(const ActiveKey& key) const
+{
+  size_t i, num_exp = archiveKeys.size();
+  for (i=0; i<num_exp; ++i)
+    if (archiveKeys[i] == key)
+      return i;
+  return SZ_MAX;
+}
+
+
+inline size_t ExpansionArchive::num_terms(size_t i) const
+{ return expansionRecords[i].numTerms; }
+
+
+inline const unsigned short* ExpansionArchive::multi_index(size_t i) const
+{ return expansionRecords[i].multiIndex; }
+
+
+inline RealVector ExpansionArchive::coefficients(size_t i) const
+{
+  const ExpansionRecord& rec = expansionRecords[i];
+  return RealVector(Teuchos::View, rec.coeffs, (int)rec.numTerms);
+}
+
+
+inline RealMatrix ExpansionArchive::coefficient_gradients(size_t i) const
+{
+  const ExpansionRecord& rec = expansionRecords[i];
+  return (rec.numGradRows) ?
+    RealMatrix(Teuchos::View, rec.coeffGrads, (int)rec.numGradRows,
+	       (int)rec.numGradRows, (int)rec.numTerms) : RealMatrix();
+}
+
+} // namespace Pecos
+
+#endif
@@ -0,0 +1,90 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 GaussRuleCache
+//- Description: Implementation code for GaussRuleCache class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "GaussRuleCache.hpp"
+
+//#define DEBUG
+
+namespace Pecos {
+
+GaussRuleCache::RuleMap GaussRuleCache::gaussRules;
+GaussRuleCache::KeyList GaussRuleCache::lruKeys;
+size_t                  GaussRuleCache::maxRules = 1024;
+std::mutex              GaussRuleCache::cacheMutex;
+
+
+bool GaussRuleCache::
+find(short dist_type, const RealVector& dist_params, unsigned short order,
+     GaussRule& rule)
+{
+  RealArray key;
+  form_key(dist_type, dist_params, order, key);
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  RuleMap::iterator it = gaussRules.find(key);
+  if (it == gaussRules.end())
+    return false;
+  // promote to most recently used
+  lruKeys.splice(lruKeys.begin(), lruKeys, it->second.second);
+  rule = it->second.first;
+#ifdef DEBUG
+  PCout << "GaussRuleCache::find(): retrieved rule of order " << order
+	<< " for distribution type " << dist_type << std::endl;
+#endif // DEBUG
+  return true;
+}
+
+
+void GaussRuleCache::
+insert(short dist_type, const RealVector& dist_params, unsigned short order,
+       const GaussRule& rule)
+{
+  RealArray key;
+  form_key(dist_type, dist_params, order, key);
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (!maxRules)
+    return;
+  RuleMap::iterator it = gaussRules.find(key);
+  if (it != gaussRules.end()) {
+    it->second.first = rule;
+    lruKeys.splice(lruKeys.begin(), lruKeys, it->second.second);
+  }
+  else {
+    lruKeys.push_front(key);
+    gaussRules.insert(RuleMap::value_type(key,
+      std::pair<GaussRule, KeyList::iterator>(rule, lruKeys.begin())));
+    enforce_capacity();
+  }
+}
+
+
+void GaussRuleCache::capacity(size_t max_rules)
+{
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  maxRules = max_rules;
+  enforce_capacity();
+}
+
+
+/** Assumes that cacheMutex is held by the caller. */
+void GaussRuleCache::enforce_capacity()
+{
+  while (gaussRules.size() > maxRules) {
+    gaussRules.erase(lruKeys.back());
+    lruKeys.pop_back();
+  }
+}
+
+} // namespace Pecos
@@ -0,0 +1,144 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 GaussRuleCache
+//- Description: Process-wide cache of numerically generated Gauss rules
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef GAUSS_RULE_CACHE_HPP
+#define GAUSS_RULE_CACHE_HPP
+
+#include "pecos_data_types.hpp"
+#include <list>
+#include <mutex>
+
+namespace Pecos {
+
+
+/// Gauss rule, three-term recursion coefficients and polynomial norms
+/// for a numerically generated orthogonal polynomial of a given order.
+
+struct GaussRule
+{
+  /// Gauss points (eigenvalues of the Jacobi matrix)
+  RealArray points;
+  /// type 1 Gauss weights
+  RealArray weights;
+  /// recursion coefficients alpha_i, i = 0 to order-1
+  RealVector alpha;
+  /// recursion coefficients beta_i, i = 0 to order-1
+  RealVector beta;
+  /// norm-squared of the orthogonal polynomials of orders 0 to order
+  /// (empty if not generated)
+  RealVector normsSq;
+  /// monomial coefficients of the orthogonal polynomials of orders 0 to
+  /// order (empty if not generated)
+  RealVectorArray polyCoeffs;
+};
+
+
+/// Least recently used cache of Gauss rules shared by all
+/// NumericGenOrthogPolynomial instances.
+
+/** Rules are keyed by distribution type, distribution parameters and
+    order, such that rules for parameter sets that recur (e.g., within
+    design under uncertainty, where reset_gauss() is invoked for each
+    distribution parameter update) are retrieved rather than
+    regenerated.  The number of cached rules is bounded by capacity(),
+    with the least recently used rule evicted first.  All operations
+    are serialized, such that the cache may be accessed concurrently. */
+
+class GaussRuleCache
+{
+public:
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// retrieve a copy of the rule for the given distribution and order;
+  /// returns false if not cached
+  static bool find(short dist_type, const RealVector& dist_params,
+		   unsigned short order, GaussRule& rule);
+  /// add (or replace) the rule for the given distribution and order
+  static void insert(short dist_type, const RealVector& dist_params,
+		     unsigned short order, const GaussRule& rule);
+
+  /// set the maximum number of cached rules (0 disables caching)
+  static void capacity(size_t max_rules);
+  /// return the maximum number of cached rules
+  static size_t capacity();
+  /// return the number of cached rules
+  static size_t size();
+  /// remove all cached rules
+  static void clear();
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// define the lookup key from distribution type, parameters and order
+  static void form_key(short dist_type, const RealVector& dist_params,
+		       unsigned short order, RealArray& key);
+  /// evict least recently used rules until the capacity is satisfied
+  static void enforce_capacity();
+
+  //
+  //- Heading: Data
+  //
+
+  /// list of keys ordered from most to least recently used
+  typedef std::list<RealArray> KeyList;
+  /// mapping from key to cached rule and its position within lruKeys
+  typedef std::map<RealArray, std::pair<GaussRule, KeyList::iterator> >
+    RuleMap;
+
+  /// cached rules
+  static RuleMap gaussRules;
+  /// keys in order of use
+  static KeyList lruKeys;
+  /// maximum number of cached rules
+  static size_t maxRules;
+  /// serializes access to gaussRules and lruKeys
+  static std::mutex cacheMutex;
+};
+
+
+inline size_t GaussRuleCache::capacity()
+{ std::lock_guard<std::mutex> lock(cacheMutex); return maxRules; }
+
+
+inline size_t GaussRuleCache::size()
+{ std::lock_guard<std::mutex> lock(cacheMutex); return gaussRules.size(); }
+
+
+inline void GaussRuleCache::clear()
+{
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  gaussRules.clear();  lruKeys.clear();
+}
+
+
+inline void GaussRuleCache::
+form_key(short dist_type, const RealVector& dist_params, unsigned short order,
+	 RealArray& key)
+{
+  int i, num_params = dist_params.length();
+  key.resize(num_params + 2);
+  key[0] = (Real)dist_type;  key[1] = (Real)order;
+  for (i=0; i<num_params; ++i)
+    key[i+2] = dist_params[i];
+}
+
+} // namespace Pecos
+
+#endif
@@ -146,6 +146,21 @@ Real GenLaguerreOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 }
 
 
+bool GenLaguerreOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  // (n+1) La_{n+1} = (2n+1+alpha-x) La_n - (n+alpha) La_{n-1}
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  for (unsigned short n=0; n<max_order; ++n) {
+    a[n] = -1./(n+1.);  b[n] = (2.*n+1.+alphaPoly)/(n+1.);
+    c[n] = (n+alphaPoly)/(n+1.);
+  }
+  return true;
+}
+
+
 Real GenLaguerreOrthogPolynomial::norm_squared(unsigned short order)
 {
   // For integer alphaPoly, Gamma(alphaPoly+n+1)/n!/Gamma(alphaPoly+1)
@@ -70,6 +70,9 @@ protected:
   Real type1_hessian(Real x, unsigned short order);
   Real norm_squared(unsigned short order);
 
+  bool recurrence_coefficients(unsigned short max_order, RealVector& a,
+			       RealVector& b, RealVector& c);
+
   const RealArray& collocation_points(unsigned short order);
   const RealArray& type1_collocation_weights(unsigned short order);
 
@@ -99,6 +99,19 @@ Real HermiteOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 { return (order>1) ? order*(order-1)*type1_value(x, order-2) : 0.; }
 
 
+bool HermiteOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  // He_{n+1} = x He_n - n He_{n-1}
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  for (unsigned short n=0; n<max_order; ++n)
+    { a[n] = 1.; b[n] = 0.; c[n] = (Real)n; }
+  return true;
+}
+
+
 Real HermiteOrthogPolynomial::norm_squared(unsigned short order)
 { return factorial(order); }
 
@@ -15,6 +15,8 @@
 #include "Teuchos_SerialDenseHelpers.hpp"
 #include "pecos_stat_util.hpp"
 #include "ActiveKey.hpp"
+#include <boost/unordered_map.hpp>
+#include <thread>
 
 //#define DEBUG
 //#define VBD_DEBUG
@@ -124,48 +126,53 @@ void HierarchInterpPolyApproximation::compute_coefficients()
   const SDVArray& sdv_array = surrData.variables_data();
   const SDRArray& sdr_array = surrData.response_data();
 
-  // level 0
-  c_index = (empty_c_index) ? cntr++ : colloc_index[0][0][0];
-  const SurrogateDataResp& sdr_0 = sdr_array[c_index];
-  if (expansionCoeffFlag) {
-    exp_t1_coeffs[0][0][0] = sdr_0.response_function();
-    if (use_derivs)
-      Teuchos::setCol(sdr_0.response_gradient(), 0, exp_t2_coeffs[0][0]);
-  }
-  if (expansionCoeffGradFlag)
-    Teuchos::setCol(sdr_0.response_gradient(), 0, exp_t1_coeff_grads[0][0]);
+  if (unidirectional_hierarchization())
+    hierarchize_coefficients(sm_mi, colloc_key, colloc_index, sdr_array);
+  else {
+    // level 0
+    c_index = (empty_c_index) ? cntr++ : colloc_index[0][0][0];
+    const SurrogateDataResp& sdr_0 = sdr_array[c_index];
+    if (expansionCoeffFlag) {
+      exp_t1_coeffs[0][0][0] = sdr_0.response_function();
+      if (use_derivs)
+	Teuchos::setCol(sdr_0.response_gradient(), 0, exp_t2_coeffs[0][0]);
+    }
+    if (expansionCoeffGradFlag)
+      Teuchos::setCol(sdr_0.response_gradient(), 0, exp_t1_coeff_grads[0][0]);
 
-  // levels 1 to num_levels
-  for (lev=1; lev<num_levels; ++lev) {
-    const UShort3DArray& key_l = colloc_key[lev];
-    num_sets = key_l.size();
-    for (set=0; set<num_sets; ++set) {
-      num_tp_pts = key_l[set].size();
-      for (pt=0; pt<num_tp_pts; ++pt) {
-	c_index = (empty_c_index) ? cntr++ : colloc_index[lev][set][pt];
-	const RealVector& c_vars = sdv_array[c_index].continuous_variables();
-	const SurrogateDataResp& sdr = sdr_array[c_index];
-	// coefficients are hierarchical surpluses
-	if (expansionCoeffFlag) {
-	  exp_t1_coeffs[lev][set][pt] = sdr.response_function() -
-	    value(c_vars, sm_mi, colloc_key, exp_t1_coeffs,exp_t2_coeffs,lev-1);
-	  if (use_derivs) {
+    // levels 1 to num_levels
+    for (lev=1; lev<num_levels; ++lev) {
+      const UShort3DArray& key_l = colloc_key[lev];
+      num_sets = key_l.size();
+      for (set=0; set<num_sets; ++set) {
+	num_tp_pts = key_l[set].size();
+	for (pt=0; pt<num_tp_pts; ++pt) {
+	  c_index = (empty_c_index) ? cntr++ : colloc_index[lev][set][pt];
+	  const RealVector& c_vars = sdv_array[c_index].continuous_variables();
+	  const SurrogateDataResp& sdr = sdr_array[c_index];
+	  // coefficients are hierarchical surpluses
+	  if (expansionCoeffFlag) {
+	    exp_t1_coeffs[lev][set][pt] = sdr.response_function() -
+	      value(c_vars, sm_mi, colloc_key, exp_t1_coeffs, exp_t2_coeffs,
+		    lev-1);
+	    if (use_derivs) {
+	      const RealVector& data_grad = sdr.response_gradient();
+	      const RealVector& prev_grad = gradient_basis_variables(c_vars,
+		sm_mi, colloc_key, exp_t1_coeffs, exp_t2_coeffs, lev-1);
+	      Real* hier_grad = exp_t2_coeffs[lev][set][pt];
+	      for (v=0; v<num_deriv_vars; ++v)
+		hier_grad[v] = data_grad[v] - prev_grad[v];
+	    }
+	  }
+	  if (expansionCoeffGradFlag) {
 	    const RealVector& data_grad = sdr.response_gradient();
-	    const RealVector& prev_grad = gradient_basis_variables(c_vars,
-	      sm_mi, colloc_key, exp_t1_coeffs, exp_t2_coeffs, lev-1);
-	    Real* hier_grad = exp_t2_coeffs[lev][set][pt];
+	    const RealVector& prev_grad = gradient_nonbasis_variables(c_vars,
+	      sm_mi, colloc_key, exp_t1_coeff_grads, lev-1);
+	    Real* hier_grad = exp_t1_coeff_grads[lev][set][pt];
 	    for (v=0; v<num_deriv_vars; ++v)
 	      hier_grad[v] = data_grad[v] - prev_grad[v];
 	  }
 	}
-	if (expansionCoeffGradFlag) {
-	  const RealVector& data_grad = sdr.response_gradient();
-	  const RealVector& prev_grad = gradient_nonbasis_variables(c_vars,
-	    sm_mi, colloc_key, exp_t1_coeff_grads, lev-1);
-	  Real* hier_grad = exp_t1_coeff_grads[lev][set][pt];
-	  for (v=0; v<num_deriv_vars; ++v)
-	    hier_grad[v] = data_grad[v] - prev_grad[v];
-	}
       }
     }
   }
@@ -295,6 +302,68 @@ increment_coefficients(const UShortArray& index_set)
     t1_coeff_grads.shapeUninitialized(num_deriv_vars, num_trial_pts);
   }
  
+  if (unidirectional_hierarchization()) {
+    // evaluate the current interpolant at the new points by dehierarchization
+    // over the existing index sets dominated by index_set (all other sets
+    // vanish at the new points), with zero surpluses for the new points
+    size_t l, s, r, num_v = index_set.size(), num_rows = 0, p = 0;
+    if (expansionCoeffFlag)     ++num_rows;
+    if (expansionCoeffGradFlag) num_rows += num_deriv_vars;
+    UShort2DArray pt_levels, pt_keys;  SizetArray dom_levels, dom_sets;
+    for (l=0; l<lev; ++l) {
+      const UShort2DArray& sm_mi_l = sm_mi[l];
+      old_sets = exp_t1_coeffs[l].size();
+      for (s=0; s<old_sets; ++s) {
+	const UShortArray& sm_index = sm_mi_l[s];
+	for (v=0; v<num_v; ++v)
+	  if (sm_index[v] > index_set[v])
+	    break;
+	if (v == num_v) {
+	  const UShort2DArray& key_ls = colloc_key[l][s];
+	  pt_levels.insert(pt_levels.end(), key_ls.size(), sm_index);
+	  pt_keys.insert(pt_keys.end(), key_ls.begin(), key_ls.end());
+	  dom_levels.push_back(l);  dom_sets.push_back(s);
+	}
+      }
+    }
+    size_t num_old_pts = pt_levels.size(), num_dom = dom_levels.size();
+    const UShort2DArray& key_new = colloc_key[lev][set];
+    pt_levels.insert(pt_levels.end(), num_trial_pts, index_set);
+    pt_keys.insert(pt_keys.end(), key_new.begin(), key_new.end());
+
+    RealMatrix pt_data(num_rows, num_old_pts + num_trial_pts); // init to 0
+    for (size_t d=0; d<num_dom; ++d) {
+      l = dom_levels[d];  s = dom_sets[d];
+      size_t num_ls_pts = colloc_key[l][s].size();
+      for (pt=0; pt<num_ls_pts; ++pt, ++p) {
+	Real* data_p = pt_data[p];  r = 0;
+	if (expansionCoeffFlag)
+	  data_p[r++] = exp_t1_coeffs[l][s][pt];
+	if (expansionCoeffGradFlag) {
+	  const Real* grad = exp_t1_coeff_grads[l][s][pt];
+	  for (v=0; v<num_deriv_vars; ++v)
+	    data_p[r++] = grad[v];
+	}
+      }
+    }
+    unidirectional_transform(pt_levels, pt_keys, pt_data, false);
+
+    // coefficients are hierarchical surpluses
+    for (pt=0, index=old_pts; pt<num_trial_pts; ++pt, ++index, ++p) {
+      const SurrogateDataResp& sdr = sdr_array[index];
+      const Real* data_p = pt_data[p];  r = 0;
+      if (expansionCoeffFlag)
+	t1_coeffs[pt] = sdr.response_function() - data_p[r++];
+      if (expansionCoeffGradFlag) {
+	const RealVector& data_grad = sdr.response_gradient();
+	Real* hier_grad = t1_coeff_grads[pt];
+	for (v=0; v<num_deriv_vars; ++v)
+	  hier_grad[v] = data_grad[v] - data_p[r++];
+      }
+    }
+    return;
+  }
+
   for (pt=0, index=old_pts; pt<num_trial_pts; ++pt, ++index) {
     const RealVector& c_vars = sdv_array[index].continuous_variables();
     const SurrogateDataResp& sdr = sdr_array[index];
@@ -322,6 +391,230 @@ increment_coefficients(const UShortArray& index_set)
 }
 
 
+/** Computes the hierarchical surpluses for all points at once using the
+    unidirectional principle, rather than evaluating the interpolant
+    from lower levels at each point: O(N d n_1D) in place of O(N^2). */
+void HierarchInterpPolyApproximation::
+hierarchize_coefficients(const UShort3DArray& sm_mi,
+			 const UShort4DArray& colloc_key,
+			 const Sizet3DArray&  colloc_index,
+			 const SDRArray& sdr_array)
+{
+  RealVector2DArray& exp_t1_coeffs = expT1CoeffsIter->second;
+  RealMatrix2DArray& exp_t1_coeff_grads = expT1CoeffGradsIter->second;
+  size_t lev, set, pt, v, r, p, num_levels = colloc_key.size(), num_sets,
+    num_tp_pts, num_pts = 0, num_rows = 0, c_index,
+    num_deriv_vars = surrData.num_derivative_variables();
+  bool empty_c_index = colloc_index.empty();
+  if (expansionCoeffFlag)     ++num_rows;
+  if (expansionCoeffGradFlag) num_rows += num_deriv_vars;
+  for (lev=0; lev<num_levels; ++lev) {
+    num_sets = colloc_key[lev].size();
+    for (set=0; set<num_sets; ++set)
+      num_pts += colloc_key[lev][set].size();
+  }
+
+  // gather the nodal data, identified by the level and 1D point index
+  // of each point in each variable
+  UShort2DArray pt_levels(num_pts), pt_keys(num_pts);
+  RealMatrix pt_data(num_rows, num_pts, false);
+  for (lev=0, p=0; lev<num_levels; ++lev) {
+    const UShort3DArray& key_l = colloc_key[lev];
+    num_sets = key_l.size();
+    for (set=0; set<num_sets; ++set) {
+      num_tp_pts = key_l[set].size();
+      for (pt=0; pt<num_tp_pts; ++pt, ++p) {
+	c_index = (empty_c_index) ? p : colloc_index[lev][set][pt];
+	const SurrogateDataResp& sdr = sdr_array[c_index];
+	pt_levels[p] = sm_mi[lev][set];  pt_keys[p] = key_l[set][pt];
+	Real* data_p = pt_data[p];  r = 0;
+	if (expansionCoeffFlag)
+	  data_p[r++] = sdr.response_function();
+	if (expansionCoeffGradFlag) {
+	  const RealVector& data_grad = sdr.response_gradient();
+	  for (v=0; v<num_deriv_vars; ++v)
+	    data_p[r++] = data_grad[v];
+	}
+      }
+    }
+  }
+
+  unidirectional_transform(pt_levels, pt_keys, pt_data, true);
+
+  // scatter the hierarchical surpluses
+  for (lev=0, p=0; lev<num_levels; ++lev) {
+    num_sets = colloc_key[lev].size();
+    for (set=0; set<num_sets; ++set) {
+      num_tp_pts = colloc_key[lev][set].size();
+      for (pt=0; pt<num_tp_pts; ++pt, ++p) {
+	const Real* data_p = pt_data[p];  r = 0;
+	if (expansionCoeffFlag)
+	  exp_t1_coeffs[lev][set][pt] = data_p[r++];
+	if (expansionCoeffGradFlag) {
+	  Real* hier_grad = exp_t1_coeff_grads[lev][set][pt];
+	  for (v=0; v<num_deriv_vars; ++v)
+	    hier_grad[v] = data_p[r++];
+	}
+      }
+    }
+  }
+}
+
+
+/** For a nested grid, the hierarchical interpolant is a tensor product of
+    1D hierarchical interpolants, such that the multidimensional transform
+    between nodal values and surpluses factors into 1D transforms applied
+    along each variable in turn.  Along variable v, the value at a point
+    of level l is corrected by the contributions of the level j < l
+    points that coincide with it in all other variables (its hierarchical
+    ancestors in v).  Points are processed by increasing level in v for
+    hierarchization, such that ancestors already hold surpluses, and by
+    decreasing level for dehierarchization, such that ancestors still
+    hold surpluses.  The points sharing a level in v (spanning the
+    disjoint index sets with that level) only read data of lower levels,
+    so they are updated concurrently. */
+void HierarchInterpPolyApproximation::
+unidirectional_transform(const UShort2DArray& pt_levels,
+			 const UShort2DArray& pt_keys, RealMatrix& pt_data,
+			 bool hierarchize)
+{
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver = data_rep->hsg_driver();
+  const Real3DArray& colloc_pts_1d = hsg_driver->collocation_points_1d();
+  size_t p, r, v, i, j, k, c, t, num_pts = pt_levels.size(),
+    num_v = data_rep->numVars, num_dk, num_anc, num_threads,
+    max_threads = std::max(1u, std::thread::hardware_concurrency());
+  unsigned short l, max_l;
+
+  // hash each point on its (levels, keys) for lookup of its ancestors
+  boost::unordered_map<UShortArray, size_t> pt_map;
+  UShortArray pt_id(2*num_v);
+  for (p=0; p<num_pts; ++p) {
+    std::copy(pt_levels[p].begin(), pt_levels[p].end(), pt_id.begin());
+    std::copy(pt_keys[p].begin(), pt_keys[p].end(), pt_id.begin() + num_v);
+    pt_map[pt_id] = p;
+  }
+
+  Sizet2DArray level_pts;  UShort2DArray delta_keys;
+  RealVectorArray basis_l; // [key] --> ancestor basis values
+  SizetArray missing(max_threads);
+  for (v=0; v<num_v; ++v) {
+    // bucket the points by their level in variable v
+    max_l = 0;
+    for (p=0; p<num_pts; ++p)
+      if (pt_levels[p][v] > max_l)
+	max_l = pt_levels[p][v];
+    if (!max_l) continue;
+    level_pts.clear();  level_pts.resize(max_l+1);
+    for (p=0; p<num_pts; ++p)
+      level_pts[pt_levels[p][v]].push_back(p);
+    delta_keys.resize(max_l);
+    for (l=0; l<max_l; ++l)
+      hsg_driver->level_to_delta_key(v, l, delta_keys[l]);
+
+    for (i=1; i<=max_l; ++i) {
+      l = (hierarchize) ? i : max_l + 1 - i;
+      const SizetArray& pts_l = level_pts[l];
+      size_t num_pts_l = pts_l.size();
+      if (!num_pts_l) continue;
+
+      // ancestor basis values are shared by all points with a 1D point
+      const RealArray& colloc_pts_1d_lv = colloc_pts_1d[l][v];
+      basis_l.clear();  basis_l.resize(colloc_pts_1d_lv.size());
+      for (j=0, num_anc=0; j<l; ++j)
+	num_anc += delta_keys[j].size();
+      for (k=0; k<num_pts_l; ++k) {
+	unsigned short key_pv = pt_keys[pts_l[k]][v];
+	RealVector& basis_lk = basis_l[key_pv];
+	if (basis_lk.length()) continue;
+	basis_lk.sizeUninitialized(num_anc);
+	Real x_v = colloc_pts_1d_lv[key_pv];
+	for (j=0, c=0; j<l; ++j) {
+	  const UShortArray& dk_j = delta_keys[j];  num_dk = dk_j.size();
+	  for (r=0; r<num_dk; ++r, ++c)
+	    basis_lk[c] = (j) ?
+	      data_rep->polynomialBasis[j][v].type1_value(x_v, dk_j[r]) : 1.;
+	}
+      }
+
+      num_threads = std::min(max_threads,
+			     std::max((size_t)1, num_pts_l / 256));
+      if (num_threads == 1)
+	unidirectional_update(0, 1, v, l, pts_l, pt_levels, pt_keys, pt_map,
+			      delta_keys, basis_l, hierarchize, pt_data,
+			      missing[0]);
+      else {
+	std::vector<std::thread> threads;  threads.reserve(num_threads);
+	for (t=0; t<num_threads; ++t)
+	  threads.push_back(std::thread(
+	    &HierarchInterpPolyApproximation::unidirectional_update, this, t,
+	    num_threads, v, l, std::cref(pts_l), std::cref(pt_levels),
+	    std::cref(pt_keys), std::cref(pt_map), std::cref(delta_keys),
+	    std::cref(basis_l), hierarchize, std::ref(pt_data),
+	    std::ref(missing[t])));
+	for (t=0; t<num_threads; ++t)
+	  threads[t].join();
+      }
+      for (t=0; t<num_threads; ++t)
+	if (missing[t]) {
+	  PCerr << "Error: " << missing[t] << " hierarchical ancestors in "
+		<< "variable " << v << " missing from grid in HierarchInterp"
+		<< "PolyApproximation::unidirectional_transform().\n       "
+		<< "Grid must be closed under hierarchical parents."
+		<< std::endl;
+	  abort_handler(-1);
+	}
+    }
+  }
+}
+
+
+/** Applies the 1D correction along variable v to the points of level l
+    in v with positions thread, thread + num_threads, ... within pts_l.
+    Ancestors with a nonzero basis value that are not present in the grid
+    are counted in num_missing, rather than aborting from a worker. */
+void HierarchInterpPolyApproximation::
+unidirectional_update(size_t thread, size_t num_threads, size_t v,
+		      unsigned short l, const SizetArray& pts_l,
+		      const UShort2DArray& pt_levels,
+		      const UShort2DArray& pt_keys,
+		      const boost::unordered_map<UShortArray, size_t>& pt_map,
+		      const UShort2DArray& delta_keys,
+		      const RealVectorArray& basis_l, bool hierarchize,
+		      RealMatrix& pt_data, size_t& num_missing)
+{
+  size_t j, k, c, d, r, p, num_dk, num_v = pt_levels[0].size(),
+    num_pts_l = pts_l.size(), num_rows = pt_data.numRows();
+  boost::unordered_map<UShortArray, size_t>::const_iterator cit;
+  UShortArray pt_id(2*num_v);
+  num_missing = 0;
+  for (k=thread; k<num_pts_l; k+=num_threads) {
+    p = pts_l[k];
+    const UShortArray& key_p = pt_keys[p];
+    const RealVector& basis_lk = basis_l[key_p[v]];
+    std::copy(pt_levels[p].begin(), pt_levels[p].end(), pt_id.begin());
+    std::copy(key_p.begin(), key_p.end(), pt_id.begin() + num_v);
+    Real* data_p = pt_data[p];
+    for (j=0, c=0; j<l; ++j) {
+      const UShortArray& dk_j = delta_keys[j];  num_dk = dk_j.size();
+      pt_id[v] = j;
+      for (d=0; d<num_dk; ++d, ++c) {
+	Real basis = basis_lk[c];
+	if (basis == 0.) continue;
+	pt_id[num_v+v] = dk_j[d];
+	cit = pt_map.find(pt_id);
+	if (cit == pt_map.end()) { ++num_missing; continue; }
+	if (hierarchize) basis = -basis;
+	const Real* data_anc = pt_data[cit->second];
+	for (r=0; r<num_rows; ++r)
+	  data_p[r] += basis * data_anc[r];
+      }
+    }
+  }
+}
+
+
 void HierarchInterpPolyApproximation::pop_coefficients(bool save_data)
 {
   std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
@@ -608,6 +901,7 @@ void HierarchInterpPolyApproximation::finalize_coefficients()
   // synchronize expansionCoeff{s,Grads} and approxData
   update_active_iterators(data_rep->activeKey);
   clear_current_bits(); //clear_delta_bits();
+  clear_surplus_array();
 
   promote_all_popped_coefficients();
 }
@@ -872,6 +1166,7 @@ void HierarchInterpPolyApproximation::combined_to_active(bool clear_combined)
   else
     primaryDeltaMomIter->second = combinedDeltaMoments; // deep copy
 
+  clear_surplus_array();
   InterpPolyApproximation::combined_to_active(clear_combined);
 }
 
@@ -1024,7 +1319,10 @@ value(const RealVector& x, const UShort3DArray& sm_mi,
   Real approx_val = 0.;
   SizetArray colloc_index; // empty -> 2DArrays allow default indexing
   size_t lev, set, set_start = 0, set_end;
-  bool partial = !set_partition.empty();
+  bool partial = !set_partition.empty(), support = support_evaluation();
+  // for local bases, locate the 1D supports containing x once for all sets
+  if (support)
+    data_rep->support_basis_values(x, level);
   for (lev=0; lev<=level; ++lev) {
     const UShort2DArray&       sm_mi_l = sm_mi[lev];
     const UShort3DArray&         key_l = colloc_key[lev];
@@ -1036,7 +1334,10 @@ value(const RealVector& x, const UShort3DArray& sm_mi,
          // coeffs may refect a partial state derived from a ref_key
       set_end = t1_coeffs_l.size();
     for (set=set_start; set<set_end; ++set)
-      approx_val +=
+      approx_val += (support) ?
+	data_rep->tensor_product_support_value(x, t1_coeffs_l[set],
+					       t2_coeffs_l[set], sm_mi_l[set],
+					       key_l[set], colloc_index) :
 	data_rep->tensor_product_value(x, t1_coeffs_l[set], t2_coeffs_l[set],
 				       sm_mi_l[set], key_l[set], colloc_index);
   }
@@ -1044,6 +1345,100 @@ value(const RealVector& x, const UShort3DArray& sm_mi,
 }
 
 
+/** Batched version of value(x): the active grid and coefficients are
+    retrieved once, the packed surpluses are traversed for each sample,
+    and for barycentric interpolation the 1D factors are computed once
+    per block and shared by all index sets. */
+void HierarchInterpPolyApproximation::
+values(const RealMatrix& samples, RealVector& approx_vals)
+{
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver = data_rep->hsg_driver();
+  const UShort3DArray&        sm_mi = hsg_driver->smolyak_multi_index();
+  const UShort4DArray&   colloc_key = hsg_driver->collocation_key();
+  const RealVector2DArray& t1_coeffs = expT1CoeffsIter->second;
+  unsigned short max_level = sm_mi.size() - 1;
+  size_t s, num_v = samples.numRows(), num_samples = samples.numCols();
+
+  if (data_rep->barycentricFlag) {
+    // 1D barycentric factors are computed once per level and variable for
+    // the block of samples and shared by all index sets
+    if (approx_vals.length() != num_samples)
+      approx_vals.size(num_samples); // init to 0
+    else
+      approx_vals = 0.;
+    data_rep->barycentric_value_factors(samples);
+    SizetArray colloc_index; // empty -> default indexing
+    size_t lev, set, num_sets;
+    for (lev=0; lev<=max_level; ++lev) {
+      const RealVectorArray& t1_coeffs_l = t1_coeffs[lev];
+      num_sets = t1_coeffs_l.size();
+      for (set=0; set<num_sets; ++set)
+	data_rep->tensor_product_values(t1_coeffs_l[set], sm_mi[lev][set],
+					colloc_key[lev][set], colloc_index, 1.,
+					approx_vals);
+    }
+    return;
+  }
+
+  if (approx_vals.length() != num_samples)
+    approx_vals.sizeUninitialized(num_samples);
+  HierarchSurplusArray& surp_array = surplus_array();
+  for (s=0; s<num_samples; ++s) {
+    RealVector x(Teuchos::View, const_cast<Real*>(samples[s]), num_v);
+    approx_vals[s] = surp_array.value(x, data_rep->polynomialBasis);
+  }
+}
+
+
+/** The packed array is rebuilt from the level/set arrays of the active
+    expansion after any change to its coefficients (see
+    clear_surplus_array()) or to the active key. */
+HierarchSurplusArray& HierarchInterpPolyApproximation::surplus_array()
+{
+  const ActiveKey& key = expT1CoeffsIter->first;
+  if (!surplusArray.empty() && surplusArrayKey == key)
+    return surplusArray;
+
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver = data_rep->hsg_driver();
+  surplusArray.pack(hsg_driver->smolyak_multi_index(),
+		    hsg_driver->collocation_key(), expT1CoeffsIter->second,
+		    expT2CoeffsIter->second, expT1CoeffGradsIter->second,
+		    hsg_driver->type1_hierarchical_weight_sets(),
+		    hsg_driver->type2_hierarchical_weight_sets());
+  surplusArrayKey = key.interned();
+  return surplusArray;
+}
+
+
+/** Surplus-driven marking for point-local refinement: for a
+    discontinuous response, large surpluses concentrate near the
+    discontinuity, such that only the points in its vicinity are
+    refined.  Candidates from multiple QoI may be concatenated, since
+    duplicate and previously refined points are skipped by the driver. */
+void HierarchInterpPolyApproximation::
+local_refinement_candidates(Real surplus_tol, Sizet2DArray& refine_pts)
+{
+  const RealVector2DArray& t1_coeffs = expT1CoeffsIter->second;
+  size_t lev, num_lev = t1_coeffs.size(), set, num_sets, pt, num_tp_pts;
+  SizetArray ref_pt(3);
+  for (lev=0; lev<num_lev; ++lev) {
+    const RealVectorArray& t1_coeffs_l = t1_coeffs[lev];
+    num_sets = t1_coeffs_l.size();  ref_pt[0] = lev;
+    for (set=0; set<num_sets; ++set) {
+      const RealVector& t1_coeffs_ls = t1_coeffs_l[set];
+      num_tp_pts = t1_coeffs_ls.length();  ref_pt[1] = set;
+      for (pt=0; pt<num_tp_pts; ++pt)
+	if (std::abs(t1_coeffs_ls[pt]) > surplus_tol)
+	  { ref_pt[2] = pt;  refine_pts.push_back(ref_pt); }
+    }
+  }
+}
+
+
 /** All variables version. */
 Real HierarchInterpPolyApproximation::
 value(const RealVector& x, const UShort3DArray& sm_mi,
@@ -1308,7 +1703,7 @@ Real HierarchInterpPolyApproximation::mean()
   if (use_tracker && (primaryMeanIter->second & 1))
     return primaryMomIter->second[0];
 
-  Real mean = expectation(expT1CoeffsIter->second, expT2CoeffsIter->second);
+  Real mean = surplus_array().expectation();
 
   if (use_tracker)
     { primaryMomIter->second[0] = mean; primaryMeanIter->second |= 1; }
@@ -1411,7 +1806,7 @@ const RealVector& HierarchInterpPolyApproximation::mean_gradient()
     return primaryMomGradsIter->second[0];
 
   RealVector& mean_grad = primaryMomGradsIter->second[0];
-  mean_grad = expectation_gradient(expT1CoeffGradsIter->second);
+  surplus_array().expectation_gradient(mean_grad);
 
   // In the case of returning a grad reference, we unconditionally update shared
   // moment storage, but protect its reuse through bit tracker deactivation
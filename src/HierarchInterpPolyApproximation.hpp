@@ -18,6 +18,7 @@
 #include "InterpPolyApproximation.hpp"
 #include "SharedHierarchInterpPolyApproxData.hpp"
 #include "HierarchSparseGridDriver.hpp"
+#include "HierarchSurplusArray.hpp"
 
 namespace Pecos {
 
@@ -44,6 +45,32 @@ public:
   /// destructor
   ~HierarchInterpPolyApproximation();
 
+  //
+  //- Heading: Member functions
+  //
+
+  /// evaluate the active expansion at a set of samples (variables x
+  /// samples), returning one value per sample
+  void values(const RealMatrix& samples, RealVector& approx_vals);
+
+  /// identify the collocation points whose hierarchical surpluses exceed
+  /// surplus_tol in magnitude, returning their {level,set,point} indices
+  /// for HierarchSparseGridDriver::compute_local_refinement()
+  void local_refinement_candidates(Real surplus_tol, Sizet2DArray& refine_pts);
+
+  /// return poppedExpT1Coeffs
+  const std::map<ActiveKey, RealVectorDequeArray>&
+    popped_type1_coefficients_map() const;
+  /// return poppedExpT2Coeffs
+  const std::map<ActiveKey, RealMatrixDequeArray>&
+    popped_type2_coefficients_map() const;
+  /// return poppedProdType1Coeffs
+  const std::map<ActiveKey, std::map<PolynomialApproximation*,
+    RealVectorDequeArray> >& popped_product_type1_coefficients_map() const;
+  /// return poppedProdType2Coeffs
+  const std::map<ActiveKey, std::map<PolynomialApproximation*,
+    RealMatrixDequeArray> >& popped_product_type2_coefficients_map() const;
+
 protected:
 
   //
@@ -385,8 +412,6 @@ private:
     const std::map<ActiveKey, UShort2DArray>& ref_key_map,
     const std::map<ActiveKey, UShort2DArray>& incr_key_map);
 
-  /// shared logic for handling exceptional cases
-  Real beta_map(Real mu, Real var, bool cdf_flag, Real z_bar);
   /// shared logic for handling exceptional cases
   Real delta_beta_map(Real mu0, Real delta_mu, Real var0, Real delta_sigma,
 		      bool cdf_flag, Real z_bar);
@@ -601,6 +626,42 @@ private:
   /// for a single index_set
   void increment_coefficients(const UShortArray& index_set);
 
+  /// returns true if evaluation can be restricted to the hierarchical
+  /// points whose (local) supports contain the evaluation point
+  bool support_evaluation();
+
+  /// returns true if the active expansion is evaluated from surplusArray
+  /// (barycentric interpolation retains its own accumulation)
+  bool packed_evaluation();
+  /// return surplusArray, packing the active expansion if required
+  HierarchSurplusArray& surplus_array();
+  /// invalidate surplusArray
+  void clear_surplus_array();
+
+  /// returns true if hierarchical surpluses can be computed by successive
+  /// 1D transforms (nested grid without type2 interpolation)
+  bool unidirectional_hierarchization();
+  /// compute expansion{Type1Coeffs,Type1CoeffGrads} for the full grid by
+  /// unidirectional hierarchization of the nodal response data
+  void hierarchize_coefficients(const UShort3DArray& sm_mi,
+				const UShort4DArray& colloc_key,
+				const Sizet3DArray&  colloc_index,
+				const SDRArray& sdr_array);
+  /// convert nodal values to hierarchical surpluses (hierarchize = true)
+  /// or surpluses to nodal values (hierarchize = false) in place, one
+  /// variable at a time; pt_data is (data values x points)
+  void unidirectional_transform(const UShort2DArray& pt_levels,
+				const UShort2DArray& pt_keys,
+				RealMatrix& pt_data, bool hierarchize);
+  /// apply the 1D transform along variable v to a strided subset of the
+  /// points of level l in v (see unidirectional_transform())
+  void unidirectional_update(size_t thread, size_t num_threads, size_t v,
+    unsigned short l, const SizetArray& pts_l, const UShort2DArray& pt_levels,
+    const UShort2DArray& pt_keys,
+    const boost::unordered_map<UShortArray, size_t>& pt_map,
+    const UShort2DArray& delta_keys, const RealVectorArray& basis_l,
+    bool hierarchize, RealMatrix& pt_data, size_t& num_missing);
+
   /// increment coefficients of product interpolants
   void increment_products(const UShort2DArray& set_partition = UShort2DArray());
 
@@ -783,6 +844,15 @@ private:
 
   /// array of pointers to the set of QoI used in covariance calculations
   std::set<PolynomialApproximation*> covariancePointers;
+
+  /// contiguous surpluses and hierarchical weights of the active
+  /// expansion, used for its value, gradients, and mean over the full
+  /// grid (the level/set arrays above remain the reference for grid
+  /// increments, decrements, and partial states); this duplicates the
+  /// active surpluses and weights until clear_surplus_array()
+  HierarchSurplusArray surplusArray;
+  /// active key of the expansion packed within surplusArray
+  ActiveKey surplusArrayKey;
 };
 
 
@@ -827,7 +897,7 @@ update_active_iterators(const ActiveKey& key)
   primaryDeltaMeanIter = primaryDeltaMean.find(key);
   primaryDeltaVarIter  = primaryDeltaVariance.find(key);
 
-  // share 1 deep copy of current active key
+  // share 1 interned (deep) copy of current active key
   ActiveKey key_copy;
   if (expT1CoeffsIter      == expansionType1Coeffs.end() ||
       expT2CoeffsIter      == expansionType2Coeffs.end() ||
@@ -840,7 +910,7 @@ update_active_iterators(const ActiveKey& key)
       primaryDeltaMomIter  == primaryDeltaMoments.end() ||
       primaryDeltaMeanIter == primaryDeltaMean.end()    ||
       primaryDeltaVarIter  == primaryDeltaVariance.end())
-    key_copy = key.copy();
+    key_copy = key.interned();
 
   if (expT1CoeffsIter == expansionType1Coeffs.end()) {
     std::pair<ActiveKey, RealVector2DArray>
@@ -913,6 +983,31 @@ inline bool HierarchInterpPolyApproximation::product_interpolants()
 }
 
 
+/** Piecewise bases have local support, such that only O(1) points per
+    level and variable contribute at any x.  Type2 interpolants are
+    evaluated using the full tensor-product traversal. */
+inline bool HierarchInterpPolyApproximation::support_evaluation()
+{
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  return (data_rep->basisConfigOptions.piecewiseBasis &&
+	  !data_rep->basisConfigOptions.useDerivs &&
+	  data_rep->hsg_driver()->nested_grid());
+}
+
+
+/** The hierarchical collocation key is only defined for nested grids.
+    Type2 interpolants omit the mixed derivative terms, such that the
+    Hermite basis is not a tensor product of 1D hierarchization operators. */
+inline bool HierarchInterpPolyApproximation::unidirectional_hierarchization()
+{
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  return (data_rep->hsg_driver()->nested_grid() &&
+	  !data_rep->basisConfigOptions.useDerivs);
+}
+
+
 inline void HierarchInterpPolyApproximation::
 initialize_covariance(PolynomialApproximation* poly_approx_2)
 {
@@ -928,6 +1023,28 @@ inline void HierarchInterpPolyApproximation::clear_covariance_pointers()
 { covariancePointers.clear(); }
 
 
+inline const std::map<ActiveKey, RealVectorDequeArray>&
+HierarchInterpPolyApproximation::popped_type1_coefficients_map() const
+{ return poppedExpT1Coeffs; }
+
+
+inline const std::map<ActiveKey, RealMatrixDequeArray>&
+HierarchInterpPolyApproximation::popped_type2_coefficients_map() const
+{ return poppedExpT2Coeffs; }
+
+
+inline const std::map<ActiveKey, std::map<PolynomialApproximation*,
+  RealVectorDequeArray> >& HierarchInterpPolyApproximation::
+popped_product_type1_coefficients_map() const
+{ return poppedProdType1Coeffs; }
+
+
+inline const std::map<ActiveKey, std::map<PolynomialApproximation*,
+  RealMatrixDequeArray> >& HierarchInterpPolyApproximation::
+popped_product_type2_coefficients_map() const
+{ return poppedProdType2Coeffs; }
+
+
 inline void HierarchInterpPolyApproximation::clear_reference_active_bits()
 { primaryRefMeanIter->second = primaryRefVarIter->second = 0; }
 
@@ -977,6 +1094,19 @@ inline void HierarchInterpPolyApproximation::clear_computed_bits()
   clear_reference_bits();
   clear_delta_bits();
   clear_current_bits();
+  clear_surplus_array();
+}
+
+
+inline void HierarchInterpPolyApproximation::clear_surplus_array()
+{ surplusArray.clear(); }
+
+
+inline bool HierarchInterpPolyApproximation::packed_evaluation()
+{
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  return !data_rep->barycentricFlag;
 }
 
 
@@ -1001,7 +1131,7 @@ inline void HierarchInterpPolyApproximation::increment_reference_to_current()
   if ( (combinedMeanBits & 1) || (combinedVarBits & 1) )
     combinedRefMoments = combinedMoments;
 
-  clear_current_bits(); clear_delta_bits();
+  clear_current_bits(); clear_delta_bits(); clear_surplus_array();
 }
 
 
@@ -1027,6 +1157,7 @@ inline void HierarchInterpPolyApproximation::decrement_current_to_reference()
     combinedMoments = combinedRefMoments;
 
   clear_delta_bits(); // clear delta bits, but retain reference
+  clear_surplus_array();
 }
 
 
@@ -1187,19 +1318,6 @@ central_product_gradient_interpolant(
 }
 
 
-inline Real HierarchInterpPolyApproximation::
-beta_map(Real mu, Real var, bool cdf_flag, Real z_bar)
-{
-  if (var > 0.) {
-    Real stdev = std::sqrt(var);
-    return (cdf_flag) ? (mu - z_bar)/stdev : (z_bar - mu)/stdev;
-  }
-  else
-    return ( (cdf_flag && mu <= z_bar) || (!cdf_flag && mu > z_bar) ) ?
-      Pecos::LARGE_NUMBER : -Pecos::LARGE_NUMBER;
-}
-
-
 inline Real HierarchInterpPolyApproximation::beta(bool cdf_flag, Real z_bar)
 { return beta_map(mean(), variance(), cdf_flag, z_bar); }
 
@@ -1447,6 +1565,14 @@ inline Real HierarchInterpPolyApproximation::value(const RealVector& x)
 {
   std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
     std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  if (packed_evaluation()) {
+    if (!expansionCoeffFlag) {
+      PCerr << "Error: expansion coefficients not defined in "
+	    << "HierarchInterpPolyApproximation::value()" << std::endl;
+      abort_handler(-1);
+    }
+    return surplus_array().value(x, data_rep->polynomialBasis);
+  }
   std::shared_ptr<HierarchSparseGridDriver> hsg_driver = data_rep->hsg_driver();
   const UShort3DArray& sm_mi = hsg_driver->smolyak_multi_index();
   unsigned short   max_level = sm_mi.size() - 1;
@@ -1460,6 +1586,15 @@ gradient_basis_variables(const RealVector& x)
 {
   std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
     std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  if (packed_evaluation()) {
+    if (!expansionCoeffFlag) {
+      PCerr << "Error: expansion coefficients not defined in HierarchInterp"
+	    << "PolyApproximation::gradient_basis_variables()" << std::endl;
+      abort_handler(-1);
+    }
+    surplus_array().gradient(x, data_rep->polynomialBasis, approxGradient);
+    return approxGradient;
+  }
   std::shared_ptr<HierarchSparseGridDriver> hsg_driver = data_rep->hsg_driver();
   const UShort3DArray& sm_mi = hsg_driver->smolyak_multi_index();
   unsigned short   max_level = sm_mi.size() - 1;
@@ -1488,6 +1623,17 @@ gradient_nonbasis_variables(const RealVector& x)
 {
   std::shared_ptr<SharedHierarchInterpPolyApproxData> data_rep =
     std::static_pointer_cast<SharedHierarchInterpPolyApproxData>(sharedDataRep);
+  if (packed_evaluation()) {
+    if (!expansionCoeffGradFlag) {
+      PCerr << "Error: expansion coefficient gradients not defined in Hierarch"
+	    << "InterpPolyApproximation::gradient_nonbasis_variables()"
+	    << std::endl;
+      abort_handler(-1);
+    }
+    surplus_array().coefficient_gradient_values(x, data_rep->polynomialBasis,
+						approxGradient);
+    return approxGradient;
+  }
   std::shared_ptr<HierarchSparseGridDriver> hsg_driver = data_rep->hsg_driver();
   const UShort3DArray& sm_mi = hsg_driver->smolyak_multi_index();
   unsigned short   max_level = sm_mi.size() - 1;
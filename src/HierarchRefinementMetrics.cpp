@@ -0,0 +1,261 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 HierarchRefinementMetrics
+//- Description: Implementation code for HierarchRefinementMetrics class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "HierarchRefinementMetrics.hpp"
+#include "HierarchInterpPolyApproximation.hpp"
+#include <thread>
+
+namespace Pecos {
+
+void HierarchRefinementMetrics::
+compute(const SharedBasisApproxData& shared_data,
+	const std::vector<BasisApproximation>& poly_approxs, bool variance,
+	bool full_covariance)
+{
+  numQoI = poly_approxs.size();
+  deltaVariance = variance;  deltaCovariance = full_covariance;
+  candidateSets.clear();  candidateLevels.clear();  candidatePositions.clear();
+  if (!numQoI) {
+    referenceMeans.resize(0);  deltaMeans.shape(0, 0);
+    deltaVariances.shape(0, 0);  deltaCovariances.clear();
+    return;
+  }
+
+  size_t q, q2, lev, num_lev, p, num_pop;
+  std::vector<HierarchInterpPolyApproximation*> hip_approxs(numQoI);
+  for (q=0; q<numQoI; ++q) {
+    hip_approxs[q] = dynamic_cast<HierarchInterpPolyApproximation*>
+      (poly_approxs[q].approx_rep().get());
+    if (!hip_approxs[q]) {
+      PCerr << "Error: hierarchical interpolation required for QoI " << q
+	    << " in HierarchRefinementMetrics::compute()." << std::endl;
+      abort_handler(-1);
+    }
+  }
+  std::shared_ptr<SharedPolyApproxData> data_rep =
+    std::dynamic_pointer_cast<SharedHierarchInterpPolyApproxData>
+    (shared_data.data_rep());
+  if (!data_rep) {
+    PCerr << "Error: hierarchical interpolation shared data required in "
+	  << "HierarchRefinementMetrics::compute()." << std::endl;
+    abort_handler(-1);
+  }
+  const ExpansionConfigOptions& ec_options
+    = data_rep->expansion_configuration_options();
+  if (ec_options.refineControl != DIMENSION_ADAPTIVE_CONTROL_GENERALIZED ||
+      ec_options.refineStatsType == COMBINED_EXPANSION_STATS ||
+      !data_rep->non_random_indices().empty()) {
+    PCerr << "Error: HierarchRefinementMetrics::compute() supports active "
+	  << "expansion statistics in standard mode for generalized "
+	  << "refinement." << std::endl;
+    abort_handler(-1);
+  }
+
+  // The candidates are the popped index sets of the active key, ordered
+  // by level and then by their position within the popped data
+  const ActiveKey& key = data_rep->active_key();
+  bool use_derivs = data_rep->basis_configuration_options().useDerivs;
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver =
+    std::static_pointer_cast<HierarchSparseGridDriver>
+    (data_rep->integration_driver_rep());
+  const UShortArrayDequeArray& pop_mi = hsg_driver->popped_level_multi_index();
+  poppedT1Wts = &hsg_driver->popped_type1_weight_sets();
+  poppedT2Wts = (use_derivs) ? &hsg_driver->popped_type2_weight_sets()
+                             : nullptr;
+  num_lev = pop_mi.size();
+  for (lev=0; lev<num_lev; ++lev) {
+    const UShortArrayDeque& pop_mi_l = pop_mi[lev];
+    num_pop = pop_mi_l.size();
+    for (p=0; p<num_pop; ++p) {
+      candidateSets.push_back(pop_mi_l[p]);
+      candidateLevels.push_back(lev);  candidatePositions.push_back(p);
+    }
+  }
+  size_t c, num_cand = candidateSets.size();
+
+  // Reference means are shared by all candidates.  They are computed
+  // serially, since mean() updates the moment trackers of each QoI.
+  referenceMeans.sizeUninitialized(numQoI);
+  for (q=0; q<numQoI; ++q)
+    referenceMeans[q] = static_cast<PolynomialApproximation*>
+      (hip_approxs[q])->mean();
+
+  // Locate the popped surpluses serially, such that the threaded sweep
+  // only reads from the popped data
+  poppedT1Coeffs.assign(numQoI, nullptr);
+  poppedT2Coeffs.assign(numQoI, nullptr);
+  for (q=0; q<numQoI; ++q) {
+    const std::map<ActiveKey, RealVectorDequeArray>& pop_t1c
+      = hip_approxs[q]->popped_type1_coefficients_map();
+    std::map<ActiveKey, RealVectorDequeArray>::const_iterator t1_it
+      = pop_t1c.find(key);
+    if (t1_it != pop_t1c.end())
+      poppedT1Coeffs[q] = &t1_it->second;
+    if (use_derivs) {
+      const std::map<ActiveKey, RealMatrixDequeArray>& pop_t2c
+	= hip_approxs[q]->popped_type2_coefficients_map();
+      std::map<ActiveKey, RealMatrixDequeArray>::const_iterator t2_it
+	= pop_t2c.find(key);
+      if (t2_it != pop_t2c.end())
+	poppedT2Coeffs[q] = &t2_it->second;
+    }
+    if ( num_cand && ( !poppedT1Coeffs[q] ||
+	 ( use_derivs && !poppedT2Coeffs[q] ) ) ) {
+      PCerr << "Error: popped coefficients not available for QoI " << q
+	    << " in HierarchRefinementMetrics::compute()." << std::endl;
+      abort_handler(-1);
+    }
+  }
+  poppedProdT1Coeffs.assign(numQoI * numQoI, nullptr);
+  poppedProdT2Coeffs.assign(numQoI * numQoI, nullptr);
+  if (num_cand && (deltaVariance || deltaCovariance))
+    for (q=0; q<numQoI; ++q)
+      for (q2=q; q2<numQoI; ++q2)
+	if (q2 == q || deltaCovariance)
+	  product_coefficients(hip_approxs[q], hip_approxs[q2], key,
+	    use_derivs, poppedProdT1Coeffs[q * numQoI + q2],
+	    poppedProdT2Coeffs[q * numQoI + q2]);
+
+  deltaMeans.shapeUninitialized(numQoI, num_cand);
+  if (deltaVariance) deltaVariances.shapeUninitialized(numQoI, num_cand);
+  else               deltaVariances.shape(0, 0);
+  deltaCovariances.resize((deltaCovariance) ? num_cand : 0);
+  for (c=0; c<deltaCovariances.size(); ++c)
+    deltaCovariances[c].shapeUninitialized(numQoI);
+
+  size_t num_threads = (maxThreads) ? maxThreads :
+    std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::max((size_t)1, std::min(num_threads, num_cand));
+  if (num_threads == 1)
+    candidate_statistics(0, 1);
+  else {
+    std::vector<std::thread> threads;  threads.reserve(num_threads);
+    for (size_t t=0; t<num_threads; ++t)
+      threads.push_back(std::thread(
+	&HierarchRefinementMetrics::candidate_statistics, this, t,
+	num_threads));
+    for (size_t t=0; t<num_threads; ++t)
+      threads[t].join();
+  }
+}
+
+
+void HierarchRefinementMetrics::
+product_coefficients(HierarchInterpPolyApproximation* hip_approx_1,
+		     HierarchInterpPolyApproximation* hip_approx_2,
+		     const ActiveKey& key, bool use_derivs,
+		     const RealVectorDequeArray*& prod_t1c,
+		     const RealMatrixDequeArray*& prod_t2c) const
+{
+  // the product interpolant of a pair is stored by either member
+  prod_t1c = nullptr;  prod_t2c = nullptr;
+  HierarchInterpPolyApproximation* hip_pair[2] = { hip_approx_1, hip_approx_2 };
+  for (size_t i=0; i<2 && !prod_t1c; ++i) {
+    HierarchInterpPolyApproximation *hip_a = hip_pair[i],
+      *hip_b = hip_pair[1-i];
+    const std::map<ActiveKey, std::map<PolynomialApproximation*,
+      RealVectorDequeArray> >& pop_prod_t1c
+      = hip_a->popped_product_type1_coefficients_map();
+    std::map<ActiveKey, std::map<PolynomialApproximation*,
+      RealVectorDequeArray> >::const_iterator k1_it = pop_prod_t1c.find(key);
+    if (k1_it == pop_prod_t1c.end()) continue;
+    std::map<PolynomialApproximation*, RealVectorDequeArray>::const_iterator
+      p1_it = k1_it->second.find(hip_b);
+    if (p1_it == k1_it->second.end()) continue;
+    prod_t1c = &p1_it->second;
+    if (use_derivs) {
+      const std::map<ActiveKey, std::map<PolynomialApproximation*,
+	RealMatrixDequeArray> >& pop_prod_t2c
+	= hip_a->popped_product_type2_coefficients_map();
+      std::map<ActiveKey, std::map<PolynomialApproximation*,
+	RealMatrixDequeArray> >::const_iterator k2_it = pop_prod_t2c.find(key);
+      if (k2_it != pop_prod_t2c.end()) {
+	std::map<PolynomialApproximation*, RealMatrixDequeArray>::
+	  const_iterator p2_it = k2_it->second.find(hip_b);
+	if (p2_it != k2_it->second.end())
+	  prod_t2c = &p2_it->second;
+      }
+    }
+  }
+  if (!prod_t1c || (use_derivs && !prod_t2c)) {
+    PCerr << "Error: product interpolants not available in HierarchRefinement"
+	  << "Metrics::compute().\n       Delta variances require a covariance "
+	  << "or mixed statistics refinement metric." << std::endl;
+    abort_handler(-1);
+  }
+}
+
+
+Real HierarchRefinementMetrics::
+expectation(const RealVectorDequeArray& t1_coeffs,
+	    const RealMatrixDequeArray* t2_coeffs, size_t c) const
+{
+  size_t lev = candidateLevels[c], p = candidatePositions[c], pt, num_pts, v;
+  const RealVector& t1c = t1_coeffs[lev][p];
+  const RealVector& t1w = (*poppedT1Wts)[lev][p];
+  num_pts = t1c.length();
+  Real integral = 0.;
+  for (pt=0; pt<num_pts; ++pt) // omitted if empty surplus vector
+    integral += t1c[pt] * t1w[pt];
+  if (t2_coeffs) {
+    const RealMatrix& t2c = (*t2_coeffs)[lev][p];
+    const RealMatrix& t2w = (*poppedT2Wts)[lev][p];
+    size_t num_v = t2c.numRows();
+    for (pt=0; pt<num_pts; ++pt) {
+      const Real* t2c_p = t2c[pt];  const Real* t2w_p = t2w[pt];
+      for (v=0; v<num_v; ++v)
+	integral += t2c_p[v] * t2w_p[v];
+    }
+  }
+  return integral;
+}
+
+
+/** Each thread computes all statistics of its candidates, such that
+    threads write disjoint columns of the results.  The hierarchical
+    increments follow HierarchInterpPolyApproximation::delta_covariance():
+    \Delta\Sigma_ij = \DeltaE[Ri Rj] - \Delta\mu_i \mu_j^0 - \mu_i^0
+    \Delta\mu_j - \Delta\mu_i \Delta\mu_j. */
+void HierarchRefinementMetrics::
+candidate_statistics(size_t thread, size_t num_threads)
+{
+  size_t c, num_cand = candidateSets.size(), q, q2, pair;
+  Real d_mu_q, d_mu_q2, mu_q, mu_q2, d_cov;
+  for (c=thread; c<num_cand; c+=num_threads) {
+    Real* d_means_c = deltaMeans[c];
+    for (q=0; q<numQoI; ++q)
+      d_means_c[q] = expectation(*poppedT1Coeffs[q], poppedT2Coeffs[q], c);
+
+    if (!deltaVariance && !deltaCovariance)
+      continue;
+    for (q=0; q<numQoI; ++q) {
+      d_mu_q = d_means_c[q];  mu_q = referenceMeans[q];
+      for (q2=q; q2<numQoI; ++q2) {
+	if (q2 != q && !deltaCovariance)
+	  break;
+	d_mu_q2 = d_means_c[q2];  mu_q2 = referenceMeans[q2];
+	pair = q * numQoI + q2;
+	d_cov = expectation(*poppedProdT1Coeffs[pair],
+			    poppedProdT2Coeffs[pair], c)
+	  - d_mu_q * mu_q2 - mu_q * d_mu_q2 - d_mu_q * d_mu_q2;
+	if (q2 == q && deltaVariance)
+	  deltaVariances(q, c) = d_cov;
+	if (deltaCovariance)
+	  deltaCovariances[c](q, q2) = d_cov;
+      }
+    }
+  }
+}
+
+} // namespace Pecos
@@ -0,0 +1,196 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 HierarchRefinementMetrics
+//- Description: Batched delta statistics for hierarchical refinement
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef HIERARCH_REFINEMENT_METRICS_HPP
+#define HIERARCH_REFINEMENT_METRICS_HPP
+
+#include "pecos_data_types.hpp"
+#include "BasisApproximation.hpp"
+#include "SharedBasisApproxData.hpp"
+#include "ActiveKey.hpp"
+
+namespace Pecos {
+
+class HierarchInterpPolyApproximation;
+
+
+/// Evaluation of the delta statistics of all candidate index sets of
+/// a generalized sparse grid refinement for a set of QoI.
+
+/** During generalized dimension-adaptive refinement, each evaluated
+    candidate index set is popped from the grid together with its
+    hierarchical weights, the surpluses of each QoI, and the surpluses
+    of any product interpolants.  Scoring a candidate one at a time
+    restores it, computes delta_mean() and delta_covariance() for each
+    QoI, and pops it again.  Here the statistics increments of all
+    available candidates are instead computed in one sweep directly
+    from the popped data: the reference means are computed once per QoI
+    and shared by all candidates, and the candidates are distributed
+    among threads.  The increments match those of the restore/score/pop
+    sequence for active expansion statistics in standard (all random)
+    mode.  Delta variances and covariances require the product
+    interpolants maintained for COVARIANCE_METRIC and MIXED_STATS_METRIC
+    refinement. */
+
+class HierarchRefinementMetrics
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  HierarchRefinementMetrics();
+  /// destructor
+  ~HierarchRefinementMetrics();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// compute the delta statistics of the popped candidate index sets of
+  /// the active key for each hierarchical approximation in poly_approxs,
+  /// which share shared_data; delta variances are computed if variance
+  /// is set and the delta covariance matrices if full_covariance is set
+  void compute(const SharedBasisApproxData& shared_data,
+	       const std::vector<BasisApproximation>& poly_approxs,
+	       bool variance = true, bool full_covariance = false);
+
+  /// set the maximum number of threads (0 for the hardware concurrency)
+  void max_threads(size_t num_threads);
+
+  /// return the number of candidate index sets
+  size_t num_candidates() const;
+  /// return the c-th candidate index set
+  const UShortArray& candidate(size_t c) const;
+  /// return the (QoI x candidates) delta means
+  const RealMatrix& delta_means() const;
+  /// return the (QoI x candidates) delta variances
+  const RealMatrix& delta_variances() const;
+  /// return the (QoI x QoI) delta covariance of each candidate
+  const RealSymMatrixArray& delta_covariances() const;
+  /// return the reference means shared by the candidates
+  const RealVector& reference_means() const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// compute the statistics of candidates thread, thread + num_threads, ...
+  void candidate_statistics(size_t thread, size_t num_threads);
+
+  /// integrate the popped surpluses of candidate c
+  Real expectation(const RealVectorDequeArray& t1_coeffs,
+		   const RealMatrixDequeArray* t2_coeffs, size_t c) const;
+
+  /// locate the popped surpluses of the product interpolant of
+  /// hip_approx_1 and hip_approx_2 for the active key
+  void product_coefficients(HierarchInterpPolyApproximation* hip_approx_1,
+			    HierarchInterpPolyApproximation* hip_approx_2,
+			    const ActiveKey& key, bool use_derivs,
+			    const RealVectorDequeArray*& prod_t1c,
+			    const RealMatrixDequeArray*& prod_t2c) const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// maximum number of threads (0 for the hardware concurrency)
+  size_t maxThreads;
+
+  /// candidate index sets
+  UShort2DArray candidateSets;
+  /// level of each candidate within the popped data
+  SizetArray candidateLevels;
+  /// position of each candidate within the popped data of its level
+  SizetArray candidatePositions;
+
+  /// popped type1 weights of the active key
+  const RealVectorDequeArray* poppedT1Wts;
+  /// popped type2 weights of the active key (nullptr without derivatives)
+  const RealMatrixDequeArray* poppedT2Wts;
+  /// popped type1 surpluses of each QoI
+  std::vector<const RealVectorDequeArray*> poppedT1Coeffs;
+  /// popped type2 surpluses of each QoI (nullptr without derivatives)
+  std::vector<const RealMatrixDequeArray*> poppedT2Coeffs;
+  /// popped type1 surpluses of the product interpolant of each QoI pair,
+  /// indexed as [qoi_1 * numQoI + qoi_2] for qoi_1 <= qoi_2
+  std::vector<const RealVectorDequeArray*> poppedProdT1Coeffs;
+  /// popped type2 surpluses of the product interpolants, indexed as
+  /// poppedProdT1Coeffs
+  std::vector<const RealMatrixDequeArray*> poppedProdT2Coeffs;
+
+  /// number of QoI
+  size_t numQoI;
+  /// compute delta variances
+  bool deltaVariance;
+  /// compute delta covariance matrices
+  bool deltaCovariance;
+
+  /// reference (current grid) means of each QoI
+  RealVector referenceMeans;
+  /// (QoI x candidates) delta means
+  RealMatrix deltaMeans;
+  /// (QoI x candidates) delta variances
+  RealMatrix deltaVariances;
+  /// delta covariance matrix of each candidate
+  RealSymMatrixArray deltaCovariances;
+};
+
+
+inline HierarchRefinementMetrics::HierarchRefinementMetrics():
+  maxThreads(0), poppedT1Wts(nullptr), poppedT2Wts(nullptr), numQoI(0),
+  deltaVariance(false), deltaCovariance(false)
+{ }
+
+
+inline HierarchRefinementMetrics::~HierarchRefinementMetrics()
+{ }
+
+
+inline void HierarchRefinementMetrics::max_threads(size_t num_threads)
+{ maxThreads = num_threads; }
+
+
+inline size_t HierarchRefinementMetrics::num_candidates() const
+{ return candidateSets.size(); }
+
+
+inline const UShortArray& HierarchRefinementMetrics::
+candidate(size_t c) const
+{ return candidateSets[c]; }
+
+
+inline const RealMatrix& HierarchRefinementMetrics::delta_means() const
+{ return deltaMeans; }
+
+
+inline const RealMatrix& HierarchRefinementMetrics::delta_variances() const
+{ return deltaVariances; }
+
+
+inline const RealSymMatrixArray& HierarchRefinementMetrics::
+delta_covariances() const
+{ return deltaCovariances; }
+
+
+inline const RealVector& HierarchRefinementMetrics::reference_means() const
+{ return referenceMeans; }
+
+} // namespace Pecos
+
+#endif
@@ -62,6 +62,11 @@ void HierarchSparseGridDriver::clear_inactive()
       collocKey.erase(ck_it++);       collocIndices.erase(ci_it++);
       type1WeightSets.erase(t1_it++); type2WeightSets.erase(t2_it++);
     }
+
+  std::map<ActiveKey, HierarchPointMap>::iterator pt_it = pointTree.begin();
+  while (pt_it != pointTree.end())
+    if (pt_it->first == activeKey) ++pt_it;
+    else                           pointTree.erase(pt_it++);
 }
 
 
@@ -615,6 +620,8 @@ void HierarchSparseGridDriver::compute_grid()
 			   t2WtIter->second);
     if (trackCollocIndices)
       assign_collocation_indices();
+    if (refineControl == LOCAL_ADAPTIVE_CONTROL)
+      update_point_tree();
   }
   /*
   else {
@@ -717,43 +724,8 @@ void HierarchSparseGridDriver::compute_increment(RealMatrix& var_sets)
   update_smolyak_multi_index();
   UShortArray& incr_sets = incrSetsIter->second;
   update_collocation_key_from_increment(incr_sets);
-  size_t lev, num_lev = incr_sets.size();
   if (nestedGrid) {
-    RealMatrix2DArray&    pts = varSetsIter->second;
-    RealVector2DArray& t1_wts =    t1WtIter->second;
-    RealMatrix2DArray& t2_wts =    t2WtIter->second;
-    if (pts.size()<num_lev || t1_wts.size()<num_lev || t2_wts.size()<num_lev)
-      { pts.resize(num_lev); t1_wts.resize(num_lev); t2_wts.resize(num_lev); }
-    // compute total increment evaluations and size var_sets
-    size_t num_incr_pts = 0, set, start_set, num_sets;
-    const UShort4DArray& colloc_key = collocKeyIter->second;
-    const UShort3DArray&      sm_mi =    smolMIIter->second;
-    for (lev=0; lev<num_lev; ++lev) {
-      const UShort3DArray& key_l = colloc_key[lev];
-      start_set = incr_sets[lev]; num_sets = key_l.size();
-      for (set=start_set; set<num_sets; ++set)
-	num_incr_pts += key_l[set].size();
-    }
-    if (var_sets.numCols() != num_incr_pts)
-      var_sets.shapeUninitialized(numVars, num_incr_pts);
-    // update type1/2 weights and subset view of points
-    size_t cntr = 0, pt, num_tp_pts, v;
-    for (lev=0; lev<num_lev; ++lev) {
-      const UShort2DArray& sm_mi_l = sm_mi[lev];
-      const UShort3DArray&   key_l = colloc_key[lev];
-      start_set = incr_sets[lev]; num_sets = sm_mi_l.size();
-      RealMatrixArray&    pts_l =    pts[lev];     pts_l.resize(num_sets);
-      RealVectorArray& t1_wts_l = t1_wts[lev];  t1_wts_l.resize(num_sets);
-      RealMatrixArray& t2_wts_l = t2_wts[lev];  t2_wts_l.resize(num_sets);
-      for (set=start_set; set<num_sets; ++set) {
-	const UShort2DArray& key_ls = key_l[set]; num_tp_pts = key_ls.size();
-	RealMatrix& pts_ls = pts_l[set];
-	compute_points_weights(sm_mi_l[set], key_ls, pts_ls, t1_wts_l[set],
-			       t2_wts_l[set]);
-	for (pt=0; pt<num_tp_pts; ++pt, ++cntr)
-	  copy_data(pts_ls[pt], numVars, var_sets[cntr]);
-      }
-    }
+    increment_points_weights(incr_sets, var_sets);
     if (trackCollocIndices)
       update_collocation_indices_from_increment(incr_sets);
   }
@@ -772,8 +744,57 @@ void HierarchSparseGridDriver::compute_increment(RealMatrix& var_sets)
 }
 
 
+void HierarchSparseGridDriver::
+increment_points_weights(const UShortArray& incr_sets, RealMatrix& var_sets)
+{
+  size_t lev, num_lev = incr_sets.size();
+  RealMatrix2DArray&    pts = varSetsIter->second;
+  RealVector2DArray& t1_wts =    t1WtIter->second;
+  RealMatrix2DArray& t2_wts =    t2WtIter->second;
+  if (pts.size()<num_lev || t1_wts.size()<num_lev || t2_wts.size()<num_lev)
+    { pts.resize(num_lev); t1_wts.resize(num_lev); t2_wts.resize(num_lev); }
+  // compute total increment evaluations and size var_sets
+  size_t num_incr_pts = 0, set, start_set, num_sets;
+  const UShort4DArray& colloc_key = collocKeyIter->second;
+  const UShort3DArray&      sm_mi =    smolMIIter->second;
+  for (lev=0; lev<num_lev; ++lev) {
+    const UShort3DArray& key_l = colloc_key[lev];
+    start_set = incr_sets[lev]; num_sets = key_l.size();
+    for (set=start_set; set<num_sets; ++set)
+      num_incr_pts += key_l[set].size();
+  }
+  if (var_sets.numCols() != num_incr_pts)
+    var_sets.shapeUninitialized(numVars, num_incr_pts);
+  // update type1/2 weights and subset view of points
+  size_t cntr = 0, pt, num_tp_pts;
+  for (lev=0; lev<num_lev; ++lev) {
+    const UShort2DArray& sm_mi_l = sm_mi[lev];
+    const UShort3DArray&   key_l = colloc_key[lev];
+    start_set = incr_sets[lev]; num_sets = sm_mi_l.size();
+    RealMatrixArray&    pts_l =    pts[lev];     pts_l.resize(num_sets);
+    RealVectorArray& t1_wts_l = t1_wts[lev];  t1_wts_l.resize(num_sets);
+    RealMatrixArray& t2_wts_l = t2_wts[lev];  t2_wts_l.resize(num_sets);
+    for (set=start_set; set<num_sets; ++set) {
+      const UShort2DArray& key_ls = key_l[set]; num_tp_pts = key_ls.size();
+      RealMatrix& pts_ls = pts_l[set];
+      compute_points_weights(sm_mi_l[set], key_ls, pts_ls, t1_wts_l[set],
+			     t2_wts_l[set]);
+      for (pt=0; pt<num_tp_pts; ++pt, ++cntr)
+	copy_data(pts_ls[pt], numVars, var_sets[cntr]);
+    }
+  }
+}
+
+
 void HierarchSparseGridDriver::push_increment()
 {
+  if (refineControl == LOCAL_ADAPTIVE_CONTROL) {
+    PCerr << "Error: point-local increments are recomputed rather than "
+	  << "restored in HierarchSparseGridDriver::push_increment()."
+	  << std::endl;
+    abort_handler(-1);
+  }
+
   // update collocKey and restore variable/weight sets
 
   update_smolyak_multi_index();
@@ -825,7 +846,242 @@ void HierarchSparseGridDriver::pop_increment()
       sm_mi[lev].resize(start_set);  colloc_key[lev].resize(start_set);
       if (trackCollocIndices) colloc_ind[lev].resize(start_set);
     }
+    if (refineControl == LOCAL_ADAPTIVE_CONTROL)
+      update_point_tree();
+  }
+}
+
+
+/** Orders collocation keys consistently with SharedPolyApproxData::
+    hierarchical_tensor_product_multi_index() (first variable fastest),
+    such that a set completed by local refinement matches a full key. */
+static bool tensor_key_order(const UShortArray& a, const UShortArray& b)
+{
+  return std::lexicographical_compare(a.rbegin(), a.rend(),
+				      b.rbegin(), b.rend());
+}
+
+
+/** Point-local (spatially adaptive) refinement for piecewise bases on
+    closed nested rules: rather than adding complete index sets, each
+    marked point spawns only its hierarchical children in each variable.
+    Missing hierarchical ancestors of the children are added as well,
+    such that the grid remains closed under parents (as assumed by
+    unidirectional hierarchization).  The new points are grouped by
+    Smolyak index set and appended as partial sets at the end of each
+    level, defining incrementSets for increment_coefficients() and
+    pop_increment().
+
+    Successive increments may therefore append the same Smolyak index
+    set more than once within a level.  These repeated sets are not
+    merged: the expansion coefficients, weights and popped data are
+    positional within [level][set], such that merging would reorder
+    data already assigned to earlier sets.  Repetition is safe since
+    the sets partition distinct points (enforced by the point tree, see
+    insert_point_tree()): each hierarchical basis function is defined
+    by the levels and key of its point alone, so that interpolant and
+    moment evaluations (sums over sets of surpluses times basis values
+    or weights) count every point exactly once.  Likewise, the surplus
+    of a new point accumulates the interpolant over all dominated sets
+    at lower levels, whichever repeated set holds each ancestor, while
+    the basis functions of other sets within the same level vanish at
+    the new point. */
+void HierarchSparseGridDriver::
+compute_local_refinement(const Sizet2DArray& refine_pts, RealMatrix& var_sets)
+{
+  check_local_refinement();
+
+  UShort3DArray&      sm_mi = smolMIIter->second;
+  UShort4DArray& colloc_key = collocKeyIter->second;
+  HierarchPointMap& pt_tree = pointTree[activeKey];
+  if (pt_tree.empty()) update_point_tree();
+
+  // generate the children of the marked points along with any missing
+  // ancestors, grouped by index set
+  boost::unordered_set<UShortArray> new_ids;
+  std::map<UShortArray, UShort2DArray> new_sets;
+  size_t i, num_refine = refine_pts.size(), v, c, num_c;
+  unsigned short child_lev;  UShortArray child_keys, levels, key;
+  for (i=0; i<num_refine; ++i) {
+    const SizetArray& ref_i = refine_pts[i]; // {level, set, point}
+    const UShortArray& sm_index = sm_mi[ref_i[0]][ref_i[1]];
+    const UShortArray&   key_pt = colloc_key[ref_i[0]][ref_i[1]][ref_i[2]];
+    for (v=0; v<numVars; ++v) {
+      point_children_1d(v, sm_index[v], key_pt[v], child_lev, child_keys);
+      levels = sm_index;  levels[v] = child_lev;  key = key_pt;
+      num_c = child_keys.size();
+      for (c=0; c<num_c; ++c) {
+	key[v] = child_keys[c];
+	add_local_point(levels, key, pt_tree, new_ids, new_sets);
+      }
+    }
+  }
+
+  // append new points as trailing (partial) index sets within each level
+  UShortArray& incr_sets = incrSetsIter->second;
+  size_t lev, num_lev = sm_mi.size(), set, num_sets;
+  incr_sets.resize(num_lev);
+  for (lev=0; lev<num_lev; ++lev)
+    incr_sets[lev] = sm_mi[lev].size();
+  std::map<UShortArray, UShort2DArray>::iterator ns_it;
+  for (ns_it=new_sets.begin(); ns_it!=new_sets.end(); ++ns_it) {
+    lev = l1_norm(ns_it->first);
+    if (lev >= num_lev) {
+      num_lev = lev + 1;  incr_sets.resize(num_lev, 0);
+      sm_mi.resize(num_lev);  colloc_key.resize(num_lev);
+    }
+    UShort2DArray& key_ls = ns_it->second;
+    std::sort(key_ls.begin(), key_ls.end(), tensor_key_order);
+    sm_mi[lev].push_back(ns_it->first);  colloc_key[lev].push_back(key_ls);
   }
+
+  // add the increment to the point tree
+  for (lev=0; lev<num_lev; ++lev) {
+    num_sets = colloc_key[lev].size();
+    for (set=incr_sets[lev]; set<num_sets; ++set)
+      insert_point_tree(sm_mi[lev][set], colloc_key[lev][set], set, pt_tree);
+  }
+
+  increment_points_weights(incr_sets, var_sets);
+  if (trackCollocIndices)
+    update_collocation_indices_from_increment(incr_sets);
+  // sets beyond the isotropic level must not be regenerated by grid_size()
+  update_collocation_points();
+
+#ifdef DEBUG
+  PCout << "compute_local_refinement(): " << new_ids.size() << " new points "
+	<< "in " << new_sets.size() << " index sets\nunique variable sets:\n"
+	<< var_sets;
+#endif // DEBUG
+}
+
+
+void HierarchSparseGridDriver::check_local_refinement() const
+{
+  bool err = (!nestedGrid || computeType2Weights);
+  for (size_t i=0; i<numVars && !err; ++i) {
+    if (collocRules[i] != NEWTON_COTES && collocRules[i] != CLENSHAW_CURTIS)
+      err = true;
+    else
+      switch (polynomialBasis[i].basis_type()) {
+      case PIECEWISE_LINEAR_INTERP: case PIECEWISE_QUADRATIC_INTERP: break;
+      default: err = true;                                           break;
+      }
+  }
+  if (err) {
+    PCerr << "Error: point-local refinement requires value-based piecewise "
+	  << "interpolation on closed nested rules in HierarchSparseGrid"
+	  << "Driver::compute_local_refinement()." << std::endl;
+    abort_handler(-1);
+  }
+}
+
+
+void HierarchSparseGridDriver::update_point_tree()
+{
+  const UShort3DArray&      sm_mi = smolMIIter->second;
+  const UShort4DArray& colloc_key = collocKeyIter->second;
+  HierarchPointMap& pt_tree = pointTree[activeKey];
+  pt_tree.clear();
+  size_t lev, num_lev = colloc_key.size(), set, num_sets;
+  for (lev=0; lev<num_lev; ++lev) {
+    num_sets = colloc_key[lev].size();
+    for (set=0; set<num_sets; ++set)
+      insert_point_tree(sm_mi[lev][set], colloc_key[lev][set], set, pt_tree);
+  }
+}
+
+
+/** Index sets may repeat within a level following point-local
+    refinement (see compute_local_refinement()), but each point must be
+    held by exactly one set. */
+void HierarchSparseGridDriver::
+insert_point_tree(const UShortArray& sm_index, const UShort2DArray& key_ls,
+		  size_t set, HierarchPointMap& pt_tree)
+{
+  size_t pt, num_tp_pts = key_ls.size();
+  UShortArray pt_id;
+  for (pt=0; pt<num_tp_pts; ++pt) {
+    point_id(sm_index, key_ls[pt], pt_id);
+    if (!pt_tree.insert(std::make_pair(pt_id, SizetSizetPair(set, pt))).second)
+    {
+      PCerr << "Error: point " << pt << " of index set " << set << " is "
+	    << "already held by another set in HierarchSparseGridDriver::"
+	    << "insert_point_tree()." << std::endl;
+      abort_handler(-1);
+    }
+  }
+}
+
+
+/** For closed nested rules, the number of intervals doubles from one
+    nonempty level to the next, such that 1D point key_i maps to 2*key_i
+    and its children are the new interior points 2*key_i -/+ 1.  The
+    level 0 center point spawns the two end points of the 3 point rule. */
+void HierarchSparseGridDriver::
+point_children_1d(size_t i, unsigned short lev_i, unsigned short key_i,
+		  unsigned short& child_lev, UShortArray& child_keys)
+{
+  // skip levels that repeat the order due to growth restriction
+  child_lev = lev_i + 1;
+  while (!level_to_delta_size(i, child_lev))
+    ++child_lev;
+
+  child_keys.clear();
+  if (!lev_i)
+    { child_keys.push_back(0); child_keys.push_back(2); }
+  else {
+    unsigned short child_order, c = 2*key_i;
+    level_to_order(i, child_lev, child_order);
+    if (c)               child_keys.push_back(c-1);
+    if (c+1<child_order) child_keys.push_back(c+1);
+  }
+}
+
+
+/** The parent of a new interior point is whichever of its two neighbors
+    was introduced at the preceding nonempty level. */
+bool HierarchSparseGridDriver::
+point_parent_1d(size_t i, unsigned short lev_i, unsigned short key_i,
+		unsigned short& parent_lev, unsigned short& parent_key)
+{
+  if (!lev_i) return false; // root
+
+  parent_lev = lev_i - 1;
+  while (parent_lev && !level_to_delta_size(i, parent_lev))
+    --parent_lev;
+  if (!parent_lev)
+    { parent_key = 0; return true; }
+
+  UShortArray delta_key;  level_to_delta_key(i, parent_lev, delta_key);
+  parent_key = (key_i - 1) / 2;
+  if (!std::binary_search(delta_key.begin(), delta_key.end(), parent_key))
+    parent_key = (key_i + 1) / 2;
+  return true;
+}
+
+
+void HierarchSparseGridDriver::
+add_local_point(const UShortArray& levels, const UShortArray& key,
+		const HierarchPointMap& pt_tree,
+		boost::unordered_set<UShortArray>& new_ids,
+		std::map<UShortArray, UShort2DArray>& new_sets)
+{
+  UShortArray pt_id;  point_id(levels, key, pt_id);
+  if (pt_tree.find(pt_id) != pt_tree.end() || !new_ids.insert(pt_id).second)
+    return; // already present in grid or increment
+
+  new_sets[levels].push_back(key);
+
+  // enforce closure under the hierarchical parent in each variable
+  unsigned short parent_lev, parent_key;
+  UShortArray parent_levels, parent_pt;
+  for (size_t v=0; v<numVars; ++v)
+    if (point_parent_1d(v, levels[v], key[v], parent_lev, parent_key)) {
+      parent_levels = levels;  parent_levels[v] = parent_lev;
+      parent_pt     = key;     parent_pt[v]     = parent_key;
+      add_local_point(parent_levels, parent_pt, pt_tree, new_ids, new_sets);
+    }
 }
 
 
@@ -16,9 +16,16 @@
 #define HIERARCH_SPARSE_GRID_DRIVER_HPP
 
 #include "SparseGridDriver.hpp"
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 namespace Pecos {
 
+/// hashed lookup of hierarchical collocation points, mapping a point
+/// identifier (levels followed by 1D keys) to its {set,point} indices
+/// within level l1_norm(levels)
+typedef boost::unordered_map<UShortArray, SizetSizetPair> HierarchPointMap;
+
 
 /// Derived integration driver class that generates N-dimensional
 /// Smolyak sparse grids for numerical evaluation of expectation
@@ -154,6 +161,18 @@ public:
   void update_collocation_points(const UShort4DArray& colloc_key,
 				 int& num_colloc_pts);
 
+  /// append the hierarchical children of the points identified by
+  /// {level,set,point} indices within refine_pts, along with any missing
+  /// hierarchical ancestors, as a point-local refinement increment
+  void compute_local_refinement(const Sizet2DArray& refine_pts,
+				RealMatrix& var_sets);
+  /// locate a point within the active grid from its Smolyak index set and
+  /// collocation key, returning its {set,point} indices within its level
+  bool find_point(const UShortArray& levels, const UShortArray& key,
+		  SizetSizetPair& set_pt);
+  /// return active entry in pointTree
+  const HierarchPointMap& point_tree();
+
   /// return active entry in incrementSets
   const UShortArray& increment_sets() const;
 
@@ -176,6 +195,9 @@ public:
   /// get trackCollocIndices
   bool track_collocation_indices() const;
 
+  /// return nestedGrid
+  bool nested_grid() const;
+
   /// return active entry in collocKey
   const UShort4DArray& collocation_key() const;
   /// set active entry in collocKey
@@ -273,6 +295,13 @@ public:
   /// return combinedT2WeightSets
   const RealMatrix2DArray& combined_type2_hierarchical_weight_sets() const;
 
+  /// return poppedLevMultiIndex for the active key
+  const UShortArrayDequeArray& popped_level_multi_index();
+  /// return poppedT1WtSets for the active key
+  const RealVectorDequeArray& popped_type1_weight_sets();
+  /// return poppedT2WtSets for the active key
+  const RealMatrixDequeArray& popped_type2_weight_sets();
+
 private:
 
   //
@@ -288,6 +317,38 @@ private:
   /// moves all data from popped points/weights to active arrays
   void push_popped_points_weights();
 
+  /// compute points and weights for the trailing index sets identified by
+  /// incr_sets and return the increment points within var_sets
+  void increment_points_weights(const UShortArray& incr_sets,
+				RealMatrix& var_sets);
+
+  /// form the pointTree identifier from a Smolyak index set and a key
+  void point_id(const UShortArray& levels, const UShortArray& key,
+		UShortArray& pt_id) const;
+  /// rebuild the active pointTree from smolyakMultiIndex and collocKey
+  void update_point_tree();
+  /// add the points of an index set to pt_tree, aborting if a point is
+  /// already held by another set
+  void insert_point_tree(const UShortArray& sm_index,
+			 const UShort2DArray& key_ls, size_t set,
+			 HierarchPointMap& pt_tree);
+  /// verify that point-local refinement is supported by the 1D rules
+  void check_local_refinement() const;
+  /// return the level and keys of the hierarchical children of 1D point
+  /// key_i at level lev_i for variable i
+  void point_children_1d(size_t i, unsigned short lev_i, unsigned short key_i,
+			 unsigned short& child_lev, UShortArray& child_keys);
+  /// return the level and key of the hierarchical parent of 1D point
+  /// key_i at level lev_i for variable i (false for the level 0 root)
+  bool point_parent_1d(size_t i, unsigned short lev_i, unsigned short key_i,
+		       unsigned short& parent_lev, unsigned short& parent_key);
+  /// add a point that is not yet in the grid, along with its missing
+  /// hierarchical ancestors, to the sets of a local refinement increment
+  void add_local_point(const UShortArray& levels, const UShortArray& key,
+		       const HierarchPointMap& pt_tree,
+		       boost::unordered_set<UShortArray>& new_ids,
+		       std::map<UShortArray, UShort2DArray>& new_sets);
+
   /// kernel routine used for computing points and weights for a tensor grid
   /// corresponding to a single index set
   void compute_points_weights(const UShortArray& sm_index,
@@ -398,6 +459,12 @@ private:
   /// type 2 weight sets popped during decrement for later restoration to
   /// type2WeightSets
   std::map<ActiveKey, RealMatrixDequeArray> poppedT2WtSets;
+
+  /// hash-based point tree supporting point-local refinement: each point
+  /// in the active grid is mapped to its {set,point} indices within its
+  /// level, such that hierarchical children and ancestors are found in
+  /// constant time (maintained for LOCAL_ADAPTIVE_CONTROL)
+  std::map<ActiveKey, HierarchPointMap> pointTree;
 };
 
 
@@ -446,7 +513,7 @@ inline void HierarchSparseGridDriver::update_active_iterators()
       varSetsIter   == variableSets.end()      ||
       t1WtIter      == type1WeightSets.end()   ||
       t2WtIter      == type2WeightSets.end())
-    active_copy = activeKey.copy();
+    active_copy = activeKey.interned();
   */
 
   if (smolMIIter == smolyakMultiIndex.end()) {
@@ -556,6 +623,7 @@ inline void HierarchSparseGridDriver::clear_keys()
   type2WeightSets.clear();    t2WtIter      = type2WeightSets.end();
 
   poppedLevMultiIndex.clear(); poppedT1WtSets.clear(); poppedT2WtSets.clear();
+  pointTree.clear();
 }
 
 
@@ -678,6 +746,36 @@ inline const UShortArray& HierarchSparseGridDriver::increment_sets() const
 { return incrSetsIter->second; }
 
 
+inline void HierarchSparseGridDriver::
+point_id(const UShortArray& levels, const UShortArray& key,
+	 UShortArray& pt_id) const
+{
+  pt_id.resize(2*numVars);
+  std::copy(levels.begin(), levels.end(), pt_id.begin());
+  std::copy(key.begin(),    key.end(),    pt_id.begin() + numVars);
+}
+
+
+inline const HierarchPointMap& HierarchSparseGridDriver::point_tree()
+{
+  HierarchPointMap& pt_tree = pointTree[activeKey];
+  if (pt_tree.empty()) update_point_tree();
+  return pt_tree;
+}
+
+
+inline bool HierarchSparseGridDriver::
+find_point(const UShortArray& levels, const UShortArray& key,
+	   SizetSizetPair& set_pt)
+{
+  const HierarchPointMap& pt_tree = point_tree();
+  UShortArray pt_id;  point_id(levels, key, pt_id);
+  HierarchPointMap::const_iterator cit = pt_tree.find(pt_id);
+  if (cit == pt_tree.end()) return false;
+  set_pt = cit->second;  return true;
+}
+
+
 /*
 inline size_t HierarchSparseGridDriver::
 popped_sets(const ActiveKey& key) const
@@ -757,6 +855,10 @@ inline bool HierarchSparseGridDriver::track_collocation_indices() const
 { return trackCollocIndices; }
 
 
+inline bool HierarchSparseGridDriver::nested_grid() const
+{ return nestedGrid; }
+
+
 inline const UShort4DArray& HierarchSparseGridDriver::collocation_key() const
 { return collocKeyIter->second; }
 
@@ -918,6 +1020,21 @@ combined_type2_hierarchical_weight_sets() const
 { return combinedT2WeightSets; }
 
 
+inline const UShortArrayDequeArray& HierarchSparseGridDriver::
+popped_level_multi_index()
+{ return poppedLevMultiIndex[activeKey]; }
+
+
+inline const RealVectorDequeArray& HierarchSparseGridDriver::
+popped_type1_weight_sets()
+{ return poppedT1WtSets[activeKey]; }
+
+
+inline const RealMatrixDequeArray& HierarchSparseGridDriver::
+popped_type2_weight_sets()
+{ return poppedT2WtSets[activeKey]; }
+
+
 inline void HierarchSparseGridDriver::
 levels_to_delta_sizes(const UShortArray& levels, UShortArray& delta_sizes)
 {
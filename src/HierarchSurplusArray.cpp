@@ -0,0 +1,416 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 HierarchSurplusArray
+//- Description: Implementation code for HierarchSurplusArray class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "HierarchSurplusArray.hpp"
+#include <algorithm>
+
+namespace Pecos {
+
+void HierarchSurplusArray::
+pack(const UShort3DArray& sm_mi, const UShort4DArray& colloc_key,
+     const RealVector2DArray& t1_coeffs, const RealMatrix2DArray& t2_coeffs,
+     const RealMatrix2DArray& t1_coeff_grads, const RealVector2DArray& t1_wts,
+     const RealMatrix2DArray& t2_wts)
+{
+  clear();
+  size_t lev, set, num_sets_l, pt, num_pts, v, k, num_lev
+    = std::max(t1_coeffs.size(), t1_coeff_grads.size());
+  if (!num_lev || sm_mi.empty() || sm_mi[0].empty())
+    return;
+  numVars = sm_mi[0][0].size();
+
+  // Sizing pass: points per set, maximum basis level, and the number of
+  // type2 and surplus gradient components
+  SizetArray set_pts;
+  levelOffsets.resize(num_lev + 1);
+  for (lev=0; lev<num_lev; ++lev) {
+    levelOffsets[lev] = set_pts.size();
+    num_sets_l = std::max( (lev < t1_coeffs.size())  ? t1_coeffs[lev].size()
+			   : 0, (lev < t1_coeff_grads.size()) ?
+			   t1_coeff_grads[lev].size() : 0 );
+    for (set=0; set<num_sets_l; ++set) {
+      num_pts = 0;
+      if (lev < t1_coeffs.size() && set < t1_coeffs[lev].size())
+	num_pts = t1_coeffs[lev][set].length();
+      if (lev < t1_coeff_grads.size() && set < t1_coeff_grads[lev].size()) {
+	const RealMatrix& t1cg_ls = t1_coeff_grads[lev][set];
+	num_pts = std::max(num_pts, (size_t)t1cg_ls.numCols());
+	if (t1cg_ls.numCols()) numGrads = t1cg_ls.numRows();
+      }
+      if (lev < t2_coeffs.size() && set < t2_coeffs[lev].size() &&
+	  t2_coeffs[lev][set].numCols())
+	numT2 = numVars;
+      if (num_pts) {
+	const UShortArray& sm_mi_ls = sm_mi[lev][set];
+	for (v=0; v<numVars; ++v)
+	  maxBasisLevel = std::max(maxBasisLevel, sm_mi_ls[v]);
+      }
+      set_pts.push_back(num_pts);
+    }
+  }
+  size_t num_sets = set_pts.size();
+  levelOffsets[num_lev] = num_sets;
+
+  // Key tables: the distinct 1D keys of each basis level and variable
+  size_t num_tables = (maxBasisLevel + 1) * numVars, t;
+  UShort2DArray tables(num_tables);
+  for (lev=0; lev<num_lev; ++lev)
+    for (set=0; set<levelOffsets[lev+1]-levelOffsets[lev]; ++set) {
+      num_pts = set_pts[levelOffsets[lev] + set];
+      if (!num_pts) continue;
+      const UShortArray&  sm_mi_ls = sm_mi[lev][set];
+      const UShort2DArray&  key_ls = colloc_key[lev][set];
+      for (v=0; v<numVars; ++v) {
+	UShortArray& table = tables[sm_mi_ls[v] * numVars + v];
+	for (pt=0; pt<num_pts; ++pt)
+	  table.push_back(key_ls[pt][v]);
+	std::sort(table.begin(), table.end());
+	table.erase(std::unique(table.begin(), table.end()), table.end());
+      }
+    }
+  tableOffsets.resize(num_tables + 1);
+  for (t=0; t<num_tables; ++t) {
+    tableOffsets[t] = tableKeys.size();
+    tableKeys.insert(tableKeys.end(), tables[t].begin(), tables[t].end());
+  }
+  tableOffsets[num_tables] = tableKeys.size();
+
+  // Packing pass
+  size_t total_pts = 0, set_index, stride, pos, start, size;
+  for (set=0; set<num_sets; ++set)
+    total_pts += set_pts[set];
+  t1Coeffs.assign(total_pts, 0.);  t1Weights.assign(total_pts, 0.);
+  t2Coeffs.assign(numT2 * total_pts, 0.);
+  t2Weights.assign(numT2 * total_pts, 0.);
+  t1CoeffGrads.assign(numGrads * total_pts, 0.);
+  setOffsets.resize(num_sets + 1);  keyOffsets.resize(num_sets + 1);
+  setBasisIndices.resize(num_sets * numVars);
+  SizetArray sizes(numVars);
+  for (lev=0, set_index=0, total_pts=0; lev<num_lev; ++lev)
+    for (set=0; set<levelOffsets[lev+1]-levelOffsets[lev]; ++set,++set_index){
+      setOffsets[set_index] = total_pts;
+      keyOffsets[set_index] = pointKeys.size();
+      num_pts = set_pts[set_index];
+      if (!num_pts) continue;
+      const UShortArray& sm_mi_ls = sm_mi[lev][set];
+      std::copy(sm_mi_ls.begin(), sm_mi_ls.end(),
+		setBasisIndices.begin() + set_index * numVars);
+
+      if (lev < t1_coeffs.size() && set < t1_coeffs[lev].size() &&
+	  t1_coeffs[lev][set].length()) {
+	const RealVector& t1c_ls = t1_coeffs[lev][set];
+	std::copy(t1c_ls.values(), t1c_ls.values() + num_pts,
+		  &t1Coeffs[total_pts]);
+      }
+      if (lev < t1_wts.size() && set < t1_wts[lev].size() &&
+	  t1_wts[lev][set].length() == (int)num_pts) {
+	const RealVector& t1w_ls = t1_wts[lev][set];
+	std::copy(t1w_ls.values(), t1w_ls.values() + num_pts,
+		  &t1Weights[total_pts]);
+      }
+      if (numT2 && lev < t2_coeffs.size() && set < t2_coeffs[lev].size() &&
+	  t2_coeffs[lev][set].numCols() == (int)num_pts) {
+	const RealMatrix& t2c_ls = t2_coeffs[lev][set];
+	Real* t2c = &t2Coeffs[numT2 * total_pts];
+	for (pt=0; pt<num_pts; ++pt)
+	  for (k=0; k<numT2; ++k)
+	    t2c[k * num_pts + pt] = t2c_ls(k, pt);
+      }
+      if (numT2 && lev < t2_wts.size() && set < t2_wts[lev].size() &&
+	  t2_wts[lev][set].numCols() == (int)num_pts) {
+	const RealMatrix& t2w_ls = t2_wts[lev][set];
+	Real* t2w = &t2Weights[numT2 * total_pts];
+	for (pt=0; pt<num_pts; ++pt)
+	  for (k=0; k<numT2; ++k)
+	    t2w[k * num_pts + pt] = t2w_ls(k, pt);
+      }
+      if (numGrads && lev < t1_coeff_grads.size() &&
+	  set < t1_coeff_grads[lev].size() &&
+	  t1_coeff_grads[lev][set].numCols() == (int)num_pts) {
+	const RealMatrix& t1cg_ls = t1_coeff_grads[lev][set];
+	Real* t1cg = &t1CoeffGrads[numGrads * total_pts];
+	for (pt=0; pt<num_pts; ++pt)
+	  for (k=0; k<numGrads; ++k)
+	    t1cg[k * num_pts + pt] = t1cg_ls(k, pt);
+      }
+
+      // full sets enumerate the tensor product of their key tables and
+      // store no keys; test the enumeration point by point
+      const UShort2DArray& key_ls = colloc_key[lev][set];
+      size_t num_tp_pts = 1;
+      for (v=0; v<numVars; ++v) {
+	t = sm_mi_ls[v] * numVars + v;
+	sizes[v] = tableOffsets[t+1] - tableOffsets[t];
+	num_tp_pts *= sizes[v];
+      }
+      bool full = (num_tp_pts == num_pts);
+      for (pt=0; pt<num_pts && full; ++pt) {
+	const UShortArray& key_lsp = key_ls[pt];
+	for (v=0, stride=1; v<numVars; ++v) {
+	  pos = (pt / stride) % sizes[v];  stride *= sizes[v];
+	  if (tableKeys[table_offset(sm_mi_ls[v], v) + pos] != key_lsp[v])
+	    { full = false; break; }
+	}
+      }
+      if (!full)
+	for (pt=0; pt<num_pts; ++pt) {
+	  const UShortArray& key_lsp = key_ls[pt];
+	  for (v=0; v<numVars; ++v) {
+	    start = table_offset(sm_mi_ls[v], v);  size = sizes[v];
+	    pos = std::lower_bound(&tableKeys[start], &tableKeys[start] + size,
+				   key_lsp[v]) - &tableKeys[start];
+	    pointKeys.push_back((unsigned short)pos);
+	  }
+	}
+      total_pts += num_pts;
+    }
+  setOffsets[num_sets] = total_pts;  keyOffsets[num_sets] = pointKeys.size();
+}
+
+
+void HierarchSurplusArray::clear()
+{
+  numVars = numT2 = numGrads = 0;  maxBasisLevel = 0;
+  levelOffsets.clear();  setOffsets.clear();  setBasisIndices.clear();
+  keyOffsets.clear();    pointKeys.clear();
+  tableOffsets.clear();  tableKeys.clear();
+  t1Coeffs.clear();      t2Coeffs.clear();    t1CoeffGrads.clear();
+  t1Weights.clear();     t2Weights.clear();
+}
+
+
+/** For local bases, most of the type1 values within a table are zero,
+    and their nonzero positions are recorded for contract_support(). */
+void HierarchSurplusArray::
+basis_values(const RealVector& x,
+	     std::vector<std::vector<BasisPolynomial> >& poly_basis,
+	     bool derivs)
+{
+  size_t num_keys = tableKeys.size(), v, j, t, start, end;
+  unsigned short b, key;  Real x_v;
+  t1Values.resize(num_keys);
+  if (derivs) t1Gradients.resize(num_keys);
+  if (numT2) {
+    t2Values.resize(num_keys);
+    if (derivs) t2Gradients.resize(num_keys);
+  }
+  supportPositions.clear();  supportOffsets.resize(tableOffsets.size());
+  for (b=0, t=0; b<=maxBasisLevel; ++b)
+    for (v=0; v<numVars; ++v, ++t) {
+      supportOffsets[t] = supportPositions.size();
+      start = tableOffsets[t];  end = tableOffsets[t+1];
+      if (start == end) continue;
+      BasisPolynomial& poly_bv = poly_basis[b][v];  x_v = x[v];
+      for (j=start; j<end; ++j) {
+	key = tableKeys[j];
+	// the level 0 type1 basis is the constant 1 (see Horner evaluation
+	// in SharedInterpPolyApproxData::tensor_product_value())
+	t1Values[j] = (b) ? poly_bv.type1_value(x_v, key) : 1.;
+	if (t1Values[j] != 0.)
+	  supportPositions.push_back((unsigned short)(j - start));
+	if (derivs)
+	  t1Gradients[j] = (b) ? poly_bv.type1_gradient(x_v, key) : 0.;
+	if (numT2) {
+	  t2Values[j] = poly_bv.type2_value(x_v, key);
+	  if (derivs) t2Gradients[j] = poly_bv.type2_gradient(x_v, key);
+	}
+      }
+    }
+  supportOffsets[t] = supportPositions.size();
+}
+
+
+/** Full sets are contracted one variable at a time (first variable
+    fastest), such that each pass is a sequence of contiguous dot
+    products.  Partial sets accumulate the product of 1D factors at
+    each of their encoded points. */
+Real HierarchSurplusArray::
+contract(size_t set, const Real* coeffs, size_t deriv_index,
+	 size_t interp_index)
+{
+  size_t num_pts = setOffsets[set+1] - setOffsets[set];
+  if (!num_pts)
+    return 0.;
+
+  const unsigned short* bi = &setBasisIndices[set * numVars];
+  size_t v, pt;
+  setFactors.resize(numVars);
+  for (v=0; v<numVars; ++v)
+    setFactors[v] = factors(bi[v], v, deriv_index, interp_index);
+
+  size_t k_start = keyOffsets[set], k_end = keyOffsets[set+1];
+  if (k_start == k_end) {
+    if (contraction.size() < num_pts) contraction.resize(num_pts);
+    const Real* src = coeffs;  Real* dst = &contraction[0];  Real sum;
+    size_t i, p, n, t, len = num_pts;
+    for (v=0; v<numVars; ++v) {
+      const Real* f_v = setFactors[v];
+      t = bi[v] * numVars + v;  n = tableOffsets[t+1] - tableOffsets[t];
+      len /= n;
+      // in place after the first pass: dst[i] follows the reads of src[i*n]
+      for (i=0; i<len; ++i) {
+	const Real* src_i = src + i * n;  sum = 0.;
+	for (p=0; p<n; ++p)
+	  sum += src_i[p] * f_v[p];
+	dst[i] = sum;
+      }
+      src = dst;
+    }
+    return src[0];
+  }
+
+  const unsigned short* keys = &pointKeys[k_start];
+  Real sum = 0., prod;
+  for (pt=0; pt<num_pts; ++pt, keys+=numVars) {
+    prod = coeffs[pt];
+    for (v=0; v<numVars && prod != 0.; ++v)
+      prod *= setFactors[v][keys[v]];
+    sum += prod;
+  }
+  return sum;
+}
+
+
+/** Only the points whose type1 factors are all nonzero are visited.
+    The dense contraction is used when the supports span at least half
+    of the set or when the set is partial. */
+Real HierarchSurplusArray::contract_support(size_t set, const Real* coeffs)
+{
+  size_t num_pts = setOffsets[set+1] - setOffsets[set];
+  if (!num_pts || keyOffsets[set] != keyOffsets[set+1])
+    return contract(set, coeffs, _NPOS, _NPOS);
+
+  const unsigned short* bi = &setBasisIndices[set * numVars];
+  size_t v, t, num_supp = 1;
+  for (v=0; v<numVars; ++v) {
+    t = bi[v] * numVars + v;
+    num_supp *= supportOffsets[t+1] - supportOffsets[t];
+  }
+  if (!num_supp)
+    return 0.;
+  if (2 * num_supp >= num_pts)
+    return contract(set, coeffs, _NPOS, _NPOS);
+
+  size_t pt, stride, pos;  Real sum = 0., prod;
+  supportIndices.assign(numVars, 0);
+  do {
+    pt = 0;  stride = 1;  prod = 1.;
+    for (v=0; v<numVars; ++v) {
+      t   = bi[v] * numVars + v;
+      pos = supportPositions[supportOffsets[t] + supportIndices[v]];
+      pt     += stride * pos;
+      prod   *= t1Values[tableOffsets[t] + pos];
+      stride *= tableOffsets[t+1] - tableOffsets[t];
+    }
+    sum += prod * coeffs[pt];
+    // increment the odometer over the supports
+    for (v=0; v<numVars; ++v) {
+      t = bi[v] * numVars + v;
+      if (++supportIndices[v] < supportOffsets[t+1] - supportOffsets[t])
+	break;
+      else
+	supportIndices[v] = 0;
+    }
+  } while (v < numVars);
+  return sum;
+}
+
+
+Real HierarchSurplusArray::
+value(const RealVector& x,
+      std::vector<std::vector<BasisPolynomial> >& poly_basis)
+{
+  basis_values(x, poly_basis, false);
+  size_t set, num_sets = this->num_sets(), k, num_pts;  Real val = 0.;
+  for (set=0; set<num_sets; ++set) {
+    num_pts = setOffsets[set+1] - setOffsets[set];
+    val += contract_support(set, t1Coeffs.data() + setOffsets[set]);
+    const Real* t2c = t2Coeffs.data() + numT2 * setOffsets[set];
+    for (k=0; k<numT2; ++k)
+      val += contract(set, t2c + k * num_pts, _NPOS, k);
+  }
+  return val;
+}
+
+
+void HierarchSurplusArray::
+gradient(const RealVector& x,
+	 std::vector<std::vector<BasisPolynomial> >& poly_basis,
+	 RealVector& grad)
+{
+  if (grad.length() != numVars) grad.sizeUninitialized(numVars);
+  grad = 0.;
+  basis_values(x, poly_basis, true);
+  size_t set, num_sets = this->num_sets(), j, k, num_pts;
+  for (set=0; set<num_sets; ++set) {
+    num_pts = setOffsets[set+1] - setOffsets[set];
+    const Real* t1c = t1Coeffs.data() + setOffsets[set];
+    const Real* t2c = t2Coeffs.data() + numT2 * setOffsets[set];
+    for (j=0; j<numVars; ++j) {
+      grad[j] += contract(set, t1c, j, _NPOS);
+      for (k=0; k<numT2; ++k)
+	grad[j] += contract(set, t2c + k * num_pts, j, k);
+    }
+  }
+}
+
+
+void HierarchSurplusArray::
+coefficient_gradient_values(const RealVector& x,
+  std::vector<std::vector<BasisPolynomial> >& poly_basis, RealVector& grad)
+{
+  if (grad.length() != numGrads) grad.sizeUninitialized(numGrads);
+  grad = 0.;
+  basis_values(x, poly_basis, false);
+  size_t set, num_sets = this->num_sets(), g, num_pts;
+  for (set=0; set<num_sets; ++set) {
+    num_pts = setOffsets[set+1] - setOffsets[set];
+    const Real* t1cg = t1CoeffGrads.data() + numGrads * setOffsets[set];
+    for (g=0; g<numGrads; ++g)
+      grad[g] += contract_support(set, t1cg + g * num_pts);
+  }
+}
+
+
+Real HierarchSurplusArray::expectation() const
+{
+  size_t i, num_pts = t1Coeffs.size(), num_t2 = t2Coeffs.size();
+  Real integral = 0.;
+  for (i=0; i<num_pts; ++i)
+    integral += t1Coeffs[i] * t1Weights[i];
+  for (i=0; i<num_t2; ++i)
+    integral += t2Coeffs[i] * t2Weights[i];
+  return integral;
+}
+
+
+void HierarchSurplusArray::expectation_gradient(RealVector& grad) const
+{
+  if (grad.length() != numGrads) grad.sizeUninitialized(numGrads);
+  grad = 0.;
+  size_t set, num_sets = this->num_sets(), g, pt, num_pts;  Real sum;
+  for (set=0; set<num_sets; ++set) {
+    num_pts = setOffsets[set+1] - setOffsets[set];
+    const Real* t1w  = t1Weights.data() + setOffsets[set];
+    const Real* t1cg = t1CoeffGrads.data() + numGrads * setOffsets[set];
+    for (g=0; g<numGrads; ++g, t1cg+=num_pts) {
+      sum = 0.;
+      for (pt=0; pt<num_pts; ++pt)
+	sum += t1cg[pt] * t1w[pt];
+      grad[g] += sum;
+    }
+  }
+}
+
+} // namespace Pecos
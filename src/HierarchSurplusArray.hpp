@@ -0,0 +1,261 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 HierarchSurplusArray
+//- Description: Packed storage of hierarchical interpolation surpluses
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef HIERARCH_SURPLUS_ARRAY_HPP
+#define HIERARCH_SURPLUS_ARRAY_HPP
+
+#include "pecos_data_types.hpp"
+#include "BasisPolynomial.hpp"
+
+namespace Pecos {
+
+
+/// Structure-of-arrays storage of the surpluses of a hierarchical
+/// interpolant, used for its evaluation and integration.
+
+/** The type1 and type2 surpluses, surplus gradients, and hierarchical
+    integration weights held as [level][set][point] arrays of Teuchos
+    objects are packed into contiguous arrays, with level and set offset
+    tables locating the points of each index set.  Type2 surpluses,
+    surplus gradients, and type2 weights are stored component-major
+    within each set, such that each component is contiguous.
+
+    Collocation keys are encoded compactly: the 1D keys of each variable
+    and basis level are collected into a table, and an index set whose
+    points enumerate the tensor product of its tables (first variable
+    fastest, as for hierarchical_tensor_product_multi_index()) stores no
+    keys at all.  Only partial sets (e.g., from point-local refinement)
+    store their points as table positions.  The 1D basis is evaluated
+    once per table entry, after which full sets are contracted one
+    variable at a time over contiguous surpluses.  An instance is a
+    snapshot of its source arrays and must be packed again when they
+    change.
+
+    Packing trades memory for evaluation speed: the source arrays remain
+    the reference for refinement, such that the surpluses, surplus
+    gradients, and weights of the packed expansion are held twice (the
+    key tables and offsets add comparatively little).  clear() releases
+    the copy. */
+
+class HierarchSurplusArray
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  HierarchSurplusArray();
+  /// destructor
+  ~HierarchSurplusArray();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// pack the index sets retained in t1_coeffs (the Smolyak multi-index
+  /// and collocation key may include additional sets); t2_coeffs,
+  /// t1_coeff_grads, and t2_wts may be empty
+  void pack(const UShort3DArray& sm_mi, const UShort4DArray& colloc_key,
+	    const RealVector2DArray& t1_coeffs,
+	    const RealMatrix2DArray& t2_coeffs,
+	    const RealMatrix2DArray& t1_coeff_grads,
+	    const RealVector2DArray& t1_wts, const RealMatrix2DArray& t2_wts);
+  /// release the packed arrays
+  void clear();
+  /// return true if no surpluses are packed
+  bool empty() const;
+
+  /// return the number of packed levels
+  size_t num_levels() const;
+  /// return the number of packed index sets
+  size_t num_sets() const;
+  /// return the number of packed points
+  size_t num_points() const;
+  /// return the index of the first set of level lev
+  size_t level_offset(size_t lev) const;
+  /// return the index of the first point of set (flattened over levels)
+  size_t set_offset(size_t set) const;
+  /// return true if type2 surpluses are packed
+  bool type2() const;
+  /// return the number of rows in the packed surplus gradients
+  size_t num_coefficient_gradients() const;
+
+  /// evaluate the interpolant at x using poly_basis[level][variable]
+  Real value(const RealVector& x,
+	     std::vector<std::vector<BasisPolynomial> >& poly_basis);
+  /// evaluate the gradient of the interpolant with respect to x
+  void gradient(const RealVector& x,
+		std::vector<std::vector<BasisPolynomial> >& poly_basis,
+		RealVector& grad);
+  /// evaluate the interpolant of the surplus gradients at x
+  void coefficient_gradient_values(const RealVector& x,
+    std::vector<std::vector<BasisPolynomial> >& poly_basis, RealVector& grad);
+
+  /// integrate the interpolant using the packed weights
+  Real expectation() const;
+  /// integrate the interpolant of the surplus gradients using the
+  /// packed type1 weights
+  void expectation_gradient(RealVector& grad) const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// return the start of the key table for variable v at basis level b
+  size_t table_offset(unsigned short b, size_t v) const;
+
+  /// evaluate the 1D basis over the key tables at x; gradients and
+  /// type2 values are included when derivs is set
+  void basis_values(const RealVector& x,
+		    std::vector<std::vector<BasisPolynomial> >& poly_basis,
+		    bool derivs);
+  /// return the table of 1D factors used for variable v, where
+  /// deriv_index selects the differentiated variable and interp_index
+  /// the type2 component (_NPOS for neither)
+  const Real* factors(unsigned short b, size_t v, size_t deriv_index,
+		      size_t interp_index) const;
+  /// contract the contiguous surpluses of one set against the 1D factors
+  Real contract(size_t set, const Real* coeffs, size_t deriv_index,
+		size_t interp_index);
+  /// contract the surpluses of one full set over the points whose type1
+  /// factors are all nonzero
+  Real contract_support(size_t set, const Real* coeffs);
+
+  //
+  //- Heading: Data
+  //
+
+  /// number of variables
+  size_t numVars;
+  /// number of type2 components per point (0 or numVars)
+  size_t numT2;
+  /// number of rows in the surplus gradients
+  size_t numGrads;
+
+  /// index of the first set of each level (one more than the levels)
+  SizetArray levelOffsets;
+  /// index of the first point of each set (one more than the sets)
+  SizetArray setOffsets;
+  /// basis index of each set (numVars per set)
+  UShortArray setBasisIndices;
+  /// index of the first explicit point key of each set within pointKeys
+  /// (one more than the sets); full sets have no explicit keys
+  SizetArray keyOffsets;
+  /// table positions of the points of partial sets (numVars per point)
+  UShortArray pointKeys;
+
+  /// maximum basis level among the packed sets
+  unsigned short maxBasisLevel;
+  /// start of the key table of each basis level and variable
+  /// ((maxBasisLevel+1) * numVars + 1 entries)
+  SizetArray tableOffsets;
+  /// sorted 1D collocation keys of each table
+  UShortArray tableKeys;
+
+  /// contiguous type1 surpluses
+  RealArray t1Coeffs;
+  /// type2 surpluses (numT2 components by points of each set)
+  RealArray t2Coeffs;
+  /// surplus gradients (numGrads components by points of each set)
+  RealArray t1CoeffGrads;
+  /// type1 hierarchical weights
+  RealArray t1Weights;
+  /// type2 hierarchical weights, ordered as t2Coeffs
+  RealArray t2Weights;
+
+  /// 1D type1 values at the current point, ordered as tableKeys
+  RealArray t1Values;
+  /// 1D type1 gradients at the current point, ordered as tableKeys
+  RealArray t1Gradients;
+  /// 1D type2 values at the current point, ordered as tableKeys
+  RealArray t2Values;
+  /// 1D type2 gradients at the current point, ordered as tableKeys
+  RealArray t2Gradients;
+  /// positions of the nonzero type1 values within each table
+  UShortArray supportPositions;
+  /// start of the nonzero positions of each table within supportPositions
+  SizetArray supportOffsets;
+  /// 1D factors of each variable for the set being contracted
+  std::vector<const Real*> setFactors;
+  /// workspace for partial contractions
+  RealArray contraction;
+  /// odometer over supportPositions
+  SizetArray supportIndices;
+};
+
+
+inline HierarchSurplusArray::HierarchSurplusArray():
+  numVars(0), numT2(0), numGrads(0), maxBasisLevel(0)
+{ }
+
+
+inline HierarchSurplusArray::~HierarchSurplusArray()
+{ }
+
+
+inline bool HierarchSurplusArray::empty() const
+{ return levelOffsets.empty(); }
+
+
+inline size_t HierarchSurplusArray::num_levels() const
+{ return (levelOffsets.empty()) ? 0 : levelOffsets.size() - 1; }
+
+
+inline size_t HierarchSurplusArray::num_sets() const
+{ return (setOffsets.empty()) ? 0 : setOffsets.size() - 1; }
+
+
+inline size_t HierarchSurplusArray::num_points() const
+{ return t1Coeffs.size(); }
+
+
+inline size_t HierarchSurplusArray::level_offset(size_t lev) const
+{ return levelOffsets[lev]; }
+
+
+inline size_t HierarchSurplusArray::set_offset(size_t set) const
+{ return setOffsets[set]; }
+
+
+inline bool HierarchSurplusArray::type2() const
+{ return (numT2 > 0); }
+
+
+inline size_t HierarchSurplusArray::num_coefficient_gradients() const
+{ return numGrads; }
+
+
+inline size_t HierarchSurplusArray::
+table_offset(unsigned short b, size_t v) const
+{ return tableOffsets[b * numVars + v]; }
+
+
+inline const Real* HierarchSurplusArray::
+factors(unsigned short b, size_t v, size_t deriv_index,
+	size_t interp_index) const
+{
+  size_t offset = table_offset(b, v);
+  if (v == interp_index)
+    return (v == deriv_index) ? &t2Gradients[offset] : &t2Values[offset];
+  else
+    return (v == deriv_index) ? &t1Gradients[offset] : &t1Values[offset];
+}
+
+} // namespace Pecos
+
+#endif
@@ -14,7 +14,6 @@
 
 #include "IncrementalSparseGridDriver.hpp"
 #include "SharedPolyApproxData.hpp"
-#include "sandia_sgmgg.hpp"
 #include "pecos_stat_util.hpp"
 
 static const char rcsId[]="@(#) $Id: IncrementalSparseGridDriver.C,v 1.57 2004/06/21 19:57:32 mseldre Exp $";
@@ -199,41 +198,22 @@ update_smolyak_arrays_aniso(UShort2DArray& sm_mi, IntArray& sm_coeffs)
 }
 
 
-void IncrementalSparseGridDriver::update_collocation_key()
-{
-  const UShort2DArray& sm_mi = smolMIIter->second;
-  UShort3DArray& colloc_key = collocKeyIter->second;
-  UShortArray quad_order(numVars);
-  size_t i, start_index = colloc_key.size(), num_sm_mi = sm_mi.size();
-  colloc_key.resize(num_sm_mi);
-  for (i=start_index; i<num_sm_mi; ++i) {
-    level_to_order(sm_mi[i], quad_order);
-    SharedPolyApproxData::
-      tensor_product_multi_index(quad_order, colloc_key[i], false);
-  }
-}
-
-
 int IncrementalSparseGridDriver::grid_size()
 {
   int& num_colloc_pts = numPtsIter->second;
   if (num_colloc_pts == 0) { // special value indicated update required
     update_smolyak_arrays();
-    update_collocation_key();
+    clear_collocation_key(); // leading sets may have been redefined
 
-    RealMatrix a1_pts, a1_t2_wts;  RealVector a1_t1_wts;
+    // update 1D pts/wts for the tensor grids, but defer the tensor points
     const UShort2DArray& sm_mi = smolMIIter->second;
-    compute_tensor_points_weights(sm_mi, collocKeyIter->second, 0, sm_mi.size(),
-				  true, a1_pts, a1_t1_wts, a1_t2_wts);
-
-    int m = numVars, n1 = a1_pts.numCols(), seed = 1234567;
-    RealVector zv(m, false), r1v(n1, false);  IntArray sind1(n1);
-    bool* is_unique1 = new bool[n1];
-    // Use _count_inc1 whereas reference_unique uses _index_inc1
-    webbur::point_radial_tol_unique_count_inc1(m, n1, a1_pts.values(),
-      duplicateTol, &seed, zv.values(), r1v.values(), &sind1[0], is_unique1,
-      &num_colloc_pts);
-    delete [] is_unique1;
+    size_t i, num_sm_mi = sm_mi.size();  UShort2DArray tp_orders;
+    assign_tensor_orders(sm_mi, tp_orders);
+    for (i=0; i<num_sm_mi; ++i)
+      assign_1d_collocation_points_weights(tp_orders[i], sm_mi[i]);
+    // count only: reference ids in pointIndexer are updated in compute_grid()
+    CollocPointIndexer indexer;  indexer.reset(numVars, duplicateTol);
+    num_colloc_pts = indexer.count_unique(sm_mi, tp_orders, collocPts1D);
   }
   return num_colloc_pts;
 }
@@ -246,7 +226,6 @@ void IncrementalSparseGridDriver::compute_grid()
   // to define its reference grid, rather than inheriting from CombinedSGDriver
 
   update_smolyak_arrays();  // smolyak{MultiIndex,Coeffs}
-  update_collocation_key(); // collocKey
   reference_unique();       // compute pts,wts for the reference grid
   update_reference();       // update reference arrays
 
@@ -280,9 +259,9 @@ void IncrementalSparseGridDriver::compute_trial_grid(RealMatrix& var_sets)
                       a2T2WIter->second, colloc_key.back());
   */
 
-  // trial set already appended, update collocation key
-  size_t last_index = collocKeyIter->second.size();
-  update_collocation_key(); // needed for compute_tensor_points_weights()
+  // trial set already appended to smolyakMultiIndex (collocKey is not
+  // required for compute_tensor_points_weights(); it is updated on demand)
+  size_t last_index = smolMIIter->second.size() - 1;
   // compute a2 pts/wts; update collocIndices, uniqueIndexMapping
   increment_unique(last_index);
   // update var_sets with increment (not aggregate) of unique points from a2
@@ -303,7 +282,6 @@ void IncrementalSparseGridDriver::compute_trial_grid(RealMatrix& var_sets)
 void IncrementalSparseGridDriver::compute_increment(RealMatrix& var_sets)
 {
   update_smolyak_arrays();  // update smolyak{MultiIndex,Coeffs}
-  update_collocation_key(); // synchronize collocKey
   // update a2 for multiple trial sets
   size_t start_index = smolyakCoeffsRef[activeKey].size();
   increment_unique(start_index);
@@ -317,7 +295,6 @@ void IncrementalSparseGridDriver::compute_increment(RealMatrix& var_sets)
 void IncrementalSparseGridDriver::push_increment()
 {
   update_smolyak_arrays();  // update smolyak{MultiIndex,Coeffs}
-  update_collocation_key(); // synchronize collocKey
   // update a2 for multiple trial sets
   size_t start_index = smolyakCoeffsRef[activeKey].size();
   increment_unique(start_index, false);
@@ -330,7 +307,7 @@ void IncrementalSparseGridDriver::pop_increment()
   size_t ref_size = sm_coeffs_ref.size();
   smolMIIter->second.resize(ref_size);
   smolCoeffsIter->second = sm_coeffs_ref;
-  collocKeyIter->second.resize(ref_size);
+  truncate_collocation_key(ref_size);
   collocIndIter->second.resize(ref_size);
 
   numPtsIter->second = numUniq1Iter->second;             // unique ref points
@@ -404,23 +381,70 @@ void IncrementalSparseGridDriver::push_set()
   if (p_index != _NPOS) pop_trials.erase(pop_trials.begin() + p_index);
   pushIndex[activeKey] = p_index;
  
-  // synchronize collocKey with smolyakMultiIndex
-  update_collocation_key();
   // compute a2; update collocIndices, uniqueIndexMapping
   // no new var_sets and 1D updates have already been performed
   increment_unique(smolMIIter->second.size()-1, false); // no 1D pts/wts update
 }
 
 
+void IncrementalSparseGridDriver::
+compute_trial_grids(const UShort2DArray& trial_sets, RealMatrix& var_sets,
+		    SizetArray& trial_offsets)
+{
+  // Each trial set is an increment to the same reference grid, such that
+  // the candidates are independent and their unique points can be stacked
+  // for a single (batched) evaluation.  The reference grid is restored
+  // after each trial without recording it within poppedTrialSets, since no
+  // corresponding approximation data exists until the trial is evaluated
+  // and scored using increment_smolyak_multi_index() + compute_trial_grid(),
+  // which reproduces the same ordering of the trial points.  Trial sets that
+  // are available for restoration require no new points.
+  size_t i, j, num_tr = trial_sets.size(), num_pts = 0, num_tr_pts;
+  std::vector<RealMatrix> tr_var_sets(num_tr);
+  trial_offsets.resize(num_tr+1);
+  for (i=0; i<num_tr; ++i) {
+    trial_offsets[i] = num_pts;
+    const UShortArray& tr_set = trial_sets[i];
+    if (push_trial_available(activeKey, tr_set)) continue;
+    increment_smolyak_multi_index(tr_set);
+    compute_trial_grid(tr_var_sets[i]);
+    num_pts += tr_var_sets[i].numCols();
+    pop_trial_grid();
+  }
+  trial_offsets[num_tr] = num_pts;
+
+  // stack the trial points for batched evaluation
+  var_sets.shapeUninitialized(numVars, num_pts);
+  for (i=0; i<num_tr; ++i) {
+    const RealMatrix& tr_vars_i = tr_var_sets[i];
+    num_tr_pts = tr_vars_i.numCols();
+    for (j=0; j<num_tr_pts; ++j)
+      copy_data(tr_vars_i[j], numVars, var_sets[trial_offsets[i]+j]);
+  }
+
+#ifdef DEBUG
+  PCout << "compute_trial_grids(): trial offsets:\n" << trial_offsets
+	<< "stacked variable sets:\n" << var_sets;
+#endif // DEBUG
+}
+
+
 void IncrementalSparseGridDriver::pop_set()
 {
   UShort2DArray& sm_mi = smolMIIter->second;
   poppedTrialSets[activeKey].push_back(sm_mi.back());
   pushIndex[activeKey] = _NPOS;
 
+  pop_trial_grid(); // restore reference grid state
+}
+
+
+void IncrementalSparseGridDriver::pop_trial_grid()
+{
   // restore reference grid state
+  UShort2DArray& sm_mi = smolMIIter->second;
   sm_mi.pop_back();
-  collocKeyIter->second.pop_back();
+  truncate_collocation_key(sm_mi.size());
   collocIndIter->second.pop_back();
   smolCoeffsIter->second = smolyakCoeffsRef[activeKey];
 
@@ -464,8 +488,6 @@ finalize_sets(bool output_sets, bool converged_within_tol, bool reverted)
 
   // update smolyakCoeffs from smolyakMultiIndex
   update_smolyak_coefficients(start_index);
-  // synchronize collocKey with smolyakMultiIndex
-  update_collocation_key();
   // generate final grid, uniqueIndexMapping, collocIndices, numCollocPts
   finalize_unique(start_index);
 
@@ -493,25 +515,22 @@ finalize_sets(bool output_sets, bool converged_within_tol, bool reverted)
 void IncrementalSparseGridDriver::
 increment_unique_points_weights(size_t start_index, const UShort2DArray& sm_mi,
   const IntArray& sm_coeffs, const IntArray& sm_coeffs_ref,
-  const UShort3DArray& colloc_key, Sizet2DArray& colloc_ind,
+  Sizet2DArray& colloc_ind,
   int& num_colloc_pts, RealMatrix& a1_pts, RealVector& a1_t1w,
   RealMatrix& a1_t2w,  RealMatrix& a2_pts, RealVector& a2_t1w,
-  RealMatrix& a2_t2w, RealVector& zv, RealVector& r1v, RealVector& r2v,
-  IntArray& sind1, BitArray& isu1, IntArray& uind1, IntArray& uset1,
-  int& num_u1, IntArray& sind2, BitArray& isu2, IntArray& uind2,
-  IntArray& uset2, int& num_u2, IntArray& unique_index_map,
+  RealMatrix& a2_t2w, CollocPointIndexer& indexer, int num_u1,
+  BitArray& isu2, int& num_u2, IntArray& unique_index_map,
   bool update_1d_pts_wts, RealMatrix& pts, RealVector& t1_wts,
   RealMatrix& t2_wts)
 {
   size_t i, j, num_sm_mi = sm_mi.size();
-  int m = numVars, n1 = a1_pts.numCols(), tp_n2, n2 = 0;
+  int tp_n2, n2 = 0;
   RealVector tp_t1w; RealMatrix tp_pts, tp_t2w;
-  bool *is_unique1, *is_unique2;
 
   // compute the points/weights for each tensor grid, updating 1D if needed
   for (i=start_index; i<num_sm_mi; ++i) {
-    compute_tensor_points_weights(sm_mi, colloc_key, i, 1, update_1d_pts_wts,
-				  tp_pts, tp_t1w, tp_t2w);
+    compute_tensor_points_weights(sm_mi, i, 1, update_1d_pts_wts, tp_pts,
+				  tp_t1w, tp_t2w);
     tp_n2 = tp_pts.numCols();
     a2_pts.reshape(numVars, n2+tp_n2);  a2_t1w.resize(n2+tp_n2);
     if (computeType2Weights) a2_t2w.reshape(numVars, n2+tp_n2);
@@ -532,110 +551,52 @@ increment_unique_points_weights(size_t start_index, const UShort2DArray& sm_mi,
   // INC2 detects a2 duplication with respect to a1 reference grid as well as
   // internal duplicates (multiple TP grids in a2 have internal duplication).
   // This allows for a single update spanning multiple Smolyak index sets.
-  r2v.sizeUninitialized(n2);  sind2.resize(n2);
-  uset2.resize(n2);           uind2.resize(n2);
-  is_unique1 = new bool[n1];  copy_data(isu1, is_unique1, n1);
-  is_unique2 = new bool[n2];  // bridges inc2 to inc3: isUnique2 not needed
-  webbur::point_radial_tol_unique_index_inc2(m, n1, a1_pts.values(), n2,
-    a2_pts.values(), duplicateTol, zv.values(), r1v.values(), &sind1[0],
-    is_unique1,  num_u1, &uset1[0], &uind1[0],  r2v.values(), &sind2[0],
-    is_unique2, &num_u2, &uset2[0], &uind2[0]);
+  // Reference point ids are retained by the indexer, so only the increment
+  // requires identification (no re-sort of the reference points).
+  UShort2DArray tp_orders;  assign_tensor_orders(sm_mi, tp_orders);
+  num_u2 = indexer.increment_unique(start_index, sm_mi, tp_orders,
+				    collocPts1D, num_u1, isu2,
+				    unique_index_map);
 #ifdef DEBUG
   PCout << "Increment unique: numUnique2 = " << num_u2 << "\na2 =\n";
   write_data(PCout, a2_pts, false, true, true);
-  PCout << "               r2   indx2 unique2   undx2   xdnu2:\n";
-  for (j=0; j<num_u2; ++j)
-    PCout << std::setw(17) << r2v[j]        << std::setw(8) << sind2[j]
-	  << std::setw(8)  << is_unique2[j] << std::setw(8) << uset2[j]
-	  << std::setw(8)  << uind2[j]      << '\n';
-  for (j=num_u2; j<n2; ++j)
-    PCout << std::setw(17) << r2v[j]       << std::setw(8)  << sind2[j]
-	  << std::setw(8) << is_unique2[j] << std::setw(16) << uind2[j] << '\n';
-  PCout << std::endl;
+  PCout << "isUnique2:\n" << isu2 << std::endl;
 #endif // DEBUG
-  copy_data(is_unique2, n2, isu2);
-  delete [] is_unique1; delete [] is_unique2;
 
   num_colloc_pts = num_u1 + num_u2;
-  update_unique_indices(start_index, num_u1, uind1, uset1, isu2, uind2, uset2,
-			unique_index_map);
-  assign_collocation_indices(colloc_key, unique_index_map, colloc_ind,
+  assign_collocation_indices(sm_mi, unique_index_map, colloc_ind,
 			     start_index);
   assign_sparse_points(colloc_ind, start_index, isu2, num_u1, a2_pts, pts);
   if (trackUniqueProdWeights)
-    update_sparse_weights(start_index, colloc_key, colloc_ind, num_colloc_pts,
+    update_sparse_weights(start_index, colloc_ind, num_colloc_pts,
 			  sm_coeffs, sm_coeffs_ref, a1_t1w, a1_t2w, a2_t1w,
 			  a2_t2w, t1_wts, t2_wts);
 }
 
 
 void IncrementalSparseGridDriver::
-merge_unique_points_weights(const UShort2DArray& sm_mi,
-  const IntArray& sm_coeffs, const IntArray& sm_coeffs_ref,
-  const UShort3DArray& colloc_key, Sizet2DArray& colloc_ind,
-  int& num_colloc_pts, RealMatrix& a1_pts, RealVector& a1_t1w,
-  RealMatrix& a1_t2w, RealMatrix& a2_pts, RealVector& a2_t1w,
-  RealMatrix& a2_t2w, RealVector& r1v, RealVector& r2v, IntArray& sind1,
-  BitArray& isu1, IntArray& uind1, IntArray& uset1, int& num_u1,
-  IntArray& sind2, BitArray& isu2, IntArray& uind2, IntArray& uset2,
-  int& num_u2, IntArray& unique_index_map, RealMatrix& pts,
-  RealVector& t1_wts, RealMatrix& t2_wts)
+merge_unique_points_weights(int& num_colloc_pts, RealMatrix& a1_pts,
+  RealVector& a1_t1w, RealMatrix& a1_t2w, const RealMatrix& a2_pts,
+  const RealVector& a2_t1w, const RealMatrix& a2_t2w,
+  CollocPointIndexer& indexer, BitArray& isu1, int& num_u1,
+  const BitArray& isu2, int num_u2)
 {
-  int i, m = numVars, n1 = a1_pts.numCols(), n2 = a2_pts.numCols(),
-    n1n2 = n1+n2, n3;
-  RealVector r3v(n1n2, false);
-  RealMatrix a3_pts(m, n1n2, false);
-  IntArray sind3(n1n2), uset3(n1n2), uind3(n1n2);
-  bool *is_unique1 = new bool[n1], *is_unique2 = new bool[n2],
-       *is_unique3 = new bool[n1n2];
-  copy_data(isu1, is_unique1, n1);
-  copy_data(isu2, is_unique2, n2);
-
   // ----
   // INC3
   // ----
-  webbur::point_radial_tol_unique_index_inc3(m, n1, a1_pts.values(),
-    r1v.values(), &sind1[0], is_unique1, num_u1, &uset1[0], &uind1[0], n2,
-    a2_pts.values(), r2v.values(), &sind2[0], is_unique2, num_u2, &uset2[0],
-    &uind2[0], &n3, a3_pts.values(), r3v.values(), &sind3[0], is_unique3,
-    &num_colloc_pts, &uset3[0], &uind3[0]);
+  // The merged set is a1 followed by a2 and the unique ids assigned within
+  // increment_unique_points_weights() are preserved, such that uniqueness
+  // bookkeeping reduces to a promotion of the increment ids.
+  indexer.merge_unique();
 
-#ifdef DEBUG
-  PCout << "Merge unique: num_unique3 = " << num_colloc_pts << "\na3 =\n";
-  write_data(PCout, a3_pts, false, true, true);
-  PCout << "               r3   indx3 unique3   undx3   xdnu3:\n";
-  for (size_t i=0; i<num_colloc_pts; ++i)
-    PCout << std::setw(17) << r3v[i]        << std::setw(8) << sind3[i]
-	  << std::setw(8)  << is_unique3[i] << std::setw(8) << uset3[i]
-	  << std::setw(8)  << uind3[i] << '\n';
-  for (size_t i=num_colloc_pts; i<n1n2; ++i)
-    PCout << std::setw(17) << r3v[i]       << std::setw(8)  << sind3[i]
-	  << std::setw(8) << is_unique3[i] << std::setw(16) << uind3[i] << '\n';
-  PCout << std::endl;
-#endif // DEBUG
+  // Note: redundant steps from increment_unique() are no longer repeated
+  // here: all cases of merge_unique follow either increment or push ops.
 
-  // Need to increment again as pop operations need to restore previous state
-  // after a non-permanent increment
-  /* MSE, 3/19/2019: seems redundant with same steps in increment_unique():
-     > all cases of merge_unique follow either increment or push operations
-     > only need to redo this is if merge ordering was modified by inc3
-       (if needed, check _inc3() ordering by activating DEBUG block above)
-  size_t start_index = sm_coeffs_ref.size();
-  update_unique_indices(start_index, num_u1, uind1, uset1, isu2, uind2, uset2,
-			unique_index_map);
-  assign_collocation_indices(colloc_key, unique_index_map, colloc_ind,
-			     start_index);
-  assign_sparse_points(colloc_ind, start_index, isu2, num_u1, a2_pts, pts);
-  if (trackUniqueProdWeights)
-    update_sparse_weights(start_index, colloc_key, colloc_ind, num_colloc_pts,
-			  sm_coeffs, sm_coeffs_ref, a1_t1w, a1_t2w, a2_t1w,
-			  a2_t2w, t1_wts, t2_wts);
-  */
-  // Promote a3 to a1: update a1 reference points/weights
-  //a1_pts = a3_pts; // equivalent, but potentially more copy overhead
+  // Promote a2 to a1: update a1 reference points/weights
+  int i, n1 = a1_pts.numCols(), n2 = a2_pts.numCols(), n1n2 = n1+n2;
   a1_pts.reshape(numVars, n1n2);
-  for (i=n1; i<n1n2; ++i)
-    copy_data(a3_pts[i], numVars, a1_pts[i]);
+  for (i=0; i<n2; ++i)
+    copy_data(a2_pts[i], numVars, a1_pts[n1+i]);
   if (trackUniqueProdWeights) {
     a1_t1w.resize(n1n2);
     if (computeType2Weights) a1_t2w.reshape(numVars, n1n2);
@@ -645,53 +606,14 @@ merge_unique_points_weights(const UShort2DArray& sm_mi,
 	copy_data(a2_t2w[i], numVars, a1_t2w[n1+i]);
     }
   }
-  // Promote a3 to a1: update reference indices, counts, radii
-  num_u1 = num_colloc_pts;
-  r1v = r3v;  sind1 = sind3;  uset1 = uset3;  uind1 = uind3;
-  copy_data(is_unique3, n1n2, isu1);
-  delete [] is_unique1; delete [] is_unique2; delete [] is_unique3;
-}
-
-
-void IncrementalSparseGridDriver::
-update_unique_indices(size_t start_index, int num_uniq1, const IntArray& xdnu1,
-		      const IntArray& undx1, const BitArray& isu2,
-		      const IntArray& xdnu2, const IntArray& undx2,
-		      IntArray& unique_index_map)
-{
-  int xdnu_j, a1_a2_index, a1_index, new_cntr = num_uniq1;
-
-  size_t i, n1 = xdnu1.size(), n2 = xdnu2.size();
-  unique_index_map.resize(n1+n2);
-
-  // first pass assigns unique indices
+  // Promote a2 to a1: update reference uniqueness flags and counts
+  isu1.resize(n1n2);
   for (i=0; i<n2; ++i)
-    if (isu2[i])
-      unique_index_map[n1+i] = new_cntr++;
-  // second pass refers back to unique indices and can be a forward reference
-  // (dictating two passes)
-  for (i=0; i<n2; ++i)
-    if (!isu2[i]) {
-      // XDNU2[N2] in point_radial_tol_unique_index_inc2() [sandia_rules.cpp]:
-      //   If the value represents an index in UNDX2, this can be inferred by
-      //   the fact that its value is >= UNIQUE_NUM1.  To reference UNDX2, the
-      //   value should then be decremented by UNIQUE_NUM1.
-      xdnu_j = xdnu2[i];
-      // UNDX2[UNIQUE_NUM2] in point_radial_tol_unique_index_inc2():
-      //   The index in A2 of the tolerably unique points, incremented by N1
-      // Note: xdnu --> undx --> recovers original point ordering
-      if (xdnu_j >= num_uniq1) {
-	a1_a2_index = undx2[xdnu_j - num_uniq1]; // - n1 for a2_index
-	unique_index_map[n1+i] = unique_index_map[a1_a2_index];
-      }
-      else {
-	a1_index = undx1[xdnu_j];
-	unique_index_map[n1+i] = unique_index_map[a1_index];
-      }
-    }
+    if (isu2[i]) isu1.set(n1+i);
+  num_u1 += num_u2;  num_colloc_pts = num_u1;
 
 #ifdef DEBUG
-  PCout << "Incremented map:\n" << unique_index_map;
+  PCout << "Merge unique: num_unique = " << num_colloc_pts << std::endl;
 #endif // DEBUG
 }
 
@@ -722,8 +644,8 @@ increment_sparse_points(const Sizet2DArray& colloc_ind, size_t start_index,
 
 
 void IncrementalSparseGridDriver::
-update_sparse_weights(size_t start_index, const UShort3DArray& colloc_key,
-		      const Sizet2DArray& colloc_ind, int num_colloc_pts,
+update_sparse_weights(size_t start_index, const Sizet2DArray& colloc_ind,
+		      int num_colloc_pts,
 		      const IntArray& sm_coeffs, const IntArray& sm_coeffs_ref,
 		      const RealVector& a1_t1_wts, const RealMatrix& a1_t2_wts,
 		      const RealVector& a2_t1_wts, const RealMatrix& a2_t2_wts,
@@ -740,12 +662,12 @@ update_sparse_weights(size_t start_index, const UShort3DArray& colloc_key,
     unique_t2_wts.reshape(numVars, num_colloc_pts); // new entries init to 0
 
   // back out changes in Smolyak coeff for existing index sets
-  size_t i, j, k, cntr, num_sm_mi = colloc_key.size(), num_tp_pts, uniq_index;
+  size_t i, j, k, cntr, num_tp_pts, uniq_index;
   for (i=0, cntr=0; i<start_index; ++i) {
     delta_coeff = sm_coeffs[i] - sm_coeffs_ref[i];
+    const SizetArray& colloc_ind_i = colloc_ind[i];
+    num_tp_pts = colloc_ind_i.size();
     if (delta_coeff) {
-      num_tp_pts = colloc_key[i].size();
-      const SizetArray& colloc_ind_i = colloc_ind[i];
       for (j=0; j<num_tp_pts; ++j, ++cntr) {
 	uniq_index = colloc_ind_i[j];
 	// assign tensor weights to unique weights
@@ -759,11 +681,11 @@ update_sparse_weights(size_t start_index, const UShort3DArray& colloc_key,
       }
     }
     else
-      cntr += colloc_key[i].size();
+      cntr += num_tp_pts;
   }
   // add contributions for new index sets
-  add_sparse_weights(start_index, colloc_key, colloc_ind, sm_coeffs,
-		     a2_t1_wts, a2_t2_wts, unique_t1_wts, unique_t2_wts);
+  add_sparse_weights(start_index, colloc_ind, sm_coeffs, a2_t1_wts,
+		     a2_t2_wts, unique_t1_wts, unique_t2_wts);
 
 #ifdef DEBUG
   PCout << "updated type1 weight sets =\n" << unique_t1_wts;
@@ -781,21 +703,14 @@ void IncrementalSparseGridDriver::clear_inactive()
 
   std::map<ActiveKey, int>::iterator nu1_it = numUnique1.begin();
   std::map<ActiveKey, int>::iterator nu2_it = numUnique2.begin();
-  std::map<ActiveKey, RealVector>::iterator z_it = zVec.begin();
-  std::map<ActiveKey, RealVector>::iterator r1_it = r1Vec.begin();
-  std::map<ActiveKey, RealVector>::iterator r2_it = r2Vec.begin();
+  std::map<ActiveKey, CollocPointIndexer>::iterator pi_it
+    = pointIndexer.begin();
   std::map<ActiveKey, RealMatrix>::iterator a1p_it = a1Points.begin();
   std::map<ActiveKey, RealVector>::iterator a11w_it = a1Type1Weights.begin();
   std::map<ActiveKey, RealMatrix>::iterator a12w_it = a1Type2Weights.begin();
   std::map<ActiveKey, RealMatrix>::iterator a2p_it = a2Points.begin();
   std::map<ActiveKey, RealVector>::iterator a21w_it = a2Type1Weights.begin();
   std::map<ActiveKey, RealMatrix>::iterator a22w_it = a2Type2Weights.begin();
-  std::map<ActiveKey, IntArray>::iterator si1_it = sortIndex1.begin();
-  std::map<ActiveKey, IntArray>::iterator si2_it = sortIndex2.begin();
-  std::map<ActiveKey, IntArray>::iterator us1_it = uniqueSet1.begin();
-  std::map<ActiveKey, IntArray>::iterator us2_it = uniqueSet2.begin();
-  std::map<ActiveKey, IntArray>::iterator ui1_it = uniqueIndex1.begin();
-  std::map<ActiveKey, IntArray>::iterator ui2_it = uniqueIndex2.begin();
   std::map<ActiveKey, BitArray>::iterator iu1_it = isUnique1.begin();
   std::map<ActiveKey, BitArray>::iterator iu2_it = isUnique2.begin();
   std::map<ActiveKey, IntArray>::iterator uim_it = uniqueIndexMapping.begin();
@@ -808,22 +723,17 @@ void IncrementalSparseGridDriver::clear_inactive()
 
   while (a1p_it != a1Points.end())
     if (a1p_it == a1PIter) { // preserve active
-      ++nu1_it; ++nu2_it; ++z_it; ++r1_it; ++r2_it; ++a1p_it; ++a11w_it;
-      ++a12w_it; ++a2p_it; ++a21w_it; ++a22w_it; ++si1_it; ++si2_it; ++us1_it;
-      ++us2_it; ++ui1_it; ++ui2_it; ++iu1_it; ++iu2_it; ++uim_it;
-      ++scr_it; //++pmi_it;
+      ++nu1_it; ++nu2_it; ++pi_it; ++a1p_it; ++a11w_it; ++a12w_it; ++a2p_it;
+      ++a21w_it; ++a22w_it; ++iu1_it; ++iu2_it; ++uim_it; ++scr_it;//++pmi_it;
       if (trackUniqueProdWeights)
 	{ ++t1r_it; if (computeType2Weights) ++t2r_it; }
     }
     else { // clear inactive: postfix increments manage iterator invalidations
       numUnique1.erase(nu1_it++);         numUnique2.erase(nu2_it++);
-      zVec.erase(z_it++); r1Vec.erase(r1_it++); r2Vec.erase(r2_it++);
+      pointIndexer.erase(pi_it++);
       a1Points.erase(a1p_it++);           a1Type1Weights.erase(a11w_it++);
       a1Type2Weights.erase(a12w_it++);    a2Points.erase(a2p_it++);
       a2Type1Weights.erase(a21w_it++);    a2Type2Weights.erase(a22w_it++);
-      sortIndex1.erase(si1_it++);         sortIndex2.erase(si2_it++);
-      uniqueSet1.erase(us1_it++);         uniqueSet2.erase(us2_it++);
-      uniqueIndex1.erase(ui1_it++);       uniqueIndex2.erase(ui2_it++);
       isUnique1.erase(iu1_it++);          isUnique2.erase(iu2_it++);
       uniqueIndexMapping.erase(uim_it++); smolyakCoeffsRef.erase(scr_it++);
       if (trackUniqueProdWeights) {
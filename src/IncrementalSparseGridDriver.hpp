@@ -77,6 +77,8 @@ public:
   //size_t finalize_index(size_t i, const ActiveKey& key) const;
 
   void compute_trial_grid(RealMatrix& var_sets);
+  void compute_trial_grids(const UShort2DArray& trial_sets,
+			   RealMatrix& var_sets, SizetArray& trial_offsets);
   void push_set();
   void pop_set();
   void finalize_sets(bool output_sets, bool converged_within_tol,
@@ -114,8 +116,6 @@ public:
 
   /// update smolyakMultiIndex and smolyakCoeffs
   void update_smolyak_arrays();
-  /// update collocKey for the trailing index sets within smolyakMultiIndex
-  void update_collocation_key();
 
   /// define a1{Points,Type1Weights,Type2Weights} based on the reference grid
   void reference_unique(bool update_1d_pts_wts = true);
@@ -134,26 +134,18 @@ private:
   /// modular helper for public increment_unique(size_t, bool)
   void increment_unique_points_weights(size_t start_index,
     const UShort2DArray& sm_mi, const IntArray& sm_coeffs,
-    const IntArray& sm_coeffs_ref, const UShort3DArray& colloc_key,
-    Sizet2DArray& colloc_ind, int& num_colloc_pts, RealMatrix& a1_pts,
+    const IntArray& sm_coeffs_ref, Sizet2DArray& colloc_ind, int& num_colloc_pts, RealMatrix& a1_pts,
     RealVector& a1_t1w, RealMatrix& a1_t2w,  RealMatrix& a2_pts,
-    RealVector& a2_t1w, RealMatrix& a2_t2w, RealVector& zv, RealVector& r1v,
-    RealVector& r2v, IntArray& sind1, BitArray& isu1, IntArray& uind1,
-    IntArray& uset1, int& num_u1, IntArray& sind2, BitArray& isu2,
-    IntArray& uind2, IntArray& uset2, int& num_u2, IntArray& unique_index_map,
+    RealVector& a2_t1w, RealMatrix& a2_t2w, CollocPointIndexer& indexer,
+    int num_u1, BitArray& isu2, int& num_u2, IntArray& unique_index_map,
     bool update_1d_pts_wts, RealMatrix& pts, RealVector& t1_wts,
     RealMatrix& t2_wts);
   /// modular helper for public merge_unique()
-  void merge_unique_points_weights(const UShort2DArray& sm_mi,
-    const IntArray& sm_coeffs, const IntArray& sm_coeffs_ref,
-    const UShort3DArray& colloc_key, Sizet2DArray& colloc_ind,
-    int& num_colloc_pts, RealMatrix& a1_pts, RealVector& a1_t1w,
-    RealMatrix& a1_t2w, RealMatrix& a2_pts, RealVector& a2_t1w,
-    RealMatrix& a2_t2w, RealVector& r1v, RealVector& r2v,
-    IntArray& sind1, BitArray& isu1, IntArray& uind1, IntArray& uset1,
-    int& num_u1, IntArray& sind2, BitArray& isu2, IntArray& uind2,
-    IntArray& uset2, int& num_u2, IntArray& unique_index_map,
-    RealMatrix& pts, RealVector& t1_wts, RealMatrix& t2_wts);
+  void merge_unique_points_weights(int& num_colloc_pts, RealMatrix& a1_pts,
+    RealVector& a1_t1w, RealMatrix& a1_t2w, const RealMatrix& a2_pts,
+    const RealVector& a2_t1w, const RealMatrix& a2_t2w,
+    CollocPointIndexer& indexer, BitArray& isu1, int& num_u1,
+    const BitArray& isu2, int num_u2);
 
   /// updates sm_mi from sm_coeffs after uniform/isotropic refinement
   void update_smolyak_arrays(UShort2DArray& sm_mi, IntArray& sm_coeffs);
@@ -168,12 +160,6 @@ private:
 				const IntArray& new_sm_coeffs,
 				UShort2DArray& sm_mi, IntArray& sm_coeffs);
 
-  /// define an increment to the collocation indices
-  void update_unique_indices(size_t start_index, int num_uniq1,
-			     const IntArray& xdnu1, const IntArray& undx1,
-			     const BitArray& isu2,  const IntArray& xdnu2,
-			     const IntArray& undx2, IntArray& unique_index_map);
-
   /// process raw a2 points to create a unique point set increment
   void increment_sparse_points(const Sizet2DArray& colloc_ind,
 			       size_t start_index,
@@ -189,7 +175,6 @@ private:
   /// convenience function for updating sparse weights from two sets of
   /// tensor weights and updated coefficients
   void update_sparse_weights(size_t start_index,
-			     const UShort3DArray& colloc_key,
 			     const Sizet2DArray& colloc_ind, int num_colloc_pts,
 			     const IntArray& sm_coeffs,
 			     const IntArray& sm_coeffs_ref,
@@ -199,6 +184,8 @@ private:
 			     const RealMatrix& a2_t2_wts,
 			     RealVector& unique_t1_wts,
 			     RealMatrix& unique_t2_wts);
+  /// restore the reference grid following evaluation of a trial set
+  void pop_trial_grid();
   /// restore type{1,2}WeightSets to reference values
   void pop_weights();
 
@@ -230,12 +217,11 @@ private:
   /// active entry within numUnique2
   std::map<ActiveKey, int>::iterator numUniq2Iter;
 
-  /// random vector used within sgmgg for sorting
-  std::map<ActiveKey, RealVector> zVec;
-  /// distance values for sorting in set 1 (reference)
-  std::map<ActiveKey, RealVector> r1Vec;
-  /// distance values for sorting in set 2 (increment)
-  std::map<ActiveKey, RealVector> r2Vec;
+  /// symbolic identification of unique points in the reference and
+  /// increment sets (retains the reference point ids across increments)
+  std::map<ActiveKey, CollocPointIndexer> pointIndexer;
+  /// active entry within pointIndexer
+  std::map<ActiveKey, CollocPointIndexer>::iterator pointIndIter;
 
   /// array of collocation points in set 1 (reference)
   std::map<ActiveKey, RealMatrix> a1Points;
@@ -263,29 +249,6 @@ private:
   /// active entry within a2Type2Weights
   std::map<ActiveKey, RealMatrix>::iterator a2T2WIter;
 
-  /// ascending sort index for set 1 (reference)
-  std::map<ActiveKey, IntArray> sortIndex1;
-  /// ascending sort index for set 2 (increment)
-  std::map<ActiveKey, IntArray> sortIndex2;
-
-  /// index within a1 (reference set) of unique points
-  std::map<ActiveKey, IntArray> uniqueSet1;
-  /// active entry within uniqueSet1
-  std::map<ActiveKey, IntArray>::iterator uniqSet1Iter;
-  /// index within a2 (increment set) of unique points
-  std::map<ActiveKey, IntArray> uniqueSet2;
-  /// active entry within uniqueSet2
-  std::map<ActiveKey, IntArray>::iterator uniqSet2Iter;
-
-  /// index within uniqueSet1 corresponding to all of a1
-  std::map<ActiveKey, IntArray> uniqueIndex1;
-  /// active entry within uniqueIndex1
-  std::map<ActiveKey, IntArray>::iterator uniqInd1Iter;
-  /// index within uniqueSet2 corresponding to all of a2
-  std::map<ActiveKey, IntArray> uniqueIndex2;
-  /// active entry within uniqueIndex2
-  std::map<ActiveKey, IntArray>::iterator uniqInd2Iter;
-
   /// key to unique points in set 1 (reference)
   std::map<ActiveKey, BitArray> isUnique1;
   /// active entry within isUnique1
@@ -329,10 +292,7 @@ inline void IncrementalSparseGridDriver::update_active_iterators()
   a2T2WIter    = a2Type2Weights.find(activeKey);
   numUniq1Iter = numUnique1.find(activeKey);
   numUniq2Iter = numUnique2.find(activeKey);
-  uniqSet1Iter = uniqueSet1.find(activeKey);
-  uniqSet2Iter = uniqueSet2.find(activeKey);
-  uniqInd1Iter = uniqueIndex1.find(activeKey);
-  uniqInd2Iter = uniqueIndex2.find(activeKey);
+  pointIndIter = pointIndexer.find(activeKey);
   isUniq1Iter  = isUnique1.find(activeKey);
   isUniq2Iter  = isUnique2.find(activeKey);
 
@@ -343,11 +303,9 @@ inline void IncrementalSparseGridDriver::update_active_iterators()
       a1T2WIter  == a1Type2Weights.end() || a2PIter   == a2Points.end()       ||
       a2T1WIter  == a2Type1Weights.end() || a2T2WIter == a2Type2Weights.end() ||
       numUniq1Iter == numUnique1.end()   || numUniq2Iter == numUnique2.end()  ||
-      uniqSet1Iter == uniqueSet1.end()   || uniqSet2Iter == uniqueSet2.end()  ||
-      uniqInd1Iter == uniqueIndex1.end() ||
-      uniqInd2Iter == uniqueIndex2.end() ||
+      pointIndIter == pointIndexer.end() ||
       isUniq1Iter == isUnique1.end()     || isUniq2Iter  == isUnique2.end())
-    active_copy = activeKey.copy();
+    active_copy = activeKey.interned();
   */
 
   if (a1PIter == a1Points.end()) {
@@ -388,21 +346,10 @@ inline void IncrementalSparseGridDriver::update_active_iterators()
     std::pair<ActiveKey, int> i_pair(activeKey/*active_copy*/, 0);
     numUniq2Iter = numUnique2.insert(i_pair).first;
   }
-  if (uniqSet1Iter == uniqueSet1.end()) {
-    std::pair<ActiveKey, IntArray> ia_pair(activeKey/*active_copy*/,IntArray());
-    uniqSet1Iter = uniqueSet1.insert(ia_pair).first;
-  }
-  if (uniqSet2Iter == uniqueSet2.end()) {
-    std::pair<ActiveKey, IntArray> ia_pair(activeKey/*active_copy*/,IntArray());
-    uniqSet2Iter = uniqueSet2.insert(ia_pair).first;
-  }
-  if (uniqInd1Iter == uniqueIndex1.end()) {
-    std::pair<ActiveKey, IntArray> ia_pair(activeKey/*active_copy*/,IntArray());
-    uniqInd1Iter = uniqueIndex1.insert(ia_pair).first;
-  }
-  if (uniqInd2Iter == uniqueIndex2.end()) {
-    std::pair<ActiveKey, IntArray> ia_pair(activeKey/*active_copy*/,IntArray());
-    uniqInd2Iter = uniqueIndex2.insert(ia_pair).first;
+  if (pointIndIter == pointIndexer.end()) {
+    std::pair<ActiveKey, CollocPointIndexer>
+      cpi_pair(activeKey/*active_copy*/, CollocPointIndexer());
+    pointIndIter = pointIndexer.insert(cpi_pair).first;
   }
   if (isUniq1Iter == isUnique1.end()) {
     std::pair<ActiveKey, BitArray> ba_pair(activeKey/*active_copy*/,BitArray());
@@ -424,9 +371,6 @@ inline void IncrementalSparseGridDriver::clear_keys()
   smolyakCoeffsRef.clear();
   type1WeightSetsRef.clear(); type2WeightSetsRef.clear();
 
-  zVec.clear();            r1Vec.clear();          r2Vec.clear();
-  sortIndex1.clear();      sortIndex2.clear();
-
   numUnique1.clear();      numUniq1Iter = numUnique1.end();
   numUnique2.clear();      numUniq2Iter = numUnique2.end();
   a1Points.clear();        a1PIter      = a1Points.end();
@@ -435,10 +379,7 @@ inline void IncrementalSparseGridDriver::clear_keys()
   a2Points.clear();        a2PIter      = a2Points.end();
   a2Type1Weights.clear();  a2T1WIter    = a2Type1Weights.end();
   a2Type2Weights.clear();  a2T2WIter    = a2Type2Weights.end();
-  uniqueSet1.clear();      uniqSet1Iter = uniqueSet1.end();
-  uniqueSet2.clear();      uniqSet2Iter = uniqueSet2.end();
-  uniqueIndex1.clear();    uniqInd1Iter = uniqueIndex1.end();
-  uniqueIndex2.clear();    uniqInd2Iter = uniqueIndex2.end();
+  pointIndexer.clear();    pointIndIter = pointIndexer.end();
   isUnique1.clear();       isUniq1Iter  = isUnique1.end();
   isUnique2.clear();       isUniq2Iter  = isUnique2.end();
 }
@@ -454,11 +395,13 @@ inline void IncrementalSparseGridDriver::compute_grid(RealMatrix& var_sets)
 inline void IncrementalSparseGridDriver::
 reference_unique(bool update_1d_pts_wts)
 {
+  // update_smolyak_arrays() may redefine leading sets (e.g., for a new level
+  // or anisotropy), so any prior collocKey is rebuilt on demand
+  clear_collocation_key();
   compute_unique_points_weights(smolMIIter->second, smolCoeffsIter->second,
-    collocKeyIter->second, collocIndIter->second, numPtsIter->second,
-    a1PIter->second, a1T1WIter->second, a1T2WIter->second, zVec[activeKey],
-    r1Vec[activeKey], sortIndex1[activeKey], isUniq1Iter->second,
-    uniqInd1Iter->second, uniqSet1Iter->second, numUniq1Iter->second,
+    collocIndIter->second, numPtsIter->second,
+    a1PIter->second, a1T1WIter->second, a1T2WIter->second,
+    pointIndIter->second, isUniq1Iter->second, numUniq1Iter->second,
     uniqIndMapIter->second, update_1d_pts_wts, varSetsIter->second,
     t1WtIter->second, t2WtIter->second);
 }
@@ -468,29 +411,21 @@ inline void IncrementalSparseGridDriver::
 increment_unique(size_t start_index, bool update_1d_pts_wts)
 {
   increment_unique_points_weights(start_index, smolMIIter->second,
-    smolCoeffsIter->second, smolyakCoeffsRef[activeKey], collocKeyIter->second,
-    collocIndIter->second, numPtsIter->second, a1PIter->second,
+    smolCoeffsIter->second, smolyakCoeffsRef[activeKey], collocIndIter->second, numPtsIter->second, a1PIter->second,
     a1T1WIter->second, a1T2WIter->second, a2PIter->second, a2T1WIter->second,
-    a2T2WIter->second, zVec[activeKey], r1Vec[activeKey], r2Vec[activeKey],
-    sortIndex1[activeKey], isUniq1Iter->second, uniqInd1Iter->second,
-    uniqSet1Iter->second, numUniq1Iter->second, sortIndex2[activeKey],
-    isUniq2Iter->second,  uniqInd2Iter->second, uniqSet2Iter->second,
-    numUniq2Iter->second, uniqIndMapIter->second, update_1d_pts_wts,
-    varSetsIter->second,  t1WtIter->second, t2WtIter->second);
+    a2T2WIter->second, pointIndIter->second, numUniq1Iter->second,
+    isUniq2Iter->second, numUniq2Iter->second, uniqIndMapIter->second,
+    update_1d_pts_wts, varSetsIter->second, t1WtIter->second,
+    t2WtIter->second);
 }
 
 
 inline void IncrementalSparseGridDriver::merge_unique()
 {
-  merge_unique_points_weights(smolMIIter->second, smolCoeffsIter->second,
-    smolyakCoeffsRef[activeKey], collocKeyIter->second, collocIndIter->second,
-    numPtsIter->second, a1PIter->second, a1T1WIter->second, a1T2WIter->second,
-    a2PIter->second, a2T1WIter->second, a2T2WIter->second, r1Vec[activeKey],
-    r2Vec[activeKey], sortIndex1[activeKey], isUniq1Iter->second,
-    uniqInd1Iter->second, uniqSet1Iter->second, numUniq1Iter->second,
-    sortIndex2[activeKey], isUniq2Iter->second, uniqInd2Iter->second,
-    uniqSet2Iter->second, numUniq2Iter->second, uniqIndMapIter->second,
-    varSetsIter->second, t1WtIter->second, t2WtIter->second);
+  merge_unique_points_weights(numPtsIter->second, a1PIter->second,
+    a1T1WIter->second, a1T2WIter->second, a2PIter->second, a2T1WIter->second,
+    a2T2WIter->second, pointIndIter->second, isUniq1Iter->second,
+    numUniq1Iter->second, isUniq2Iter->second, numUniq2Iter->second);
 }
 
 
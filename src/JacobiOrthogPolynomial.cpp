@@ -156,6 +156,29 @@ Real JacobiOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 }
 
 
+/** See Abramowitz & Stegun, Section 22.7, p.782, normalized by the
+    leading coefficient.  The first step is special-cased since its
+    general form is singular for alphaPoly + betaPoly = 0 or -1. */
+bool JacobiOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  if (!max_order)
+    return true;
+  Real apbp = alphaPoly + betaPoly, amb = alphaPoly - betaPoly;
+  a[0] = (apbp + 2.)/2.;  b[0] = amb/2.;  c[0] = 0.;
+  for (unsigned short n=1; n<max_order; ++n) {
+    Real ab2n = apbp + 2.*n, denom = 2.*(n+1.)*(n+apbp+1.)*ab2n;
+    a[n] = pochhammer(ab2n, 3) / denom;
+    b[n] = (ab2n+1.)*apbp*amb  / denom;
+    c[n] = 2.*(n+alphaPoly)*(n+betaPoly)*(ab2n+2.) / denom;
+  }
+  return true;
+}
+
+
 Real JacobiOrthogPolynomial::norm_squared(unsigned short order)
 {
   Real apbp1 = alphaPoly + betaPoly + 1.;
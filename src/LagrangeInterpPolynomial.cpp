@@ -66,25 +66,24 @@ void LagrangeInterpPolynomial::set_new_point(Real x, short request_order)
   // second form of barycentric interpolation: precompute value factors and
   // grad factor terms or identify exactIndex
   size_t j, num_interp_pts = interpPts.size();
-  Real diff_inv_sum; RealVector diffs;
+  Real diff_inv_sum, diff_j;
   if (exactIndex == _NPOS) { // exact match may have been previously detected
-    // first, compute diffs vector or exactIndex
-    diffs.sizeUninitialized(num_interp_pts);
-    for (j=0; j<num_interp_pts; ++j) {
-      diffs[j] = newPoint - interpPts[j];
-      if (diffs[j] == 0.) // no tolerance needed due to favorable stability
+    // first, detect exactIndex (differences are recomputed below rather
+    // than stored, avoiding a temporary allocation per point)
+    for (j=0; j<num_interp_pts; ++j)
+      if (newPoint == interpPts[j]) // no tolerance needed: favorable stability
 	{ exactIndex = exactDeltaIndex = j; break; }
-    }
 
     // now compute value factors and grad factor terms based on exactIndex
     if (exactIndex == _NPOS) {
       if (compute_order & 1) bcValueFactorSum = 0.;
       if (compute_order & 2) { diffProduct = 1.; diff_inv_sum = 0.; }
       for (j=0; j<num_interp_pts; ++j) {
+	diff_j = newPoint - interpPts[j];
 	if (compute_order & 1)
-	  bcValueFactorSum += bcValueFactors[j] = bcWeights[j] / diffs[j];
+	  bcValueFactorSum += bcValueFactors[j] = bcWeights[j] / diff_j;
 	if (compute_order & 2)
-	  { diffProduct *= diffs[j]; diff_inv_sum += 1. / diffs[j]; }
+	  { diffProduct *= diff_j; diff_inv_sum += 1. / diff_j; }
       }
     }
   }
@@ -102,7 +101,7 @@ void LagrangeInterpPolynomial::set_new_point(Real x, short request_order)
     if (exactIndex == _NPOS)
       for (j=0; j<num_interp_pts; ++j) // bcValueFactors must be available
 	bcGradFactors[j] = bcValueFactors[j] // * diffProduct
-	  * (diff_inv_sum - 1. / diffs[j]); // back out jth inverse diff
+	  * (diff_inv_sum - 1. / (newPoint - interpPts[j])); // back out jth
     else { // Berrut and Trefethen, 2004
       // for this case, bcGradFactors are the actual gradient values
       // and no diffProduct scaling needs to be subsequently applied
@@ -131,16 +130,13 @@ set_new_point(Real x, short request_order, const UShortArray& delta_key)
   // grad factor terms or identify exactIndex
   size_t j, vj, num_interp_pts = interpPts.size(),
     num_delta_pts = delta_key.size();
-  Real diff_inv_sum; RealVector diffs;
+  Real diff_inv_sum, diff_j;
 
   if (exactIndex == _NPOS) { // exact match may have been previously detected
-    // compute diffs vector and detect exactIndex within all of interpPts
-    diffs.sizeUninitialized(num_interp_pts);
-    for (j=0; j<num_interp_pts; ++j) {
-      diffs[j] = newPoint - interpPts[j];
-      if (diffs[j] == 0.) // no tol reqd due to favorable stability
+    // detect exactIndex within all of interpPts
+    for (j=0; j<num_interp_pts; ++j)
+      if (newPoint == interpPts[j]) // no tol reqd due to favorable stability
 	{ exactIndex = j; break; }
-    }
     // detect exactDeltaIndex within delta points only
     // (see, for example, InterpPolyApproximation::barycentric_exact_index())
     exactDeltaIndex = (exactIndex == _NPOS) ? _NPOS :
@@ -151,10 +147,11 @@ set_new_point(Real x, short request_order, const UShortArray& delta_key)
       if (compute_order & 1) bcValueFactorSum = 0.;
       if (compute_order & 2) { diffProduct = 1.; diff_inv_sum = 0.; }
       for (j=0; j<num_interp_pts; ++j) {
+	diff_j = newPoint - interpPts[j];
 	if (compute_order & 1)
-	  bcValueFactorSum += bcValueFactors[j] = bcWeights[j] / diffs[j];
+	  bcValueFactorSum += bcValueFactors[j] = bcWeights[j] / diff_j;
 	if (compute_order & 2)
-	  { diffProduct *= diffs[j]; diff_inv_sum += 1. / diffs[j]; }
+	  { diffProduct *= diff_j; diff_inv_sum += 1. / diff_j; }
       }
     }
   }
@@ -173,7 +170,7 @@ set_new_point(Real x, short request_order, const UShortArray& delta_key)
       for (j=0; j<num_delta_pts; ++j) { // bcValueFactors must be available
 	vj = delta_key[j];
 	bcGradFactors[vj] = bcValueFactors[vj] // * diffProduct
-	  * (diff_inv_sum - 1. / diffs[vj]); // back out vj-th inverse diff
+	  * (diff_inv_sum - 1. / (newPoint - interpPts[vj])); // back out vj
       }
     else { // Berrut and Trefethen, 2004
       // for this case, bcGradFactors are the actual gradient values
@@ -188,6 +185,119 @@ set_new_point(Real x, short request_order, const UShortArray& delta_key)
 }
 
 
+/** Stateless counterpart to set_new_point(x, 1) for a block of num_x
+    points, for use in batched evaluation.  The factors w_j/(x_k-x_j)
+    are returned in value_factors(k,j), such that the factors for each
+    interpolation point are contiguous over the block, and their sums in
+    value_factor_sums[k].  If x_k matches interpolation point j exactly,
+    exact_indices[k] = j and the factors reduce to the Lagrange values
+    (a unit vector with unit sum); otherwise exact_indices[k] = _NPOS.
+    Caller-provided buffers are only resized when their shape changes. */
+void LagrangeInterpPolynomial::
+barycentric_value_factors(const Real* x, size_t num_x,
+			  RealMatrix& value_factors,
+			  RealVector& value_factor_sums,
+			  SizetArray& exact_indices) const
+{
+  allocate_factors(num_x, value_factors, value_factor_sums, exact_indices);
+
+  size_t j, k, num_interp_pts = interpPts.size();
+  Real pt_j, wt_j, diff, *vf_j, *vf_sums = value_factor_sums.values();
+  for (j=0; j<num_interp_pts; ++j) {
+    pt_j = interpPts[j];  wt_j = bcWeights[j];  vf_j = value_factors[j];
+    for (k=0; k<num_x; ++k) {
+      diff = x[k] - pt_j;
+      if (diff == 0.) // no tolerance needed due to favorable stability
+	{ exact_indices[k] = j;  vf_j[k] = 0.; }
+      else
+	vf_sums[k] += vf_j[k] = wt_j / diff;
+    }
+  }
+
+  exact_value_factors(num_x, value_factors, value_factor_sums, exact_indices);
+}
+
+
+/** Stateless counterpart to set_new_point(x, 3) for a block of num_x
+    points.  Value factors and exact indices are as for
+    barycentric_value_factors().  Gradient factors are scaled by
+    diff_products[k] = prod_j (x_k - x_j) to obtain the derivatives of
+    the Lagrange polynomials; for exact matches, the gradient factors are
+    the derivatives themselves (Berrut and Trefethen, 2004) and
+    diff_products[k] = 1. */
+void LagrangeInterpPolynomial::
+barycentric_factors(const Real* x, size_t num_x, RealMatrix& value_factors,
+		    RealVector& value_factor_sums, RealMatrix& grad_factors,
+		    RealVector& diff_products, SizetArray& exact_indices) const
+{
+  allocate_factors(num_x, value_factors, value_factor_sums, exact_indices);
+  size_t j, k, e, num_interp_pts = interpPts.size();
+  if (grad_factors.numRows() != num_x ||
+      grad_factors.numCols() != num_interp_pts)
+    grad_factors.shapeUninitialized(num_x, num_interp_pts);
+  if (diff_products.length() != num_x)
+    diff_products.size(num_x); // init to 0
+  else
+    diff_products = 0.;
+
+  // value factors and their sums; diff_products temporarily accumulates
+  // the sums of inverse differences
+  Real pt_j, wt_j, diff, *vf_j, *gf_j, *vf_sums = value_factor_sums.values(),
+    *dp = diff_products.values();
+  for (j=0; j<num_interp_pts; ++j) {
+    pt_j = interpPts[j];  wt_j = bcWeights[j];  vf_j = value_factors[j];
+    for (k=0; k<num_x; ++k) {
+      diff = x[k] - pt_j;
+      if (diff == 0.)
+	{ exact_indices[k] = j;  vf_j[k] = 0.; }
+      else
+	{ vf_sums[k] += vf_j[k] = wt_j / diff;  dp[k] += 1. / diff; }
+    }
+  }
+  // gradient factors back out the jth inverse difference
+  for (j=0; j<num_interp_pts; ++j) {
+    pt_j = interpPts[j];  vf_j = value_factors[j];  gf_j = grad_factors[j];
+    for (k=0; k<num_x; ++k) {
+      diff = x[k] - pt_j;
+      gf_j[k] = (diff == 0.) ? 0. : vf_j[k] * (dp[k] - 1. / diff);
+    }
+  }
+  // difference products
+  diff_products = 1.;
+  for (j=0; j<num_interp_pts; ++j) {
+    pt_j = interpPts[j];
+    for (k=0; k<num_x; ++k)
+      dp[k] *= x[k] - pt_j;
+  }
+
+  exact_value_factors(num_x, value_factors, value_factor_sums, exact_indices);
+  for (k=0; k<num_x; ++k)
+    if ( (e = exact_indices[k]) != _NPOS) {
+      dp[k] = 1.;
+      Real& gf_ke = grad_factors(k,e);  gf_ke = 0.;
+      for (j=0; j<num_interp_pts; ++j)
+	if (j != e)
+	  gf_ke -= grad_factors(k,j) = bcWeights[j] / bcWeights[e]
+	    / (interpPts[e] - interpPts[j]);
+    }
+}
+
+
+void LagrangeInterpPolynomial::
+exact_value_factors(size_t num_x, RealMatrix& value_factors,
+		    RealVector& value_factor_sums,
+		    const SizetArray& exact_indices) const
+{
+  size_t j, k, e, num_interp_pts = interpPts.size();
+  for (k=0; k<num_x; ++k)
+    if ( (e = exact_indices[k]) != _NPOS) {
+      for (j=0; j<num_interp_pts; ++j)
+	value_factors(k,j) = 0.;
+      value_factors(k,e) = value_factor_sums[k] = 1.;
+    }
+}
+
+
 /** Compute value of the Lagrange polynomial (1st barycentric form)
     corresponding to interpolation point i using data from previous
     call to set_new_point(). */
@@ -83,6 +83,16 @@ public:
   Real barycentric_value_factor_sum() const;
   Real barycentric_difference_product() const;
 
+  void barycentric_value_factors(const Real* x, size_t num_x,
+				 RealMatrix& value_factors,
+				 RealVector& value_factor_sums,
+				 SizetArray& exact_indices) const;
+  void barycentric_factors(const Real* x, size_t num_x,
+			   RealMatrix& value_factors,
+			   RealVector& value_factor_sums,
+			   RealMatrix& grad_factors, RealVector& diff_products,
+			   SizetArray& exact_indices) const;
+
 protected:
 
   //
@@ -101,6 +111,15 @@ private:
   void init_new_point(Real x, short request_order, short& compute_order);
   /// based on compute order, size barycentric value/gradient factors
   void allocate_factors(short compute_order);
+  /// size the caller-provided buffers for batched barycentric factors
+  void allocate_factors(size_t num_x, RealMatrix& value_factors,
+			RealVector& value_factor_sums,
+			SizetArray& exact_indices) const;
+  /// overwrite batched value factors for points matching an interpolation
+  /// point, such that the factors become the Lagrange values
+  void exact_value_factors(size_t num_x, RealMatrix& value_factors,
+			   RealVector& value_factor_sums,
+			   const SizetArray& exact_indices) const;
 
   //
   //- Heading: Data
@@ -173,6 +192,30 @@ inline void LagrangeInterpPolynomial::allocate_factors(short compute_order)
 }
 
 
+/** Shared initialization code for batched factors. */
+inline void LagrangeInterpPolynomial::
+allocate_factors(size_t num_x, RealMatrix& value_factors,
+		 RealVector& value_factor_sums, SizetArray& exact_indices) const
+{
+  size_t num_interp_pts = interpPts.size();
+  if (bcWeights.length() != num_interp_pts) {
+    PCerr << "Error: length of precomputed bcWeights (" << bcWeights.length()
+	  << ") is inconsistent with number of collocation points ("
+	  << num_interp_pts << ")." << std::endl;
+    abort_handler(-1);
+  }
+
+  if (value_factors.numRows() != num_x ||
+      value_factors.numCols() != num_interp_pts)
+    value_factors.shapeUninitialized(num_x, num_interp_pts);
+  if (value_factor_sums.length() != num_x)
+    value_factor_sums.size(num_x); // init to 0
+  else
+    value_factor_sums = 0.;
+  exact_indices.assign(num_x, _NPOS);
+}
+
+
 inline size_t LagrangeInterpPolynomial::exact_index() const
 { return exactIndex; }
 
@@ -177,6 +177,19 @@ Real LaguerreOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 }
 
 
+bool LaguerreOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  // (n+1) L_{n+1} = (2n+1-x) L_n - n L_{n-1}
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  for (unsigned short n=0; n<max_order; ++n)
+    { a[n] = -1./(n+1.); b[n] = (2.*n+1.)/(n+1.); c[n] = n/(n+1.); }
+  return true;
+}
+
+
 Real LaguerreOrthogPolynomial::norm_squared(unsigned short order)
 { return 1.; }
 
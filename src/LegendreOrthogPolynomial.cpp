@@ -183,6 +183,19 @@ Real LegendreOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 }
 
 
+bool LegendreOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  // (n+1) P_{n+1} = (2n+1) x P_n - n P_{n-1}
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  for (unsigned short n=0; n<max_order; ++n)
+    { a[n] = (2.*n+1.)/(n+1.); b[n] = 0.; c[n] = n/(n+1.); }
+  return true;
+}
+
+
 Real LegendreOrthogPolynomial::norm_squared(unsigned short order)
 {
   // Abramowitz & Stegun: w(x) = 1
@@ -550,29 +550,17 @@ tensor_product_mean(const RealVector& x, const RealVector& exp_t1_coeffs,
     */
   }
   else {
-    // Horner's rule approach:
-    //PCout << "tensor_product_mean(): Horner's no derivs." << std::endl;
-    RealVector accumulator(num_v); // init to 0.
-    const Real3DArray& t1_wts_1d = driver_rep->type1_collocation_weights_1d();
-    unsigned short       li_0 = lev_index[0];
-    BasisPolynomial&   poly_0 = data_rep->polynomialBasis[li_0][0];
-    const RealArray& t1_wts_0 = t1_wts_1d[li_0][0];
-    size_t c_index; bool rand_0 = data_rep->randomVarsKey[0]; Real x0 = x[0];
-    unsigned short key_i0, max0 = poly_0.interpolation_size() - 1;
-    for (i=0; i<num_colloc_pts; ++i) {
-      const UShortArray& key_i = colloc_key[i]; key_i0 = key_i[0];
-      c_index = (colloc_index.empty()) ? i : colloc_index[i];
-      if (li_0 == 0)   // single integration/interpolation weight = 1
-	accumulator[0]  = exp_t1_coeffs[c_index];
-      else if (rand_0) // integration
-	accumulator[0] += exp_t1_coeffs[c_index] * t1_wts_0[key_i0];
-      else             // interpolation
-	accumulator[0] += exp_t1_coeffs[c_index]
-	               *  poly_0.type1_value(x0, key_i0);
-      if (key_i0 == max0)
-	data_rep->accumulate_horners(accumulator, lev_index, key_i, x);
-    }
-    return accumulator[num_v-1];
+    // Sum factorization: contract the tensor of coefficients one dimension
+    // at a time using 1D weights (integration) and cached 1D interpolant
+    // values (interpolation).
+    //PCout << "tensor_product_mean(): sum factorization." << std::endl;
+    RealArray tensor(num_colloc_pts); UShortArray dims;
+    for (i=0; i<num_colloc_pts; ++i)
+      tensor[i] = (colloc_index.empty()) ?
+	exp_t1_coeffs[i] : exp_t1_coeffs[colloc_index[i]];
+    data_rep->tensor_dimensions(lev_index, dims);
+    data_rep->contract_tensor(x, lev_index, tensor, dims);
+    return tensor[0];
 
     /*
     // Simpler but more expensive approach:
@@ -1136,29 +1124,18 @@ tensor_product_covariance(const RealVector& x, Real mean_1, Real mean_2,
       */
     }
     else {
-      // Horner's rule approach:
-      RealVector accumulator(num_v); // init to 0.
-      unsigned short       li_0 = lev_index[0];
-      BasisPolynomial&   poly_0 = data_rep->polynomialBasis[li_0][0];
-      const RealArray& t1_wts_0 = t1_wts_1d[li_0][0]; // li==li for integrated
-      unsigned short key_i0, max0 = poly_0.interpolation_size() - 1;
-      bool rand_0 = data_rep->randomVarsKey[0]; Real x0 = x[0];
+      // Sum factorization: contract the tensor of central products one
+      // dimension at a time using 1D weights (integration) and cached 1D
+      // interpolant values (interpolation).
+      RealArray tensor(num_colloc_pts); UShortArray dims;
       for (i=0; i<num_colloc_pts; ++i) {
 	c_index_i = (colloc_index.empty()) ? i : colloc_index[i];
-	t1_coeff_1_mm1 = exp_t1c_1[c_index_i] - mean_1;
-	t1_coeff_2_mm2 = exp_t1c_2[c_index_i] - mean_2;
-	const UShortArray& key_i = colloc_key[i]; key_i0 = key_i[0];
-	if (li_0 == 0)   // single integration/interpolation weight = 1
-	  accumulator[0]  = t1_coeff_1_mm1 * t1_coeff_2_mm2;
-	else if (rand_0) // integration
-	  accumulator[0] += t1_coeff_1_mm1 * t1_coeff_2_mm2 * t1_wts_0[key_i0];
-	else             // interpolation
-	  accumulator[0] += t1_coeff_1_mm1 * t1_coeff_2_mm2 *
-	    poly_0.type1_value(x0, key_i0);
-	if (key_i0 == max0)
-	  data_rep->accumulate_horners(accumulator, lev_index, key_i, x);
+	tensor[i] = (exp_t1c_1[c_index_i] - mean_1)
+	          * (exp_t1c_2[c_index_i] - mean_2);
       }
-      return accumulator[num_v-1];
+      data_rep->tensor_dimensions(lev_index, dims);
+      data_rep->contract_tensor(x, lev_index, tensor, dims);
+      return tensor[0];
 
       /*
       // Simpler but more expensive approach:
@@ -2238,6 +2215,12 @@ tensor_product_variance_gradient(const RealVector& x, Real mean,
 }
 
 
+/** Rather than a double loop over the tensor points that pairs points
+    with matching random keys, the central coefficients for each response
+    are first contracted over the non-random dimensions (interpolation),
+    which collapses the points sharing a random key.  The product of the
+    two contracted tensors is then contracted over the random dimensions
+    (integration). */
 Real NodalInterpPolyApproximation::
 product_of_interpolants(const RealVector& x, Real mean_1, Real mean_2,
 			const RealVector& exp_t1c_1,
@@ -2250,49 +2233,27 @@ product_of_interpolants(const RealVector& x, Real mean_1, Real mean_2,
 {
   std::shared_ptr<SharedNodalInterpPolyApproxData> data_rep =
     std::static_pointer_cast<SharedNodalInterpPolyApproxData>(sharedDataRep);
-  size_t i, j, c_index_i, c_index_j, num_colloc_pts = colloc_key.size(),
-    num_v = sharedDataRep->numVars;
-  Real tp_covar = 0., t1_wt_Ls_prod_i, t1_coeff_1_mm1, t1_coeff_2_mm2;
+  size_t i, c_index_i, num_colloc_pts = colloc_key.size();
+  RealArray tensor_1(num_colloc_pts), tensor_2(num_colloc_pts);
   for (i=0; i<num_colloc_pts; ++i) {
-    const UShortArray& key_i = colloc_key[i];
     c_index_i = (colloc_index.empty()) ? i : colloc_index[i];
-    t1_coeff_1_mm1  = exp_t1c_1[c_index_i] - mean_1;
-    t1_wt_Ls_prod_i
-      = data_rep->type1_weight(key_i, lev_index, data_rep->randomIndices)
-      * data_rep->type1_interpolant_value(x, key_i, lev_index,
-					    data_rep->nonRandomIndices);
-    for (j=0; j<num_colloc_pts; ++j) {
-      const UShortArray& key_j = colloc_key[j];
-      // to include the ij-th term,  basis i must be the same as basis j for
-      // the random var subset.  In this case, wt_prod_i may be reused.  Note
-      // that it is not necessary to collapse terms with the same random basis
-      // subset, since cross term in (a+b)(a+b) = a^2+2ab+b^2 gets included.
-      // If terms were collapsed (following eval of non-random portions), the
-      // nested loop could be replaced with a single loop to evaluate (a+b)^2.
-      if (data_rep->match_random_key(key_i, key_j)) {
-	c_index_j = (colloc_index.empty()) ? j : colloc_index[j];
-	t1_coeff_2_mm2 = exp_t1c_2[c_index_j] - mean_2;
-	tp_covar += t1_coeff_1_mm1 * t1_coeff_2_mm2 * t1_wt_Ls_prod_i *
-	  data_rep->type1_interpolant_value(x, key_j, lev_index,
-					    data_rep->nonRandomIndices);
-	/* TO DO
-	if (data_rep->basisConfigOptions.useDerivs) {
-	  const Real *t2_coeff_1i = exp_t2c_1[c_index_i],
-	             *t2_coeff_2i = exp_t2c_2[c_index_i];
-	  for (j=0; j<num_v; ++j)
-	    tp_covar += (t1_coeff_1i_mm1 * t2_coeff_2i[j] +
-	                 t1_coeff_2i_mm2 * t2_coeff_1i[j])
-	      * data_rep->type2_interpolant_value(x, j, key_i, lev_index,
-	                                          data_rep->nonRandomIndices)
-	      * data_rep->type2_weight(j, key_i, lev_index,
-	                               data_rep->randomIndices);
-	}
-	*/
-      }
-    }
-  }
-
-  return tp_covar;
+    tensor_1[i] = exp_t1c_1[c_index_i] - mean_1;
+    tensor_2[i] = exp_t1c_2[c_index_i] - mean_2;
+  }
+  // TO DO: type2 contributions for useDerivs
+
+  UShortArray dims_1, dims_2;
+  data_rep->tensor_dimensions(lev_index, dims_1); dims_2 = dims_1;
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  data_rep->contract_tensor(x, lev_index, nrand_ind, tensor_1, dims_1);
+  data_rep->contract_tensor(x, lev_index, nrand_ind, tensor_2, dims_2);
+
+  size_t num_rand_pts = tensor_1.size();
+  for (i=0; i<num_rand_pts; ++i)
+    tensor_1[i] *= tensor_2[i];
+  data_rep->contract_tensor(x, lev_index, data_rep->randomIndices,
+			    tensor_1, dims_1);
+  return tensor_1[0];
 }
 
 
@@ -2326,45 +2287,42 @@ product_of_interpolants(const RealVector& x, Real mean_1, Real mean_2,
     abort_handler(-1);
   }
 
-  size_t i, j, k, c_index_1i, c_index_2j, num_pts_1 = colloc_key_1.size(),
+  // Contract each tensor of central coefficients over its non-random
+  // dimensions, apply the 1D expectations of the basis products over each
+  // random dimension of the second tensor, and then contract the result
+  // with the first.
+  size_t i, c_index, num_pts_1 = colloc_key_1.size(),
     num_pts_2 = colloc_key_2.size();
-  Real tp_covar = 0., t1_coeff_1i_mm1, t1_coeff_2j_mm2, t1_Ls_1i,
-    basis_prod, basis_prod_k;
-  bool non_zero; unsigned short l1k, l2k; SizetList::iterator it;
+  RealArray tensor_1(num_pts_1), tensor_2(num_pts_2);
   for (i=0; i<num_pts_1; ++i) {
-    const UShortArray& key_1i = colloc_key_1[i];
-    c_index_1i = (colloc_index_1.empty()) ? i : colloc_index_1[i];
-    t1_coeff_1i_mm1 = exp_t1c_1[c_index_1i] - mean_1;
-    t1_Ls_1i = data_rep->type1_interpolant_value(x, key_1i, lev_index_1,
-						 data_rep->nonRandomIndices);
-    for (j=0; j<num_pts_2; ++j) {
-      const UShortArray& key_2j = colloc_key_2[j];
-      // to include ij-th term, expectation of the product of the interpolation
-      // polynomials must be nonzero
-      if (data_rep->basis_product(lev_index_1, key_1i,
-				  lev_index_2, key_2j, basis_prod)) {
-	c_index_2j = (colloc_index_2.empty()) ? j : colloc_index_2[j];
-	t1_coeff_2j_mm2 = exp_t1c_2[c_index_2j] - mean_2;
-	tp_covar += basis_prod * t1_coeff_1i_mm1 * t1_coeff_2j_mm2 * t1_Ls_1i *
-	  data_rep->type1_interpolant_value(x, key_2j, lev_index_2,
-					    data_rep->nonRandomIndices);
-	/* TO DO
-	if (data_rep->basisConfigOptions.useDerivs) {
-	  const Real *t2_coeff_1i = exp_t2c_1[c_index_i],
-	             *t2_coeff_2i = exp_t2c_2[c_index_i];
-	  for (j=0; j<num_v; ++j)
-	    tp_covar += (t1_coeff_1i_mm1 * t2_coeff_2i[j] +
-	                 t1_coeff_2i_mm2 * t2_coeff_1i[j])
-	      * data_rep->type2_interpolant_value(x, j, key_i, lev_index,
-	                                          data_rep->nonRandomIndices)
-	      * data_rep->type2_weight(j, key_i, lev_index,
-	                               data_rep->randomIndices);
-	}
-	*/
-      }
-    }
-  }
-
+    c_index = (colloc_index_1.empty()) ? i : colloc_index_1[i];
+    tensor_1[i] = exp_t1c_1[c_index] - mean_1;
+  }
+  for (i=0; i<num_pts_2; ++i) {
+    c_index = (colloc_index_2.empty()) ? i : colloc_index_2[i];
+    tensor_2[i] = exp_t1c_2[c_index] - mean_2;
+  }
+  // TO DO: type2 contributions for useDerivs
+
+  UShortArray dims_1, dims_2;
+  data_rep->tensor_dimensions(lev_index_1, dims_1);
+  data_rep->tensor_dimensions(lev_index_2, dims_2);
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  data_rep->contract_tensor(x, lev_index_1, nrand_ind, tensor_1, dims_1);
+  data_rep->contract_tensor(x, lev_index_2, nrand_ind, tensor_2, dims_2);
+
+  const SizetList& rand_ind = data_rep->randomIndices;
+  SizetList::const_iterator cit; size_t v, v_cntr; RealMatrix prod_1d;
+  for (cit=rand_ind.begin(), v_cntr=0; cit!=rand_ind.end(); ++cit, ++v_cntr) {
+    v = *cit;
+    data_rep->basis_products_1d(lev_index_1[v], lev_index_2[v], v, v_cntr,
+				prod_1d);
+    data_rep->transform_dimension(prod_1d, v, tensor_2, dims_2);
+  }
+
+  Real tp_covar = 0.; size_t num_rand_pts = tensor_1.size();
+  for (i=0; i<num_rand_pts; ++i)
+    tp_covar += tensor_1[i] * tensor_2[i];
   return tp_covar;
 }
 
@@ -2399,6 +2357,68 @@ value(const RealVector& x, const RealVector& exp_t1_coeffs,
 }
 
 
+/** Batched version of value(x).  For barycentric interpolation, the 1D
+    barycentric factors are computed once per level and variable for the
+    block of samples and shared by all tensor grids in the Smolyak
+    recursion; otherwise, value(x) is applied to each sample. */
+void NodalInterpPolyApproximation::
+values(const RealMatrix& samples, RealVector& approx_vals)
+{
+  if (!expansionCoeffFlag) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "NodalInterpPolyApproximation::values()" << std::endl;
+    abort_handler(-1);
+  }
+
+  std::shared_ptr<SharedNodalInterpPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedNodalInterpPolyApproxData>(sharedDataRep);
+  const RealVector& exp_t1_coeffs = expT1CoeffsIter->second;
+  const RealMatrix& exp_t2_coeffs = expT2CoeffsIter->second;
+  size_t i, num_v = samples.numRows(), num_samples = samples.numCols();
+  if (approx_vals.length() != num_samples)
+    approx_vals.size(num_samples); // init to 0
+  else
+    approx_vals = 0.;
+
+  if (!data_rep->barycentricFlag) {
+    for (i=0; i<num_samples; ++i) {
+      RealVector x(Teuchos::View, const_cast<Real*>(samples[i]), num_v);
+      approx_vals[i] = value(x, exp_t1_coeffs, exp_t2_coeffs);
+    }
+    return;
+  }
+
+  data_rep->barycentric_value_factors(samples);
+  switch (data_rep->expConfigOptions.expCoeffsSolnApproach) {
+  case QUADRATURE: {
+    std::shared_ptr<TensorProductDriver> tpq_driver =
+      std::static_pointer_cast<TensorProductDriver>(data_rep->driver());
+    SizetArray colloc_index; // empty -> default indexing
+    data_rep->tensor_product_values(exp_t1_coeffs, tpq_driver->level_index(),
+				    tpq_driver->collocation_key(),
+				    colloc_index, 1., approx_vals);
+    break;
+  }
+  case COMBINED_SPARSE_GRID: case INCREMENTAL_SPARSE_GRID: {
+    // Smolyak recursion of anisotropic tensor products
+    std::shared_ptr<CombinedSparseGridDriver> csg_driver =
+      std::static_pointer_cast<CombinedSparseGridDriver>(data_rep->driver());
+    const UShort2DArray&       sm_mi = csg_driver->smolyak_multi_index();
+    const IntArray&        sm_coeffs = csg_driver->smolyak_coefficients();
+    const UShort3DArray&  colloc_key = csg_driver->collocation_key();
+    const Sizet2DArray& colloc_index = csg_driver->collocation_indices();
+    size_t num_smolyak_indices = sm_coeffs.size();
+    for (i=0; i<num_smolyak_indices; ++i)
+      if (sm_coeffs[i])
+	data_rep->tensor_product_values(exp_t1_coeffs, sm_mi[i], colloc_key[i],
+					colloc_index[i], (Real)sm_coeffs[i],
+					approx_vals);
+    break;
+  }
+  }
+}
+
+
 Real NodalInterpPolyApproximation::
 stored_value(const RealVector& x, const ActiveKey& key)
 {
@@ -2914,6 +2934,8 @@ mean(const RealVector& x, const RealVector& exp_t1_coeffs,
 {
   std::shared_ptr<SharedNodalInterpPolyApproxData> data_rep =
     std::static_pointer_cast<SharedNodalInterpPolyApproxData>(sharedDataRep);
+  // 1D interpolant values are reused across tensor grids within this call
+  data_rep->clear_type1_factors_1d();
   Real mean;
   switch (data_rep->expConfigOptions.expCoeffsSolnApproach) {
   case QUADRATURE: {
@@ -3112,6 +3134,8 @@ covariance(const RealVector& x, Real mean_1, Real mean_2,
   Real covar;
   std::shared_ptr<SharedNodalInterpPolyApproxData> data_rep =
     std::static_pointer_cast<SharedNodalInterpPolyApproxData>(sharedDataRep);
+  // 1D interpolant values are reused across tensor grids within this call
+  data_rep->clear_type1_factors_1d();
   switch (data_rep->expConfigOptions.expCoeffsSolnApproach) {
   case QUADRATURE: {
     std::shared_ptr<TensorProductDriver> tpq_driver =
@@ -42,6 +42,14 @@ public:
   /// destructor
   ~NodalInterpPolyApproximation();
 
+  //
+  //- Heading: Member functions
+  //
+
+  /// evaluate the active expansion at a set of samples (variables x
+  /// samples), returning one value per sample
+  void values(const RealMatrix& samples, RealVector& approx_vals);
+
 protected:
 
   //
@@ -371,12 +379,12 @@ update_active_iterators(const ActiveKey& key)
   expT2CoeffsIter = expansionType2Coeffs.find(key);
   expT1CoeffGradsIter = expansionType1CoeffGrads.find(key);
 
-  // share 1 deep copy of current active key
+  // share 1 interned (deep) copy of current active key
   ActiveKey key_copy;
   if (expT1CoeffsIter     == expansionType1Coeffs.end() ||
       expT2CoeffsIter     == expansionType2Coeffs.end() ||
       expT1CoeffGradsIter == expansionType1CoeffGrads.end())
-    key_copy = key.copy();
+    key_copy = key.interned();
 
   if (expT1CoeffsIter == expansionType1Coeffs.end()) {
     std::pair<ActiveKey, RealVector> rv_pair(key_copy, RealVector());
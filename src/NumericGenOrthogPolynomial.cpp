@@ -61,10 +61,8 @@ void NumericGenOrthogPolynomial::solve_eigenproblem(unsigned short m)
   // *******************************
   // Discretized Stieltjes approach:
   // *******************************
-  default:
+  default: // orthogPolyNormsSq[m] is generated by discretized_stieltjes()
     pre_process_coeffs_norms = true;
-    if (coeffsNormsFlag) // PCE
-      post_process_last_norm_sq = true;
     break;
   }
 
@@ -187,39 +185,25 @@ void NumericGenOrthogPolynomial::solve_eigenproblem(unsigned short m)
     }
     break;
   }
-  default: {
+  default:
     // ---------------------------------------------------------------------
     // The default approach is the discretized Stieltjes algorithm
     // (W. Gautschi, SIAM J. Sci. Stat. Comput., Vol. 3, No. 3, Sept. 1982)
+    // applied to a discretization of the measure that is computed once and
+    // reused for all orders.
     // ---------------------------------------------------------------------
-    // set up the coefficients
-    beta3TR[0] = orthogPolyNormsSq[0];
-    RealVector xi_poly_coeffs_i;
-    for (i=0; i<m; ++i) {
-      const RealVector& poly_coeffs_i = polyCoeffs[i];
-      if (i) { // compute norm^2, beta, and off_diag
-	orthogPolyNormsSq[i] = inner_product(poly_coeffs_i, poly_coeffs_i);
-	beta3TR[i] = orthogPolyNormsSq[i] / orthogPolyNormsSq[i-1];
-	off_diag[i-1] = std::sqrt(beta3TR[i]);
-      }
-      // form xi_poly_coeffs_i to compute alpha_i
-      int i_len = poly_coeffs_i.length();
-      xi_poly_coeffs_i.sizeUninitialized(i_len+1);
-      xi_poly_coeffs_i[0] = 0.;
-      for (j=0; j<i_len; ++j)
-	xi_poly_coeffs_i[j+1] = poly_coeffs_i[j];
-      alpha3TR[i] = inner_product(xi_poly_coeffs_i, poly_coeffs_i)
-	          / orthogPolyNormsSq[i];
-      // update polyCoeffs[i+1]
+    discretized_stieltjes(m);
+    for (i=1; i<m; ++i)
+      off_diag[i-1] = std::sqrt(beta3TR[i]);
+    // update polyCoeffs
+    for (i=0; i<m; ++i)
       if (i == 0)
-	polynomial_recursion(polyCoeffs[i+1], alpha3TR[i], poly_coeffs_i);
+	polynomial_recursion(polyCoeffs[i+1], alpha3TR[i], polyCoeffs[i]);
       else if (i < m-1 || coeffsNormsFlag)
-	polynomial_recursion(polyCoeffs[i+1], alpha3TR[i], poly_coeffs_i,
+	polynomial_recursion(polyCoeffs[i+1], alpha3TR[i], polyCoeffs[i],
 			     beta3TR[i], polyCoeffs[i-1]);
-    }
     break;
   }
-  }
 
   if (post_process_coeffs) {
     polynomial_recursion(polyCoeffs[1], alpha3TR[0], polyCoeffs[0]);
@@ -237,34 +221,49 @@ void NumericGenOrthogPolynomial::solve_eigenproblem(unsigned short m)
       PCout << "polyCoeffs[" << i << "] =\n" << polyCoeffs[i];
 #endif
 
-  // solve the symmetric tridiagonal eigenvalue problem using LAPACK
-  int ldz = std::max((unsigned short)1,m);
-  RealMatrix z_eigvec(ldz, m, false);
+  // solve the symmetric tridiagonal eigenvalue problem using LAPACK.  Only
+  // the eigenvalues are computed (COMPZ = 'N' employs the O(m^2) root-free
+  // QL/QR iteration of DSTERF), since the weights are recovered below from
+  // the recursion rather than from the eigenvectors.
   Teuchos::LAPACK<int, Real> la;
-  int info = 0;
-  double* work = new double [std::max(1,2*m-2)]; // temporary work array
+  int info = 0, ldz = 1;
+  Real z_unused = 0., work_unused = 0.; // not referenced for COMPZ = 'N'
   // DSTEQR docs for 3rd field: (input/output)
   //   On entry, the diagonal elements of the tridiagonal matrix.
   //   On exit, if INFO = 0, the eigenvalues in ascending order.
   RealArray& colloc_pts = collocPointsMap[m];
   RealArray& colloc_wts = collocWeightsMap[m];
   copy_data(alpha3TR, colloc_pts); // eigenvalues are Gauss points
-  la.STEQR('I', m, &colloc_pts[0], off_diag.values(), z_eigvec.values(), ldz,
-	   work, &info);
+  ++numEigenSolves;
+  la.STEQR('N', m, &colloc_pts[0], off_diag.values(), &z_unused, ldz,
+	   &work_unused, &info);
   if (info) {
     PCerr << "Error: nonzero return code (" << info << ") from LAPACK STEQR "
 	  << "(symmetric tridiagonal eigensolution)\n       in "
 	  << "NumericGenOrthogPolynomial::solve_eigenproblem()" << std::endl;
     abort_handler(-1);
   }
-  delete [] work;
 
   // Gauss points are the eigenvalues which are updated in place by STEQR.
-  // compute the Gauss weights from the eigenvectors:
+  // The Gauss weights are the Christoffel numbers 1 / sum_k q_k(x_i)^2 for
+  // the orthonormal polynomials q_k (q_0 = 1 for a unit measure), which
+  // equal the squared first components of the normalized eigenvectors.
   colloc_wts.resize(m);
-  //Real norm_sq_0 = orthogPolyNormsSq[0];
-  for (i=0; i<m; ++i)
-    colloc_wts[i] = std::pow(z_eigvec(0, i), 2.);// * norm_sq_0;
+  RealVector sqrt_beta(m, false);
+  for (i=1; i<m; ++i)
+    sqrt_beta[i] = std::sqrt(beta3TR[i]);
+  Real x_i, q_jm1, q_j, q_jp1, sum_sq;
+  for (i=0; i<m; ++i) {
+    x_i = colloc_pts[i];  q_jm1 = 0.;  q_j = sum_sq = 1.;
+    for (j=0; j<m-1; ++j) {
+      q_jp1 = (x_i - alpha3TR[j]) * q_j;
+      if (j) q_jp1 -= sqrt_beta[j] * q_jm1;
+      q_jp1 /= sqrt_beta[j+1];
+      sum_sq += q_jp1 * q_jp1;
+      q_jm1 = q_j;  q_j = q_jp1;
+    }
+    colloc_wts[i] = 1. / sum_sq;
+  }
 
   // orthogPolyNormsSq up to order m-1 are available using the just
   // computed Gauss points/weights
@@ -286,6 +285,335 @@ void NumericGenOrthogPolynomial::solve_eigenproblem(unsigned short m)
 }
 
 
+/** The orthonormal form of the recursion, q_{i+1} = ((x - alpha_i) q_i
+    - sqrt(beta_i) q_{i-1}) / sqrt(beta_{i+1}), is evaluated on the N
+    points of the discretized measure, which avoids the overflow and
+    underflow of the monic polynomials at high order and requires O(N)
+    operations per order. */
+void NumericGenOrthogPolynomial::discretized_stieltjes(unsigned short m)
+{
+  discretize_measure(m);
+
+  int k, num_pts = measurePoints.length();
+  if (m > num_pts) {
+    PCerr << "Error: polynomial order (" << m << ") exceeds the number of "
+	  << "points (" << num_pts << ") in the discretized measure in\n"
+	  << "       NumericGenOrthogPolynomial::discretized_stieltjes()."
+	  << std::endl;
+    abort_handler(-1);
+  }
+
+  const Real *x = measurePoints.values(), *w = measureWeights.values();
+  RealArray q_im1(num_pts, 0.), q_i(num_pts, 1.), r_i(num_pts);
+  Real alpha_i, beta_ip1, sqrt_beta_i = 0., norm_sq = 1.;
+  beta3TR[0] = orthogPolyNormsSq[0] = 1.; // probability measure
+  for (unsigned short i=0; i<m; ++i) {
+    for (k=0, alpha_i=0.; k<num_pts; ++k)
+      alpha_i += w[k] * x[k] * q_i[k] * q_i[k];
+    alpha3TR[i] = alpha_i;
+    // r_i = sqrt(beta_{i+1}) q_{i+1} with beta_{i+1} = ||P_{i+1}||^2/||P_i||^2
+    for (k=0, beta_ip1=0.; k<num_pts; ++k) {
+      r_i[k] = (x[k] - alpha_i) * q_i[k] - sqrt_beta_i * q_im1[k];
+      beta_ip1 += w[k] * r_i[k] * r_i[k];
+    }
+    norm_sq *= beta_ip1;
+    orthogPolyNormsSq[i+1] = norm_sq;
+    if (i+1 < m) {
+      beta3TR[i+1] = beta_ip1;  sqrt_beta_i = std::sqrt(beta_ip1);
+      for (k=0; k<num_pts; ++k)
+	{ q_im1[k] = q_i[k]; q_i[k] = r_i[k] / sqrt_beta_i; }
+    }
+  }
+}
+
+
+/** Discrete distributions define the measure directly.  Continuous
+    distributions are discretized by adaptive Gauss-Kronrod quadrature,
+    where the PDF is evaluated once per retained point and the resolution
+    is targeted to polynomials up to order m; the discretization is reused
+    for all orders up to m and is only regenerated for higher orders. */
+void NumericGenOrthogPolynomial::discretize_measure(unsigned short m)
+{
+  if (measureWeights.length() && measureOrder >= m)
+    return;
+
+  Real dbl_inf = std::numeric_limits<Real>::infinity();
+  size_t i, dp_len = distParams.length();
+  RealArray x_breaks;
+  switch (distributionType) {
+  case HISTOGRAM_PT_INT: case HISTOGRAM_PT_STRING: case HISTOGRAM_PT_REAL:
+  case DISCRETE_INTERVAL_UNCERTAIN:   case DISCRETE_UNCERTAIN_SET_INT:
+  case DISCRETE_UNCERTAIN_SET_STRING: case DISCRETE_UNCERTAIN_SET_REAL: {
+    // distParams[even]: abscissas; distParams[odd]: weights (masses)
+    size_t num_pts = dp_len / 2;
+    measurePoints.sizeUninitialized(num_pts);
+    measureWeights.sizeUninitialized(num_pts);
+    for (i=0; i<num_pts; ++i) {
+      measurePoints[i]  = distParams[2*i];
+      measureWeights[i] = distParams[2*i+1];
+    }
+    measureOrder = std::numeric_limits<unsigned short>::max(); // exact
+    break;
+  }
+  case DISCRETE_RANGE: {
+    // distParams: lower and upper bounds of an integer range
+    int l_bnd = (int)distParams[0], u_bnd = (int)distParams[1],
+      num_pts = u_bnd - l_bnd + 1;
+    measurePoints.sizeUninitialized(num_pts);
+    measureWeights.sizeUninitialized(num_pts);
+    for (int j=0; j<num_pts; ++j)
+      { measurePoints[j] = (Real)(l_bnd + j); measureWeights[j] = 1.; }
+    measureOrder = std::numeric_limits<unsigned short>::max(); // exact
+    break;
+  }
+  case DISCRETE_SET_INT: case DISCRETE_SET_STRING: case DISCRETE_SET_REAL:
+    // distParams: all abscissas, no weights (assign equal weights)
+    measurePoints = distParams;
+    measureWeights.sizeUninitialized(dp_len);  measureWeights.putScalar(1.);
+    measureOrder = std::numeric_limits<unsigned short>::max(); // exact
+    break;
+  case BOUNDED_NORMAL:
+    // trap infinite bounds and replace with mu +/- 15 sigma
+    x_breaks.resize(2);
+    x_breaks[0] = (real_compare(distParams[2], -dbl_inf)) ?
+      distParams[0] - 15. * distParams[1] : distParams[2];
+    x_breaks[1] = (real_compare(distParams[3],  dbl_inf)) ?
+      distParams[0] + 15. * distParams[1] : distParams[3];
+    adaptive_gauss_kronrod(bounded_normal_pdf, BOUNDED_DOMAIN, x_breaks, m);
+    break;
+  case BOUNDED_LOGNORMAL:
+    x_breaks.resize(2);  x_breaks[0] = distParams[2];
+    x_breaks[1] = (real_compare(distParams[3], dbl_inf)) ?
+      distParams[0] + 15. * distParams[1] : distParams[3];
+    adaptive_gauss_kronrod(bounded_lognormal_pdf, BOUNDED_DOMAIN, x_breaks,
+			   m);
+    break;
+  case LOGUNIFORM:
+    x_breaks.resize(2);
+    x_breaks[0] = distParams[0];  x_breaks[1] = distParams[1];
+    adaptive_gauss_kronrod(loguniform_pdf, BOUNDED_DOMAIN, x_breaks, m);
+    break;
+  case TRIANGULAR: // break at the mode
+    copy_data(distParams, x_breaks);
+    adaptive_gauss_kronrod(triangular_pdf, BOUNDED_DOMAIN, x_breaks, m);
+    break;
+  case HISTOGRAM_BIN: case CONTINUOUS_INTERVAL_UNCERTAIN:
+    // break at the bin boundaries: distParams[even]
+    for (i=0; i+1<dp_len; i+=2)
+      x_breaks.push_back(distParams[i]);
+    adaptive_gauss_kronrod(HistogramBinRandomVariable::pdf, BOUNDED_DOMAIN,
+			   x_breaks, m);
+    break;
+  case LOGNORMAL: case FRECHET: case WEIBULL: {
+    NGFPType pdf = (distributionType == LOGNORMAL) ? lognormal_pdf :
+      ((distributionType == FRECHET) ? frechet_pdf : weibull_pdf);
+    x_breaks.assign(1, 0.);
+    adaptive_gauss_kronrod(pdf, SEMI_BOUNDED_DOMAIN, x_breaks, m);
+    break;
+  }
+  case GUMBEL:
+    adaptive_gauss_kronrod(gumbel_pdf, UNBOUNDED_DOMAIN, x_breaks, m);
+    break;
+  default:
+    PCerr << "Error: unsupported distribution type (" << distributionType
+	  << ") in NumericGenOrthogPolynomial::discretize_measure()."
+	  << std::endl;
+    abort_handler(-1);
+    break;
+  }
+
+  // normalize to a probability measure (removes truncation/discretization
+  // error in the total mass as well as unnormalized discrete weights)
+  Real mass = 0.;  int k, num_pts = measureWeights.length();
+  for (k=0; k<num_pts; ++k)
+    mass += measureWeights[k];
+  measureWeights.scale(1./mass);
+}
+
+
+/** Panels are refined in order of decreasing relative error estimate
+    until the total estimates satisfy the tolerance or the panel limit is
+    reached.  Error estimates are formed for both the mass and the moment
+    of (1 + x^2)^m (with x replaced by z on bounded domains), such that
+    the retained points integrate the polynomials of order up to 2m that
+    arise within the Stieltjes inner products. */
+void NumericGenOrthogPolynomial::
+adaptive_gauss_kronrod(NGFPType pdf, short domain, const RealArray& x_breaks,
+		       unsigned short m)
+{
+  size_t i, j, max_panels = 1000;
+  Real tol = 1.e-12, lb = 0., ub = 0., total_mass = 0., total_moment = 0.,
+    mass_err = 0., moment_err = 0.;
+  std::multimap<Real, MeasurePanel> panels; // ordered by rel error estimate
+  std::multimap<Real, MeasurePanel>::iterator it;
+
+  // initial panels: bin boundaries for bounded domains, else uniform in z
+  RealArray z_breaks;
+  if (domain == BOUNDED_DOMAIN) {
+    size_t num_breaks = x_breaks.size();
+    lb = x_breaks[0];  ub = x_breaks[num_breaks-1];
+    for (i=0; i<num_breaks; ++i)
+      z_breaks.push_back(2. * (x_breaks[i] - lb) / (ub - lb) - 1.);
+  }
+  else {
+    if (domain == SEMI_BOUNDED_DOMAIN) lb = x_breaks[0];
+    for (i=0; i<=4; ++i)
+      z_breaks.push_back(-1. + 0.5 * i);
+  }
+  std::vector<MeasurePanel> initial;
+  MeasurePanel panel;
+  for (i=1; i<z_breaks.size(); ++i) {
+    if (z_breaks[i] <= z_breaks[i-1])
+      continue; // degenerate panel
+    panel.zLower = z_breaks[i-1];  panel.zUpper = z_breaks[i];
+    gauss_kronrod_panel(pdf, domain, lb, ub, m, panel);
+    total_mass += panel.mass;           total_moment += panel.moment;
+    mass_err   += panel.massError;      moment_err   += panel.momentError;
+    initial.push_back(panel);
+  }
+  if (total_mass <= 0. || total_moment <= 0.) {
+    PCerr << "Error: PDF integrates to zero in NumericGenOrthogPolynomial::"
+	  << "adaptive_gauss_kronrod()." << std::endl;
+    abort_handler(-1);
+  }
+  for (i=0; i<initial.size(); ++i)
+    panels.insert(std::pair<Real, MeasurePanel>(initial[i].massError /
+      total_mass + initial[i].momentError / total_moment, initial[i]));
+
+  // bisect the panel with the largest relative error estimate
+  MeasurePanel lower, upper;
+  while ( ( mass_err > tol * total_mass || moment_err > tol * total_moment )
+	  && panels.size() < max_panels ) {
+    it = --panels.end();
+    const MeasurePanel& worst = it->second;
+    Real z_mid = (worst.zLower + worst.zUpper) / 2.;
+    lower.zLower = worst.zLower;  lower.zUpper = z_mid;
+    upper.zLower = z_mid;         upper.zUpper = worst.zUpper;
+    total_mass -= worst.mass;     total_moment -= worst.moment;
+    mass_err   -= worst.massError;  moment_err -= worst.momentError;
+    panels.erase(it);
+    gauss_kronrod_panel(pdf, domain, lb, ub, m, lower);
+    gauss_kronrod_panel(pdf, domain, lb, ub, m, upper);
+    total_mass += lower.mass + upper.mass;
+    total_moment += lower.moment + upper.moment;
+    mass_err   += lower.massError   + upper.massError;
+    moment_err += lower.momentError + upper.momentError;
+    panels.insert(std::pair<Real, MeasurePanel>(lower.massError / total_mass
+      + lower.momentError / total_moment, lower));
+    panels.insert(std::pair<Real, MeasurePanel>(upper.massError / total_mass
+      + upper.momentError / total_moment, upper));
+  }
+
+  // collect the Kronrod points with nonzero mass
+  RealArray pts, wts;
+  for (it=panels.begin(); it!=panels.end(); ++it) {
+    const MeasurePanel& p = it->second;
+    for (j=0; j<p.points.size(); ++j)
+      if (p.weights[j] > 0.)
+	{ pts.push_back(p.points[j]); wts.push_back(p.weights[j]); }
+  }
+  copy_data(pts, measurePoints);  copy_data(wts, measureWeights);
+  measureOrder = m;
+#ifdef DEBUG
+  PCout << "NumericGenOrthogPolynomial::adaptive_gauss_kronrod(): "
+	<< panels.size() << " panels, " << pts.size() << " points, relative "
+	<< "error estimates = " << mass_err / total_mass << " (mass), "
+	<< moment_err / total_moment << " (moment)" << std::endl;
+#endif // DEBUG
+}
+
+
+void NumericGenOrthogPolynomial::
+gauss_kronrod_panel(NGFPType pdf, short domain, Real lb, Real ub,
+		    unsigned short m, MeasurePanel& panel)
+{
+  // 15-point Kronrod abscissae/weights and embedded 7-point Gauss weights
+  // (symmetric halves, ordered from the endpoint to the center; QUADPACK)
+  static const Real xgk[8] = { 0.991455371120812639206854697526329,
+    0.949107912342758524526189684047851, 0.864864423359769072789712788640926,
+    0.741531185599394439863864773280788, 0.586087235467691130294144845693013,
+    0.405845151377397166906606412076961, 0.207784955007898467600689403773245,
+    0. };
+  static const Real wgk[8] = { 0.022935322010529224963732008058970,
+    0.063092092629978553290700663189204, 0.104790010322250183839876322541518,
+    0.140653259715525918745189590510238, 0.169004726639267902826583426598550,
+    0.190350578064785409913256402421014, 0.204432940075298892414161999234649,
+    0.209482141084727828012999174891714 };
+  static const Real wg[4] = { 0.129484966168869693270611432679082,
+    0.279705391489276667901467771423780, 0.381830050505118944950369775488975,
+    0.417959183673469387755102040816327 };
+
+  Real center = (panel.zLower + panel.zUpper) / 2.,
+    half_len = (panel.zUpper - panel.zLower) / 2., z, x, x_m, dx_dz, f, f_m,
+    k_int = 0., g_int = 0., k_int_m = 0., g_int_m = 0.;
+  panel.points.resize(15);  panel.weights.resize(15);
+  for (int j=0; j<15; ++j) {
+    // j = 0..6: left half, j = 7: center, j = 8..14: right half
+    int h = (j <= 7) ? j : 14 - j;
+    z = (j < 7) ? center - half_len * xgk[h] : center + half_len * xgk[h];
+    x = map_measure_point(z, domain, lb, ub, dx_dz);
+    f = pdf(x, distParams) * dx_dz;
+    if (!std::isfinite(f))
+      f = 0.; // PDF underflow/overflow at the mapped domain extremes
+    // moment integrand f (1 + x^2)^m, evaluated in log form for large x
+    x_m = (domain == BOUNDED_DOMAIN) ? z : x;
+    f_m = (f > 0.) ? std::exp(m * std::log1p(x_m * x_m) + std::log(f)) : 0.;
+    if (!std::isfinite(f_m))
+      f_m = 0.;
+    panel.points[j]  = x;
+    panel.weights[j] = half_len * wgk[h] * f;
+    k_int += wgk[h] * f;  k_int_m += wgk[h] * f_m;
+    if (h % 2) // embedded Gauss points (including the center)
+      { g_int += wg[h/2] * f;  g_int_m += wg[h/2] * f_m; }
+  }
+  panel.mass        = half_len * k_int;
+  panel.moment      = half_len * k_int_m;
+  panel.massError   = half_len * std::abs(k_int - g_int);
+  panel.momentError = half_len * std::abs(k_int_m - g_int_m);
+}
+
+
+/** Rules are first sought within the process-wide GaussRuleCache, such
+    that distribution parameter sets that recur following reset_gauss()
+    do not repeat the moment/Stieltjes and eigenvalue computations.  A
+    cached rule lacking the coefficients and norms required by
+    coeffsNormsFlag (as cached by an instance that did not require them)
+    is regenerated. */
+void NumericGenOrthogPolynomial::retrieve_rule(unsigned short m)
+{
+  GaussRule rule;
+  if (GaussRuleCache::find(distributionType, distParams, m, rule) &&
+      ( !coeffsNormsFlag || ( rule.normsSq.length() > m &&
+				rule.polyCoeffs.size() > m ) ) ) {
+    collocPointsMap[m]  = rule.points;
+    collocWeightsMap[m] = rule.weights;
+    if (alpha3TR.length() < m)
+      { alpha3TR = rule.alpha; beta3TR = rule.beta; }
+    if (orthogPolyNormsSq.length() < rule.normsSq.length())
+      orthogPolyNormsSq = rule.normsSq;
+    if (polyCoeffs.size() < rule.polyCoeffs.size())
+      polyCoeffs = rule.polyCoeffs;
+  }
+  else {
+    solve_eigenproblem(m);
+    if (!m)
+      return;
+    rule.points  = collocPointsMap[m];  rule.weights = collocWeightsMap[m];
+    rule.alpha.sizeUninitialized(m);    rule.beta.sizeUninitialized(m);
+    for (unsigned short i=0; i<m; ++i)
+      { rule.alpha[i] = alpha3TR[i]; rule.beta[i] = beta3TR[i]; }
+    // norms and coefficients are retained only if generated through order m
+    if (orthogPolyNormsSq.length() > m) rule.normsSq = orthogPolyNormsSq;
+    else                                rule.normsSq.resize(0);
+    if (polyCoeffs.size() > m && polyCoeffs[m].length())
+      rule.polyCoeffs = polyCoeffs;
+    else
+      rule.polyCoeffs.clear();
+    GaussRuleCache::insert(distributionType, distParams, m, rule);
+  }
+}
+
+
 Real NumericGenOrthogPolynomial::
 inner_product(const RealVector& poly_coeffs1,
 	      const RealVector& poly_coeffs2)
@@ -775,7 +1103,7 @@ native_quadrature_integral(const RealVector& poly_coeffs1,
 Real NumericGenOrthogPolynomial::alpha_recursion(unsigned short order)
 {
   if (alpha3TR.length() <= order)
-    solve_eigenproblem(order+1);
+    retrieve_rule(order+1);
   return alpha3TR[order];
 }
 
@@ -783,74 +1111,122 @@ Real NumericGenOrthogPolynomial::alpha_recursion(unsigned short order)
 Real NumericGenOrthogPolynomial::beta_recursion(unsigned short order)
 {
   if (beta3TR.length() <= order)
-    solve_eigenproblem(order+1);
+    retrieve_rule(order+1);
   return beta3TR[order];
 }
 
 
 Real NumericGenOrthogPolynomial::type1_value(Real x, unsigned short order)
 {
-  if (polyCoeffs.size() <= order)
-    solve_eigenproblem(order);
-  return type1_value(x, polyCoeffs[order]);
+  Real t1_val, t1_grad, t1_hess;
+  recursion_value(x, order, 0, t1_val, t1_grad, t1_hess);
+  return t1_val;
 }
 
 
 Real NumericGenOrthogPolynomial::
 type1_value(Real x, const RealVector& poly_coeffs)
 {
-  size_t num_terms = poly_coeffs.length();
-  Real t1_val = poly_coeffs[0];
-  for (int i=1; i<num_terms; ++i)
-    t1_val += poly_coeffs[i]*std::pow(x,i);
+  // employ Horner's rule for improved efficiency and precision
+  int i = poly_coeffs.length() - 1;
+  Real t1_val = poly_coeffs[i];
+  for (--i; i>=0; --i)
+    t1_val = t1_val*x + poly_coeffs[i];
   return t1_val;
 }
 
 
 Real NumericGenOrthogPolynomial::type1_gradient(Real x, unsigned short order)
 {
-  if (polyCoeffs.size() <= order)
-    solve_eigenproblem(order);
-  return type1_gradient(x, polyCoeffs[order]);
+  Real t1_val, t1_grad, t1_hess;
+  recursion_value(x, order, 1, t1_val, t1_grad, t1_hess);
+  return t1_grad;
 }
 
 
 Real NumericGenOrthogPolynomial::
 type1_gradient(Real x, const RealVector& poly_coeffs)
 {
-  // differentiate poly_coeffs with respect to x once
-  size_t num_terms = poly_coeffs.length();
-  Real t1_grad = (num_terms > 1) ? poly_coeffs[1] : 0.;
-  for (int i=2; i<num_terms; ++i)
-    t1_grad += i*poly_coeffs[i]*std::pow(x,i-1);
+  // differentiate poly_coeffs with respect to x once (Horner's rule)
+  int i = poly_coeffs.length() - 1;
+  if (i < 1)
+    return 0.;
+  Real t1_grad = i*poly_coeffs[i];
+  for (--i; i>=1; --i)
+    t1_grad = t1_grad*x + i*poly_coeffs[i];
   return t1_grad;
 }
 
 
 Real NumericGenOrthogPolynomial::type1_hessian(Real x, unsigned short order)
 {
-  if (polyCoeffs.size() <= order)
-    solve_eigenproblem(order);
-  return type1_hessian(x, polyCoeffs[order]);
+  Real t1_val, t1_grad, t1_hess;
+  recursion_value(x, order, 2, t1_val, t1_grad, t1_hess);
+  return t1_hess;
 }
 
 
 Real NumericGenOrthogPolynomial::
 type1_hessian(Real x, const RealVector& poly_coeffs)
 {
-  // differentiate poly_coeffs with respect to x twice
-  size_t num_terms = poly_coeffs.length();
-  Real t1_hess = (num_terms > 2) ? poly_coeffs[2] : 0.;
-  for (int i=3; i<num_terms; ++i)
-    t1_hess += i*(i-1)*poly_coeffs[i]*std::pow(x,i-2);
+  // differentiate poly_coeffs with respect to x twice (Horner's rule)
+  int i = poly_coeffs.length() - 1;
+  if (i < 2)
+    return 0.;
+  Real t1_hess = i*(i-1)*poly_coeffs[i];
+  for (--i; i>=2; --i)
+    t1_hess = t1_hess*x + i*(i-1)*poly_coeffs[i];
   return t1_hess;
 }
 
 
+/** The monic recursion P_{i+1} = (x - alpha_i) P_i - beta_i P_{i-1} is
+    evaluated directly (along with its derivatives as requested), which
+    avoids the cancellation incurred by the monomial form in polyCoeffs
+    and does not require polyCoeffs to be retained. */
+void NumericGenOrthogPolynomial::
+recursion_value(Real x, unsigned short order, short deriv_order,
+		Real& t1_val, Real& t1_grad, Real& t1_hess)
+{
+  t1_val = 1.;  t1_grad = t1_hess = 0.;
+  if (!order)
+    return;
+  if (alpha3TR.length() < order)
+    retrieve_rule(order);
+
+  bool grad = (deriv_order >= 1), hess = (deriv_order >= 2);
+  Real val_im1 = 0., grad_im1 = 0., hess_im1 = 0., val_ip1, grad_ip1 = 0.,
+    hess_ip1 = 0., xma_i, beta_i;
+  for (unsigned short i=0; i<order; ++i) {
+    xma_i = x - alpha3TR[i];  beta_i = (i) ? beta3TR[i] : 0.;
+    val_ip1 = xma_i * t1_val - beta_i * val_im1;
+    if (grad) grad_ip1 = xma_i * t1_grad + t1_val - beta_i * grad_im1;
+    if (hess) hess_ip1 = xma_i * t1_hess + 2. * t1_grad - beta_i * hess_im1;
+    val_im1  = t1_val;   t1_val  = val_ip1;
+    grad_im1 = t1_grad;  t1_grad = grad_ip1;
+    hess_im1 = t1_hess;  t1_hess = hess_ip1;
+  }
+}
+
+
+bool NumericGenOrthogPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a,
+			RealVector& b, RealVector& c)
+{
+  if (max_order && alpha3TR.length() < max_order)
+    retrieve_rule(max_order);
+  a.sizeUninitialized(max_order); b.sizeUninitialized(max_order);
+  c.sizeUninitialized(max_order);
+  for (unsigned short n=0; n<max_order; ++n)
+    { a[n] = 1.; b[n] = -alpha3TR[n]; c[n] = (n) ? beta3TR[n] : 0.; }
+  return true;
+}
+
+
 Real NumericGenOrthogPolynomial::norm_squared(unsigned short order)
 {
   if (orthogPolyNormsSq.length() <= order)
-    solve_eigenproblem(order);
+    retrieve_rule(order);
   return orthogPolyNormsSq[order];
 }
 
@@ -867,7 +1243,7 @@ collocation_points(unsigned short order)
 
   UShortRealArrayMap::iterator it = collocPointsMap.find(order);
   if (it == collocPointsMap.end()) { // not yet computed
-    solve_eigenproblem(order);
+    retrieve_rule(order);
     return collocPointsMap[order];
   }
   else
@@ -887,7 +1263,7 @@ type1_collocation_weights(unsigned short order)
 
   UShortRealArrayMap::iterator it = collocWeightsMap.find(order);
   if (it == collocWeightsMap.end()) { // not yet computed
-    solve_eigenproblem(order);
+    retrieve_rule(order);
     return collocWeightsMap[order];
   }
   else
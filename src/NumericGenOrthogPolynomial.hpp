@@ -15,6 +15,7 @@
 #define NUMERIC_GEN_ORTHOG_POLYNOMIAL_HPP
 
 #include "OrthogonalPolynomial.hpp"
+#include "GaussRuleCache.hpp"
 #include "pecos_global_defs.hpp"
 #include "pecos_stat_util.hpp"
 #include "BoundedNormalRandomVariable.hpp"
@@ -121,6 +122,9 @@ public:
   /// set coeffsNormsFlag
   void coefficients_norms_flag(bool flag);
 
+  /// return the number of eigensolutions performed by this instance
+  size_t eigen_solves() const;
+
 protected:
 
   //
@@ -132,6 +136,9 @@ protected:
   Real type1_hessian(Real x, unsigned short order);
   Real norm_squared(unsigned short order);
 
+  bool recurrence_coefficients(unsigned short max_order, RealVector& a,
+			       RealVector& b, RealVector& c);
+
   const RealArray& collocation_points(unsigned short order);
   const RealArray& type1_collocation_weights(unsigned short order);
 
@@ -144,6 +151,32 @@ protected:
 
 private:
 
+  /// domain types for the discretization of a continuous measure
+  enum { BOUNDED_DOMAIN, SEMI_BOUNDED_DOMAIN, UNBOUNDED_DOMAIN };
+
+  /// Gauss-Kronrod panel within the discretization of a continuous measure
+  struct MeasurePanel
+  {
+    /// lower bound of the panel in the mapped variable z in [-1,1]
+    Real zLower;
+    /// upper bound of the panel in the mapped variable z in [-1,1]
+    Real zUpper;
+    /// Kronrod estimate of the panel mass
+    Real mass;
+    /// Kronrod estimate of the panel moment of (1 + x^2)^m
+    Real moment;
+    /// error estimate for mass from the difference of the Kronrod and
+    /// Gauss rules
+    Real massError;
+    /// error estimate for moment from the difference of the Kronrod and
+    /// Gauss rules
+    Real momentError;
+    /// Kronrod points mapped to the random variable domain
+    RealArray points;
+    /// Kronrod weights scaled by the PDF and mapping Jacobian
+    RealArray weights;
+  };
+
   //
   //- Heading: Convenience functions
   //
@@ -168,6 +201,28 @@ private:
   /// solve a symmetric tridiagonal eigenvalue problem for the Gauss
   /// points and weights for an orthogonal polynomial of order m
   void solve_eigenproblem(unsigned short m);
+  /// compute alpha3TR, beta3TR and orthogPolyNormsSq up to order m using
+  /// the discretized Stieltjes procedure on measurePoints/measureWeights
+  void discretized_stieltjes(unsigned short m);
+  /// define measurePoints/measureWeights with sufficient resolution for
+  /// generating orthogonal polynomials up to order m
+  void discretize_measure(unsigned short m);
+  /// discretize a continuous measure using globally adaptive Gauss-Kronrod
+  /// quadrature, subdividing the initial panels defined by x_breaks
+  void adaptive_gauss_kronrod(NGFPType pdf, short domain,
+			      const RealArray& x_breaks, unsigned short m);
+  /// evaluate the 15-point Kronrod discretization of a panel and its
+  /// error estimate relative to the embedded 7-point Gauss rule
+  void gauss_kronrod_panel(NGFPType pdf, short domain, Real lb, Real ub,
+			   unsigned short m, MeasurePanel& panel);
+  /// map z in [-1,1] to the random variable domain, returning x and dx/dz
+  static Real map_measure_point(Real z, short domain, Real lb, Real ub,
+				Real& dx_dz);
+
+  /// retrieve the Gauss rule, recursion coefficients, polynomial
+  /// coefficients and norms of order m from GaussRuleCache, or generate
+  /// and cache them using solve_eigenproblem()
+  void retrieve_rule(unsigned short m);
 
   /// compute three point recursion for polyCoeffs[i+1]
   void polynomial_recursion(RealVector& poly_coeffs_ip1, Real alpha_i,
@@ -231,6 +286,12 @@ private:
   /// coefficients) with respect to its dimension for a given parameter value
   Real type1_hessian(Real x, const RealVector& poly_coeffs);
 
+  /// evaluate the value and (optionally) the gradient and Hessian of the
+  /// 1-D generated polynomial of given order using the three-term
+  /// recursion coefficients alpha3TR and beta3TR
+  void recursion_value(Real x, unsigned short order, short deriv_order,
+		       Real& t1_val, Real& t1_grad, Real& t1_hess);
+
   //
   //- Heading: Data
   //
@@ -260,11 +321,23 @@ private:
   /// norm-squared of all orthogonal polynomials, from order 0 to m,
   /// as defined by the inner product <Poly_i, Poly_i> = ||Poly_i||^2
   RealVector orthogPolyNormsSq;
+
+  /// abscissae of the discretized measure used by discretized_stieltjes()
+  RealVector measurePoints;
+  /// probability masses of the discretized measure used by
+  /// discretized_stieltjes()
+  RealVector measureWeights;
+  /// polynomial order for which measurePoints/measureWeights are resolved
+  unsigned short measureOrder;
+
+  /// number of eigensolutions performed by solve_eigenproblem()
+  size_t numEigenSolves;
 };
 
 
 inline NumericGenOrthogPolynomial::NumericGenOrthogPolynomial() :
-  distributionType(NO_TYPE), coeffsNormsFlag(false)
+  distributionType(NO_TYPE), coeffsNormsFlag(false), measureOrder(0),
+  numEigenSolves(0)
 { collocRule = GOLUB_WELSCH; ptFactor = wtFactor = 1.; }
 
 
@@ -300,6 +373,24 @@ polynomial_recursion(RealVector& poly_coeffs_ip1, Real alpha_i,
 }
 
 
+inline Real NumericGenOrthogPolynomial::
+map_measure_point(Real z, short domain, Real lb, Real ub, Real& dx_dz)
+{
+  switch (domain) {
+  case SEMI_BOUNDED_DOMAIN: { // x = lb + (1+z)/(1-z), dx/dz = 2/(1-z)^2
+    Real one_m_z = 1. - z;
+    dx_dz = 2. / (one_m_z * one_m_z);  return lb + (1. + z) / one_m_z;
+  }
+  case UNBOUNDED_DOMAIN: {    // x = z/(1-z^2), dx/dz = (1+z^2)/(1-z^2)^2
+    Real z_sq = z * z, one_m_z_sq = 1. - z_sq;
+    dx_dz = (1. + z_sq) / (one_m_z_sq * one_m_z_sq);  return z / one_m_z_sq;
+  }
+  default:                    // x = lb + (ub-lb)(1+z)/2
+    dx_dz = (ub - lb) / 2.;   return lb + dx_dz * (1. + z);
+  }
+}
+
+
 inline void NumericGenOrthogPolynomial::
 discrete_range_distribution(int l_bnd, int u_bnd)
 {
@@ -762,10 +853,14 @@ inline Real NumericGenOrthogPolynomial::length_scale() const
 }
 
 
+inline size_t NumericGenOrthogPolynomial::eigen_solves() const
+{ return numEigenSolves; }
+
+
 inline void NumericGenOrthogPolynomial::precompute_rules(unsigned short order)
 {
   if (polyCoeffs.size() <= order)
-    solve_eigenproblem(order);
+    retrieve_rule(order);
   // TO DO: sweep through colloc{Points,Weights}Map
   // > solve_eigenproblem() currently sweeps out a range of polyCoeffs
   //   but only generates one set of Gauss pts/wts per eigensolve
@@ -774,7 +869,12 @@ inline void NumericGenOrthogPolynomial::precompute_rules(unsigned short order)
 
 
 inline void NumericGenOrthogPolynomial::reset_gauss()
-{ OrthogonalPolynomial::reset_gauss();  polyCoeffs.clear(); }
+{
+  OrthogonalPolynomial::reset_gauss();
+  polyCoeffs.clear();  orthogPolyNormsSq.resize(0);
+  alpha3TR.resize(0);  beta3TR.resize(0);
+  measurePoints.resize(0);  measureWeights.resize(0);  measureOrder = 0;
+}
 
 } // namespace Pecos
 
@@ -12,6 +12,8 @@
 //- Owner:        Mike Eldred
 
 #include "OrthogPolyApproximation.hpp"
+#include "ExpansionArchive.hpp"
+#include "SobolMaskIndex.hpp"
 #include "pecos_global_defs.hpp"
 #include "Teuchos_SerialDenseHelpers.hpp"
 
@@ -189,6 +191,7 @@ void OrthogPolyApproximation::combined_to_active(bool clear_combined)
     else // redundant copy
       expCoeffGradsIter->second = combinedExpCoeffGrads;     // deep copy
   }
+  clear_random_contraction();
 
   PolynomialApproximation::combined_to_active(clear_combined);
 }
@@ -556,22 +559,11 @@ Real OrthogPolyApproximation::mean(const RealVector& x)
       data_rep->match_nonrandom_vars(x, xPrevMean[key]))
     return primaryMomIter->second[0];
 
-  const RealVector& exp_coeffs = expCoeffsIter->second;
-  Real mean = exp_coeffs[0];
-  const UShort2DArray& mi = data_rep->multi_index();
-  size_t i, num_exp_terms = mi.size();
-  for (i=1; i<num_exp_terms; ++i)
-    // expectations are zero for expansion terms with nonzero random indices
-    if (data_rep->zero_random(mi[i])) {
-      mean += exp_coeffs[i] *
-	data_rep->multivariate_polynomial(x, mi[i], nrand_ind);
-#ifdef DEBUG
-      PCout << "Mean estimate inclusion: term index = " << i << " Psi = "
-	    << data_rep->multivariate_polynomial(x, mi[i], nrand_ind)
-	    << " PCE coeff = " << exp_coeffs[i] << " total = " << mean
-	    << std::endl;
-#endif // DEBUG
-    }
+  // expectations are zero for expansion terms with nonzero random indices,
+  // leaving the mean polynomial of the contracted expansion
+  RandomContraction& rc = random_contraction();
+  contraction_values(x, 0, rc);
+  Real mean = contracted_mean(rc);
 
   if (use_tracker) {
     primaryMomIter->second[0] = mean;
@@ -640,60 +632,14 @@ mean_gradient(const RealVector& x, const SizetArray& dvv)
     // && dvv == dvvPrev)
     return primaryMomGradsIter->second[0];
 
-  const UShort2DArray& mi = data_rep->multi_index();
-  const RealVector& exp_coeffs      = expCoeffsIter->second;
-  const RealMatrix& exp_coeff_grads = expCoeffGradsIter->second;
-  size_t i, j, deriv_index, num_deriv_v = dvv.size(),
-    num_exp_terms = mi.size(),
-    cntr = 0; // insertions carried in order within expansionCoeffGrads
+  size_t num_deriv_v = dvv.size();
+  RandomContraction& rc = random_contraction();
+  contraction_values(x, contraction_deriv_order(dvv), rc);
   RealVector& mean_grad = primaryMomGradsIter->second[0];
   if (mean_grad.length() != num_deriv_v)
     mean_grad.sizeUninitialized(num_deriv_v);
-  for (i=0; i<num_deriv_v; ++i) {
-    deriv_index = dvv[i] - 1; // OK since we are in an "All" view
-    bool random = data_rep->randomVarsKey[deriv_index];
-    Real& grad_i = mean_grad[i];
-    if (random) {// deriv w.r.t. des var insertion
-      // Error check for required data
-      if (!expansionCoeffGradFlag) {
-	PCerr << "Error: expansion coefficient gradients not defined in "
-	      << "OrthogPolyApproximation::mean_gradient()." << std::endl;
-	abort_handler(-1);
-      }
-      grad_i = exp_coeff_grads[0][cntr];
-    }
-    else {
-      grad_i = 0.;
-      if (!expansionCoeffFlag) { // check for reqd data
-	PCerr << "Error: expansion coefficients not defined in "
-	      << "OrthogPolyApproximation::mean_gradient()" << std::endl;
-	abort_handler(-1);
-      }
-    }
-    for (j=1; j<num_exp_terms; ++j) {
-      // expectations are zero for expansion terms with nonzero random indices
-      if (data_rep->zero_random(mi[j])) {
-	// In both cases below, term to differentiate is alpha_j(s) Psi_j(s)
-	// since <Psi_j>_xi = 1 for included terms.  The difference occurs
-	// based on whether a particular s_i dependence appears in alpha
-	// (for inserted) or Psi (for augmented).
-	if (random)
-	  // -------------------------------------------
-	  // derivative w.r.t. design variable insertion
-	  // -------------------------------------------
-	  grad_i += exp_coeff_grads[j][cntr] *
-	    data_rep->multivariate_polynomial(x, mi[j], nrand_ind);
-	else
-	  // ----------------------------------------------
-	  // derivative w.r.t. design variable augmentation
-	  // ----------------------------------------------
-	  grad_i += exp_coeffs[j] * data_rep->
-	    multivariate_polynomial_gradient(x, deriv_index, mi[j], nrand_ind);
-      }
-    }
-    if (random) // deriv w.r.t. des var insertion
-      ++cntr;
-  }
+  contracted_mean_gradient(dvv, expCoeffGradsIter->second, rc, 0,
+			   mean_grad.values());
 
   // In the case of returning a grad reference, we unconditionally update shared
   // moment storage, but protect its reuse through bit tracker deactivation
@@ -806,8 +752,21 @@ covariance(const RealVector& x, PolynomialApproximation* poly_approx_2)
        data_rep->match_nonrandom_vars(x, xPrevVar[key]) )
     return primaryMomIter->second[1];
 
-  Real covar = covariance(x, data_rep->multi_index(), expCoeffsIter->second,
-			  opa_2->expCoeffsIter->second);
+  // For r = random_vars and nr = non_random_vars,
+  // sigma^2_R(nr) = < (R(r,nr) - \mu_R(nr))^2 >_r, for which only terms
+  // with identical random indices contribute (else orthogonality drops the
+  // term).  Collapsing these groups following evaluation of their non-random
+  // portions reduces the covariance to a single sum over the groups.
+  RandomContraction& rc = random_contraction();
+  contraction_values(x, 0, rc);  group_sums(rc);
+  Real covar;
+  if (same)
+    covar = contracted_covariance(rc, rc);
+  else {
+    RandomContraction& rc_2 = opa_2->random_contraction();
+    opa_2->contraction_values(x, 0, rc_2);  opa_2->group_sums(rc_2);
+    covar = contracted_covariance(rc, rc_2);
+  }
 
   if (use_tracker) {
     primaryMomIter->second[1] = covar;
@@ -987,19 +946,296 @@ variance_gradient(const RealVector& x, const SizetArray& dvv)
     // && dvv == dvvPrev)
     return primaryMomGradsIter->second[1];
 
-  const UShort2DArray&   mi = data_rep->multi_index();
-  const SizetList& rand_ind = data_rep->randomIndices;
-  const RealVector& exp_coeffs      = expCoeffsIter->second;
-  const RealMatrix& exp_coeff_grads = expCoeffGradsIter->second;
-  size_t i, j, k, deriv_index, num_deriv_v = dvv.size(),
-    num_exp_terms = mi.size(),
-    cntr = 0; // insertions carried in order within expansionCoeffGrads
+  size_t num_deriv_v = dvv.size();
+  RandomContraction& rc = random_contraction();
+  contraction_values(x, contraction_deriv_order(dvv), rc);  group_sums(rc);
   RealVector& var_grad = primaryMomGradsIter->second[1];
   if (var_grad.length() != num_deriv_v)
     var_grad.sizeUninitialized(num_deriv_v);
-  var_grad = 0.;
+  contracted_variance_gradient(dvv, expCoeffGradsIter->second, rc, 0,
+			       var_grad.values());
+
+  // In the case of returning a grad reference, we unconditionally update shared
+  // moment storage, but protect its reuse through bit tracker deactivation
+  if (use_tracker)
+    {  primaryVarIter->second |=  2; xPrevVarGrad[key] = x; } // activate bit
+  else primaryVarIter->second &= ~2;         // deactivate: protect mixed use
+  return var_grad;
+}
+
+
+/** The contraction is rebuilt only when the expansion has changed, as
+    indicated by clear_computed_bits() (which accompanies coefficient
+    updates), a change in the active key, or reallocated coefficients. */
+OrthogPolyApproximation::RandomContraction&
+OrthogPolyApproximation::random_contraction()
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  const UShort2DArray& mi = data_rep->multi_index();
+  const RealVector& exp_coeffs = expCoeffsIter->second;
+  RandomContraction& rc = randomContraction;
+  if (rc.expCoeffs != exp_coeffs.values() || rc.numTerms != mi.size() ||
+      !(rc.activeKey == data_rep->activeKey))
+    random_contraction(mi, SizetSet(), exp_coeffs, rc);
+  return rc;
+}
+
+
+void OrthogPolyApproximation::
+random_contraction(const UShort2DArray& mi, const SizetSet& sparse_ind,
+		   const RealVector& exp_coeffs, RandomContraction& rc)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  const SizetList&  rand_ind = data_rep->randomIndices;
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  SizetArray terms;  batch_terms(mi, sparse_ind, terms);
+  size_t k, v, num_terms = terms.size(), num_v = data_rep->numVars;
+  rc.maxOrders.assign(num_v, 0);
+  rc.monomials.clear();       rc.meanMonomials.clear();
+  rc.meanTerms.clear();       rc.meanCoeffs.clear();
+  rc.groupKeys.clear();       rc.groupNorms.clear();
+  rc.groupOffsets.clear();    rc.groupMonomials.clear();
+  rc.groupTerms.clear();      rc.groupCoeffs.clear();
+
+  // reduce the non-random portion of each term to a distinct monomial and
+  // collect the terms with random dependence by their random multi-index
+  std::map<UShortArray, size_t> monomial_map;
+  std::map<UShortArray, size_t>::iterator m_it;
+  std::map<UShortArray, SizetArray> group_map;
+  SizetArray term_monomials(num_terms);
+  UShortArray monomial(num_v), rand_key(rand_ind.size());
+  SizetList::const_iterator cit;  size_t r;
+  // coefficients may be omitted when only their gradients are in use
+  bool coeffs = ((size_t)exp_coeffs.length() == num_terms);
+  for (k=0; k<num_terms; ++k) {
+    const UShortArray& mi_k = mi[terms[k]];
+    for (v=0; v<num_v; ++v)
+      if (mi_k[v] > rc.maxOrders[v])
+	rc.maxOrders[v] = mi_k[v];
+    std::fill(monomial.begin(), monomial.end(), 0);
+    for (cit=nrand_ind.begin(); cit!=nrand_ind.end(); ++cit)
+      monomial[*cit] = mi_k[*cit];
+    m_it = monomial_map.find(monomial);
+    if (m_it == monomial_map.end()) {
+      term_monomials[k] = rc.monomials.size();
+      monomial_map[monomial] = rc.monomials.size();
+      rc.monomials.push_back(monomial);
+    }
+    else
+      term_monomials[k] = m_it->second;
+
+    if (data_rep->zero_random(mi_k)) {
+      rc.meanMonomials.push_back(term_monomials[k]);
+      rc.meanTerms.push_back(k);
+      rc.meanCoeffs.push_back((coeffs) ? exp_coeffs[k] : 0.);
+    }
+    else {
+      for (r=0, cit=rand_ind.begin(); cit!=rand_ind.end(); ++r, ++cit)
+	rand_key[r] = mi_k[*cit];
+      group_map[rand_key].push_back(k);
+    }
+  }
+
+  // store the groups contiguously in ascending order of their random
+  // multi-index, which supports merging the groups of two expansions
+  std::map<UShortArray, SizetArray>::iterator g_it;
+  for (g_it=group_map.begin(); g_it!=group_map.end(); ++g_it) {
+    const SizetArray& group_terms = g_it->second;
+    rc.groupKeys.push_back(g_it->first);
+    rc.groupNorms.push_back(
+      data_rep->norm_squared(mi[terms[group_terms[0]]], rand_ind));
+    rc.groupOffsets.push_back(rc.groupTerms.size());
+    for (r=0; r<group_terms.size(); ++r) {
+      k = group_terms[r];
+      rc.groupMonomials.push_back(term_monomials[k]);
+      rc.groupTerms.push_back(k);
+      rc.groupCoeffs.push_back((coeffs) ? exp_coeffs[k] : 0.);
+    }
+  }
+  rc.groupOffsets.push_back(rc.groupTerms.size());
+
+  rc.monomialValues.resize(rc.monomials.size());
+  rc.groupSums.resize(rc.groupNorms.size());
+  rc.activeKey = data_rep->activeKey.interned();
+  rc.expCoeffs = exp_coeffs.values();  rc.numTerms = num_terms;
+}
+
+
+void OrthogPolyApproximation::
+contraction_values(const RealVector& x, short deriv_order,
+		   RandomContraction& rc)
+{
+  int num_v = x.length();
+  RealMatrix x_mat(Teuchos::View, const_cast<Real*>(x.values()), num_v,
+		   num_v, 1);
+  contraction_values(x_mat, deriv_order, rc);
+  monomial_values(0, rc);
+}
+
+
+void OrthogPolyApproximation::
+contraction_values(const RealMatrix& x_batch, short deriv_order,
+		   RandomContraction& rc)
+{
+  nonrandom_basis_values(x_batch, rc.maxOrders, deriv_order, rc.t1Vals,
+			 rc.t1Grads);
+}
+
+
+void OrthogPolyApproximation::monomial_values(int j, RandomContraction& rc)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  size_t m, num_monomials = rc.monomials.size();
+  for (m=0; m<num_monomials; ++m)
+    rc.monomialValues[m]
+      = nonrandom_value(rc.monomials[m], nrand_ind, rc.t1Vals, j);
+}
+
+
+void OrthogPolyApproximation::group_sums(RandomContraction& rc)
+{
+  size_t g, t, num_groups = rc.groupNorms.size();
+  for (g=0; g<num_groups; ++g) {
+    Real sum = 0.;
+    for (t=rc.groupOffsets[g]; t<rc.groupOffsets[g+1]; ++t)
+      sum += rc.groupCoeffs[t] * rc.monomialValues[rc.groupMonomials[t]];
+    rc.groupSums[g] = sum;
+  }
+}
+
+
+short OrthogPolyApproximation::
+contraction_deriv_order(const SizetArray& dvv) const
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  size_t i, num_deriv_v = dvv.size();
+  for (i=0; i<num_deriv_v; ++i)
+    if (!data_rep->randomVarsKey[dvv[i] - 1])
+      return 1; // basis gradients required for augmentation
+  return 0;
+}
+
+
+/** Expectations are zero for expansion terms with nonzero random
+    indices, leaving the mean polynomial of the contracted expansion. */
+Real OrthogPolyApproximation::contracted_mean(const RandomContraction& rc)
+{
+  Real mean = 0.;
+  size_t m, num_mean_terms = rc.meanMonomials.size();
+  for (m=0; m<num_mean_terms; ++m)
+    mean += rc.meanCoeffs[m] * rc.monomialValues[rc.meanMonomials[m]];
+  return mean;
+}
+
+
+/** Only groups with identical random multi-indices contribute, such
+    that the groups of two contractions are merged in key order. */
+Real OrthogPolyApproximation::
+contracted_covariance(const RandomContraction& rc,
+		      const RandomContraction& rc_2)
+{
+  const RealArray& a = rc.groupSums;
+  size_t g, num_groups = rc.groupNorms.size();
+  Real covar = 0.;
+  if (&rc == &rc_2)
+    for (g=0; g<num_groups; ++g)
+      covar += rc.groupNorms[g] * a[g] * a[g];
+  else {
+    const RealArray& b = rc_2.groupSums;
+    // merge the ordered group keys of each expansion
+    size_t g2 = 0, num_groups_2 = rc_2.groupNorms.size();
+    g = 0;
+    while (g < num_groups && g2 < num_groups_2) {
+      const UShortArray& key_g = rc.groupKeys[g];
+      const UShortArray& key_g2 = rc_2.groupKeys[g2];
+      if (key_g < key_g2)      ++g;
+      else if (key_g2 < key_g) ++g2;
+      else
+	{ covar += rc.groupNorms[g] * a[g] * b[g2];  ++g;  ++g2; }
+    }
+  }
+  return covar;
+}
+
+
+void OrthogPolyApproximation::
+contracted_mean_gradient(const SizetArray& dvv,
+			 const RealMatrix& exp_coeff_grads,
+			 const RandomContraction& rc, int j, Real* mean_grad)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  size_t i, m, deriv_index, num_deriv_v = dvv.size(),
+    num_mean_terms = rc.meanMonomials.size(),
+    cntr = 0; // insertions carried in order within expansionCoeffGrads
+  for (i=0; i<num_deriv_v; ++i) {
+    deriv_index = dvv[i] - 1; // OK since we are in an "All" view
+    bool random = data_rep->randomVarsKey[deriv_index];
+    Real& grad_i = mean_grad[i];
+    if (random) {// deriv w.r.t. des var insertion
+      // Error check for required data
+      if (!expansionCoeffGradFlag) {
+	PCerr << "Error: expansion coefficient gradients not defined in "
+	      << "OrthogPolyApproximation::mean_gradient()." << std::endl;
+	abort_handler(-1);
+      }
+    }
+    else if (!expansionCoeffFlag) { // check for reqd data
+      PCerr << "Error: expansion coefficients not defined in "
+	    << "OrthogPolyApproximation::mean_gradient()" << std::endl;
+      abort_handler(-1);
+    }
+    // expectations are zero for expansion terms with nonzero random indices.
+    // In both cases below, term to differentiate is alpha_j(s) Psi_j(s)
+    // since <Psi_j>_xi = 1 for included terms.  The difference occurs
+    // based on whether a particular s_i dependence appears in alpha
+    // (for inserted) or Psi (for augmented).
+    grad_i = 0.;
+    if (random)
+      // -------------------------------------------
+      // derivative w.r.t. design variable insertion
+      // -------------------------------------------
+      for (m=0; m<num_mean_terms; ++m)
+	grad_i += exp_coeff_grads[rc.meanTerms[m]][cntr] *
+	  rc.monomialValues[rc.meanMonomials[m]];
+    else
+      // ----------------------------------------------
+      // derivative w.r.t. design variable augmentation
+      // ----------------------------------------------
+      for (m=0; m<num_mean_terms; ++m)
+	grad_i += rc.meanCoeffs[m] *
+	  nonrandom_gradient(rc.monomials[rc.meanMonomials[m]], deriv_index,
+			     nrand_ind, rc.t1Vals, rc.t1Grads, j);
+    if (random) // deriv w.r.t. des var insertion
+      ++cntr;
+  }
+}
 
-  Real norm_sq_j, poly_j, poly_grad_j, norm_poly_j, coeff_j, coeff_grad_j;
+
+/** With a_g(s) = Sum_{j in g} alpha_j(s) Psi_j(s) for the terms within
+    each random group g, d/ds sigma^2 = 2 Sum_g <Psi_g^2>_xi a_g da_g/ds,
+    where the s_i dependence appears in alpha (for inserted) or Psi (for
+    augmented). */
+void OrthogPolyApproximation::
+contracted_variance_gradient(const SizetArray& dvv,
+			     const RealMatrix& exp_coeff_grads,
+			     const RandomContraction& rc, int j,
+			     Real* var_grad)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  const RealArray& a = rc.groupSums;
+  size_t i, t, g, deriv_index, num_deriv_v = dvv.size(),
+    num_groups = rc.groupNorms.size(),
+    cntr = 0; // insertions carried in order within expansionCoeffGrads
+  Real da_g;
   for (i=0; i<num_deriv_v; ++i) {
     deriv_index = dvv[i] - 1; // OK since we are in an "All" view
     bool random = data_rep->randomVarsKey[deriv_index];
@@ -1008,61 +1244,210 @@ variance_gradient(const RealVector& x, const SizetArray& dvv)
 	    << "OrthogPolyApproximation::variance_gradient()." << std::endl;
       abort_handler(-1);
     }
-    for (j=1; j<num_exp_terms; ++j) {
-      const UShortArray& mi_j = mi[j];
-      if (!data_rep->zero_random(mi_j)) {
-	coeff_j   = exp_coeffs[j];
-	norm_sq_j = data_rep->norm_squared(mi_j, rand_ind);
-	poly_j    = data_rep->multivariate_polynomial(x, mi_j, nrand_ind);
-	if (random) {
-	  norm_poly_j  = norm_sq_j * poly_j;
-	  coeff_grad_j = exp_coeff_grads[j][cntr];
-	}
-	else
-	  poly_grad_j = data_rep->
-	    multivariate_polynomial_gradient(x, deriv_index, mi_j, nrand_ind);
-	for (k=1; k<num_exp_terms; ++k) {
-	  // random part of polynomial must be identical to contribute to
-	  // variance (else orthogonality drops term)
-	  const UShortArray& mi_k = mi[k];
-	  if (data_rep->match_random_key(mi_j, mi_k)) {
-	    // In both cases below, the term to differentiate is
-	    // alpha_j(s) alpha_k(s) <Psi_j^2>_xi Psi_j(s) Psi_k(s) and the
-	    // difference occurs based on whether a particular s_i dependence
-	    // appears in alpha (for inserted) or Psi (for augmented).
-	    if (random)
-	      // -------------------------------------------
-	      // derivative w.r.t. design variable insertion
-	      // -------------------------------------------
-	      var_grad[i] += norm_poly_j *
-		(coeff_j * exp_coeff_grads[k][cntr] +
-		 exp_coeffs[k] * coeff_grad_j) *
-		data_rep->multivariate_polynomial(x, mi_k, nrand_ind);
-	    else
-	      // ----------------------------------------------
-	      // derivative w.r.t. design variable augmentation
-	      // ----------------------------------------------
-	      var_grad[i] +=
-		coeff_j * exp_coeffs[k] * norm_sq_j *
-		// Psi_j * dPsi_k_ds_i + dPsi_j_ds_i * Psi_k
-		(poly_j * data_rep->multivariate_polynomial_gradient(x,
-		   deriv_index, mi_k, nrand_ind) +
-		 poly_grad_j * data_rep->multivariate_polynomial(x, mi_k,
-		   nrand_ind));
-	  }
-	}
-      }
+    Real& grad_i = var_grad[i];  grad_i = 0.;
+    for (g=0; g<num_groups; ++g) {
+      da_g = 0.;
+      if (random)
+	// -------------------------------------------
+	// derivative w.r.t. design variable insertion
+	// -------------------------------------------
+	for (t=rc.groupOffsets[g]; t<rc.groupOffsets[g+1]; ++t)
+	  da_g += exp_coeff_grads[rc.groupTerms[t]][cntr] *
+	    rc.monomialValues[rc.groupMonomials[t]];
+      else
+	// ----------------------------------------------
+	// derivative w.r.t. design variable augmentation
+	// ----------------------------------------------
+	for (t=rc.groupOffsets[g]; t<rc.groupOffsets[g+1]; ++t)
+	  da_g += rc.groupCoeffs[t] *
+	    nonrandom_gradient(rc.monomials[rc.groupMonomials[t]], deriv_index,
+			       nrand_ind, rc.t1Vals, rc.t1Grads, j);
+      grad_i += 2. * rc.groupNorms[g] * a[g] * da_g;
     }
     if (random) // deriv w.r.t. des var insertion
       ++cntr;
   }
+}
 
-  // In the case of returning a grad reference, we unconditionally update shared
-  // moment storage, but protect its reuse through bit tracker deactivation
-  if (use_tracker)
-    {  primaryVarIter->second |=  2; xPrevVarGrad[key] = x; } // activate bit
-  else primaryVarIter->second &= ~2;         // deactivate: protect mixed use
-  return var_grad;
+
+/** The cached contraction of the active expansion, shared with the
+    pointwise statistics, is evaluated at each column of x_batch using
+    univariate basis values tabulated over the batch. */
+void OrthogPolyApproximation::
+batch_mean(const RealMatrix& x_batch, RealVector& means)
+{
+  // Error check for required data
+  if (!expansionCoeffFlag) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "OrthogPolyApproximation::batch_mean()" << std::endl;
+    abort_handler(-1);
+  }
+
+  contracted_mean(x_batch, random_contraction(), means);
+}
+
+
+/** Since orthogonality removes the cross terms between random groups,
+    the covariance at each column of x_batch reduces to Sum_g <Psi_g^2>
+    a_g(x) b_g(x), where a_g and b_g are the group polynomials in the
+    non-random variables of the cached contraction of each expansion. */
+void OrthogPolyApproximation::
+batch_covariance(const RealMatrix& x_batch,
+		 PolynomialApproximation* poly_approx_2, RealVector& covars)
+{
+  OrthogPolyApproximation* opa_2 = (OrthogPolyApproximation*)poly_approx_2;
+  // Error check for required data
+  if ( !expansionCoeffFlag || ( opa_2 != this && !opa_2->expansionCoeffFlag )) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "OrthogPolyApproximation::batch_covariance()" << std::endl;
+    abort_handler(-1);
+  }
+
+  RandomContraction& rc = random_contraction();
+  contracted_covariance(x_batch, rc,
+    (opa_2 == this) ? rc : opa_2->random_contraction(), covars);
+}
+
+
+void OrthogPolyApproximation::
+batch_mean_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+		    RealMatrix& mean_grads)
+{
+  contracted_mean_gradient(x_batch, dvv, random_contraction(),
+			   expCoeffGradsIter->second, mean_grads);
+}
+
+
+void OrthogPolyApproximation::
+batch_variance_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			RealMatrix& var_grads)
+{
+  // Error check for required data
+  if (!expansionCoeffFlag) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "OrthogPolyApproximation::batch_variance_gradient()" << std::endl;
+    abort_handler(-1);
+  }
+
+  contracted_variance_gradient(x_batch, dvv, random_contraction(),
+			       expCoeffGradsIter->second, var_grads);
+}
+
+
+void OrthogPolyApproximation::
+contracted_mean(const RealMatrix& x_batch, RandomContraction& rc,
+		RealVector& means)
+{
+  contraction_values(x_batch, 0, rc);
+  int j, num_pts = x_batch.numCols();
+  if (means.length() != num_pts)
+    means.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j)
+    { monomial_values(j, rc);  means[j] = contracted_mean(rc); }
+}
+
+
+void OrthogPolyApproximation::
+contracted_covariance(const RealMatrix& x_batch, RandomContraction& rc,
+		      RandomContraction& rc_2, RealVector& covars)
+{
+  bool same = (&rc == &rc_2);
+  contraction_values(x_batch, 0, rc);
+  if (!same) contraction_values(x_batch, 0, rc_2);
+  int j, num_pts = x_batch.numCols();
+  if (covars.length() != num_pts)
+    covars.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j) {
+    monomial_values(j, rc);  group_sums(rc);
+    if (!same)
+      { monomial_values(j, rc_2);  group_sums(rc_2); }
+    covars[j] = contracted_covariance(rc, rc_2);
+  }
+}
+
+
+void OrthogPolyApproximation::
+contracted_mean_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			 RandomContraction& rc,
+			 const RealMatrix& exp_coeff_grads,
+			 RealMatrix& mean_grads)
+{
+  contraction_values(x_batch, contraction_deriv_order(dvv), rc);
+  int j, num_pts = x_batch.numCols();
+  size_t num_deriv_v = dvv.size();
+  if (mean_grads.numRows() != num_deriv_v || mean_grads.numCols() != num_pts)
+    mean_grads.shapeUninitialized(num_deriv_v, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    monomial_values(j, rc);
+    contracted_mean_gradient(dvv, exp_coeff_grads, rc, j, mean_grads[j]);
+  }
+}
+
+
+void OrthogPolyApproximation::
+contracted_variance_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			     RandomContraction& rc,
+			     const RealMatrix& exp_coeff_grads,
+			     RealMatrix& var_grads)
+{
+  contraction_values(x_batch, contraction_deriv_order(dvv), rc);
+  int j, num_pts = x_batch.numCols();
+  size_t num_deriv_v = dvv.size();
+  if (var_grads.numRows() != num_deriv_v || var_grads.numCols() != num_pts)
+    var_grads.shapeUninitialized(num_deriv_v, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    monomial_values(j, rc);  group_sums(rc);
+    contracted_variance_gradient(dvv, exp_coeff_grads, rc, j, var_grads[j]);
+  }
+}
+
+
+void OrthogPolyApproximation::
+batch_terms(const UShort2DArray& mi, const SizetSet& sparse_ind,
+	    SizetArray& terms) const
+{
+  if (sparse_ind.empty()) {
+    size_t k, num_terms = mi.size();
+    terms.resize(num_terms);
+    for (k=0; k<num_terms; ++k)
+      terms[k] = k;
+  }
+  else
+    terms.assign(sparse_ind.begin(), sparse_ind.end());
+}
+
+
+/** The univariate basis values of all orders for each non-random
+    variable are evaluated over all columns of x_batch in a single
+    recurrence pass (see BasisPolynomial::type1_values()). */
+void OrthogPolyApproximation::
+nonrandom_basis_values(const RealMatrix& x_batch,
+		       const UShortArray& max_orders, short deriv_order,
+		       RealMatrixArray& t1_vals, RealMatrixArray& t1_grads)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  const SizetList& nrand_ind = data_rep->nonRandomIndices;
+  size_t v, num_v = data_rep->numVars;
+  int j, num_pts = x_batch.numCols();
+  if (x_batch.numRows() != num_v) {
+    PCerr << "Error: number of rows in x_batch (" << x_batch.numRows()
+	  << ") inconsistent with number of variables (" << num_v << ") in "
+	  << "OrthogPolyApproximation::nonrandom_basis_values()" << std::endl;
+    abort_handler(-1);
+  }
+
+  t1_vals.resize(num_v);  t1_grads.resize(num_v);
+  RealVector x_v(num_pts, false);  RealMatrix t1_hess;
+  SizetList::const_iterator cit;
+  for (cit=nrand_ind.begin(); cit!=nrand_ind.end(); ++cit) {
+    v = *cit;
+    for (j=0; j<num_pts; ++j)
+      x_v[j] = x_batch(v, j);
+    data_rep->polynomialBasis[v].type1_values(x_v, max_orders[v],
+					      deriv_order, t1_vals[v],
+					      t1_grads[v], t1_hess);
+  }
 }
 
 
@@ -1072,9 +1457,10 @@ void OrthogPolyApproximation::compute_component_sobol()
   // A bit is turned on for an expansion term if there is a variable
   // dependence (i.e., its multi-index component is non-zero).  Since
   // the Sobol' indices involve a consolidation of variance contributions
-  // from the expansion terms, we define a bit array from the multIndex
-  // and then use a lookup within sobolIndexMap to assign the expansion
-  // term contribution to the correct Sobol' index.
+  // from the expansion terms, we pack the variable dependence of each
+  // multiIndex term into a bit mask and then use a hashed lookup of
+  // sobolIndexMap to assign the expansion term contribution to the
+  // correct Sobol' index.
 
   // iterate through multiIndex and store sensitivities.  Note: sobolIndices[0]
   // (corresponding to constant exp term with no variable dependence) is unused.
@@ -1085,27 +1471,22 @@ void OrthogPolyApproximation::compute_component_sobol()
   // is the desired reference pt for type-agnostic global sensitivity analysis.
   std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
     std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
-  const UShort2DArray&           mi = data_rep->multi_index();
-  const BitArrayULongMap& index_map = data_rep->sobolIndexMap;
-  const RealVector&      exp_coeffs = expCoeffsIter->second;
-  size_t i, j, num_exp_terms = mi.size(), num_v = sharedDataRep->numVars;
+  const UShort2DArray&      mi = data_rep->multi_index();
+  const RealVector& exp_coeffs = expCoeffsIter->second;
+  size_t i, s, num_exp_terms = mi.size();
+  SobolMaskIndex sobol_index(data_rep->sobolIndexMap, sharedDataRep->numVars);
   Real p_var, sum_p_var = 0.;
-  BitArray set(num_v);
   for (i=1; i<num_exp_terms; ++i) {
     const UShortArray& mi_i = mi[i];
     p_var = exp_coeffs(i) * exp_coeffs(i) * data_rep->norm_squared(mi_i);
     sum_p_var += p_var;
 
-    // determine the bit set corresponding to this expansion term
-    for (j=0; j<num_v; ++j)
-      if (mi_i[j]) set.set(j);   //   activate bit j
-      else         set.reset(j); // deactivate bit j
-
-    // lookup the bit set within sobolIndexMap --> increment the correct
-    // Sobol' index with the variance contribution from this expansion term.
-    BAULMCIter cit = index_map.find(set);
-    if (cit != index_map.end()) // may not be found if vbdOrderLimit
-      sobolIndices[cit->second] += p_var; // divide by sum_p_var below
+    // lookup the variable dependence of this expansion term within
+    // sobolIndexMap --> increment the correct Sobol' index with the
+    // variance contribution from this expansion term.
+    s = sobol_index.find(mi_i);
+    if (s != SZ_MAX) // may not be found if vbdOrderLimit
+      sobolIndices[s] += p_var; // divide by sum_p_var below
   }
   assert(sum_p_var >= 0.0);
   if (!Pecos::is_small(std::sqrt(sum_p_var),mean())) // don't attribute variance if zero/negligible
@@ -1157,10 +1538,13 @@ void OrthogPolyApproximation::compute_total_sobol()
     // all component effects are present, so simply add them up:
     // totalSobolIndices parses the bit sets of each of the sobolIndices
     // and adds them to each matching variable bin
-    for (BAULMCIter cit=index_map.begin(); cit!=index_map.end(); ++cit)
-      for (k=0; k<num_v; ++k) 
-        if (cit->first[k]) // var k is present in this Sobol' index
-          totalSobolIndices[k] += sobolIndices[cit->second];
+    for (BAULMCIter cit=index_map.begin(); cit!=index_map.end(); ++cit) {
+      const BitArray& set = cit->first;
+      Real comp_sobol = sobolIndices[cit->second];
+      // visit the vars present in this Sobol' index
+      for (k=set.find_first(); k!=BitArray::npos; k=set.find_next(k))
+	totalSobolIndices[k] += comp_sobol;
+    }
   }
 
 #ifdef DEBUG
@@ -1174,113 +1558,169 @@ const RealVector& OrthogPolyApproximation::dimension_decay_rates()
 {
   std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
     std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
-  const UShort2DArray& mi = data_rep->multi_index();
-  const RealVector& exp_coeffs = expCoeffsIter->second;
-  size_t i, j, num_exp_terms = mi.size(),
-    num_v = sharedDataRep->numVars;
-  if (decayRates.empty())
-    decayRates.sizeUninitialized(num_v);
+  dimension_decay_rates(data_rep->multi_index(), SizetSet(),
+			expCoeffsIter->second);
+  return decayRates;
+}
 
-  // define max_orders for each var for sizing LLS matrices/vectors
-  UShortArray max_orders(num_v, 0);
-  for (i=0; i<num_exp_terms; ++i)
+
+/** The univariate terms are binned by variable and order within a single
+    sweep of the expansion terms, forming a column of log coefficients
+    for each variable.  Orders without a univariate term (e.g., gaps in a
+    sparse index set) retain the value for the cut-off coefficient 1.e-25. */
+void OrthogPolyApproximation::
+dimension_decay_rates(const UShort2DArray& mi, const SizetSet& sparse_ind,
+		      const RealVector& exp_coeffs)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  SizetArray terms;  batch_terms(mi, sparse_ind, terms);
+  size_t i, j, k, num_terms = terms.size(), num_v = data_rep->numVars;
+
+  // define max_orders for each var for sizing the LLS data
+  UShortArray max_orders(num_v, 0);  unsigned short order, max_order = 0;
+  for (k=1; k<num_terms; ++k) {
+    const UShortArray& mi_k = mi[terms[k]];
     for (j=0; j<num_v; ++j)
-      if (mi[i][j] > max_orders[j])
-	max_orders[j] = mi[i][j];
-  // size A_vectors and b_vectors
-  RealVectorArray A_vectors(num_v), b_vectors(num_v);
-  for (i=0; i<num_v; ++i) {
-    A_vectors[i].sizeUninitialized(max_orders[i]);
-    b_vectors[i].sizeUninitialized(max_orders[i]);
+      if (mi_k[j] > max_orders[j])
+	max_orders[j] = mi_k[j];
+  }
+  for (j=0; j<num_v; ++j)
+    if (max_orders[j] > max_order)
+      max_order = max_orders[j];
+
+  // initialize with log(norm * 1.e-25) for cut-off coeff value of 1.e-25
+  RealMatrix log_coeffs(max_order, num_v, false);
+  for (j=0; j<num_v; ++j) {
+    BasisPolynomial& poly_j = data_rep->polynomialBasis[j];
+    Real* log_coeffs_j = log_coeffs[j];
+    for (i=0; i<max_orders[j]; ++i)
+      log_coeffs_j[i] = std::log10(poly_j.norm_squared(i+1)) / 2. - 25.;
   }
 
-  // populate A_vectors and b_vectors
-  unsigned short order, non_zero, var_index, order_index;
-  bool univariate;
-  for (i=1; i<num_exp_terms; ++i) {
-    univariate = true; non_zero = 0;
-    for (j=0; j<num_v; ++j) {
-      if (mi[i][j]) {
-	++non_zero;
-	if (non_zero > 1) { univariate = false; break; }
-	else { order = mi[i][j]; var_index = j; order_index = order-1; }
+  // populate log_coeffs from the univariate terms: y = log(coeff * norm)
+  // for y = ax + b with x = term order and b = known intercept for x = 0
+  size_t var_index;  unsigned short non_zero;
+  for (k=1; k<num_terms; ++k) {
+    const UShortArray& mi_k = mi[terms[k]];
+    non_zero = 0;
+    for (j=0; j<num_v; ++j)
+      if (mi_k[j]) {
+	if (++non_zero > 1) break;
+	order = mi_k[j];  var_index = j;
       }
-    }
-    if (univariate) {
-      // find a for y = ax + b with x = term order, y = log(coeff), and
-      // b = known intercept for order x = 0
-      Real norm =
-	std::sqrt(data_rep->polynomialBasis[var_index].norm_squared(order)),
-	abs_coeff = std::abs(exp_coeffs[i]);
+    if (non_zero == 1) {
+      Real abs_coeff = std::abs(exp_coeffs[k]);
 #ifdef DECAY_DEBUG
       PCout << "Univariate contribution: order = " << order << " coeff = "
-	    << abs_coeff << " norm = " << norm << '\n';
+	    << abs_coeff << " norm = " << std::sqrt(data_rep->
+	       polynomialBasis[var_index].norm_squared(order)) << '\n';
 #endif // DECAY_DEBUG
-      A_vectors[var_index][order_index] = (Real)order;
-      b_vectors[var_index][order_index] = (abs_coeff > 1.e-25) ?
-	std::log10(abs_coeff * norm) : std::log10(norm) - 25.;
+      if (abs_coeff > 1.e-25)
+	// log(abs_coeff * norm), but don't recompute norm
+	log_coeffs(order-1, var_index) += 25. + std::log10(abs_coeff);
     }
   }
 #ifdef DECAY_DEBUG
-  PCout << "raw b_vectors:\n";
-  for (i=0; i<num_v; ++i)
-    PCout << "Variable " << i+1 << '\n' << b_vectors[i];
+  PCout << "raw log coefficients (orders by variables):\n" << log_coeffs;
 #endif // DECAY_DEBUG
 
-  solve_decay_rates(A_vectors, b_vectors, max_orders);
-  return decayRates;
+  solve_decay_rates(log_coeffs, max_orders);
 }
 
 
+/** Each variable defines a one-parameter fit (the intercept is the first
+    coefficient), which is solved in closed form from the moments of its
+    column of log_coeffs, together with the standard error of its slope
+    from the fit residuals. */
 void OrthogPolyApproximation::
-solve_decay_rates(RealVectorArray& A_vectors, RealVectorArray& b_vectors,
-		  UShortArray& max_orders)
+solve_decay_rates(const RealMatrix& log_coeffs, UShortArray& max_orders)
 {
   // first coefficient is used in each of the LLS solves
   Real log_coeff0 = std::log10(std::abs(expCoeffsIter->second[0])), tol = -10.;
-  short last_index_above = -1, new_size;
-  size_t i, j, num_v = sharedDataRep->numVars;;
+  size_t j, num_v = sharedDataRep->numVars;
+  if (decayRates.length() != num_v)
+    decayRates.sizeUninitialized(num_v);
+  if (decayRateErrors.length() != num_v)
+    decayRateErrors.sizeUninitialized(num_v);
 
-  for (i=0; i<num_v; ++i) {
-    RealVector& A_i = A_vectors[i]; RealVector& b_i = b_vectors[i];
+  for (size_t i=0; i<num_v; ++i) {
+    const Real* y_i = log_coeffs[i];
 
     // Handle case of flatline at numerical precision by ignoring subsequent
     // values below a tolerance (allow first, prune second)
     // > high decay rate will de-emphasize refinement, but consider zeroing
     //   out refinement for a direction that is converged below tol (?)
-    // > for now, truncate max_orders and scale back {A,b}_vectors
+    // > for now, truncate max_orders
     unsigned short order = max_orders[i];
+    short last_index_above = -1, new_size;
     for (j=0; j<order; ++j)
-      if (b_i[j] > tol)
+      if (y_i[j] > tol)
 	last_index_above = j;
     new_size = last_index_above+2; // include one value below tolerance
-    if (new_size < order) {
+    if (new_size < order)
       max_orders[i] = order = new_size;
-      A_i.resize(order); // needed for psuedo-inv but not LAPACK
-      b_i.resize(order); // needed for psuedo-inv but not LAPACK
-    }
-
-    // subtract intercept b for y = Ax+b  ==>  Ax = y-b
-    for (j=0; j<order; ++j)
-      b_i[j] -= log_coeff0;
 
+    // subtract intercept b for y = Ax+b  ==>  Ax = y-b and
     // employ simple 1-D pseudo inverse for LLS:
     //   A^T A x = A^T(y-b)  ==>  x = A^T(y-b) / A^T A
+    Real A_dot_A = 0., A_dot_b = 0., A_j;
+    for (j=0; j<order; ++j) {
+      A_j = (Real)(j+1);
+      A_dot_A += A_j * A_j;  A_dot_b += A_j * (y_i[j] - log_coeff0);
+    }
+    Real slope = A_dot_b / A_dot_A;
     // negate negative slope in log space such that large>0 is fast
     // convergence, small>0 is slow convergence, and <0 is divergence
-    decayRates[i] = -A_i.dot(b_i) / A_i.dot(A_i);
+    decayRates[i] = -slope;
+
+    // standard error of the slope: sqrt(SSE / (n - 1) / A^T A)
+    if (order > 1) {
+      Real sse = 0., resid;
+      for (j=0; j<order; ++j) {
+	resid = y_i[j] - log_coeff0 - slope * (Real)(j+1);
+	sse += resid * resid;
+      }
+      decayRateErrors[i] = std::sqrt(sse / (order - 1) / A_dot_A);
+    }
+    else
+      decayRateErrors[i] = LARGE_NUMBER;
   }
 
 #ifdef DECAY_DEBUG
   PCout << "Intercept log(abs(coeff0)) = " << log_coeff0
-	<< "\nb_vectors after truncation & intercept subtraction:\n";
-  for (i=0; i<num_v; ++i)
-    PCout << "Variable " << i+1 << '\n' << b_vectors[i];
-  PCout << "Individual approximation decay:\n" << decayRates;
+	<< "\nTruncated orders:\n" << max_orders
+	<< "Individual approximation decay:\n" << decayRates
+	<< "Standard errors:\n" << decayRateErrors;
 #endif // DECAY_DEBUG
 }
 
 
+/** Archived expansions are those with coefficients for a key within the
+    shared multi-index map; see ExpansionArchive for the file layout. */
+void OrthogPolyApproximation::archive_expansions(ExpansionArchive& archive)
+{
+  std::shared_ptr<SharedOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedOrthogPolyApproxData>(sharedDataRep);
+  archive.polynomial_basis(data_rep->polynomial_basis());
+  const std::map<ActiveKey, UShort2DArray>& mi_map
+    = data_rep->multi_index_map();
+  std::map<ActiveKey, UShort2DArray>::const_iterator mi_cit;
+  std::map<ActiveKey, RealMatrix>::const_iterator g_cit;
+  std::map<ActiveKey, RealVector>::const_iterator c_cit;
+  RealMatrix empty_grads;
+  for (c_cit=expansionCoeffs.begin(); c_cit!=expansionCoeffs.end(); ++c_cit) {
+    const ActiveKey& key = c_cit->first;
+    mi_cit = mi_map.find(key);
+    if (mi_cit == mi_map.end())
+      continue;
+    g_cit = expansionCoeffGrads.find(key);
+    archive.add_expansion(key, mi_cit->second, c_cit->second,
+      (g_cit == expansionCoeffGrads.end()) ? empty_grads : g_cit->second);
+  }
+}
+
+
 void OrthogPolyApproximation::
 print_coefficients(std::ostream& s, const UShort2DArray& mi,
 		   const RealVector& exp_coeffs, bool normalized)
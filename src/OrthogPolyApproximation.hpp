@@ -20,6 +20,8 @@
 
 namespace Pecos {
 
+class ExpansionArchive;
+
 
 /// Derived approximation class for orthogonal polynomials (global
 /// approximation).
@@ -49,6 +51,10 @@ public:
   /// estimate chaos expansion coefficient decay rates for each random
   /// variable dimension using linear least squares in semilog space
   virtual const RealVector& dimension_decay_rates();
+  /// return the standard errors of the decay rates from the most recent
+  /// dimension_decay_rates() (LARGE_NUMBER for rates defined by fewer
+  /// than two coefficients)
+  const RealVector& dimension_decay_rate_errors() const;
 
   /// unscale the expansion coefficients following computation using scaled
   /// response data
@@ -68,6 +74,10 @@ public:
 
   void basis_matrix(const RealMatrix& x, RealMatrix &basis_values);
 
+  /// add the polynomial basis and the expansion for each active key
+  /// (multi-index, coefficients and coefficient gradients) to archive
+  virtual void archive_expansions(ExpansionArchive& archive);
+
 protected:
 
   //
@@ -85,6 +95,7 @@ protected:
   void remove_stored_coefficients(size_t index = _NPOS);
   */
   void clear_inactive();
+  void clear_computed_bits();
 
   void combine_coefficients();
   void combined_to_active(bool clear_combined = true);
@@ -150,6 +161,70 @@ protected:
   Real combined_covariance(const RealVector& x,
 			   PolynomialApproximation* poly_approx_2);
 
+  void batch_mean(const RealMatrix& x_batch, RealVector& means);
+  void batch_covariance(const RealMatrix& x_batch,
+			PolynomialApproximation* poly_approx_2,
+			RealVector& covars);
+  void batch_mean_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			   RealMatrix& mean_grads);
+  void batch_variance_gradient(const RealMatrix& x_batch,
+			       const SizetArray& dvv, RealMatrix& var_grads);
+
+  /// partial contraction of an expansion over the random variables,
+  /// for evaluating statistics in all-variables mode
+  /** Expansion terms are reduced to the distinct monomials formed by
+      their non-random indices.  Terms without random dependence define
+      the mean as a polynomial in these monomials, and the remaining
+      terms are grouped by their random multi-index, such that the
+      variance is Sum_g <Psi_g^2> (Sum_{t in g} c_t Psi_t(x))^2.  Each
+      query, pointwise or batched, then evaluates only the distinct
+      monomials, in place of a test of every term and a pairwise match
+      of random multi-indices. */
+  struct RandomContraction
+  {
+    /// active key of the contracted expansion
+    ActiveKey activeKey;
+    /// coefficients of the contracted expansion (nullptr if invalid)
+    const Real* expCoeffs;
+    /// number of terms in the contracted expansion
+    size_t numTerms;
+    /// maximal order of each variable among the expansion terms
+    UShortArray maxOrders;
+    /// distinct non-random portions of the expansion terms (random
+    /// indices are zero)
+    UShort2DArray monomials;
+    /// monomials of the terms without random dependence
+    SizetArray meanMonomials;
+    /// coefficient indices of the terms without random dependence
+    SizetArray meanTerms;
+    /// coefficients of the terms without random dependence
+    RealArray meanCoeffs;
+    /// random multi-indices of the groups, in ascending order
+    UShort2DArray groupKeys;
+    /// norms squared of the random basis of each group
+    RealArray groupNorms;
+    /// offsets of each group within the group{Monomials,Terms,Coeffs}
+    /// arrays (one more than the number of groups)
+    SizetArray groupOffsets;
+    /// monomials of the terms within each group
+    SizetArray groupMonomials;
+    /// coefficient indices of the terms within each group
+    SizetArray groupTerms;
+    /// coefficients of the terms within each group
+    RealArray groupCoeffs;
+
+    /// univariate basis values of the non-random variables at x (or
+    /// over the columns of a batch)
+    RealMatrixArray t1Vals;
+    /// univariate basis gradients of the non-random variables at x (or
+    /// over the columns of a batch)
+    RealMatrixArray t1Grads;
+    /// values of the monomials at x
+    RealArray monomialValues;
+    /// values of the group polynomials at x
+    RealArray groupSums;
+  };
+
   //
   //- Heading: Member functions
   //
@@ -208,10 +283,83 @@ protected:
   void fail_booleans(SizetShortMap::const_iterator& fit, size_t j,
 		     bool& add_val, bool& add_grad);
 
-  /// utility function for solving the least squares estimation of decay rates
-  void solve_decay_rates(RealVectorArray& A_vectors, RealVectorArray& b_vectors,
+  /// estimate decayRates and decayRateErrors from the univariate terms of
+  /// mi within sparse_ind (all terms if empty)
+  void dimension_decay_rates(const UShort2DArray& mi,
+			     const SizetSet& sparse_ind,
+			     const RealVector& exp_coeffs);
+  /// utility function for solving the least squares estimation of decay
+  /// rates from the binned log coefficients (orders by variables)
+  void solve_decay_rates(const RealMatrix& log_coeffs,
 			 UShortArray& max_orders);
 
+  /// return randomContraction, updating it for the active expansion if
+  /// the expansion coefficients have changed
+  RandomContraction& random_contraction();
+  /// invalidate randomContraction
+  void clear_random_contraction();
+  /// partially contract the expansion terms of mi within sparse_ind (all
+  /// terms if empty), for which exp_coeffs are stored in the same order
+  void random_contraction(const UShort2DArray& mi, const SizetSet& sparse_ind,
+			  const RealVector& exp_coeffs, RandomContraction& rc);
+  /// evaluate the contracted monomials (and optionally the univariate
+  /// basis gradients) at the non-random variables of x
+  void contraction_values(const RealVector& x, short deriv_order,
+			  RandomContraction& rc);
+  /// tabulate the univariate basis values (and optionally gradients) of
+  /// the non-random variables of a contraction over the columns of x_batch
+  void contraction_values(const RealMatrix& x_batch, short deriv_order,
+			  RandomContraction& rc);
+  /// evaluate the contracted monomials for column j of the tabulated
+  /// basis values
+  void monomial_values(int j, RandomContraction& rc);
+  /// evaluate the polynomial in the non-random variables for each random
+  /// group of a contraction, following contraction_values()
+  void group_sums(RandomContraction& rc);
+  /// return the order of the basis derivatives required for dvv (first
+  /// order if any variable is augmented rather than inserted)
+  short contraction_deriv_order(const SizetArray& dvv) const;
+
+  /// evaluate the mean from the monomial values of a contraction
+  static Real contracted_mean(const RandomContraction& rc);
+  /// evaluate the covariance from the group sums of two contractions
+  /// (which may be the same)
+  static Real contracted_covariance(const RandomContraction& rc,
+				    const RandomContraction& rc_2);
+  /// evaluate the mean gradient from the monomial values of a contraction
+  /// and column j of its tabulated basis values
+  void contracted_mean_gradient(const SizetArray& dvv,
+				const RealMatrix& exp_coeff_grads,
+				const RandomContraction& rc, int j,
+				Real* mean_grad);
+  /// evaluate the variance gradient from the monomial values and group
+  /// sums of a contraction and column j of its tabulated basis values
+  void contracted_variance_gradient(const SizetArray& dvv,
+				    const RealMatrix& exp_coeff_grads,
+				    const RandomContraction& rc, int j,
+				    Real* var_grad);
+
+  /// compute the mean for each column of x_batch from a contraction
+  void contracted_mean(const RealMatrix& x_batch, RandomContraction& rc,
+		       RealVector& means);
+  /// compute the covariance for each column of x_batch between two
+  /// contractions (which may be the same)
+  void contracted_covariance(const RealMatrix& x_batch, RandomContraction& rc,
+			     RandomContraction& rc_2, RealVector& covars);
+  /// compute the mean gradient for each column of x_batch from a
+  /// contraction
+  void contracted_mean_gradient(const RealMatrix& x_batch,
+				const SizetArray& dvv, RandomContraction& rc,
+				const RealMatrix& exp_coeff_grads,
+				RealMatrix& mean_grads);
+  /// compute the variance gradient for each column of x_batch from a
+  /// contraction
+  void contracted_variance_gradient(const RealMatrix& x_batch,
+				    const SizetArray& dvv,
+				    RandomContraction& rc,
+				    const RealMatrix& exp_coeff_grads,
+				    RealMatrix& var_grads);
+
   //
   //- Heading: Data
   //
@@ -249,6 +397,13 @@ protected:
   /// spectral coefficient decay rates estimated by LLS on log of
   /// univariate expansion coefficients
   RealVector decayRates;
+  /// standard errors of decayRates from the residuals of each LLS fit
+  RealVector decayRateErrors;
+
+  /// cached partial contraction of the active expansion, invalidated by
+  /// clear_computed_bits() and by changes to the active key or
+  /// coefficient storage
+  RandomContraction randomContraction;
 
 private:
 
@@ -265,6 +420,30 @@ private:
   Real covariance(const RealVector& x, const UShort2DArray& mi,
 		  const RealVector& exp_coeffs, const RealVector& exp_coeffs_2);
 
+  /// define the indices into mi of the expansion terms within sparse_ind,
+  /// or of all terms of mi if sparse_ind is empty
+  void batch_terms(const UShort2DArray& mi, const SizetSet& sparse_ind,
+		   SizetArray& terms) const;
+  /// tabulate the univariate basis values (and gradients for deriv_order
+  /// >= 1) of each non-random variable up to max_orders over the columns
+  /// of x_batch
+  void nonrandom_basis_values(const RealMatrix& x_batch,
+			      const UShortArray& max_orders,
+			      short deriv_order, RealMatrixArray& t1_vals,
+			      RealMatrixArray& t1_grads);
+  /// evaluate the non-random portion of an expansion term for column j
+  /// of the tabulated basis values
+  static Real nonrandom_value(const UShortArray& mi_t,
+			      const SizetList& nrand_ind,
+			      const RealMatrixArray& t1_vals, int j);
+  /// evaluate the derivative of the non-random portion of an expansion
+  /// term with respect to variable deriv_index for column j of the
+  /// tabulated basis values
+  static Real nonrandom_gradient(const UShortArray& mi_t, size_t deriv_index,
+				 const SizetList& nrand_ind,
+				 const RealMatrixArray& t1_vals,
+				 const RealMatrixArray& t1_grads, int j);
+
   // apply normalization to std_coeffs to create normalized_coeffs
   void normalize(const RealVector& std_coeffs,
 		 RealVector& normalized_coeffs) const;
@@ -282,7 +461,7 @@ private:
 inline OrthogPolyApproximation::
 OrthogPolyApproximation(const SharedBasisApproxData& shared_data):
   PolynomialApproximation(shared_data), expCoeffsIter(expansionCoeffs.end())
-{ }
+{ randomContraction.expCoeffs = nullptr; }
 
 
 inline OrthogPolyApproximation::~OrthogPolyApproximation()
@@ -299,11 +478,11 @@ update_active_iterators(const ActiveKey& key)
   expCoeffsIter     = expansionCoeffs.find(key);
   expCoeffGradsIter = expansionCoeffGrads.find(key);
 
-  // share 1 deep copy of current active key
+  // share 1 interned (deep) copy of current active key
   ActiveKey key_copy;
   if (expCoeffsIter     == expansionCoeffs.end() ||
       expCoeffGradsIter == expansionCoeffGrads.end())
-    key_copy = key.copy();
+    key_copy = key.interned();
 
   if (expCoeffsIter == expansionCoeffs.end()) {
     std::pair<ActiveKey, RealVector> rv_pair(key_copy, RealVector());
@@ -321,6 +500,55 @@ update_active_iterators(const ActiveKey& key)
 }
 
 
+inline const RealVector& OrthogPolyApproximation::
+dimension_decay_rate_errors() const
+{ return decayRateErrors; }
+
+
+inline void OrthogPolyApproximation::clear_computed_bits()
+{
+  PolynomialApproximation::clear_computed_bits();
+  clear_random_contraction();
+}
+
+
+inline void OrthogPolyApproximation::clear_random_contraction()
+{ randomContraction.expCoeffs = nullptr; }
+
+
+inline Real OrthogPolyApproximation::
+nonrandom_value(const UShortArray& mi_t, const SizetList& nrand_ind,
+		const RealMatrixArray& t1_vals, int j)
+{
+  Real psi = 1.;  unsigned short order_1d;  SizetList::const_iterator cit;
+  for (cit=nrand_ind.begin(); cit!=nrand_ind.end(); ++cit) {
+    order_1d = mi_t[*cit];
+    if (order_1d)
+      psi *= t1_vals[*cit](order_1d, j);
+  }
+  return psi;
+}
+
+
+inline Real OrthogPolyApproximation::
+nonrandom_gradient(const UShortArray& mi_t, size_t deriv_index,
+		   const SizetList& nrand_ind, const RealMatrixArray& t1_vals,
+		   const RealMatrixArray& t1_grads, int j)
+{
+  // consistent with type1_gradient(x, 0) = 0 in
+  // multivariate_polynomial_gradient()
+  unsigned short order_1d = mi_t[deriv_index];
+  if (!order_1d)
+    return 0.;
+  Real dpsi = t1_grads[deriv_index](order_1d, j);
+  SizetList::const_iterator cit;
+  for (cit=nrand_ind.begin(); cit!=nrand_ind.end(); ++cit)
+    if (*cit != deriv_index && (order_1d = mi_t[*cit]))
+      dpsi *= t1_vals[*cit](order_1d, j);
+  return dpsi;
+}
+
+
 inline const RealVector& OrthogPolyApproximation::expansion_moments() const
 { return primaryMomIter->second; }
 
@@ -492,6 +720,7 @@ approximation_coefficients(const RealVector& approx_coeffs, bool normalized)
 
   if (normalized) denormalize(approx_coeffs, expCoeffsIter->second);
   else            expCoeffsIter->second = approx_coeffs;
+  clear_computed_bits();
 
   // allocate arrays in support of external coefficient import (mirrors
   // allocate_arrays() except for redundant size_expansion())
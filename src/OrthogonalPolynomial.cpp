@@ -33,6 +33,60 @@ void OrthogonalPolynomial::gauss_check(unsigned short order)
 }
 
 
+/** All orders and derivatives are generated together from the three-term
+    recurrence and its first and second derivatives with respect to x:
+    P'_{n+1}  = (a_n x + b_n) P'_n  +   a_n P_n  - c_n P'_{n-1} and
+    P''_{n+1} = (a_n x + b_n) P''_n + 2 a_n P'_n - c_n P''_{n-1}.
+    Polynomials that do not provide recurrence_coefficients() fall back
+    to individual type1_{value,gradient,hessian}() evaluations. */
+void OrthogonalPolynomial::
+type1_values(const RealVector& x, unsigned short max_order, short deriv_order,
+	     RealMatrix& t1_vals, RealMatrix& t1_grads, RealMatrix& t1_hessians)
+{
+  int j, num_x = x.length(), num_n = max_order + 1;
+  bool grad = (deriv_order >= 1), hess = (deriv_order >= 2);
+  if (t1_vals.numRows() != num_n || t1_vals.numCols() != num_x)
+    t1_vals.shapeUninitialized(num_n, num_x);
+  if (grad && (t1_grads.numRows() != num_n || t1_grads.numCols() != num_x))
+    t1_grads.shapeUninitialized(num_n, num_x);
+  if (hess &&
+      (t1_hessians.numRows() != num_n || t1_hessians.numCols() != num_x))
+    t1_hessians.shapeUninitialized(num_n, num_x);
+
+  unsigned short n;
+  RealVector a, b, c;
+  if (!recurrence_coefficients(max_order, a, b, c)) {
+    for (j=0; j<num_x; ++j) {
+      Real x_j = x[j];
+      for (n=0; n<=max_order; ++n) {
+	t1_vals(n,j) = type1_value(x_j, n);
+	if (grad) t1_grads(n,j)    = type1_gradient(x_j, n);
+	if (hess) t1_hessians(n,j) = type1_hessian(x_j, n);
+      }
+    }
+    return;
+  }
+
+  Real a_n, f_n, c_n, *P, *dP = NULL, *d2P = NULL;
+  for (j=0; j<num_x; ++j) {
+    P = t1_vals[j];  P[0] = 1.;
+    if (grad) { dP  = t1_grads[j];    dP[0]  = 0.; }
+    if (hess) { d2P = t1_hessians[j]; d2P[0] = 0.; }
+    if (!max_order)
+      continue;
+    a_n = a[0];  P[1] = a_n * x[j] + b[0];
+    if (grad) dP[1]  = a_n;
+    if (hess) d2P[1] = 0.;
+    for (n=1; n<max_order; ++n) {
+      a_n = a[n];  f_n = a_n * x[j] + b[n];  c_n = c[n];
+      P[n+1] = f_n * P[n] - c_n * P[n-1];
+      if (grad) dP[n+1]  = f_n * dP[n]  +    a_n * P[n]  - c_n * dP[n-1];
+      if (hess) d2P[n+1] = f_n * d2P[n] + 2. * a_n * dP[n] - c_n * d2P[n-1];
+    }
+  }
+}
+
+
 /** There are a number of ways to do this precomputation.  The PECOS
     approach favors memory over flops by storing nonzero Cijk only for
     unique index sets.  This approach requires a lookup of index sets
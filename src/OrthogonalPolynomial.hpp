@@ -51,6 +51,10 @@ public:
   bool type1_weights_defined(unsigned short order) const;
   //bool type2_weights_defined(unsigned short order) const;
 
+  void type1_values(const RealVector& x, unsigned short max_order,
+		    short deriv_order, RealMatrix& t1_vals,
+		    RealMatrix& t1_grads, RealMatrix& t1_hessians);
+
   //
   //- Heading: Member functions
   //
@@ -79,6 +83,17 @@ protected:
   /// get collocRule
   short collocation_rule() const;
 
+  //
+  //- Heading: New virtual functions
+  //
+
+  /// return the coefficients {a_n, b_n, c_n}, n = 0 to max_order-1, of the
+  /// three-term recurrence P_{n+1} = (a_n x + b_n) P_n - c_n P_{n-1}
+  /// (c_0 is unused); returns false if not supported for this polynomial
+  virtual bool recurrence_coefficients(unsigned short max_order,
+				       RealVector& a, RealVector& b,
+				       RealVector& c);
+
   //
   //- Heading: Data
   //
@@ -164,6 +179,12 @@ triple_product(unsigned short i, unsigned short j, unsigned short k,
 }
 
 
+inline bool OrthogonalPolynomial::
+recurrence_coefficients(unsigned short max_order, RealVector& a, RealVector& b,
+			RealVector& c)
+{ return false; }
+
+
 inline void OrthogonalPolynomial::collocation_rule(short rule)
 { collocRule = rule; }
 
@@ -535,6 +535,87 @@ combined_beta(const RealVector& x, bool cdf_flag, Real z_bar)
 }
 
 
+/** Default implementation evaluates mean(x) for each column of x_batch;
+    this is redefined by derived classes that can contract the expansion
+    over the random variables once for the batch. */
+void PolynomialApproximation::
+batch_mean(const RealMatrix& x_batch, RealVector& means)
+{
+  int j, num_v = x_batch.numRows(), num_pts = x_batch.numCols();
+  if (means.length() != num_pts)
+    means.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector x_j(Teuchos::View, const_cast<Real*>(x_batch[j]), num_v);
+    means[j] = mean(x_j);
+  }
+}
+
+
+/** Default implementation evaluates covariance(x, poly_approx_2) for each
+    column of x_batch. */
+void PolynomialApproximation::
+batch_covariance(const RealMatrix& x_batch,
+		 PolynomialApproximation* poly_approx_2, RealVector& covars)
+{
+  int j, num_v = x_batch.numRows(), num_pts = x_batch.numCols();
+  if (covars.length() != num_pts)
+    covars.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector x_j(Teuchos::View, const_cast<Real*>(x_batch[j]), num_v);
+    covars[j] = covariance(x_j, poly_approx_2);
+  }
+}
+
+
+/** Default implementation evaluates mean_gradient(x, dvv) for each
+    column of x_batch. */
+void PolynomialApproximation::
+batch_mean_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+		    RealMatrix& mean_grads)
+{
+  int j, num_v = x_batch.numRows(), num_pts = x_batch.numCols(),
+    num_deriv_v = dvv.size();
+  if (mean_grads.numRows() != num_deriv_v || mean_grads.numCols() != num_pts)
+    mean_grads.shapeUninitialized(num_deriv_v, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector x_j(Teuchos::View, const_cast<Real*>(x_batch[j]), num_v);
+    copy_data(mean_gradient(x_j, dvv).values(), num_deriv_v, mean_grads[j]);
+  }
+}
+
+
+/** Default implementation evaluates variance_gradient(x, dvv) for each
+    column of x_batch. */
+void PolynomialApproximation::
+batch_variance_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			RealMatrix& var_grads)
+{
+  int j, num_v = x_batch.numRows(), num_pts = x_batch.numCols(),
+    num_deriv_v = dvv.size();
+  if (var_grads.numRows() != num_deriv_v || var_grads.numCols() != num_pts)
+    var_grads.shapeUninitialized(num_deriv_v, num_pts);
+  for (j=0; j<num_pts; ++j) {
+    RealVector x_j(Teuchos::View, const_cast<Real*>(x_batch[j]), num_v);
+    copy_data(variance_gradient(x_j, dvv).values(), num_deriv_v,
+	      var_grads[j]);
+  }
+}
+
+
+void PolynomialApproximation::
+batch_beta(const RealMatrix& x_batch, bool cdf_flag, Real z_bar,
+	   RealVector& betas)
+{
+  RealVector means, vars;
+  batch_mean(x_batch, means);  batch_variance(x_batch, vars);
+  int j, num_pts = x_batch.numCols();
+  if (betas.length() != num_pts)
+    betas.sizeUninitialized(num_pts);
+  for (j=0; j<num_pts; ++j)
+    betas[j] = beta_map(means[j], vars[j], cdf_flag, z_bar);
+}
+
+
 Real PolynomialApproximation::delta_mean()
 {
   PCerr << "Error: delta_mean() not available for this polynomial "
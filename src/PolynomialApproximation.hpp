@@ -173,6 +173,28 @@ public:
   /// variables as random
   virtual Real combined_beta(const RealVector& x, bool cdf_flag, Real z_bar);
 
+  /// return the mean of the expansion for each parameter vector (column)
+  /// within x_batch, treating a subset of the variables as random
+  virtual void batch_mean(const RealMatrix& x_batch, RealVector& means);
+  /// return the covariance between two response expansions for each
+  /// parameter vector (column) within x_batch, treating a subset of the
+  /// variables as random
+  virtual void batch_covariance(const RealMatrix& x_batch,
+				PolynomialApproximation* poly_approx_2,
+				RealVector& covars);
+  /// return the gradients of the expansion mean (columns) for each parameter
+  /// vector (column) within x_batch and given DVV, treating a subset of the
+  /// variables as random
+  virtual void batch_mean_gradient(const RealMatrix& x_batch,
+				   const SizetArray& dvv,
+				   RealMatrix& mean_grads);
+  /// return the gradients of the expansion variance (columns) for each
+  /// parameter vector (column) within x_batch and given DVV, treating a
+  /// subset of the variables as random
+  virtual void batch_variance_gradient(const RealMatrix& x_batch,
+				       const SizetArray& dvv,
+				       RealMatrix& var_grads);
+
   /// return the change in mean resulting from expansion refinement,
   /// treating all variables as random
   virtual Real delta_mean();
@@ -321,6 +343,14 @@ public:
   /// given parameter vector, treating a subset of the variables as random
   Real delta_combined_variance(const RealVector& x);
 
+  /// return the variance of the expansion for each parameter vector
+  /// (column) within x_batch, treating a subset of the variables as random
+  void batch_variance(const RealMatrix& x_batch, RealVector& vars);
+  /// return the reliability index (mapped from z_bar) for each parameter
+  /// vector (column) within x_batch, treating a subset of variables as random
+  void batch_beta(const RealMatrix& x_batch, bool cdf_flag, Real z_bar,
+		  RealVector& betas);
+
   // number of data points to remove in a decrement
   //size_t pop_count();
 
@@ -392,6 +422,10 @@ protected:
   /// zero out bit trackers for combined moments
   void clear_combined_bits();
 
+  /// map a mean and variance to a reliability index, with shared logic
+  /// for handling exceptional cases
+  static Real beta_map(Real mu, Real var, bool cdf_flag, Real z_bar);
+
   //
   //- Heading: Data
   //
@@ -506,13 +540,13 @@ update_active_iterators(const ActiveKey& key)
   primaryMeanIter     = primaryMeanBits.find(key);
   primaryVarIter      = primaryVarBits.find(key);
 
-  // share 1 deep copy of current active key
+  // share 1 interned (deep) copy of current active key
   ActiveKey key_copy;
   if (primaryMomIter      == primaryMoments.end()     ||
       primaryMomGradsIter == primaryMomentGrads.end() ||
       primaryMeanIter     == primaryMeanBits.end()    ||
       primaryVarIter      == primaryVarBits.end())
-    key_copy = key.copy();
+    key_copy = key.interned();
 
   if (primaryMomIter == primaryMoments.end()) {
     std::pair<ActiveKey, RealVector> rv_pair(key_copy, RealVector());
@@ -703,6 +737,24 @@ delta_combined_variance(const RealVector& x)
 { return delta_combined_covariance(x, this); }
 
 
+inline void PolynomialApproximation::
+batch_variance(const RealMatrix& x_batch, RealVector& vars)
+{ batch_covariance(x_batch, this, vars); }
+
+
+inline Real PolynomialApproximation::
+beta_map(Real mu, Real var, bool cdf_flag, Real z_bar)
+{
+  if (var > 0.) {
+    Real stdev = std::sqrt(var);
+    return (cdf_flag) ? (mu - z_bar)/stdev : (z_bar - mu)/stdev;
+  }
+  else
+    return ( (cdf_flag && mu <= z_bar) || (!cdf_flag && mu > z_bar) ) ?
+      Pecos::LARGE_NUMBER : -Pecos::LARGE_NUMBER;
+}
+
+
 //inline size_t PolynomialApproximation::pop_count()
 //{
 //  SharedPolyApproxData* spad_rep = (SharedPolyApproxData*)sharedDataRep;
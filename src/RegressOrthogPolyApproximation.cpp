@@ -12,6 +12,8 @@
 //- Owner:        John Jakeman
 
 #include "RegressOrthogPolyApproximation.hpp"
+#include "ExpansionArchive.hpp"
+#include "SobolMaskIndex.hpp"
 #include "pecos_global_defs.hpp"
 #include "pecos_math_util.hpp"
 #include "Teuchos_LAPACK.hpp"
@@ -20,6 +22,7 @@
 // headers necessary for cross validation
 #include "math_tools.hpp"
 #include "CrossValidation.hpp"
+#include <thread>
 
 //#define DEBUG
 
@@ -597,6 +600,8 @@ void RegressOrthogPolyApproximation::run_regression()
       valid_cross_validation_expansion_configuration())
     run_cross_validation_expansion(); // updates all global bookkeeping
                                       // multiple RHS not currently supported
+  else if (streaming_regression_configuration())
+    run_streaming_regression(); // updates all global bookkeeping
   else {
     RealMatrix A, B, points;
     build_linear_system( A, B, points );
@@ -625,6 +630,204 @@ void RegressOrthogPolyApproximation::run_regression()
 }
 
 
+/** Streaming applies to dense least squares (SVD_LEAST_SQ_REGRESSION)
+    for either the expansion coefficients or the expansion coefficient
+    gradients; other solvers require access to the full linear system. */
+bool RegressOrthogPolyApproximation::streaming_regression_configuration()
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  return ( data_rep->regressConfigOptions.streamBlockSize &&
+	   data_rep->expConfigOptions.expCoeffsSolnApproach !=
+	   ORTHOG_LEAST_INTERPOLATION &&
+	   CSOpts.solver == SVD_LEAST_SQ_REGRESSION &&
+	   !faultInfo.under_determined &&
+	   !(expansionCoeffFlag && expansionCoeffGradFlag) );
+}
+
+
+/** The surrogate data are partitioned into blocks of streamBlockSize
+    points, which are distributed round-robin over the available hardware
+    threads.  Each thread builds its blocks of the linear system in turn
+    and reduces them into its own triangular factor using
+    util::tsqr_update(), after which the per-thread factors are reduced in
+    the same manner and the resulting N x N system is solved with the SVD,
+    such that rank deficiency is treated as for the full system.  Memory
+    is O(terms^2 + streamBlockSize x terms) per thread. */
+void RegressOrthogPolyApproximation::run_streaming_regression()
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  const UShort2DArray& mi = data_rep->multi_index();
+  size_t i, j, v, num_terms = mi.size(), num_v = sharedDataRep->numVars,
+    num_pts = surrData.points(),
+    block_size = data_rep->regressConfigOptions.streamBlockSize,
+    num_blocks = (num_pts + block_size - 1) / block_size;
+
+  // maximal order per variable; generate any numerically-generated
+  // recursions prior to threading, such that basis evaluation is read-only
+  UShortArray max_orders(num_v, 0);
+  for (i=0; i<num_terms; ++i)
+    for (v=0; v<num_v; ++v)
+      if (mi[i][v] > max_orders[v])
+	max_orders[v] = mi[i][v];
+  RealVector x0(1); RealMatrix t1_vals, t1_grads, t1_hess;
+  for (v=0; v<num_v; ++v)
+    data_rep->polynomialBasis[v].type1_values(x0, max_orders[v], 0, t1_vals,
+					      t1_grads, t1_hess);
+
+  size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::max((size_t)1, std::min(num_threads, num_blocks));
+  RealMatrixArray R(num_threads), QtB(num_threads);
+  if (num_threads == 1)
+    stream_linear_system(0, 1, max_orders, R[0], QtB[0]);
+  else {
+    std::vector<std::thread> threads;  threads.reserve(num_threads);
+    for (i=0; i<num_threads; ++i)
+      threads.push_back(std::thread(
+	&RegressOrthogPolyApproximation::stream_linear_system, this, i,
+	num_threads, std::cref(max_orders), std::ref(R[i]),
+	std::ref(QtB[i])));
+    for (i=0; i<num_threads; ++i)
+      threads[i].join();
+    for (i=1; i<num_threads; ++i)
+      util::tsqr_update(R[0], QtB[0], R[i], QtB[i]);
+  }
+
+  RealMatrix soln;  RealVector sing_vals;  int rank;
+  util::svd_solve(R[0], QtB[0], soln, sing_vals, rank);
+  PCout << "Applying streaming least squares regression to compute "
+	<< num_terms << " chaos coefficients using " << num_blocks
+	<< " blocks on " << num_threads << " threads (rank " << rank << ").\n";
+
+  if (expansionCoeffFlag)
+    copy_data(soln[0], (int)num_terms, expCoeffsIter->second);
+  else {
+    RealMatrix& exp_coeff_grads = expCoeffGradsIter->second;
+    int num_grad_rhs = soln.numCols();
+    for (i=0; i<num_grad_rhs; ++i)
+      for (j=0; j<num_terms; ++j)
+	exp_coeff_grads(i,j) = soln(j,i);
+  }
+  if (sparseIndIter != sparseIndices.end())
+    sparseIndIter->second.clear();
+}
+
+
+void RegressOrthogPolyApproximation::
+stream_linear_system(size_t first_block, size_t block_stride,
+		     const UShortArray& max_orders, RealMatrix& R,
+		     RealMatrix& QtB)
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  size_t b, num_pts = surrData.points(),
+    block_size = data_rep->regressConfigOptions.streamBlockSize,
+    num_blocks = (num_pts + block_size - 1) / block_size;
+  RealMatrix A, B;
+  for (b=first_block; b<num_blocks; b+=block_stride) {
+    build_linear_system_block(b * block_size,
+			      std::min(num_pts, (b+1) * block_size),
+			      max_orders, A, B);
+    util::tsqr_update(R, QtB, A, B);
+  }
+}
+
+
+/** Rows are ordered by point, with the gradient rows of each point
+    (derivative-enhanced regression) following its value row.  Basis
+    values and gradients are evaluated for all points in the block with
+    one recursion per variable (BasisPolynomial::type1_values()). */
+void RegressOrthogPolyApproximation::
+build_linear_system_block(size_t first_pt, size_t last_pt,
+			  const UShortArray& max_orders,
+			  RealMatrix& A, RealMatrix& B)
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  const UShort2DArray& mi = data_rep->multi_index();
+  const SDVArray& sdv_array = surrData.variables_data();
+  const SDRArray& sdr_array = surrData.response_data();
+  const SizetShortMap& failed_resp = surrData.failed_response_data();
+  bool use_derivs = (expansionCoeffFlag &&
+		     data_rep->basisConfigOptions.useDerivs),
+    scaling = surrData.valid_response_scaling();
+  size_t j, k, p, t, v, num_v = sharedDataRep->numVars,
+    num_terms = mi.size(), num_block_pts = last_pt - first_pt;
+  int num_rhs = (expansionCoeffFlag) ? 1 :
+    (int)surrData.num_derivative_variables();
+  Real shift = 0., scale = 1.;
+  if (scaling) {
+    const RealRealPair& factors = surrData.response_function_scaling();
+    shift = factors.first;  scale = factors.second;
+  }
+
+  // 1D basis values (and gradients) for each variable over the block
+  RealMatrixArray t1_vals(num_v), t1_grads(num_v);  RealMatrix t1_hess;
+  RealVector x(num_block_pts);
+  for (v=0; v<num_v; ++v) {
+    for (p=0; p<num_block_pts; ++p)
+      x[p] = sdv_array[first_pt+p].continuous_variables()[v];
+    data_rep->polynomialBasis[v].type1_values(x, max_orders[v],
+					      (use_derivs) ? 1 : 0, t1_vals[v],
+					      t1_grads[v], t1_hess);
+  }
+
+  // retained rows: value and gradient rows of each non-failed point
+  SizetShortMap::const_iterator fit = failed_resp.lower_bound(first_pt);
+  BitArray add_vals(num_block_pts), add_grads(num_block_pts);
+  size_t num_rows = 0;
+  for (p=0; p<num_block_pts; ++p) {
+    bool add_val = true, add_grad = true;
+    fail_booleans(fit, first_pt+p, add_val, add_grad);
+    if (expansionCoeffFlag)
+      add_grad = (add_grad && use_derivs);
+    else // value rows of A are matched to gradient data
+      add_val = add_grad, add_grad = false;
+    add_vals[p] = add_val;  add_grads[p] = add_grad;
+    if (add_val)  ++num_rows;
+    if (add_grad) num_rows += num_v;
+  }
+
+  A.shapeUninitialized(num_rows, num_terms);
+  B.shapeUninitialized(num_rows, num_rhs);
+  size_t row = 0;
+  for (p=0; p<num_block_pts; ++p) {
+    const SurrogateDataResp& sdr = sdr_array[first_pt+p];
+    if (add_vals[p]) {
+      for (t=0; t<num_terms; ++t) {
+	const UShortArray& mi_t = mi[t];  Real mvp = 1.;
+	for (v=0; v<num_v; ++v)
+	  mvp *= t1_vals[v](mi_t[v], p);
+	A(row, t) = mvp;
+      }
+      if (expansionCoeffFlag)
+	B(row, 0) = (sdr.response_function() - shift) / scale;
+      else {
+	const RealVector& resp_grad = sdr.response_gradient();
+	for (j=0; j<num_rhs; ++j)
+	  B(row, j) = resp_grad[j] / scale;
+      }
+      ++row;
+    }
+    if (add_grads[p]) {
+      const RealVector& resp_grad = sdr.response_gradient();
+      for (k=0; k<num_v; ++k, ++row) {
+	for (t=0; t<num_terms; ++t) {
+	  const UShortArray& mi_t = mi[t];
+	  Real mvp_grad = t1_grads[k](mi_t[k], p);
+	  for (v=0; v<num_v; ++v)
+	    if (v != k)
+	      mvp_grad *= t1_vals[v](mi_t[v], p);
+	  A(row, t) = mvp_grad;
+	}
+	B(row, 0) = resp_grad[k] / scale;
+      }
+    }
+  }
+}
+
+
 void RegressOrthogPolyApproximation::adapt_regression()
 {
   std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
@@ -645,6 +848,11 @@ void RegressOrthogPolyApproximation::adapt_regression()
   // CV err for the reference candidate basis.
   bestAdaptedMultiIndex = mi;
   SizetSet& sparse_ind = sparseIndIter->second;
+  clear_incremental_least_squares(); // factorization is rebuilt for new data
+  // one scoring metric is used for the reference and all candidates; see
+  // switch_to_k_fold_scoring() for the transition to larger candidates
+  lsqScoring
+    = incremental_least_squares_configuration(bestAdaptedMultiIndex.size());
   cvErrorRef = run_cross_validation_solver(bestAdaptedMultiIndex,
 					   expCoeffsIter->second, sparse_ind);
   PCout << "<<<<< Cross validation error reference = " << cvErrorRef << '\n';
@@ -685,6 +893,7 @@ void RegressOrthogPolyApproximation::adapt_regression()
   // different finalize: don't add in any remaining evaluated sets; rather,
   // we need to backtrack and restore the best solution with lowest CV error
   adaptedMultiIndex.clear(); adaptedSparseIndices.clear();
+  clear_incremental_least_squares();  lsqScoring = false;
   data_rep->clear_adapted();
 
   // Once done for this QoI, append adaptedMultiIndex to shared multiIndex,
@@ -723,7 +932,8 @@ Real RegressOrthogPolyApproximation::select_best_active_multi_index()
   Real curr_cv_err, cv_err_star, rel_delta, rel_delta_star = -DBL_MAX;
   RealVector curr_exp_coeffs; SizetSet curr_sparse_ind;
   // Reevaluate the effect of every active set every time
-  for (cit=active_mi.begin(); cit!=active_mi.end(); ++cit) {
+  cit = active_mi.begin();
+  while (cit != active_mi.end()) {
 
     // increment grid with current candidate
     const UShortArray& trial_set = *cit;
@@ -737,6 +947,15 @@ Real RegressOrthogPolyApproximation::select_best_active_multi_index()
     else
       data_rep->increment_trial_set(trial_set, adaptedMultiIndex);
 
+    // candidate sizes are only known once pushed: if this candidate switches
+    // the scoring metric, the candidates scored so far are not comparable
+    // with it, so all sets are reevaluated against the rescored reference
+    if (switch_to_k_fold_scoring(adaptedMultiIndex.size())) {
+      data_rep->decrement_trial_set(trial_set, adaptedMultiIndex);
+      rel_delta_star = -DBL_MAX;  cit = active_mi.begin();
+      continue;
+    }
+
     // Solve CS with cross-validation applied to solver settings (e.g., noise
     // tolerance), but not expansion order (since we are manually adapting it).
     // The CV error is L2 (sum of squares of mismatch) and is non-negative.
@@ -775,6 +994,7 @@ Real RegressOrthogPolyApproximation::select_best_active_multi_index()
     // restore previous state (destruct order is reversed from construct order)
     data_rep->decrement_trial_set(trial_set, adaptedMultiIndex);
     //lsg_driver->pop_set();
+    ++cit;
   }
   const UShortArray& best_set = *cit_star;
   PCout << "\n<<<<< Evaluation of active index sets completed.\n"
@@ -826,9 +1046,14 @@ Real RegressOrthogPolyApproximation::select_best_basis_expansion()
 
   // Evaluate the effect of each candidate basis expansion
   size_t i, i_star = 0, num_candidates = candidate_basis_exp.size(), 
-    size_star = adaptedMultiIndex.size();
+    size_star = adaptedMultiIndex.size(), max_candidate_exp = 0;
   Real curr_cv_err, cv_err_star, rel_delta, rel_delta_star = -DBL_MAX;
   RealVector curr_exp_coeffs; SizetSet curr_sparse_ind;
+  // a single scoring metric for all candidates, from the largest candidate
+  for (i=0; i<num_candidates; ++i)
+    max_candidate_exp
+      = std::max(max_candidate_exp, candidate_basis_exp[i].size());
+  switch_to_k_fold_scoring(size_star + max_candidate_exp);
   for (i=0; i<num_candidates; ++i) {
 
     // append candidate expansion to adaptedMultiIndex.  advance_multi_index()
@@ -1979,6 +2204,122 @@ variance_gradient(const RealVector& x, const SizetArray& dvv)
 }
 
 
+
+/** Sparse expansions are contracted over the terms within sparseIndices,
+    for which the coefficients are stored in sparse order.  These
+    contractions are formed per batch, in place of the cached contraction
+    of the dense expansion. */
+void RegressOrthogPolyApproximation::
+batch_mean(const RealMatrix& x_batch, RealVector& means)
+{
+  if (sparseIndIter == sparseIndices.end() || sparseIndIter->second.empty()) {
+    OrthogPolyApproximation::batch_mean(x_batch, means);
+    return;
+  }
+
+  // Error check for required data
+  if (!expansionCoeffFlag) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "RegressOrthogPolyApproximation::batch_mean()" << std::endl;
+    abort_handler(-1);
+  }
+
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  RandomContraction rc;
+  random_contraction(data_rep->multi_index(), sparseIndIter->second,
+		     expCoeffsIter->second, rc);
+  contracted_mean(x_batch, rc, means);
+}
+
+
+void RegressOrthogPolyApproximation::
+batch_covariance(const RealMatrix& x_batch,
+		 PolynomialApproximation* poly_approx_2, RealVector& covars)
+{
+  RegressOrthogPolyApproximation* ropa_2
+    = (RegressOrthogPolyApproximation*)poly_approx_2;
+  bool sparse   = ( sparseIndIter != sparseIndices.end() &&
+		    !sparseIndIter->second.empty() ),
+       sparse_2 = ( ropa_2->sparseIndIter != ropa_2->sparseIndices.end() &&
+		    !ropa_2->sparseIndIter->second.empty() );
+  if (!sparse && !sparse_2) {
+    OrthogPolyApproximation::batch_covariance(x_batch, poly_approx_2, covars);
+    return;
+  }
+
+  // Error check for required data
+  if ( !expansionCoeffFlag || ( ropa_2 != this &&
+				!ropa_2->expansionCoeffFlag ) ) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "RegressOrthogPolyApproximation::batch_covariance()" << std::endl;
+    abort_handler(-1);
+  }
+
+  // an empty sparse index set denotes a dense (mixed mode) expansion
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  const UShort2DArray& mi = data_rep->multi_index();
+  SizetSet dense_ind;  RandomContraction rc, rc_2;
+  random_contraction(mi, (sparse) ? sparseIndIter->second : dense_ind,
+		     expCoeffsIter->second, rc);
+  if (ropa_2 == this)
+    contracted_covariance(x_batch, rc, rc, covars);
+  else {
+    random_contraction(mi,
+      (sparse_2) ? ropa_2->sparseIndIter->second : dense_ind,
+      ropa_2->expCoeffsIter->second, rc_2);
+    contracted_covariance(x_batch, rc, rc_2, covars);
+  }
+}
+
+
+void RegressOrthogPolyApproximation::
+batch_mean_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+		    RealMatrix& mean_grads)
+{
+  if (sparseIndIter == sparseIndices.end() || sparseIndIter->second.empty()) {
+    OrthogPolyApproximation::batch_mean_gradient(x_batch, dvv, mean_grads);
+    return;
+  }
+
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  RandomContraction rc;
+  random_contraction(data_rep->multi_index(), sparseIndIter->second,
+		     expCoeffsIter->second, rc);
+  contracted_mean_gradient(x_batch, dvv, rc, expCoeffGradsIter->second,
+			   mean_grads);
+}
+
+
+void RegressOrthogPolyApproximation::
+batch_variance_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			RealMatrix& var_grads)
+{
+  if (sparseIndIter == sparseIndices.end() || sparseIndIter->second.empty()) {
+    OrthogPolyApproximation::batch_variance_gradient(x_batch, dvv, var_grads);
+    return;
+  }
+
+  // Error check for required data
+  if (!expansionCoeffFlag) {
+    PCerr << "Error: expansion coefficients not defined in "
+	  << "RegressOrthogPolyApproximation::batch_variance_gradient()"
+	  << std::endl;
+    abort_handler(-1);
+  }
+
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  RandomContraction rc;
+  random_contraction(data_rep->multi_index(), sparseIndIter->second,
+		     expCoeffsIter->second, rc);
+  contracted_variance_gradient(x_batch, dvv, rc, expCoeffGradsIter->second,
+			       var_grads);
+}
+
+
 void RegressOrthogPolyApproximation::set_fault_info()
 {
   size_t constr_eqns, num_data_pts_fn,
@@ -2277,6 +2618,10 @@ run_cross_validation_solver(const UShort2DArray& multi_index,
 {
   // TO DO: employ this fn as component within primary CV context
 
+  if (lsqScoring)
+    return run_incremental_least_squares(multi_index, best_exp_coeffs,
+					 best_sparse_indices);
+
   RealMatrix A, B;
   build_linear_system( A, B, multi_index );
 
@@ -2370,6 +2715,139 @@ run_cross_validation_solver(const UShort2DArray& multi_index,
 }
 
 
+/** The factorization retained from the previous call is synchronized with
+    multi_index: columns for terms that are no longer present (e.g., the
+    candidate terms of the previous trial set or terms removed by
+    restriction) are deleted using Givens rotations and columns for new
+    terms are appended using Gram-Schmidt, such that scoring a candidate
+    that adds k terms to an N term reference costs O(rows N k) rather than
+    the O(rows N^2) of a full refactorization.  Terms that are linearly
+    dependent on the factored columns are assigned a zero coefficient.
+    The leave-one-out residuals e_i / (1 - h_ii) follow from the diagonal
+    of the hat matrix QQ', replacing the K-fold cross validation of the
+    general case. */
+Real RegressOrthogPolyApproximation::
+run_incremental_least_squares(const UShort2DArray& multi_index,
+			      RealVector& best_exp_coeffs,
+			      SizetSet& best_sparse_indices)
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  const SDVArray& sdv_array = surrData.variables_data();
+  size_t i, j, p, num_terms = multi_index.size();
+
+  // rows of the linear system are fixed for the duration of the adaptation
+  if (lsqPointIndices.empty()) {
+    const SizetShortMap& failed_resp = surrData.failed_response_data();
+    SizetShortMap::const_iterator fit = failed_resp.begin();
+    size_t num_pts = surrData.points();
+    for (p=0; p<num_pts; ++p) {
+      bool add_val = true, add_grad = false;
+      fail_booleans(fit, p, add_val, add_grad);
+      if (add_val) lsqPointIndices.push_back(p);
+    }
+    lsqRHS.sizeUninitialized(lsqPointIndices.size());
+    for (p=0; p<lsqPointIndices.size(); ++p)
+      lsqRHS[p] = surrData.scaled_response_function(lsqPointIndices[p]);
+  }
+  int num_rows = lsqRHS.length(), num_cols = lsqMultiIndex.size();
+
+  // delete factored columns for terms that are not present in multi_index;
+  // reverse order reduces trailing deletions to truncations
+  std::map<UShortArray, size_t> term_map;
+  for (i=0; i<num_terms; ++i)
+    term_map[multi_index[i]] = i;
+  for (j=num_cols; j-- > 0; )
+    if (term_map.find(lsqMultiIndex[j]) == term_map.end()) {
+      util::qr_factorization_update_delete_column(lsqFactorQ, lsqFactorR,
+						  (int)j, num_cols--);
+      lsqMultiIndex.erase(lsqMultiIndex.begin() + j);
+    }
+
+  // append columns for terms that are not yet factored
+  BitArray factored(num_terms);
+  for (j=0; j<num_cols; ++j)
+    factored.set(term_map[lsqMultiIndex[j]]);
+  RealVector col(num_rows, false);
+  for (i=0; i<num_terms; ++i) {
+    if (factored[i]) continue;
+    if (num_cols == lsqFactorQ.numCols()) { // grow reserved capacity
+      int capacity = std::min(num_rows, std::max(2 * num_cols, 16));
+      lsqFactorQ.reshape(num_rows, capacity);
+      lsqFactorR.reshape(capacity, capacity);
+    }
+    const UShortArray& mi_i = multi_index[i];
+    for (p=0; p<num_rows; ++p)
+      col[p] = data_rep->multivariate_polynomial(
+	sdv_array[lsqPointIndices[p]].continuous_variables(), mi_i);
+    if (util::qr_factorization_update_insert_column(lsqFactorQ, lsqFactorR,
+						     col, num_cols) == 0)
+      { lsqMultiIndex.push_back(mi_i); ++num_cols; }
+  }
+
+  // least squares solution R c = Q'b and leave-one-out residuals
+  RealMatrix Q(Teuchos::View, lsqFactorQ, num_rows, num_cols),
+    R(Teuchos::View, lsqFactorR, num_cols, num_cols), soln;
+  RealVector Qtb(num_cols, false), fit_vals(num_rows, false);
+  util::GEMV(Teuchos::TRANS, false, 1., Q, lsqRHS, 0., Qtb);
+  util::GEMV(Teuchos::NO_TRANS, false, 1., Q, Qtb, 0., fit_vals);
+  Real score = 0.;
+  for (p=0; p<num_rows; ++p) {
+    Real h_pp = 0.;
+    for (j=0; j<num_cols; ++j)
+      h_pp += Q(p,j) * Q(p,j);
+    Real loo_err = (lsqRHS[p] - fit_vals[p]) /
+      std::max(1. - h_pp, DBL_EPSILON);
+    score += loo_err * loo_err;
+  }
+  score /= num_rows;
+  RealMatrix Qtb_mat(Teuchos::View, Qtb.values(), num_cols, num_cols, 1);
+  util::substitution_solve(R, Qtb_mat, soln);
+
+  if ( data_rep->expConfigOptions.outputLevel >= NORMAL_OUTPUT )
+    PCout << "Leave-one-out cross validation score: " << score << '\n';
+  PCout << "Applying incremental least squares to compute " << num_terms
+	<< " chaos coefficients using " << num_rows << " equations ("
+	<< num_terms - num_cols << " dependent terms omitted).\n";
+
+  // In current usage, global (shared multiIndex/sobolIndexMap) and local
+  // (sparseSobolIndexMap) bookkeeping are *not* updated since higher level
+  // logic (select_best_*()) determines acceptance of candidate solutions.
+  RealVector dense_coeffs(num_terms); // zero for dependent terms
+  for (j=0; j<num_cols; ++j)
+    dense_coeffs[term_map[lsqMultiIndex[j]]] = soln(j,0);
+  best_sparse_indices.clear();
+  update_sparse_indices(dense_coeffs.values(), num_terms, best_sparse_indices);
+  update_sparse_coeffs(dense_coeffs.values(), best_exp_coeffs,
+		       best_sparse_indices);
+
+  return score;
+}
+
+
+/** Leave-one-out scores of the incremental least squares solver and
+    K-fold scores are not comparable, so adapt_regression() selects one of
+    them for the reference basis and all candidates.  Once a candidate has
+    as many terms as valid data points, the leave-one-out score is no longer
+    defined: scoring then switches to K-fold for the rest of the adaptation
+    and the reference basis, with its solution, is rescored. */
+bool RegressOrthogPolyApproximation::
+switch_to_k_fold_scoring(size_t num_terms)
+{
+  if (!lsqScoring || incremental_least_squares_configuration(num_terms))
+    return false;
+
+  lsqScoring = false;
+  clear_incremental_least_squares();
+  cvErrorRef = run_cross_validation_solver(bestAdaptedMultiIndex,
+					   expCoeffsIter->second,
+					   sparseIndIter->second);
+  PCout << "<<<<< Cross validation error reference (rescored by K-fold) = "
+	<< cvErrorRef << '\n';
+  return true;
+}
+
+
 Real RegressOrthogPolyApproximation::run_cross_validation_expansion()
 {
   RealMatrix A, B;
@@ -2996,17 +3474,17 @@ update_sparse_sobol(const SizetSet& sparse_indices,
   // of the sparse interactions will be consistent, e.g.:
   // sparseSobolIndexMap keys:   0, 2, 4, 5, 9, 11 (from sobolIndexMap)
   // sparseSobolIndexMap values: 0, 1, 2, 3, 4, 5  (new sobolIndices sequence)
-  size_t j, num_v = sharedDataRep->numVars;
-  StSCIter sit; BAULMCIter cit; BitArray set(num_v);
+  size_t j, s, num_v = sharedDataRep->numVars, interactions;
+  SobolMaskIndex sobol_index(shared_sobol_map, num_v);
+  StSCIter sit;
   for (sit=sparse_indices.begin(); sit!=sparse_indices.end(); ++sit) {
     const UShortArray& sparse_mi = shared_multi_index[*sit];
-    for (j=0; j<num_v; ++j)
-      if (sparse_mi[j]) set.set(j);   //   activate bit j
-      else              set.reset(j); // deactivate bit j
     // define map from shared index to sparse index
-    cit = shared_sobol_map.find(set);
-    if (cit == shared_sobol_map.end()) {
-      if (set.count() <= data_rep->expConfigOptions.vbdOrderLimit) {
+    s = sobol_index.find(sparse_mi);
+    if (s == SZ_MAX) {
+      for (j=0, interactions=0; j<num_v; ++j)
+	if (sparse_mi[j]) ++interactions;
+      if (interactions <= data_rep->expConfigOptions.vbdOrderLimit) {
 	PCerr << "Error: sobolIndexMap lookup failure in RegressOrthogPoly"
 	      << "Approximation::update_sparse_sobol() for multi-index\n"
 	      << sparse_mi << std::endl;
@@ -3015,7 +3493,7 @@ update_sparse_sobol(const SizetSet& sparse_indices,
       // else contributions to this set are not tracked
     }
     else // {key,val} = {shared,sparse} index: init sparse to 0 (updated below)
-      sparseSobolIndexMap[cit->second] = 0;
+      sparseSobolIndexMap[s] = 0;
   }
   // now that keys are complete, assign new sequence for sparse Sobol indices
   unsigned long sobol_len = 0; ULULMIter mit;
@@ -3274,9 +3752,10 @@ void RegressOrthogPolyApproximation::compute_component_sobol()
   // A bit is turned on for an expansion term if there is a variable
   // dependence (i.e., its multi-index component is non-zero).  Since
   // the Sobol' indices involve a consolidation of variance contributions
-  // from the expansion terms, we define a bit array from the multIndex
-  // and then use a lookup within sobolIndexMap to assign the expansion
-  // term contribution to the correct Sobol' index.
+  // from the expansion terms, we pack the variable dependence of each
+  // multiIndex term into a bit mask and then use a hashed lookup of
+  // sobolIndexMap to assign the expansion term contribution to the
+  // correct Sobol' index.
 
   // iterate through multiIndex and store sensitivities.  Note: sobolIndices[0]
   // (corresponding to constant exp term with no variable dependence) is unused.
@@ -3290,27 +3769,22 @@ void RegressOrthogPolyApproximation::compute_component_sobol()
   const UShort2DArray& mi = data_rep->multi_index();
   RealVector& exp_coeffs = expCoeffsIter->second;
   const SizetSet& sparse_ind = sparseIndIter->second;
-  const BitArrayULongMap& index_map = data_rep->sobolIndexMap;
-  size_t i, j, num_v = sharedDataRep->numVars; StSCIter cit;
-  BitArray set(num_v);
+  SobolMaskIndex sobol_index(data_rep->sobolIndexMap, sharedDataRep->numVars);
+  bool main_only = (data_rep->expConfigOptions.vbdOrderLimit == 1);
+  size_t i, s; StSCIter cit;
   Real p_var, sum_p_var = 0.;
   for (i=1, cit=++sparse_ind.begin(); cit!=sparse_ind.end(); ++i, ++cit) {
     const UShortArray& mi_i = mi[*cit];
     p_var = exp_coeffs(i) * exp_coeffs(i) * data_rep->norm_squared(mi_i);
     sum_p_var += p_var;
 
-    // determine the bit set corresponding to this expansion term
-    for (j=0; j<num_v; ++j)
-      if (mi_i[j]) set.set(j);   //   activate bit j
-      else         set.reset(j); // deactivate bit j
-
-    // lookup the bit set within sobolIndexMap --> increment the correct
-    // Sobol' index with the variance contribution from this expansion term.
-    BAULMCIter cit = index_map.find(set);
-    if (cit != index_map.end()) { // may not be found if vbdOrderLimit
+    // lookup the variable dependence of this expansion term within
+    // sobolIndexMap --> increment the correct Sobol' index with the
+    // variance contribution from this expansion term.
+    s = sobol_index.find(mi_i);
+    if (s != SZ_MAX) { // may not be found if vbdOrderLimit
       // sparseSobolIndexMap definition is bypassed when vbdOrderLimit == 1
-      unsigned long sp_index = (data_rep->expConfigOptions.vbdOrderLimit == 1) ?
-	cit->second : sparseSobolIndexMap[cit->second];
+      unsigned long sp_index = (main_only) ? s : sparseSobolIndexMap[s];
       sobolIndices[sp_index] += p_var; // divide by sum_p_var below
     }
   }
@@ -3371,9 +3845,9 @@ void RegressOrthogPolyApproximation::compute_total_sobol()
       if (uit != sparseSobolIndexMap.end()) {
 	const BitArray& set = cit->first;
 	Real comp_sobol = sobolIndices[uit->second];
-	for (j=0; j<num_v; ++j) 
-	  if (set[j]) // var j is present in this Sobol' index
-	    totalSobolIndices[j] += comp_sobol;
+	// visit the vars present in this Sobol' index
+	for (j=set.find_first(); j!=BitArray::npos; j=set.find_next(j))
+	  totalSobolIndices[j] += comp_sobol;
       }
     }
   }
@@ -3390,76 +3864,10 @@ const RealVector& RegressOrthogPolyApproximation::dimension_decay_rates()
   if (sparseIndIter == sparseIndices.end() || sparseIndIter->second.empty())
     return OrthogPolyApproximation::dimension_decay_rates();
 
-  size_t i, j, num_exp_terms = sparseIndices.size(),
-    num_v = sharedDataRep->numVars;
-  if (decayRates.empty())
-    decayRates.sizeUninitialized(num_v);
-
-  // define max_orders for each var for sizing LLS matrices/vectors
   std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
     std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
-  const UShort2DArray& mi = data_rep->multi_index();
-  const SizetSet& sparse_ind = sparseIndIter->second;
-  RealVector& exp_coeffs = expCoeffsIter->second;
-  UShortArray max_orders(num_v, 0); StSCIter cit;
-  for (cit=++sparse_ind.begin(); cit!=sparse_ind.end(); ++cit) {
-    const UShortArray& mi_i = mi[*cit];
-    for (j=0; j<num_v; ++j)
-      if (mi_i[j] > max_orders[j])
-	max_orders[j] = mi_i[j];
-  }
-
-  // size A_vectors and b_vectors and initialize with defaults since
-  // sparseIndices could leave gaps
-  RealVectorArray A_vectors(num_v), b_vectors(num_v);
-  unsigned short order, non_zero, var_index, order_index;
-  Real norm;
-  for (i=0; i<num_v; ++i) {
-    unsigned short max_ord = max_orders[i];
-    RealVector& A_i = A_vectors[i]; A_i.sizeUninitialized(max_ord);
-    RealVector& b_i = b_vectors[i]; b_i.sizeUninitialized(max_ord);
-    BasisPolynomial& poly_i = data_rep->polynomialBasis[i];
-    for (j=0; j<max_ord; ++j) {
-      order = j + 1;
-      A_i[j] = (Real)order;
-      // log(norm * 1.e-25) for cut-off coeff value of 1.e-25
-      b_i[j] = std::log10(poly_i.norm_squared(order))/2. - 25.; // updated below
-    }
-  }
-
-  // populate A_vectors and b_vectors
-  bool univariate;
-  for (cit=++sparse_ind.begin(), i=1; cit!=sparse_ind.end(); ++cit, ++i) {
-    const UShortArray& mi_i = mi[*cit];
-    univariate = true; non_zero = 0;
-    for (j=0; j<num_v; ++j) {
-      if (mi_i[j]) {
-	++non_zero;
-	if (non_zero > 1) { univariate = false; break; }
-	else { order = mi_i[j]; var_index = j; order_index = order-1; }
-      }
-    }
-    if (univariate) {
-      // find a for y = ax + b with x = term order, y = log(coeff), and
-      // b = known intercept for order x = 0
-      Real abs_coeff = std::abs(exp_coeffs[i]);
-#ifdef DECAY_DEBUG
-      PCout << "Univariate contribution: order = " << order << " coeff = "
-	    << abs_coeff << " norm = " << std::sqrt(data_rep->
-	       polynomialBasis[var_index].norm_squared(order)) << '\n';
-#endif // DECAY_DEBUG
-      if (abs_coeff > 1.e-25)
-	// b = std::log10(abs_coeff * norm), but don't recompute norm
-	b_vectors[var_index][order_index] += 25. + std::log10(abs_coeff);
-    }
-  }
-#ifdef DECAY_DEBUG
-  PCout << "raw b_vectors:\n";
-  for (i=0; i<num_v; ++i)
-    PCout << "Variable " << i+1 << '\n' << b_vectors[i];
-#endif // DECAY_DEBUG
-
-  solve_decay_rates(A_vectors, b_vectors, max_orders);
+  OrthogPolyApproximation::dimension_decay_rates(data_rep->multi_index(),
+    sparseIndIter->second, expCoeffsIter->second);
   return decayRates;
 }
 
@@ -3556,6 +3964,47 @@ print_coefficients(std::ostream& s, bool normalized)
 }
 
 
+/** Sparse expansions store coefficients (and coefficient gradients) for
+    the retained terms only, so the archived multi-index is reduced to
+    the terms within sparseIndices, consistent with print_coefficients(). */
+void RegressOrthogPolyApproximation::
+archive_expansions(ExpansionArchive& archive)
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  archive.polynomial_basis(data_rep->polynomial_basis());
+  const std::map<ActiveKey, UShort2DArray>& mi_map
+    = data_rep->multi_index_map();
+  std::map<ActiveKey, UShort2DArray>::const_iterator mi_cit;
+  std::map<ActiveKey, RealMatrix>::const_iterator g_cit;
+  std::map<ActiveKey, RealVector>::const_iterator c_cit;
+  std::map<ActiveKey, SizetSet>::const_iterator sp_cit;
+  RealMatrix empty_grads;  UShort2DArray sparse_mi;
+  size_t i;  StSCIter cit;
+  for (c_cit=expansionCoeffs.begin(); c_cit!=expansionCoeffs.end(); ++c_cit) {
+    const ActiveKey& key = c_cit->first;
+    mi_cit = mi_map.find(key);
+    if (mi_cit == mi_map.end())
+      continue;
+    g_cit = expansionCoeffGrads.find(key);
+    const RealMatrix& exp_coeff_grads = (g_cit == expansionCoeffGrads.end())
+      ? empty_grads : g_cit->second;
+    sp_cit = sparseIndices.find(key);
+    if (sp_cit == sparseIndices.end() || sp_cit->second.empty())
+      archive.add_expansion(key, mi_cit->second, c_cit->second,
+			    exp_coeff_grads);
+    else {
+      const UShort2DArray& mi = mi_cit->second;
+      const SizetSet& sparse_ind = sp_cit->second;
+      sparse_mi.resize(sparse_ind.size());
+      for (i=0, cit=sparse_ind.begin(); cit!=sparse_ind.end(); ++i, ++cit)
+	sparse_mi[i] = mi[*cit];
+      archive.add_expansion(key, sparse_mi, c_cit->second, exp_coeff_grads);
+    }
+  }
+}
+
+
 void RegressOrthogPolyApproximation::
 coefficient_labels(std::vector<std::string>& coeff_labels) const
 {
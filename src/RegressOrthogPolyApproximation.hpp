@@ -79,6 +79,10 @@ public:
   void augment_linear_system(const RealVectorArray& samples, RealMatrix& A,
 			     const UShort2DArray& multi_index);
 
+  /// add expansions to archive, using the multi-index reduced to the
+  /// retained terms for keys with sparse solutions
+  void archive_expansions(ExpansionArchive& archive);
+
 protected:
 
   //
@@ -158,6 +162,15 @@ protected:
   const RealVector& variance_gradient(const RealVector& x,
 				      const SizetArray& dvv);
 
+  void batch_mean(const RealMatrix& x_batch, RealVector& means);
+  void batch_covariance(const RealMatrix& x_batch,
+			PolynomialApproximation* poly_approx_2,
+			RealVector& covars);
+  void batch_mean_gradient(const RealMatrix& x_batch, const SizetArray& dvv,
+			   RealMatrix& mean_grads);
+  void batch_variance_gradient(const RealMatrix& x_batch,
+			       const SizetArray& dvv, RealMatrix& var_grads);
+
   void compute_component_sobol();
   void compute_total_sobol();
 
@@ -210,6 +223,24 @@ private:
   /// expansion coefficients using L1 or L2 minimization
   void run_regression();
 
+  /// test whether run_regression() may stream the linear system in blocks
+  /// (see RegressionConfigOptions::streamBlockSize)
+  bool streaming_regression_configuration();
+  /// compute the expansion coefficients by dense least squares without
+  /// assembling the full linear system, using a threaded TSQR reduction
+  /// over blocks of the surrogate data
+  void run_streaming_regression();
+  /// accumulate the TSQR factors (R, Q'B) for the blocks of surrogate data
+  /// first_block, first_block + block_stride, ...
+  void stream_linear_system(size_t first_block, size_t block_stride,
+			    const UShortArray& max_orders, RealMatrix& R,
+			    RealMatrix& QtB);
+  /// build the rows of the linear system for the surrogate data points
+  /// [first_pt, last_pt), omitting failed data
+  void build_linear_system_block(size_t first_pt, size_t last_pt,
+				 const UShortArray& max_orders,
+				 RealMatrix& A, RealMatrix& B);
+
   /// perform an adaptive selection of candidate basis for fixed data,
   /// employing a generalized sparse grid to define the candidate basis
   /// index sets
@@ -231,6 +262,22 @@ private:
 				   RealVector& exp_coeffs,
 				   SizetSet& sparse_indices);
 
+  /// test whether run_cross_validation_solver() may be replaced by
+  /// run_incremental_least_squares() for a candidate basis of num_terms
+  bool incremental_least_squares_configuration(size_t num_terms) const;
+  /// update the retained QR factorization to the terms of multi_index by
+  /// column deletion and insertion, compute the least squares solution and
+  /// return its leave-one-out cross validation error
+  Real run_incremental_least_squares(const UShort2DArray& multi_index,
+				     RealVector& exp_coeffs,
+				     SizetSet& sparse_indices);
+  /// release the retained QR factorization
+  void clear_incremental_least_squares();
+  /// switch candidate scoring from leave-one-out to K-fold cross validation
+  /// when a candidate basis of num_terms precludes the incremental solver,
+  /// rescoring the reference basis; returns true if the switch was made
+  bool switch_to_k_fold_scoring(size_t num_terms);
+
   /// Use cross validation to find the hyper-parameters of the polynomial
   /// chaos expansion. e.g. find the 'best' total degree basis
   Real run_cross_validation_expansion();
@@ -408,6 +455,26 @@ private:
   /// candidate basis; it's state is reset for each response QoI
   Real cvErrorRef;
 
+  /// orthonormal factor of the linear system for the terms in
+  /// lsqMultiIndex (see run_incremental_least_squares()); columns beyond
+  /// lsqMultiIndex.size() are reserved capacity
+  RealMatrix lsqFactorQ;
+  /// upper triangular factor of the linear system for the terms in
+  /// lsqMultiIndex
+  RealMatrix lsqFactorR;
+  /// the multi-index terms that define the columns of lsqFactor{Q,R}
+  UShort2DArray lsqMultiIndex;
+  /// surrogate data points with valid function values that define the
+  /// rows of lsqFactorQ
+  SizetArray lsqPointIndices;
+  /// (scaled) function values for lsqPointIndices
+  RealVector lsqRHS;
+  /// scoring used by run_cross_validation_solver() for all candidates of
+  /// the current adaptation: leave-one-out by incremental least squares
+  /// (true) or K-fold cross validation (false).  Scores of the two are not
+  /// comparable, so the choice is revised at most once per adaptation.
+  bool lsqScoring;
+
   /// previous expansionCoeffs (aggregated total) prior to increment/push
   /// that allow efficient return in pop_coefficients()
   RealVector prevExpCoeffs;
@@ -430,7 +497,7 @@ private:
 inline RegressOrthogPolyApproximation::
 RegressOrthogPolyApproximation(const SharedBasisApproxData& shared_data):
   OrthogPolyApproximation(shared_data), sparseSoln(false),
-  sparseIndIter(sparseIndices.end())
+  sparseIndIter(sparseIndices.end()), lsqScoring(false)
 { }
 
 
@@ -438,6 +505,25 @@ inline RegressOrthogPolyApproximation::~RegressOrthogPolyApproximation()
 { }
 
 
+inline bool RegressOrthogPolyApproximation::
+incremental_least_squares_configuration(size_t num_terms) const
+{
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> data_rep =
+    std::static_pointer_cast<SharedRegressOrthogPolyApproxData>(sharedDataRep);
+  return ( data_rep->regressConfigOptions.incrementalLeastSq &&
+	   CSOpts.solver == SVD_LEAST_SQ_REGRESSION &&
+	   !data_rep->basisConfigOptions.useDerivs &&
+	   num_terms < faultInfo.num_data_pts_fn );
+}
+
+
+inline void RegressOrthogPolyApproximation::clear_incremental_least_squares()
+{
+  lsqFactorQ.shape(0, 0);  lsqFactorR.shape(0, 0);  lsqRHS.size(0);
+  lsqMultiIndex.clear();  lsqPointIndices.clear();
+}
+
+
 inline bool RegressOrthogPolyApproximation::
 update_active_iterators(const ActiveKey& key)
 {
@@ -447,7 +533,7 @@ update_active_iterators(const ActiveKey& key)
 
   sparseIndIter = sparseIndices.find(key);
   if (sparseIndIter == sparseIndices.end()) {
-    std::pair<ActiveKey, SizetSet> ss_pair(key.copy(), SizetSet());
+    std::pair<ActiveKey, SizetSet> ss_pair(key.interned(), SizetSet());
     sparseIndIter = sparseIndices.insert(ss_pair).first;
   }
 
@@ -14,6 +14,7 @@
 #include "SharedHierarchInterpPolyApproxData.hpp"
 #include "Teuchos_SerialDenseHelpers.hpp"
 #include "pecos_stat_util.hpp"
+#include <algorithm>
 
 #define DEBUG
 //#define VBD_DEBUG
@@ -168,4 +169,148 @@ barycentric_exact_index(const UShortArray& basis_index,
   return pt_index;
 }
 
+
+/** For local (piecewise) bases, the support of a 1D hierarchical basis
+    function spans the interval between its neighboring points in the
+    rule for its level, such that at most the two points bracketing x
+    need to be tested for each level and variable.  Global bases are
+    evaluated for all points in the delta key. */
+void SharedHierarchInterpPolyApproxData::
+support_basis_values(const RealVector& x, unsigned short max_level)
+{
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver =
+    std::static_pointer_cast<HierarchSparseGridDriver>(driverRep);
+  const Real3DArray& colloc_pts_1d = hsg_driver->collocation_points_1d();
+  size_t lev, v, j, lo, hi, num_delta, num_pts;  Real x_v, val;
+  UShortArray delta_key;  UShortArray::iterator it;
+
+  supportPositions.resize(max_level+1);  supportValues.resize(max_level+1);
+  supportKeys.resize(max_level+1);       supportDeltaSizes.resize(max_level+1);
+  for (lev=0; lev<=max_level; ++lev) {
+    UShort2DArray& pos_l = supportPositions[lev];
+    UShort2DArray& keys_l = supportKeys[lev];
+    Real2DArray&  vals_l = supportValues[lev];
+    UShortArray& sizes_l = supportDeltaSizes[lev];
+    pos_l.resize(numVars);  keys_l.resize(numVars);  vals_l.resize(numVars);
+    sizes_l.resize(numVars);
+    for (v=0; v<numVars; ++v) {
+      UShortArray& pos_lv = pos_l[v];  UShortArray& keys_lv = keys_l[v];
+      RealArray&  vals_lv = vals_l[v];
+      pos_lv.clear();  keys_lv.clear();  vals_lv.clear();
+      if (!lev) { // constant interpolation with 1 point
+	pos_lv.push_back(0);  keys_lv.push_back(0);  vals_lv.push_back(1.);
+	sizes_l[v] = 1;  continue;
+      }
+      hsg_driver->level_to_delta_key(v, lev, delta_key);
+      sizes_l[v] = num_delta = delta_key.size();
+      if (!num_delta) continue; // possible due to growth restrictions
+
+      BasisPolynomial& poly_lv = polynomialBasis[lev][v];  x_v = x[v];
+      switch (poly_lv.basis_type()) {
+      case PIECEWISE_LINEAR_INTERP: case PIECEWISE_QUADRATIC_INTERP:
+      case PIECEWISE_CUBIC_INTERP: {
+	// closed nested rules are ordered and delta keys are increasing
+	const RealArray& pts_lv = colloc_pts_1d[lev][v];
+	num_pts = pts_lv.size();
+	hi = std::upper_bound(pts_lv.begin(), pts_lv.end(), x_v)
+	   - pts_lv.begin();
+	lo = (hi) ? hi - 1 : 0;
+	if (hi == num_pts) hi = num_pts - 1;
+	for (j=lo; j<=hi; ++j) {
+	  it = std::lower_bound(delta_key.begin(), delta_key.end(), j);
+	  if (it != delta_key.end() && *it == j) {
+	    val = poly_lv.type1_value(x_v, j);
+	    if (val != 0.) {
+	      pos_lv.push_back(it - delta_key.begin());
+	      keys_lv.push_back(j);  vals_lv.push_back(val);
+	    }
+	  }
+	}
+	break;
+      }
+      default:
+	for (j=0; j<num_delta; ++j) {
+	  val = poly_lv.type1_value(x_v, delta_key[j]);
+	  if (val != 0.) {
+	    pos_lv.push_back(j);  keys_lv.push_back(delta_key[j]);
+	    vals_lv.push_back(val);
+	  }
+	}
+	break;
+      }
+    }
+  }
+}
+
+
+/** Only the tensor points whose supports contain x are visited, using
+    the 1D supports from support_basis_values() and the ordering of
+    hierarchical_tensor_product_multi_index() (first variable fastest).
+    An index set is pruned as soon as one variable has no support
+    containing x.  Partial keys from point-local refinement are instead
+    traversed point by point, matching 1D keys against the supports. */
+Real SharedHierarchInterpPolyApproxData::
+tensor_product_support_value(const RealVector& /* x */,
+			     const RealVector& exp_t1_coeffs,
+			     const RealMatrix& /* exp_t2_coeffs */,
+			     const UShortArray& basis_index,
+			     const UShort2DArray& key,
+			     const SizetArray& colloc_index)
+{
+  if (exp_t1_coeffs.empty())
+    return 0.;
+
+  size_t v, pt, stride, num_tp_pts = 1;  unsigned short bi_v;
+  for (v=0; v<numVars; ++v) {
+    bi_v = basis_index[v];
+    if (supportPositions[bi_v][v].empty())
+      return 0.;
+    num_tp_pts *= supportDeltaSizes[bi_v][v];
+  }
+  Real tp_val = 0., basis_prod;
+  // key does not span the full hierarchical tensor grid: no direct indexing
+  size_t num_key_pts = key.size();
+  if (num_key_pts != num_tp_pts) {
+    size_t j, num_supp;
+    for (pt=0; pt<num_key_pts; ++pt) {
+      const UShortArray& key_p = key[pt];  basis_prod = 1.;
+      for (v=0; v<numVars && basis_prod != 0.; ++v) {
+	bi_v = basis_index[v];
+	const UShortArray& keys_lv = supportKeys[bi_v][v];
+	num_supp = keys_lv.size();
+	j = std::find(keys_lv.begin(), keys_lv.end(), key_p[v])
+	  - keys_lv.begin();
+	basis_prod = (j < num_supp) ? basis_prod * supportValues[bi_v][v][j]
+	                            : 0.;
+      }
+      if (basis_prod != 0.)
+	tp_val += basis_prod * ( (colloc_index.empty()) ?
+	  exp_t1_coeffs[pt] : exp_t1_coeffs[colloc_index[pt]] );
+    }
+    return tp_val;
+  }
+
+  supportIndices.assign(numVars, 0);
+  do {
+    pt = 0;  stride = 1;  basis_prod = 1.;
+    for (v=0; v<numVars; ++v) {
+      bi_v = basis_index[v];
+      const unsigned short j = supportIndices[v];
+      pt         += stride * supportPositions[bi_v][v][j];
+      basis_prod *= supportValues[bi_v][v][j];
+      stride     *= supportDeltaSizes[bi_v][v];
+    }
+    tp_val += basis_prod * ( (colloc_index.empty()) ?
+      exp_t1_coeffs[pt] : exp_t1_coeffs[colloc_index[pt]] );
+    // increment the odometer over the support lists
+    for (v=0; v<numVars; ++v)
+      if (++supportIndices[v] < supportPositions[basis_index[v]][v].size())
+	break;
+      else
+	supportIndices[v] = 0;
+  } while (v < numVars);
+
+  return tp_val;
+}
+
 }
@@ -92,6 +92,18 @@ private:
   /// return driverRep cast to requested derived type
   std::shared_ptr<HierarchSparseGridDriver> hsg_driver();
 
+  /// for each level up to max_level and each variable, identify the
+  /// hierarchical 1D points whose type1 basis is nonzero at x
+  void support_basis_values(const RealVector& x, unsigned short max_level);
+  /// compute the type1 contribution of a hierarchical tensor grid at the
+  /// point most recently passed to support_basis_values()
+  Real tensor_product_support_value(const RealVector& x,
+				    const RealVector& exp_t1_coeffs,
+				    const RealMatrix& exp_t2_coeffs,
+				    const UShortArray& basis_index,
+				    const UShort2DArray& key,
+				    const SizetArray& colloc_index);
+
   //
   //- Heading: Data
   //
@@ -105,6 +117,18 @@ private:
   /// used for precomputation of the maximum hierarchical key index
   /// for a particular basis_index
   UShortArray tpMaxKeys;
+
+  /// positions within the hierarchical delta key of the 1D points whose
+  /// basis is nonzero at the support evaluation point, [level][variable][j]
+  UShort3DArray supportPositions;
+  /// 1D collocation keys corresponding to supportPositions
+  UShort3DArray supportKeys;
+  /// nonzero 1D basis values corresponding to supportPositions
+  Real3DArray supportValues;
+  /// number of 1D points in the hierarchical delta key, [level][variable]
+  UShort2DArray supportDeltaSizes;
+  /// odometer over supportPositions used in tensor_product_support_value()
+  UShortArray supportIndices;
 };
 
 
@@ -117,9 +117,9 @@ initialize_polynomial_basis_type(short& poly_type_1d, short& rule)
 void SharedInterpPolyApproxData::active_key(const ActiveKey& key)
 {
   if (activeKey != key) {
-    activeKey = key;
+    activeKey = key.interned(); // shared rep from ActiveKeyRegistry
     update_active_iterators();
-    driverRep->active_key(key);
+    driverRep->active_key(activeKey);
   }
 }
 
@@ -724,6 +724,109 @@ tensor_product_value(const RealVector& x, const RealVector& exp_t1_coeffs,
 }
 
 
+/** The 1D factors are computed once per level and variable for the
+    whole block and then shared by all tensor grids that employ them.
+    Level 0 is excluded, consistent with set_new_point(). */
+void SharedInterpPolyApproxData::
+barycentric_value_factors(const RealMatrix& samples)
+{
+  size_t lev, num_lev = polynomialBasis.size(), v, s,
+    num_samples = samples.numCols();
+  blockValueFactors.resize(num_lev);  blockFactorSums.resize(num_lev);
+  blockExactIndices.resize(num_lev);
+  for (lev=0; lev<num_lev; ++lev) {
+    blockValueFactors[lev].resize(numVars);
+    blockFactorSums[lev].resize(numVars);
+    blockExactIndices[lev].resize(numVars);
+  }
+  if (blockSamples.length() != num_samples)
+    blockSamples.sizeUninitialized(num_samples);
+
+  for (v=0; v<numVars; ++v) {
+    for (s=0; s<num_samples; ++s)
+      blockSamples[s] = samples(v, s);
+    for (lev=1; lev<num_lev; ++lev) {
+      BasisPolynomial& poly_lv = polynomialBasis[lev][v];
+      if (!poly_lv.is_null()) // tensor grids may not populate all levels
+	poly_lv.barycentric_value_factors(blockSamples.values(), num_samples,
+	  blockValueFactors[lev][v], blockFactorSums[lev][v],
+	  blockExactIndices[lev][v]);
+    }
+  }
+}
+
+
+/** Horner's rule over the tensor key as in tensor_product_value(), with
+    each accumulation vectorized over the block of samples.  Exact
+    matches need no special treatment, since their factors reduce to the
+    Lagrange values with a unit contribution to the barycentric
+    denominator. */
+void SharedInterpPolyApproxData::
+tensor_product_values(const RealVector& exp_t1_coeffs,
+		      const UShortArray& basis_index, const UShort2DArray& key,
+		      const SizetArray& colloc_index, Real scale,
+		      RealVector& approx_vals)
+{
+  if (exp_t1_coeffs.empty())
+    return;
+
+  size_t i, j, s, num_samples = approx_vals.length(),
+    num_colloc_pts = key.size();
+  if (blockAccumulators.numRows() != num_samples ||
+      blockAccumulators.numCols() != numVars)
+    blockAccumulators.shape(num_samples, numVars); // init to 0
+  else
+    blockAccumulators = 0.;
+
+  precompute_max_keys(basis_index); // if needed for efficiency
+  unsigned short key_i0, key_ij, bi_j, bi_0 = basis_index[0],
+    max0 = tensor_product_max_key(0, bi_0);
+  Real coeff, *accum_j, *accum_jm1;  const Real* vf;
+  for (i=0; i<num_colloc_pts; ++i) {
+    const UShortArray& key_i = key[i];  key_i0 = key_i[0];
+    coeff = (colloc_index.empty()) ?
+      exp_t1_coeffs[i] : exp_t1_coeffs[colloc_index[i]];
+    accum_j = blockAccumulators[0];
+    if (bi_0) {
+      vf = blockValueFactors[bi_0][0][key_i0];
+      for (s=0; s<num_samples; ++s)
+	accum_j[s] += coeff * vf[s];
+    }
+    else
+      for (s=0; s<num_samples; ++s)
+	accum_j[s] += coeff;
+    if (key_i0 == max0) {
+      // accumulate sums over variables with max key value
+      for (j=1; j<numVars; ++j) {
+	key_ij = key_i[j];  bi_j = basis_index[j];
+	accum_jm1 = accum_j;  accum_j = blockAccumulators[j];
+	if (bi_j) {
+	  vf = blockValueFactors[bi_j][j][key_ij];
+	  for (s=0; s<num_samples; ++s)
+	    { accum_j[s] += accum_jm1[s] * vf[s];  accum_jm1[s] = 0.; }
+	}
+	else
+	  for (s=0; s<num_samples; ++s)
+	    { accum_j[s] += accum_jm1[s];  accum_jm1[s] = 0.; }
+	if (key_ij != tensor_product_max_key(j, bi_j))
+	  break;
+      }
+    }
+  }
+
+  // apply the barycentric denominator
+  accum_j = blockAccumulators[numVars-1];
+  for (j=0; j<numVars; ++j)
+    if ( (bi_j = basis_index[j]) ) {
+      const Real* vf_sums = blockFactorSums[bi_j][j].values();
+      for (s=0; s<num_samples; ++s)
+	accum_j[s] /= vf_sums[s];
+    }
+  for (s=0; s<num_samples; ++s)
+    approx_vals[s] += scale * accum_j[s];
+}
+
+
 /** All variables version. */
 Real SharedInterpPolyApproxData::
 tensor_product_value(const RealVector& x, const RealVector& subset_t1_coeffs,
@@ -273,6 +273,18 @@ protected:
     const UShortArray& basis_index,  const UShort2DArray& subset_key,
     const SizetArray& subset_colloc_index, const SizetList& subset_indices);
 
+  /// compute the batched barycentric value factors for a block of samples
+  /// (variables x samples) for all levels of polynomialBasis
+  void barycentric_value_factors(const RealMatrix& samples);
+  /// accumulate scale times the value of a barycentric tensor interpolant
+  /// at each sample of the block most recently passed to
+  /// barycentric_value_factors(); batched counterpart to value(x)
+  void tensor_product_values(const RealVector& exp_t1_coeffs,
+			     const UShortArray& basis_index,
+			     const UShort2DArray& key,
+			     const SizetArray& colloc_index, Real scale,
+			     RealVector& approx_vals);
+
   /// compute the gradient of a tensor interpolant on a tensor grid
   /// with respect to variables that are included in the polynomial
   /// basis; contributes to gradient_basis_variables(x)
@@ -400,6 +412,18 @@ private:
   /// the gradient of a tensor-product interpolant; a contributor to
   /// approxGradient
   RealVector tpGradient;
+
+  /// barycentric value factors for a block of samples, by level and
+  /// variable, as (samples x interpolation points) matrices
+  RealMatrix2DArray blockValueFactors;
+  /// sums of blockValueFactors over interpolation points for each sample
+  RealVector2DArray blockFactorSums;
+  /// interpolation points matching each sample exactly (_NPOS if none)
+  Sizet3DArray blockExactIndices;
+  /// values of a single variable over a block of samples
+  RealVector blockSamples;
+  /// (samples x variables) accumulators for batched tensor summations
+  RealMatrix blockAccumulators;
 };
 
 
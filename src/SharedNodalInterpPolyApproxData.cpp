@@ -16,6 +16,7 @@
 #include "IncrementalSparseGridDriver.hpp"
 #include "InterpolationPolynomial.hpp"
 #include "Teuchos_SerialDenseHelpers.hpp"
+#include <limits>
 
 //#define DEBUG
 //#define VBD_DEBUG
@@ -608,6 +609,7 @@ reinterpolated_level(const UShortArray& lev_index)
   driverRep->reinterpolated_tensor_grid(lev_index, nonRandomIndices);
   update_tensor_interpolation_basis(driverRep->reinterpolated_level_index(),
 				    nonRandomIndices);
+  clear_type1_factors_1d();
 }
 
 
@@ -756,4 +758,164 @@ basis_product(const UShortArray& lev_index_1, const UShortArray& key_1,
   return true;
 }
 
+/** Consolidates the special cases in basis_product() for a single random
+    variable, such that the products for all pairs of 1D points can be
+    applied one dimension at a time (see transform_dimension()).  Relies
+    on update_nonzero_basis_products() for the case of nonzero differing
+    levels. */
+void SharedNodalInterpPolyApproxData::
+basis_products_1d(unsigned short l1, unsigned short l2, size_t v,
+		  size_t v_cntr, RealMatrix& prod_1d)
+{
+  const Real3DArray& t1_wts_1d = driverRep->type1_collocation_weights_1d();
+  size_t k1, k2,
+    n1 = (l1) ? polynomialBasis[l1][v].interpolation_size() : 1,
+    n2 = (l2) ? polynomialBasis[l2][v].interpolation_size() : 1;
+  prod_1d.shape(n1, n2); // init to 0.
+  if (l1 == 0) {        // single Lagrange poly = 1: integrate the other
+    const RealArray& t1_wts_2 = t1_wts_1d[l2][v];
+    for (k2=0; k2<n2; ++k2)
+      prod_1d(0, k2) = t1_wts_2[k2];
+  }
+  else if (l2 == 0) {
+    const RealArray& t1_wts_1 = t1_wts_1d[l1][v];
+    for (k1=0; k1<n1; ++k1)
+      prod_1d(k1, 0) = t1_wts_1[k1];
+  }
+  else if (l1 == l2) {  // same level: delta_ij * weight_i
+    const RealArray& t1_wts_1 = t1_wts_1d[l1][v];
+    for (k1=0; k1<n1; ++k1)
+      prod_1d(k1, k1) = t1_wts_1[k1];
+  }
+  else {                // nonzero differing levels: lookup precomputed product
+    UShort2DMultiSetRealMap& non_zeros_map
+      = nonZerosMapArray[nonZerosMapIndices[v_cntr]];
+    UShort2DMultiSetRealMap::iterator it;
+    UShortMultiSet mk1, mk2; UShort2DMultiSet map_key;
+    for (k1=0; k1<n1; ++k1)
+      for (k2=0; k2<n2; ++k2) {
+	mk1.clear(); mk1.insert(k1); mk1.insert(n1);
+	mk2.clear(); mk2.insert(k2); mk2.insert(n2);
+	map_key.clear(); map_key.insert(mk1); map_key.insert(mk2);
+	it = non_zeros_map.find(map_key);
+	if (it != non_zeros_map.end()) // zeros are not stored
+	  prod_1d(k1, k2) = it->second;
+      }
+  }
+}
+
+
+/** The 1D interpolant values are cached by level for the current x[v],
+    such that they are evaluated once per 1D rule rather than once per
+    tensor point, and are shared among the tensor grids of a sparse grid.
+    The single point rule at level 0 contributes a unit factor, consistent
+    with accumulate_horners(). */
+const RealArray& SharedNodalInterpPolyApproxData::
+type1_factors_1d(const RealVector& x, unsigned short lev, size_t v)
+{
+  static const RealArray unit_factor(1, 1.);
+  if (lev == 0)               // single integration/interpolation weight = 1
+    return unit_factor;
+  else if (randomVarsKey[v])  // integration
+    return driverRep->type1_collocation_weights_1d()[lev][v];
+
+  // interpolation
+  size_t l, num_lev = t1InterpValues1D.size();
+  if (t1InterpPoint.size() != numVars)
+    t1InterpPoint.assign(numVars, std::numeric_limits<Real>::quiet_NaN());
+  if (lev >= num_lev) {
+    t1InterpValues1D.resize(lev+1);
+    for (l=num_lev; l<=lev; ++l)
+      t1InterpValues1D[l].resize(numVars);
+    num_lev = lev+1;
+  }
+  Real x_v = x[v];
+  if (x_v != t1InterpPoint[v]) { // invalidate all levels for this variable
+    for (l=0; l<num_lev; ++l)
+      t1InterpValues1D[l][v].clear();
+    t1InterpPoint[v] = x_v;
+  }
+  RealArray& t1_vals = t1InterpValues1D[lev][v];
+  BasisPolynomial& poly_v = polynomialBasis[lev][v];
+  size_t k, num_pts = poly_v.interpolation_size();
+  if (t1_vals.size() != num_pts) {
+    t1_vals.resize(num_pts);
+    for (k=0; k<num_pts; ++k)
+      t1_vals[k] = poly_v.type1_value(x_v, k);
+  }
+  return t1_vals;
+}
+
+
+/** Sum factorization of a tensor-product sum: the tensor (ordered with
+    the first variable varying fastest, consistent with the collocation
+    key) is reduced along dimension v, which is retained with unit extent
+    such that dimension indexing remains aligned with the variables. */
+void SharedNodalInterpPolyApproxData::
+contract_dimension(const RealArray& factors_1d, size_t v, RealArray& tensor,
+		   UShortArray& dims)
+{
+  size_t i, k, p, num_v = dims.size(), num_k = dims[v], stride = 1,
+    num_outer = 1;
+  if (factors_1d.size() != num_k) {
+    PCerr << "Error: inconsistent 1D factors in SharedNodalInterpPolyApprox"
+	  << "Data::contract_dimension()." << std::endl;
+    abort_handler(-1);
+  }
+  if (num_k == 1 && factors_1d[0] == 1.) // nothing to contract
+    return;
+
+  for (i=0; i<v; ++i)       stride    *= dims[i];
+  for (i=v+1; i<num_v; ++i) num_outer *= dims[i];
+  RealArray result(stride * num_outer, 0.);
+  Real f_k; const Real *t_p, *t_pk; Real *r_p;
+  for (p=0; p<num_outer; ++p) {
+    t_p = &tensor[p*num_k*stride]; r_p = &result[p*stride];
+    for (k=0; k<num_k; ++k) {
+      f_k = factors_1d[k];
+      if (f_k == 0.) continue;
+      t_pk = t_p + k*stride;
+      for (i=0; i<stride; ++i)
+	r_p[i] += f_k * t_pk[i];
+    }
+  }
+  tensor.swap(result); dims[v] = 1;
+}
+
+
+/** Applies matrix_1d (num_rows x dims[v]) along dimension v of the tensor,
+    replacing its extent with the number of rows.  Used to apply the 1D
+    basis products of mixed tensor grids one dimension at a time. */
+void SharedNodalInterpPolyApproxData::
+transform_dimension(const RealMatrix& matrix_1d, size_t v, RealArray& tensor,
+		    UShortArray& dims)
+{
+  size_t i, j, k, p, num_v = dims.size(), num_k = dims[v],
+    num_j = matrix_1d.numRows(), stride = 1, num_outer = 1;
+  if (matrix_1d.numCols() != num_k) {
+    PCerr << "Error: inconsistent 1D matrix in SharedNodalInterpPolyApprox"
+	  << "Data::transform_dimension()." << std::endl;
+    abort_handler(-1);
+  }
+
+  for (i=0; i<v; ++i)       stride    *= dims[i];
+  for (i=v+1; i<num_v; ++i) num_outer *= dims[i];
+  RealArray result(stride * num_j * num_outer, 0.);
+  Real m_jk; const Real *t_p, *t_pk; Real *r_p, *r_pj;
+  for (p=0; p<num_outer; ++p) {
+    t_p = &tensor[p*num_k*stride]; r_p = &result[p*num_j*stride];
+    for (k=0; k<num_k; ++k) {
+      t_pk = t_p + k*stride;
+      for (j=0; j<num_j; ++j) {
+	m_jk = matrix_1d(j, k);
+	if (m_jk == 0.) continue;
+	r_pj = r_p + j*stride;
+	for (i=0; i<stride; ++i)
+	  r_pj[i] += m_jk * t_pk[i];
+      }
+    }
+  }
+  tensor.swap(result); dims[v] = num_j;
+}
+
 } // namespace Pecos
@@ -137,6 +137,38 @@ private:
 		     const UShortArray& lev_index_2, const UShortArray& key_2,
 		     Real& prod);
 
+  /// define the 1D matrix of integrals of products of interpolation
+  /// polynomials for random variable v (the v_cntr-th random variable)
+  /// between levels l1 (rows) and l2 (columns)
+  void basis_products_1d(unsigned short l1, unsigned short l2, size_t v,
+			 size_t v_cntr, RealMatrix& prod_1d);
+
+  /// return the 1D factors for contracting dimension v of a tensor grid:
+  /// type1 weights for random variables and type1 interpolant values at
+  /// x[v] for non-random variables
+  const RealArray& type1_factors_1d(const RealVector& x, unsigned short lev,
+				    size_t v);
+  /// clear the 1D interpolant values cached by type1_factors_1d()
+  void clear_type1_factors_1d();
+
+  /// define the dimensions of the tensor grid for lev_index
+  void tensor_dimensions(const UShortArray& lev_index, UShortArray& dims);
+  /// contract all dimensions of a tensor of values (first variable
+  /// varying fastest) using type1_factors_1d()
+  void contract_tensor(const RealVector& x, const UShortArray& lev_index,
+		       RealArray& tensor, UShortArray& dims);
+  /// contract the subset_indices dimensions of a tensor of values (first
+  /// variable varying fastest) using type1_factors_1d()
+  void contract_tensor(const RealVector& x, const UShortArray& lev_index,
+		       const SizetList& subset_indices, RealArray& tensor,
+		       UShortArray& dims);
+  /// contract dimension v of a tensor of values with a vector of 1D factors
+  void contract_dimension(const RealArray& factors_1d, size_t v,
+			  RealArray& tensor, UShortArray& dims);
+  /// apply a 1D matrix (rows = new extent) to dimension v of a tensor
+  void transform_dimension(const RealMatrix& matrix_1d, size_t v,
+			   RealArray& tensor, UShortArray& dims);
+
   /// computes higher-order grid for tensor reinterpolation of the
   /// covariance fn for non-integrated dimensions in all_variables mode
   void reinterpolated_level(const UShortArray& lev_index);
@@ -170,6 +202,13 @@ private:
   /// expectations of products of interpolation polynomials,
   /// precomputed in update_nonzero_basis_products() for efficiency
   std::vector<UShort2DMultiSetRealMap> nonZerosMapArray;
+
+  /// type1 interpolant values for non-random variables, cached by
+  /// type1_factors_1d() as [level][variable][point] for reuse across the
+  /// tensor grids of a sparse grid
+  Real3DArray t1InterpValues1D;
+  /// the 1D coordinates at which t1InterpValues1D are evaluated
+  RealArray t1InterpPoint;
 };
 
 
@@ -296,6 +335,41 @@ barycentric_exact_index(const UShortArray& basis_index,
 }
 
 
+inline void SharedNodalInterpPolyApproxData::clear_type1_factors_1d()
+{ t1InterpValues1D.clear(); t1InterpPoint.clear(); }
+
+
+inline void SharedNodalInterpPolyApproxData::
+tensor_dimensions(const UShortArray& lev_index, UShortArray& dims)
+{
+  dims.resize(numVars);
+  for (size_t v=0; v<numVars; ++v)
+    dims[v] = (lev_index[v]) ?
+      polynomialBasis[lev_index[v]][v].interpolation_size() : 1;
+}
+
+
+inline void SharedNodalInterpPolyApproxData::
+contract_tensor(const RealVector& x, const UShortArray& lev_index,
+		RealArray& tensor, UShortArray& dims)
+{
+  for (size_t v=0; v<numVars; ++v)
+    contract_dimension(type1_factors_1d(x, lev_index[v], v), v, tensor, dims);
+}
+
+
+inline void SharedNodalInterpPolyApproxData::
+contract_tensor(const RealVector& x, const UShortArray& lev_index,
+		const SizetList& subset_indices, RealArray& tensor,
+		UShortArray& dims)
+{
+  SizetList::const_iterator cit; size_t v;
+  for (cit=subset_indices.begin(); cit!=subset_indices.end(); ++cit)
+    { v = *cit; contract_dimension(type1_factors_1d(x, lev_index[v], v), v,
+				   tensor, dims); }
+}
+
+
 inline std::shared_ptr<IntegrationDriver>
 SharedNodalInterpPolyApproxData::driver()
 { return driverRep; }
@@ -16,6 +16,7 @@
 #include "pecos_global_defs.hpp"
 #include "pecos_math_util.hpp"
 #include "Teuchos_SerialDenseHelpers.hpp"
+#include <thread>
 
 //#define DEBUG
 //#define DECAY_DEBUG
@@ -48,7 +49,7 @@ void SharedOrthogPolyApproxData::allocate_data()
     allocate_component_sobol(multi_index);
     // Note: defer this if update_exp_form is needed downstream
     prevApproxOrder = approx_order;
-    prevActiveKey   = activeKey.copy();
+    prevActiveKey   = activeKey.interned();
   }
 
   // output (candidate) expansion form
@@ -69,12 +70,12 @@ void SharedOrthogPolyApproxData::allocate_data()
 void SharedOrthogPolyApproxData::active_key(const ActiveKey& key)
 {
   if (activeKey != key) {
-    activeKey = key; // SharedPolyApproxData::active_key(key);
+    activeKey = key.interned(); // SharedPolyApproxData::active_key(key);
     update_active_iterators();
 
     switch (expConfigOptions.expCoeffsSolnApproach) {
     case QUADRATURE: case COMBINED_SPARSE_GRID: case INCREMENTAL_SPARSE_GRID:
-      driverRep->active_key(key); break;
+      driverRep->active_key(activeKey); break;
     }
   }
 }
@@ -170,18 +171,19 @@ precompute_maximal_rules(const UShort2DArray& multi_index)
   // within the BasisPolynomial hierarchy).
 
   size_t i, num_mi_terms = multi_index.size();
+  UShortArray max_orders(numVars, 0);
   for (i=0; i<numVars; ++i)
     switch (polynomialBasis[i].basis_type()) {
     case NUM_GEN_ORTHOG: {
-      unsigned short max_order = multi_index[0][i];
-      for (size_t j=1; j<num_mi_terms; ++j)
+      unsigned short& max_order = max_orders[i];
+      for (size_t j=0; j<num_mi_terms; ++j)
 	if (multi_index[j][i] > max_order)
 	  max_order = multi_index[j][i];
-      polynomialBasis[i].precompute_rules(max_order);
       break;
     }
     // default is no-op
     }
+  precompute_rules(max_orders);
 }
 
 
@@ -193,12 +195,53 @@ precompute_maximal_rules(const UShortArray& approx_order)
   // can call for each basis polynomial and rely on virtual precompute_rules()
   // to target polynomials that support precomputation optimizations.
 
-  for (size_t i=0; i<numVars; ++i)
-    //switch (polynomialBasis[i].basis_type()) {
-    //case NUM_GEN_ORTHOG:
-    polynomialBasis[i].precompute_rules(approx_order[i]); //break;
-    // default is no-op
-    //}
+  precompute_rules(approx_order);
+}
+
+
+/** Rule generation for NUM_GEN_ORTHOG polynomials (measure
+    discretization, Stieltjes procedure, and eigensolves) dominates basis
+    construction and is independent across variables, so these
+    polynomials are processed concurrently, with at most one thread per
+    hardware thread.  Variables sharing a polynomial representation are
+    processed once at their maximal order.  All other polynomial types
+    are processed serially. */
+void SharedOrthogPolyApproxData::precompute_rules(const UShortArray& orders)
+{
+  std::map<BasisPolynomial*, unsigned short> num_gen_orders;
+  std::map<BasisPolynomial*, unsigned short>::iterator it;
+  for (size_t i=0; i<numVars; ++i) {
+    if (polynomialBasis[i].basis_type() == NUM_GEN_ORTHOG) {
+      BasisPolynomial* poly_rep = polynomialBasis[i].polynomial_rep().get();
+      it = num_gen_orders.find(poly_rep);
+      if (it == num_gen_orders.end())
+	num_gen_orders[poly_rep] = orders[i];
+      else if (orders[i] > it->second)
+	it->second = orders[i];
+    }
+    else
+      polynomialBasis[i].precompute_rules(orders[i]);
+  }
+
+  size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+  if (num_gen_orders.size() <= 1 || max_threads == 1) {
+    for (it=num_gen_orders.begin(); it!=num_gen_orders.end(); ++it)
+      it->first->precompute_rules(it->second);
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(max_threads);
+  for (it=num_gen_orders.begin(); it!=num_gen_orders.end(); ++it) {
+    if (threads.size() == max_threads) { // join the current batch
+      for (size_t t=0; t<max_threads; ++t)
+	threads[t].join();
+      threads.clear();
+    }
+    threads.push_back(std::thread(&BasisPolynomial::precompute_rules,
+				  it->first, it->second));
+  }
+  for (size_t t=0; t<threads.size(); ++t)
+    threads[t].join();
 }
 
 
@@ -38,6 +38,7 @@ class SharedOrthogPolyApproxData: public SharedPolyApproxData
   //
 
   friend class OrthogPolyApproximation;
+  friend class VectorOrthogPolyApproximation;
 
 public:
 
@@ -352,6 +353,9 @@ private:
   //- Heading: Member functions
   //
 
+  /// precompute rules for the specified orders of the polynomialBasis
+  /// entries, concurrently across distinct NUM_GEN_ORTHOG polynomials
+  void precompute_rules(const UShortArray& orders);
 };
 
 
@@ -18,6 +18,7 @@
 #include "pecos_stat_util.hpp"
 #include "pecos_math_util.hpp"
 #include "sandia_sgmga.hpp"
+#include "math_tools.hpp"
 
 //#define DEBUG
 
@@ -365,7 +366,7 @@ update_basis_distribution_parameters(const MultivariateDistribution& u_dist,
 
 void SharedPolyApproxData::active_key(const ActiveKey& key)
 {
-  activeKey = key;
+  activeKey = key.interned(); // shared rep from ActiveKeyRegistry
   //update_active_iterators(); // make virtual if used more broadly w/i Shared*
 }
 
@@ -665,7 +666,7 @@ total_order_terms(unsigned short order, size_t num_vars,
 
 /** Return the number of terms in a total-order expansion.  For anisotropic
     expansion order, no simple expression is currently available and the
-    number of expansion terms is computed using the multiIndex recursion. */
+    admissible multi-indices are counted as they are generated. */
 size_t SharedPolyApproxData::
 total_order_terms(unsigned short max_order, const RealVector& dim_pref,
 		  short lower_bound_offset)
@@ -679,7 +680,7 @@ total_order_terms(unsigned short max_order, const RealVector& dim_pref,
     abort_handler(-1);
   }
 
-  size_t i, num_vars = dim_pref.length(), num_terms;
+  size_t num_vars = dim_pref.length(), num_terms;
   if (!num_vars) {
     PCerr << "Error: anisotropic version of SharedPolyApproxData::total_order_"
 	  << "terms() requires valid dimension preference." << std::endl;
@@ -693,32 +694,19 @@ total_order_terms(unsigned short max_order, const RealVector& dim_pref,
   webbur::sandia_sgmga_aniso_normalize(1, num_vars, aniso_wts.values());
 
   // Note: ordering of terms is not important here (as it is in
-  // total_order_multi_index()) -- only need to count them, so
-  // looping can be more compact
-  num_terms = 1; // order 0
-  if (max_order >= 1)   // order 1
-    for (i=0; i<num_vars; ++i)
-      if (aniso_wts[i] <= (Real)max_order)
-	++num_terms;
-  unsigned short order;  size_t last_index, prev_index;  Real inner_prod;
-  for (order=2; order<=max_order; ++order) { // order 2 through max
-    UShortArray terms(order, 1); // # of terms = current order
-    bool order_complete = false;
-    while (!order_complete) {
-      last_index = order - 1; prev_index = order - 2;
-      for (terms[last_index]=1; terms[last_index]<=terms[prev_index]; 
-	   ++terms[last_index]) {
-	inner_prod = 0.;
-	for (i=0; i<num_vars; ++i)
-	  inner_prod += aniso_wts[i] *
-	    std::count(terms.begin(), terms.end(), i+1);
-	if (inner_prod <= (Real)max_order)
-	  ++num_terms;
-      }
-      // increment term hierarchy
-      increment_terms(terms, last_index, prev_index, num_vars, order_complete);
-    }
-  }
+  // total_order_multi_index()) -- only need to count them, so the
+  // admissible indices are streamed in chunks without storing the set
+  util::DownwardClosedIndexSetGenerator index_gen(num_vars, max_order,
+    [&aniso_wts, max_order](const IntVector& index) {
+      Real inner_prod = 0.;
+      for (int j=0; j<index.length(); ++j)
+	inner_prod += aniso_wts[j] * index[j];
+      return (inner_prod <= (Real)max_order);
+    });
+  IntMatrix mi_chunk;  size_t num_chunk, chunk_size = 1024;
+  num_terms = 0;
+  while ( (num_chunk = index_gen.next_chunk(chunk_size, mi_chunk)) )
+    num_terms += num_chunk;
 #ifdef DEBUG
   PCout << "SharedPolyApproxData total_order_terms = " << num_terms <<std::endl;
 #endif // DEBUG
@@ -254,6 +254,7 @@ class SharedPolyApproxData: public SharedBasisApproxData
   friend class OrthogPolyApproximation;
   friend class ProjectOrthogPolyApproximation;
   friend class RegressOrthogPolyApproximation;
+  friend class VectorOrthogPolyApproximation;
 
 public:
 
@@ -388,6 +389,10 @@ public:
   void configuration_options(const ExpansionConfigOptions& ec_options);
   /// set basisConfigOptions (instead of per option below)
   void configuration_options(const BasisConfigOptions& bc_options);
+  /// get expConfigOptions
+  const ExpansionConfigOptions& expansion_configuration_options() const;
+  /// get basisConfigOptions
+  const BasisConfigOptions& basis_configuration_options() const;
   /*
   /// set ExpansionConfigOptions::expCoeffsSolnApproach
   void solution_approach(short soln_approach);
@@ -434,9 +439,13 @@ public:
 
   /// set driverRep
   void integration_driver_rep(std::shared_ptr<IntegrationDriver> driver_rep);
+  /// get driverRep
+  std::shared_ptr<IntegrationDriver> integration_driver_rep() const;
 
   /// set randomVarsKey
   void random_variables_key(const BitArray& random_vars_key);
+  /// get nonRandomIndices
+  const SizetList& non_random_indices() const;
 
   /// return the number of expansion terms for a tensor-product
   /// expansion with the provided (anisotropic) quadrature orders
@@ -633,6 +642,16 @@ configuration_options(const BasisConfigOptions& bc_options)
 }
 
 
+inline const ExpansionConfigOptions& SharedPolyApproxData::
+expansion_configuration_options() const
+{ return expConfigOptions; }
+
+
+inline const BasisConfigOptions& SharedPolyApproxData::
+basis_configuration_options() const
+{ return basisConfigOptions; }
+
+
 /*
 inline void SharedPolyApproxData::solution_approach(short soln_approach)
 { expConfigOptions.expCoeffsSolnApproach = soln_approach; }
@@ -708,6 +727,11 @@ integration_driver_rep(std::shared_ptr<IntegrationDriver> driver_rep)
 { driverRep = driver_rep; }
 
 
+inline std::shared_ptr<IntegrationDriver> SharedPolyApproxData::
+integration_driver_rep() const
+{ return driverRep; }
+
+
 inline void SharedPolyApproxData::
 random_variables_key(const BitArray& random_vars_key)
 {
@@ -720,6 +744,10 @@ random_variables_key(const BitArray& random_vars_key)
 }
 
 
+inline const SizetList& SharedPolyApproxData::non_random_indices() const
+{ return nonRandomIndices; }
+
+
 inline void SharedPolyApproxData::
 increment_indices(UShortArray& indices, const UShortArray& limits,
 		  bool include_upper_bound)
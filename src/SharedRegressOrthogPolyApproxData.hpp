@@ -88,12 +88,30 @@ public:
   /// ADAPTED_BASIS_EXPANDING_FRONT mode
   unsigned short numAdvancements;
 
+  /// flag for scoring candidate bases within basis adaptation using an
+  /// incrementally updated QR factorization
+  /** Applies to SVD least squares regression on function values, for
+      which candidate terms are inserted into (and restricted terms are
+      deleted from) a retained factorization, rather than refactoring the
+      full linear system for each candidate.  The cross-validation error
+      is then the leave-one-out error, which is obtained in closed form
+      from the factorization. */
+  bool incrementalLeastSq;
+
   /// flag indicating restriction and front expansion using a multi-index
   /// frontier
   /** This option reduces memory requirements somewhat, but allowing
       multi-index gaps in the general case results in reduced mutual
       coherence and better numerical performance. */
   bool advanceByFrontier;
+
+  /// number of sample points per block of the linear system for streaming
+  /// least squares regression (0 assembles the full linear system)
+  /** For nonzero values, dense least squares regression builds the linear
+      system block by block from the surrogate data and reduces it with a
+      threaded TSQR, such that memory remains O(terms^2) rather than
+      O(samples x terms). */
+  size_t streamBlockSize;
 };
 
 
@@ -101,7 +119,8 @@ inline RegressionConfigOptions::RegressionConfigOptions():
   crossValidation(false), crossValidNoiseOnly(false),
   maxCVOrderCandidates(USHRT_MAX), respScaling(false), randomSeed(0),
   l2Penalty(0.), normalizeCV(false), initSGLevel(0), multiIndexGrowthFactor(2),
-  numAdvancements(3), advanceByFrontier(false)
+  numAdvancements(3), incrementalLeastSq(false), advanceByFrontier(false),
+  streamBlockSize(0)
 { }
 
 
@@ -115,7 +134,8 @@ RegressionConfigOptions(bool cv, bool cv_noise_only,
   maxCVOrderCandidates(max_cv_order), respScaling(scaling), randomSeed(seed),
   noiseTols(noise_tols), l2Penalty(l2_penalty), normalizeCV(normalize_cv),
   initSGLevel(init_lev), multiIndexGrowthFactor(growth_fact),
-  numAdvancements(num_advance), advanceByFrontier(false)
+  numAdvancements(num_advance), incrementalLeastSq(false),
+  advanceByFrontier(false), streamBlockSize(0)
 { }
 
 
@@ -130,7 +150,9 @@ RegressionConfigOptions(const RegressionConfigOptions& rc_options):
   initSGLevel(rc_options.initSGLevel),
   multiIndexGrowthFactor(rc_options.multiIndexGrowthFactor),
   numAdvancements(rc_options.numAdvancements),
-  advanceByFrontier(rc_options.advanceByFrontier)
+  incrementalLeastSq(rc_options.incrementalLeastSq),
+  advanceByFrontier(rc_options.advanceByFrontier),
+  streamBlockSize(rc_options.streamBlockSize)
 { }
 
 
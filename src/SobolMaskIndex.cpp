@@ -0,0 +1,67 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 SobolMaskIndex
+//- Description: Implementation code for SobolMaskIndex class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "SobolMaskIndex.hpp"
+
+namespace Pecos {
+
+SobolMaskIndex::
+SobolMaskIndex(const BitArrayULongMap& sobol_index_map, size_t num_vars):
+  numVars(num_vars), numWords(std::max((size_t)1, (num_vars + 63) / 64)),
+  termMask(numWords)
+{
+  size_t i, v, num_sets = sobol_index_map.size(), table_size = 1;
+  // load factor <= 1/2 ensures short probe sequences and an empty slot
+  while (table_size < 2 * num_sets)
+    table_size <<= 1;
+  hashTable.assign(table_size, 0);  tableMask = table_size - 1;
+  setMasks.assign(num_sets * numWords, 0);  setValues.resize(num_sets);
+
+  BAULMCIter cit;  size_t h;
+  for (i=0, cit=sobol_index_map.begin(); cit!=sobol_index_map.end();
+       ++i, ++cit) {
+    const BitArray& set = cit->first;
+    uint64_t* mask = &setMasks[i * numWords];
+    for (v=set.find_first(); v!=BitArray::npos; v=set.find_next(v))
+      mask[v >> 6] |= (uint64_t)1 << (v & 63);
+    setValues[i] = cit->second;
+    // sets are unique within sobol_index_map: insert without comparison
+    h = hash(mask) & tableMask;
+    while (hashTable[h])
+      h = (h + 1) & tableMask;
+    hashTable[h] = i + 1;
+  }
+}
+
+
+void SobolMaskIndex::find(const UShort2DArray& mi, SizetArray& sobol_indices)
+{
+  size_t i, num_terms = mi.size();
+  sobol_indices.resize(num_terms);
+  for (i=0; i<num_terms; ++i)
+    sobol_indices[i] = find(mi[i]);
+}
+
+
+void SobolMaskIndex::
+find(const UShort2DArray& mi, const SizetSet& term_indices,
+     SizetArray& sobol_indices)
+{
+  size_t i;  StSCIter cit;
+  sobol_indices.resize(term_indices.size());
+  for (i=0, cit=term_indices.begin(); cit!=term_indices.end(); ++i, ++cit)
+    sobol_indices[i] = find(mi[*cit]);
+}
+
+} // namespace Pecos
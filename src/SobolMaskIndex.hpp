@@ -0,0 +1,137 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 SobolMaskIndex
+//- Description: Hashed lookup of Sobol' indices from packed variable masks
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef SOBOL_MASK_INDEX_HPP
+#define SOBOL_MASK_INDEX_HPP
+
+#include "pecos_data_types.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace Pecos {
+
+
+/// Hashed index from the variable dependence of expansion terms to the
+/// Sobol' indices defined by SharedPolyApproxData::sobolIndexMap.
+
+/** The variable dependence of a multi-index term (one bit per variable
+    with a non-zero order) is packed into 64-bit words, which are located
+    within an open-addressed hash table of the sobolIndexMap sets.  This
+    replaces the per-term construction of a BitArray and its ordered
+    lookup within sobolIndexMap, which dominate the aggregation of term
+    variance contributions for large expansions.  An instance is a
+    snapshot of sobolIndexMap and must be reconstructed if it changes. */
+
+class SobolMaskIndex
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor
+  SobolMaskIndex(const BitArrayULongMap& sobol_index_map, size_t num_vars);
+  /// destructor
+  ~SobolMaskIndex();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// return the Sobol' index (sobolIndexMap value) for the variable
+  /// dependence of a multi-index term, or SZ_MAX if it is not tracked
+  /// (e.g., due to vbdOrderLimit)
+  size_t find(const UShortArray& mi_term);
+  /// define the Sobol' index for each term of a multi-index
+  void find(const UShort2DArray& mi, SizetArray& sobol_indices);
+  /// define the Sobol' index for each multi-index term within term_indices
+  void find(const UShort2DArray& mi, const SizetSet& term_indices,
+	    SizetArray& sobol_indices);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// pack the variable dependence of a multi-index term into mask
+  void pack(const UShortArray& mi_term, uint64_t* mask) const;
+  /// hash a packed mask
+  size_t hash(const uint64_t* mask) const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// number of variables
+  size_t numVars;
+  /// number of 64-bit words per packed mask
+  size_t numWords;
+  /// packed masks of the sobolIndexMap sets (numWords per set)
+  std::vector<uint64_t> setMasks;
+  /// sobolIndexMap values corresponding to setMasks
+  SizetArray setValues;
+  /// open-addressed hash table of set positions, offset by one such
+  /// that 0 denotes an empty slot; its size is a power of two
+  SizetArray hashTable;
+  /// bit mask reducing a hash to a hashTable position
+  size_t tableMask;
+  /// packed mask of the term being located
+  std::vector<uint64_t> termMask;
+};
+
+
+inline SobolMaskIndex::~SobolMaskIndex()
+{ }
+
+
+inline void SobolMaskIndex::
+pack(const UShortArray& mi_term, uint64_t* mask) const
+{
+  std::fill(mask, mask + numWords, 0);
+  for (size_t v=0; v<numVars; ++v)
+    if (mi_term[v])
+      mask[v >> 6] |= (uint64_t)1 << (v & 63);
+}
+
+
+inline size_t SobolMaskIndex::hash(const uint64_t* mask) const
+{
+  uint64_t h = 0;
+  for (size_t w=0; w<numWords; ++w) {
+    h ^= mask[w] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    // finalize with the murmur3 mixer to spread sparse masks
+    h ^= h >> 33;  h *= 0xff51afd7ed558ccdULL;  h ^= h >> 33;
+  }
+  return (size_t)h;
+}
+
+
+inline size_t SobolMaskIndex::find(const UShortArray& mi_term)
+{
+  pack(mi_term, termMask.data());
+  size_t h = hash(termMask.data()) & tableMask, pos;
+  while ((pos = hashTable[h])) {
+    if (std::equal(termMask.begin(), termMask.end(),
+		   setMasks.begin() + (pos - 1) * numWords))
+      return setValues[pos - 1];
+    h = (h + 1) & tableMask;
+  }
+  return SZ_MAX;
+}
+
+} // namespace Pecos
+
+#endif
@@ -392,6 +392,16 @@ void SparseGridDriver::compute_trial_grid(RealMatrix& var_sets)
 }
 
 
+void SparseGridDriver::
+compute_trial_grids(const UShort2DArray& /* trial_sets */,
+		    RealMatrix& /* var_sets */, SizetArray& /* trial_offsets */)
+{
+  PCerr << "Error: no default implementation for SparseGridDriver::"
+	<< "compute_trial_grids()." << std::endl;
+  abort_handler(-1);
+}
+
+
 void SparseGridDriver::compute_increment(RealMatrix& var_sets)
 {
   PCerr << "Error: no default implementation for SparseGridDriver::"
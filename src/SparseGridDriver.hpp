@@ -96,6 +96,12 @@ public:
   /// computes the tensor grid for the trial index set used in
   /// increment_smolyak_multi_index()
   virtual void compute_trial_grid(RealMatrix& var_sets);
+  /// computes the unique points for a batch of trial index sets, each
+  /// defined as an increment to the reference grid, stacked into a single
+  /// matrix with trial_offsets[i] the leading column for trial set i
+  virtual void compute_trial_grids(const UShort2DArray& trial_sets,
+				   RealMatrix& var_sets,
+				   SizetArray& trial_offsets);
 
   /// computes a grid increment and evaluates the new parameter sets
   virtual void compute_increment(RealMatrix& var_sets);
@@ -182,10 +188,10 @@ public:
   /// converts an array of sparse grid levels to an array of
   /// quadrature orders based on apiIntegrationRules/apiGrowthRules
   void level_to_order(size_t i, unsigned short level,
-		      unsigned short& order);
+		      unsigned short& order) const;
   /// converts an array of sparse grid levels to an array of
   /// quadrature orders based on apiIntegrationRules/apiGrowthRules
-  void level_to_order(const UShortArray& levels, UShortArray& orders);
+  void level_to_order(const UShortArray& levels, UShortArray& orders) const;
 
   /// set active ssgLevel
   void level(unsigned short ssg_level);
@@ -338,7 +344,7 @@ inline SparseGridDriver::~SparseGridDriver()
 inline void SparseGridDriver::active_key(const ActiveKey& key)
 {
   if (activeKey != key) {
-    activeKey = key; // shared rep; use deep copy when needed downstream
+    activeKey = key.interned(); // shared rep from ActiveKeyRegistry
     update_active_iterators();
   }
 }
@@ -477,7 +483,7 @@ inline const UShortArraySet& SparseGridDriver::active_multi_index() const
 
 
 inline void SparseGridDriver::
-level_to_order(size_t i, unsigned short level, unsigned short& order)
+level_to_order(size_t i, unsigned short level, unsigned short& order) const
 {
   //int ilevel = level, iorder;
   //webbur::level_growth_to_order(1, &ilevel, &apiIntegrationRules[i],
@@ -513,7 +519,7 @@ level_to_order(size_t i, unsigned short level, unsigned short& order)
 
 
 inline void SparseGridDriver::
-level_to_order(const UShortArray& levels, UShortArray& orders)
+level_to_order(const UShortArray& levels, UShortArray& orders) const
 {
   size_t i, num_lev = levels.size();
   if (orders.size() != num_lev)
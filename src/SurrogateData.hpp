@@ -1330,7 +1330,7 @@ inline SurrogateData& SurrogateData::operator=(const SurrogateData& sd)
 inline void SurrogateData::active_key(const ActiveKey& key) const
 {
   if (sdRep->activeKey != key) {
-    sdRep->activeKey = key;
+    sdRep->activeKey = key.interned(); // shared rep from ActiveKeyRegistry
     sdRep->update_active_iterators();
 
     // Seems a bit of overkill; for now, prefer synchronization calls from
@@ -1841,6 +1841,14 @@ inline void SurrogateData::push_back(int eval_id)
 { sdRep->dataIdsIter->second.push_back(eval_id); }
 
 
+inline void SurrogateData::data_ids(const IntArray& ids)
+{ sdRep->dataIdsIter->second = ids; }
+
+
+inline const IntArray& SurrogateData::data_ids() const
+{ return sdRep->dataIdsIter->second; }
+
+
 inline void SurrogateData::
 pop_back(size_t num_pop, SDVArray& sdv_array, SDRArray& sdr_array)
 {
@@ -0,0 +1,102 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 SurrogateDataIngest
+//- Description: Implementation code for SurrogateDataIngest class
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#include "SurrogateDataIngest.hpp"
+#include <algorithm>
+
+//#define DEBUG
+
+namespace Pecos {
+
+SurrogateDataIngest::~SurrogateDataIngest()
+{
+  Node* node = stagedHead.exchange(nullptr, std::memory_order_acquire);
+  while (node) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
+
+void SurrogateDataIngest::
+append(int eval_id, const SurrogateDataVars& sdv, const SurrogateDataResp& sdr)
+{
+  Node* node = new Node;
+  node->evalId = eval_id;  node->vars = sdv;  node->resp = sdr;
+  link(node, node);
+}
+
+
+/** The staged list is detached with a single exchange, such that
+    appends proceed concurrently with the merge.  Points with ids
+    beyond max_id are linked back for a later commit.  Merged ids must
+    exceed those of previous commits (see class description).  Data
+    identifiers are appended to sd only if it already tracks
+    identifiers for all of its points. */
+size_t SurrogateDataIngest::
+commit(SurrogateData& sd, int max_id, bool track_pop)
+{
+  Node* node = stagedHead.exchange(nullptr, std::memory_order_acquire);
+  std::vector<Node*> merge;
+  Node *retain_first = nullptr, *retain_last = nullptr;
+  while (node) {
+    Node* next = node->next;
+    if (node->evalId <= max_id)
+      merge.push_back(node);
+    else {
+      if (!retain_first) retain_first = node;
+      else               retain_last->next = node;
+      retain_last = node;
+    }
+    node = next;
+  }
+  if (retain_first)
+    link(retain_first, retain_last);
+
+  size_t i, num_merge = merge.size();
+  if (!num_merge)
+    return 0;
+  std::sort(merge.begin(), merge.end(), eval_id_order);
+  for (i=1; i<num_merge; ++i)
+    if (merge[i]->evalId == merge[i-1]->evalId) {
+      PCerr << "Error: duplicate evaluation id " << merge[i]->evalId
+	    << " in SurrogateDataIngest::commit()." << std::endl;
+      abort_handler(-1);
+    }
+  if (merge[0]->evalId <= lastCommittedId) {
+    PCerr << "Error: evaluation id " << merge[0]->evalId << " does not "
+	  << "exceed previously committed id " << lastCommittedId
+	  << " in SurrogateDataIngest::commit()." << std::endl;
+    abort_handler(-1);
+  }
+  lastCommittedId = merge[num_merge-1]->evalId;
+
+  bool track_ids = (sd.data_ids().size() == sd.points());
+  for (i=0; i<num_merge; ++i) {
+    Node* node_i = merge[i];
+    sd.push_back(node_i->vars, node_i->resp);
+    if (track_ids) sd.push_back(node_i->evalId);
+#ifdef DEBUG
+    PCout << "SurrogateDataIngest::commit(): merged id " << node_i->evalId
+	  << std::endl;
+#endif // DEBUG
+    delete node_i;
+  }
+  if (track_pop)
+    sd.pop_count(num_merge);
+  return num_merge;
+}
+
+} // namespace Pecos
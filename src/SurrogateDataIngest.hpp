@@ -0,0 +1,155 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:	 SurrogateDataIngest
+//- Description: Concurrent staging of truth data for SurrogateData
+//- Owner:       Mike Eldred
+//- Revised by:
+//- Version:
+
+#ifndef SURROGATE_DATA_INGEST_HPP
+#define SURROGATE_DATA_INGEST_HPP
+
+#include "SurrogateData.hpp"
+#include <atomic>
+#include <climits>
+
+namespace Pecos {
+
+
+/// Multi-producer staging buffer for truth data returned by
+/// asynchronous evaluations.
+
+/** Evaluation workers append {id, variables, response} triples
+    concurrently and without locks: each append links a node onto an
+    atomic list head, such that a worker never waits on the surrogate
+    builder or on other workers.  A single consumer then merges the
+    staged data into a SurrogateData instance at commit points, sorted
+    by evaluation id, such that the resulting {vars,resp}Data and
+    data_ids() are independent of the order in which evaluations
+    completed.  A commit may be limited to ids up to a bound, with
+    later ids retained for a subsequent commit, and may record the
+    number of merged points on the pop count stack so that the batch
+    can be removed by SurrogateData::pop().
+
+    Successive commits form an increasing sequence of ids: a point whose
+    id does not exceed the largest id already committed (a duplicate or
+    a late arrival below a previous commit bound) aborts the commit, such
+    that data_ids() remains strictly increasing.  A bounded commit should
+    therefore follow the appends of all ids up to its bound.
+
+    Appended variables and responses should not share representations
+    with data modified by other threads until committed (e.g., use
+    DEEP_COPY when constructing them from evaluation buffers). */
+
+class SurrogateDataIngest
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// default constructor
+  SurrogateDataIngest();
+  /// destructor
+  ~SurrogateDataIngest();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// stage a data point (may be called concurrently from any thread)
+  void append(int eval_id, const SurrogateDataVars& sdv,
+	      const SurrogateDataResp& sdr);
+
+  /// merge all staged points into sd in ascending id order and return
+  /// the number of merged points; the count is appended to the pop count
+  /// stack of sd when track_pop is set
+  size_t commit(SurrogateData& sd, bool track_pop = true);
+  /// merge the staged points with ids up to max_id into sd in ascending
+  /// id order, retaining later ids for a subsequent commit
+  size_t commit(SurrogateData& sd, int max_id, bool track_pop = true);
+
+  /// return true if no points are staged (exact only in the absence of
+  /// concurrent appends)
+  bool empty() const;
+
+private:
+
+  //
+  //- Heading: Private types
+  //
+
+  /// a staged data point
+  struct Node
+  {
+    /// evaluation id
+    int evalId;
+    /// staged variables
+    SurrogateDataVars vars;
+    /// staged response
+    SurrogateDataResp resp;
+    /// next node in the staging list
+    Node* next;
+  };
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// link the list from first to last onto stagedHead
+  void link(Node* first, Node* last);
+  /// order staged nodes by ascending evaluation id
+  static bool eval_id_order(const Node* a, const Node* b);
+
+  /// disallow copies of the staged nodes
+  SurrogateDataIngest(const SurrogateDataIngest&);
+  /// disallow copies of the staged nodes
+  SurrogateDataIngest& operator=(const SurrogateDataIngest&);
+
+  //
+  //- Heading: Data
+  //
+
+  /// head of the list of staged nodes (most recent append first)
+  std::atomic<Node*> stagedHead;
+  /// largest evaluation id merged by a previous commit (INT_MIN if none)
+  int lastCommittedId;
+};
+
+
+inline SurrogateDataIngest::SurrogateDataIngest():
+  stagedHead(nullptr), lastCommittedId(INT_MIN)
+{ }
+
+
+inline size_t SurrogateDataIngest::commit(SurrogateData& sd, bool track_pop)
+{ return commit(sd, INT_MAX, track_pop); }
+
+
+inline bool SurrogateDataIngest::empty() const
+{ return (stagedHead.load(std::memory_order_acquire) == nullptr); }
+
+
+inline void SurrogateDataIngest::link(Node* first, Node* last)
+{
+  // a failed exchange reloads the head into last->next for the retry
+  last->next = stagedHead.load(std::memory_order_relaxed);
+  while (!stagedHead.compare_exchange_weak(last->next, first,
+	   std::memory_order_release, std::memory_order_relaxed))
+    ;
+}
+
+
+inline bool SurrogateDataIngest::eval_id_order(const Node* a, const Node* b)
+{ return (a->evalId < b->evalId); }
+
+} // namespace Pecos
+
+#endif
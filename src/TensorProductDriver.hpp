@@ -253,7 +253,7 @@ inline TensorProductDriver::~TensorProductDriver()
 inline void TensorProductDriver::active_key(const ActiveKey& key)
 {
   if (activeKey != key) {
-    activeKey = key; // shallow copy
+    activeKey = key.interned(); // shared rep from ActiveKeyRegistry
     update_active_iterators();
   }
 }
@@ -0,0 +1,402 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:        VectorOrthogPolyApproximation
+//- Description:  Implementation code for VectorOrthogPolyApproximation class
+//-
+//- Owner:        Mike Eldred
+
+#include "VectorOrthogPolyApproximation.hpp"
+#include "SobolMaskIndex.hpp"
+#include "Teuchos_BLAS.hpp"
+#include <algorithm>
+
+//#define DEBUG
+
+namespace Pecos {
+
+
+VectorOrthogPolyApproximation::
+VectorOrthogPolyApproximation(const SharedBasisApproxData& shared_data,
+			      size_t num_qoi):
+  sharedDataRep(std::static_pointer_cast<SharedOrthogPolyApproxData>
+		(shared_data.data_rep())),
+  numQoI(num_qoi), expCoeffsIter(expansionCoeffs.end())
+{ }
+
+
+void VectorOrthogPolyApproximation::update_active_iterators()
+{
+  const ActiveKey& key = sharedDataRep->activeKey;
+  // Test for change
+  if (expCoeffsIter != expansionCoeffs.end() && expCoeffsIter->first == key)
+    return;
+
+  expCoeffsIter = expansionCoeffs.find(key);
+  if (expCoeffsIter == expansionCoeffs.end()) {
+    std::pair<ActiveKey, RealMatrix> rm_pair(key.interned(), RealMatrix());
+    expCoeffsIter = expansionCoeffs.insert(rm_pair).first;
+  }
+}
+
+
+void VectorOrthogPolyApproximation::
+gather_coefficients(const std::vector<BasisApproximation>& poly_approxs)
+{
+  update_active_iterators();
+  size_t q, num_terms = sharedDataRep->multi_index().size();
+  numQoI = poly_approxs.size();
+  RealMatrix& exp_coeffs = expCoeffsIter->second;
+  exp_coeffs.shapeUninitialized(num_terms, numQoI);
+  for (q=0; q<numQoI; ++q) {
+    // dense coefficients corresponding to the shared multi-index
+    RealVector coeffs_q = poly_approxs[q].approximation_coefficients(false);
+    if (coeffs_q.length() != num_terms) {
+      PCerr << "Error: inconsistent expansion terms for QoI " << q
+	    << " in VectorOrthogPolyApproximation::gather_coefficients()."
+	    << std::endl;
+      abort_handler(-1);
+    }
+    const Real* coeffs_q_vals = coeffs_q.values();
+    std::copy(coeffs_q_vals, coeffs_q_vals + num_terms, exp_coeffs[q]);
+  }
+}
+
+
+void VectorOrthogPolyApproximation::
+scatter_coefficients(std::vector<BasisApproximation>& poly_approxs)
+{
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  size_t q, num_terms = exp_coeffs.numRows();
+  if (poly_approxs.size() != numQoI) {
+    PCerr << "Error: inconsistent number of QoI in VectorOrthogPoly"
+	  << "Approximation::scatter_coefficients()." << std::endl;
+    abort_handler(-1);
+  }
+  // deep copies, such that each approximation retains ownership of its data
+  for (q=0; q<numQoI; ++q)
+    poly_approxs[q].approximation_coefficients(RealVector(Teuchos::Copy,
+      const_cast<Real*>(exp_coeffs[q]), num_terms), false);
+}
+
+
+void VectorOrthogPolyApproximation::
+expansion_coefficients(const RealMatrix& exp_coeffs)
+{
+  update_active_iterators();
+  if (exp_coeffs.numRows() != sharedDataRep->multi_index().size()) {
+    PCerr << "Error: inconsistent expansion terms in VectorOrthogPoly"
+	  << "Approximation::expansion_coefficients()." << std::endl;
+    abort_handler(-1);
+  }
+  expCoeffsIter->second = exp_coeffs;
+  numQoI = exp_coeffs.numCols();
+}
+
+
+/** Each 1D basis polynomial is evaluated once per variable up to the
+    maximum order present in the multi-index, rather than once per
+    expansion term as in SharedOrthogPolyApproxData::
+    multivariate_polynomial(). */
+void VectorOrthogPolyApproximation::
+basis_values(const RealVector& x, RealVector& basis_vals)
+{
+  size_t num_v = x.length();
+  RealMatrix x_mat(Teuchos::View, const_cast<Real*>(x.values()), num_v,
+		   num_v, 1), basis_mat;
+  basis_values(x_mat, basis_mat);
+  copy_data(basis_mat.values(), basis_mat.numCols(), basis_vals);
+}
+
+
+/** The 1D values of all orders for each variable are evaluated over all
+    samples in a single recurrence pass (see
+    BasisPolynomial::type1_values()). */
+void VectorOrthogPolyApproximation::
+basis_values(const RealMatrix& samples, RealMatrix& basis_vals)
+{
+  const UShort2DArray& mi = sharedDataRep->multi_index();
+  std::vector<BasisPolynomial>& poly_basis = sharedDataRep->polynomialBasis;
+  size_t i, j, v, num_terms = mi.size(), num_samples = samples.numCols(),
+    num_v = sharedDataRep->numVars;
+  unsigned short max_k, mi_iv;
+
+  if (basisValues1D.size() != num_v)
+    basisValues1D.resize(num_v);
+  RealVector samples_v(num_samples, false);  RealMatrix t1_grads, t1_hess;
+  for (v=0; v<num_v; ++v) {
+    for (i=0, max_k=0; i<num_terms; ++i)
+      if (mi[i][v] > max_k)
+	max_k = mi[i][v];
+    for (j=0; j<num_samples; ++j)
+      samples_v[j] = samples(v,j);
+    poly_basis[v].type1_values(samples_v, max_k, 0, basisValues1D[v],
+			       t1_grads, t1_hess);
+  }
+
+  basis_vals.shapeUninitialized(num_samples, num_terms);
+  for (i=0; i<num_terms; ++i) {
+    const UShortArray& mi_i = mi[i];
+    Real* basis_vals_i = basis_vals[i];
+    for (j=0; j<num_samples; ++j)
+      basis_vals_i[j] = 1.; // consistent with multivariate_polynomial()
+    for (v=0; v<num_v; ++v) {
+      mi_iv = mi_i[v];
+      if (mi_iv) {
+	const RealMatrix& vals_v = basisValues1D[v];
+	for (j=0; j<num_samples; ++j)
+	  basis_vals_i[j] *= vals_v(mi_iv, j);
+      }
+    }
+  }
+}
+
+
+void VectorOrthogPolyApproximation::
+values(const RealVector& x, RealVector& qoi_vals)
+{
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  RealVector basis_vals;
+  basis_values(x, basis_vals);
+  if (qoi_vals.length() != numQoI)
+    qoi_vals.sizeUninitialized(numQoI);
+  qoi_vals.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., exp_coeffs,
+		    basis_vals, 0.);
+}
+
+
+void VectorOrthogPolyApproximation::
+values(const RealMatrix& samples, RealMatrix& qoi_vals)
+{
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  RealMatrix basis_vals;
+  basis_values(samples, basis_vals);
+  qoi_vals.shapeUninitialized(samples.numCols(), numQoI);
+  qoi_vals.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1., basis_vals,
+		    exp_coeffs, 0.);
+}
+
+
+/** The 1D values and gradients of all orders for each variable are
+    evaluated in a single recurrence pass; the gradient of each term
+    with respect to variable v replaces the v-th 1D value with its
+    gradient (see SharedOrthogPolyApproxData::
+    multivariate_polynomial_gradient_vector()). */
+void VectorOrthogPolyApproximation::
+basis_gradients(const RealVector& x, RealMatrix& basis_grads)
+{
+  const UShort2DArray& mi = sharedDataRep->multi_index();
+  std::vector<BasisPolynomial>& poly_basis = sharedDataRep->polynomialBasis;
+  size_t i, v, w, num_terms = mi.size(), num_v = sharedDataRep->numVars;
+  unsigned short max_k, mi_iw;
+
+  // basis_values() sizes only basisValues1D, so size each independently
+  if (basisValues1D.size() != num_v)
+    basisValues1D.resize(num_v);
+  if (basisGradients1D.size() != num_v)
+    basisGradients1D.resize(num_v);
+  RealVector x_v(1, false);  RealMatrix t1_hess;
+  for (v=0; v<num_v; ++v) {
+    for (i=0, max_k=0; i<num_terms; ++i)
+      if (mi[i][v] > max_k)
+	max_k = mi[i][v];
+    x_v[0] = x[v];
+    poly_basis[v].type1_values(x_v, max_k, 1, basisValues1D[v],
+			       basisGradients1D[v], t1_hess);
+  }
+
+  basis_grads.shapeUninitialized(num_v, num_terms);
+  Real grad_iv;
+  for (i=0; i<num_terms; ++i) {
+    const UShortArray& mi_i = mi[i];
+    Real* basis_grads_i = basis_grads[i];
+    for (v=0; v<num_v; ++v) {
+      grad_iv = basisGradients1D[v](mi_i[v], 0);
+      for (w=0; w<num_v && grad_iv != 0.; ++w) {
+	mi_iw = mi_i[w];
+	if (w != v && mi_iw)
+	  grad_iv *= basisValues1D[w](mi_iw, 0);
+      }
+      basis_grads_i[v] = grad_iv;
+    }
+  }
+}
+
+
+void VectorOrthogPolyApproximation::
+gradients(const RealVector& x, RealMatrix& qoi_grads)
+{
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  RealMatrix basis_grads;
+  basis_gradients(x, basis_grads);
+  qoi_grads.shapeUninitialized(basis_grads.numRows(), numQoI);
+  qoi_grads.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1., basis_grads,
+		     exp_coeffs, 0.);
+}
+
+
+void VectorOrthogPolyApproximation::means(RealVector& qoi_means)
+{
+  check_standard_mode("means");
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  if (qoi_means.length() != numQoI)
+    qoi_means.sizeUninitialized(numQoI);
+  for (size_t q=0; q<numQoI; ++q)
+    qoi_means[q] = exp_coeffs(0,q);
+}
+
+
+void VectorOrthogPolyApproximation::term_variances(RealMatrix& term_vars)
+{
+  const UShort2DArray& mi = sharedDataRep->multi_index();
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  size_t i, q, num_terms = mi.size();
+  term_vars.shapeUninitialized(num_terms-1, numQoI);
+  RealVector norm_sq(num_terms, false);
+  for (i=1; i<num_terms; ++i)
+    norm_sq[i] = sharedDataRep->norm_squared(mi[i]);
+  Real coeff_iq;
+  for (q=0; q<numQoI; ++q) {
+    const Real* exp_coeffs_q = exp_coeffs[q];
+    Real*        term_vars_q = term_vars[q];
+    for (i=1; i<num_terms; ++i) {
+      coeff_iq = exp_coeffs_q[i];
+      term_vars_q[i-1] = coeff_iq * coeff_iq * norm_sq[i];
+    }
+  }
+}
+
+
+void VectorOrthogPolyApproximation::variances(RealVector& qoi_vars)
+{
+  check_standard_mode("variances");
+  RealMatrix term_vars;
+  term_variances(term_vars);
+  size_t i, q, num_terms_m1 = term_vars.numRows();
+  if (qoi_vars.length() != numQoI)
+    qoi_vars.sizeUninitialized(numQoI);
+  for (q=0; q<numQoI; ++q) {
+    const Real* term_vars_q = term_vars[q];
+    Real& var_q = qoi_vars[q]; var_q = 0.;
+    for (i=0; i<num_terms_m1; ++i)
+      var_q += term_vars_q[i];
+  }
+}
+
+
+/** The covariance among all QoI is S^T S for S = diag(norm) C, where C
+    omits the constant term, which is formed using a symmetric rank-k
+    update. */
+void VectorOrthogPolyApproximation::covariance(RealSymMatrix& qoi_covar)
+{
+  check_standard_mode("covariance");
+  const UShort2DArray& mi = sharedDataRep->multi_index();
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  size_t i, q, num_terms = mi.size();
+
+  RealMatrix scaled_coeffs(num_terms-1, numQoI, false);
+  RealVector norm(num_terms, false);
+  for (i=1; i<num_terms; ++i)
+    norm[i] = std::sqrt(sharedDataRep->norm_squared(mi[i]));
+  for (q=0; q<numQoI; ++q) {
+    const Real* exp_coeffs_q = exp_coeffs[q];
+    Real*    scaled_coeffs_q = scaled_coeffs[q];
+    for (i=1; i<num_terms; ++i)
+      scaled_coeffs_q[i-1] = exp_coeffs_q[i] * norm[i];
+  }
+
+  if (qoi_covar.numRows() != numQoI)
+    qoi_covar.shapeUninitialized(numQoI);
+  Teuchos::BLAS<int, Real> blas;
+  blas.SYRK((qoi_covar.upper()) ? Teuchos::UPPER_TRI : Teuchos::LOWER_TRI,
+	    Teuchos::TRANS, numQoI, num_terms-1, 1., scaled_coeffs.values(),
+	    scaled_coeffs.stride(), 0., qoi_covar.values(), qoi_covar.stride());
+}
+
+
+/** The variance contributions of the expansion terms (see
+    OrthogPolyApproximation::compute_component_sobol()) are aggregated
+    for all QoI by scattering each term contribution into the Sobol'
+    index located for the term from the multi-index and sobolIndexMap. */
+void VectorOrthogPolyApproximation::component_sobol(RealMatrix& sobol_indices)
+{
+  check_standard_mode("component_sobol");
+  const UShort2DArray&           mi = sharedDataRep->multi_index();
+  const BitArrayULongMap& index_map = sharedDataRep->sobolIndexMap;
+  size_t i, j, q, s, num_terms = mi.size(), num_sobol = index_map.size();
+
+  RealMatrix term_vars;
+  term_variances(term_vars);
+
+  // locate the Sobol' index of each term once for all QoI
+  SizetArray term_sobol;
+  SobolMaskIndex sobol_index(index_map, sharedDataRep->numVars);
+  sobol_index.find(mi, term_sobol);
+  sobol_indices.shape(num_sobol, numQoI); // init to 0.
+  for (q=0; q<numQoI; ++q) {
+    const Real* term_vars_q = term_vars[q];
+    Real*         sobol_q   = sobol_indices[q];
+    for (i=1; i<num_terms; ++i) {
+      s = term_sobol[i];
+      if (s != SZ_MAX) // may not be found if vbdOrderLimit
+	sobol_q[s] += term_vars_q[i-1];
+    }
+  }
+
+  // normalize by the variance of each QoI
+  const RealMatrix& exp_coeffs = expansion_coefficients();
+  Real sum_p_var;
+  for (q=0; q<numQoI; ++q) {
+    const Real* term_vars_q = term_vars[q];
+    for (i=0, sum_p_var=0.; i<num_terms-1; ++i)
+      sum_p_var += term_vars_q[i];
+    // don't attribute variance if zero/negligible
+    if (!Pecos::is_small(std::sqrt(sum_p_var), exp_coeffs(0,q)))
+      for (j=0; j<num_sobol; ++j)
+	sobol_indices(j,q) /= sum_p_var;
+  }
+}
+
+
+/** Total effects are computed directly from the term variance
+    contributions using the (variables x terms) incidence matrix, which
+    does not require all component indices to be available. */
+void VectorOrthogPolyApproximation::
+total_sobol(RealMatrix& total_sobol_indices)
+{
+  check_standard_mode("total_sobol");
+  const UShort2DArray& mi = sharedDataRep->multi_index();
+  size_t i, j, q, num_terms = mi.size(), num_v = sharedDataRep->numVars;
+
+  RealMatrix term_vars;
+  term_variances(term_vars);
+
+  RealMatrix incidence(num_v, num_terms-1); // init to 0.
+  for (i=1; i<num_terms; ++i) {
+    const UShortArray& mi_i = mi[i];
+    for (j=0; j<num_v; ++j)
+      if (mi_i[j])
+	incidence(j, i-1) = 1.;
+  }
+  total_sobol_indices.shapeUninitialized(num_v, numQoI);
+  total_sobol_indices.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.,
+			       incidence, term_vars, 0.);
+
+  // normalize by the variance of each QoI (avoid division by zero)
+  Real sum_p_var;
+  for (q=0; q<numQoI; ++q) {
+    const Real* term_vars_q = term_vars[q];
+    for (i=0, sum_p_var=0.; i<num_terms-1; ++i)
+      sum_p_var += term_vars_q[i];
+    if (!Pecos::is_small(sum_p_var))
+      for (j=0; j<num_v; ++j)
+	total_sobol_indices(j,q) /= sum_p_var;
+  }
+}
+
+} // namespace Pecos
@@ -0,0 +1,178 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+//- Class:        VectorOrthogPolyApproximation
+//- Description:  Class for vector-valued orthogonal polynomial approximations
+//-
+//- Owner:        Mike Eldred
+
+#ifndef VECTOR_ORTHOG_POLY_APPROXIMATION_HPP
+#define VECTOR_ORTHOG_POLY_APPROXIMATION_HPP
+
+#include "BasisApproximation.hpp"
+#include "SharedOrthogPolyApproxData.hpp"
+#include "ActiveKey.hpp"
+
+namespace Pecos {
+
+
+/// Container for the orthogonal polynomial approximations of a set of
+/// response QoI that share a common basis.
+
+/** The VectorOrthogPolyApproximation class stores the expansion
+    coefficients for all QoI as a single (terms x QoI) matrix, keyed by
+    ActiveKey in the same manner as OrthogPolyApproximation.  Since the
+    multi-index and basis are provided by the SharedOrthogPolyApproxData
+    instance shared among the QoI, the basis is evaluated once per point
+    and all QoI values are obtained from a single basis-vector x matrix
+    product.  Moments and Sobol' indices for all QoI are likewise
+    computed with matrix-matrix products.  Per-QoI coefficient views and
+    gather/scatter operations with a set of OrthogPolyApproximation
+    instances support existing per-QoI usage. */
+
+class VectorOrthogPolyApproximation
+{
+public:
+
+  //
+  //- Heading: Constructor and destructor
+  //
+
+  /// standard constructor
+  VectorOrthogPolyApproximation(const SharedBasisApproxData& shared_data,
+				size_t num_qoi = 0);
+  /// destructor
+  ~VectorOrthogPolyApproximation();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// return the number of QoI
+  size_t num_qoi() const;
+
+  /// assemble the active coefficient matrix from a set of scalar
+  /// approximations defined from the same shared data
+  void gather_coefficients(const std::vector<BasisApproximation>& poly_approxs);
+  /// distribute the active coefficient matrix to a set of scalar
+  /// approximations defined from the same shared data
+  void scatter_coefficients(std::vector<BasisApproximation>& poly_approxs);
+
+  /// set the active (terms x QoI) coefficient matrix
+  void expansion_coefficients(const RealMatrix& exp_coeffs);
+  /// return the active (terms x QoI) coefficient matrix
+  const RealMatrix& expansion_coefficients() const;
+  /// return a view of the active coefficients for a single QoI
+  RealVector expansion_coefficients(size_t qoi) const;
+
+  /// evaluate all basis functions at x using 1D values computed
+  /// once per variable
+  void basis_values(const RealVector& x, RealVector& basis_vals);
+  /// evaluate all basis functions at a set of samples (variables x
+  /// samples), returning a (samples x terms) matrix; 1D values are
+  /// computed once per variable for all samples
+  void basis_values(const RealMatrix& samples, RealMatrix& basis_vals);
+
+  /// evaluate all QoI at x
+  void values(const RealVector& x, RealVector& qoi_vals);
+  /// evaluate all QoI at a set of samples (variables x samples),
+  /// returning a (samples x QoI) matrix
+  void values(const RealMatrix& samples, RealMatrix& qoi_vals);
+
+  /// evaluate the gradients of all basis functions with respect to the
+  /// expansion variables at x, returning a (variables x terms) matrix
+  void basis_gradients(const RealVector& x, RealMatrix& basis_grads);
+  /// evaluate the gradients of all QoI with respect to the expansion
+  /// variables at x, returning a (variables x QoI) matrix
+  void gradients(const RealVector& x, RealMatrix& qoi_grads);
+
+  /// compute the mean of all QoI
+  void means(RealVector& qoi_means);
+  /// compute the variance of all QoI
+  void variances(RealVector& qoi_vars);
+  /// compute the covariance matrix among all QoI
+  void covariance(RealSymMatrix& qoi_covar);
+
+  /// compute the (Sobol' indices x QoI) component effects, indexed
+  /// consistently with SharedPolyApproxData::sobolIndexMap
+  void component_sobol(RealMatrix& sobol_indices);
+  /// compute the (variables x QoI) total effects
+  void total_sobol(RealMatrix& total_sobol_indices);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// update expCoeffsIter for the active key within sharedDataRep
+  void update_active_iterators();
+
+  /// compute the (terms x QoI) variance contributions of the non-constant
+  /// expansion terms
+  void term_variances(RealMatrix& term_vars);
+  /// check that the expansion is defined in standard (all random) mode
+  void check_standard_mode(const String& fn_name) const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// the shared basis and multi-index
+  std::shared_ptr<SharedOrthogPolyApproxData> sharedDataRep;
+
+  /// number of QoI
+  size_t numQoI;
+
+  /// (terms x QoI) expansion coefficients for each level key
+  std::map<ActiveKey, RealMatrix> expansionCoeffs;
+  /// iterator pointing to active node in expansionCoeffs
+  std::map<ActiveKey, RealMatrix>::iterator expCoeffsIter;
+
+  /// 1D basis values for each variable, indexed as [variable](order,sample)
+  RealMatrixArray basisValues1D;
+  /// 1D basis gradients for each variable, indexed as basisValues1D
+  RealMatrixArray basisGradients1D;
+};
+
+
+inline VectorOrthogPolyApproximation::~VectorOrthogPolyApproximation()
+{ }
+
+
+inline size_t VectorOrthogPolyApproximation::num_qoi() const
+{ return numQoI; }
+
+
+inline const RealMatrix& VectorOrthogPolyApproximation::
+expansion_coefficients() const
+{ return expCoeffsIter->second; }
+
+
+/** Returns a view, such that the coefficient data is not duplicated. */
+inline RealVector VectorOrthogPolyApproximation::
+expansion_coefficients(size_t qoi) const
+{
+  RealMatrix& exp_coeffs = expCoeffsIter->second;
+  return RealVector(Teuchos::View, exp_coeffs[qoi], exp_coeffs.numRows());
+}
+
+
+inline void VectorOrthogPolyApproximation::
+check_standard_mode(const String& fn_name) const
+{
+  if (!sharedDataRep->nonRandomIndices.empty()) {
+    PCerr << "Error: all-variables mode not supported in VectorOrthogPoly"
+	  << "Approximation::" << fn_name << "()." << std::endl;
+    abort_handler(-1);
+  }
+}
+
+} // namespace Pecos
+
+#endif
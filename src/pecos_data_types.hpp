@@ -78,6 +78,7 @@ typedef boost::dynamic_bitset<unsigned long> BitArray;
 
 typedef std::pair<unsigned short, unsigned short> UShortUShortPair;
 typedef std::pair<int, int>                       IntIntPair;
+typedef std::pair<size_t, size_t>                 SizetSizetPair;
 typedef std::pair<Real, Real>                     RealRealPair;
 typedef std::pair<Real, RealVector>               RealRealVectorPair;
 
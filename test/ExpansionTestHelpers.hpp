@@ -0,0 +1,80 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file ExpansionTestHelpers.hpp
+    \brief Construction of orthogonal polynomial expansions shared by the
+    expansion unit tests */
+
+#ifndef EXPANSION_TEST_HELPERS_HPP
+#define EXPANSION_TEST_HELPERS_HPP
+
+#include <cmath>
+
+#include "OrthogPolyApproximation.hpp"
+
+using namespace Pecos;
+
+/// relative difference, guarded for values near zero
+inline Real rel_diff(Real a, Real b)
+{ return std::abs(a - b) / std::max(1., std::abs(b)); }
+
+/// define shared_data for expansions of multi-index mi over poly_basis;
+/// variables not set in random_vars_key (if nonempty) are non-random
+inline std::shared_ptr<SharedOrthogPolyApproxData>
+expansion_shared_data(const std::vector<BasisPolynomial>& poly_basis,
+		      unsigned short order, const UShort2DArray& mi,
+		      SharedBasisApproxData& shared_data,
+		      const BitArray& random_vars_key = BitArray())
+{
+  size_t num_v = poly_basis.size();
+  std::shared_ptr<SharedOrthogPolyApproxData> shared_poly_data =
+    std::make_shared<SharedOrthogPolyApproxData>
+    (GLOBAL_ORTHOGONAL_POLYNOMIAL, UShortArray(num_v, order), num_v);
+  shared_data.assign_rep(shared_poly_data);
+  shared_poly_data->polynomial_basis(poly_basis);
+  if (random_vars_key.size())
+    shared_poly_data->random_variables_key(random_vars_key);
+  shared_poly_data->allocate_data(mi);
+  return shared_poly_data;
+}
+
+/// return an expansion over shared_data with coefficients coeffs
+inline BasisApproximation
+expansion(const SharedBasisApproxData& shared_data, const RealVector& coeffs)
+{
+  BasisApproximation poly_approx;
+  poly_approx.assign_rep(
+    std::make_shared<OrthogPolyApproximation>(shared_data));
+  poly_approx.approximation_coefficients(coeffs, false);
+  return poly_approx;
+}
+
+/// return num_exp expansions of num_terms over shared_data with random
+/// coefficients in [-1,1], reproducible from seed
+inline std::vector<BasisApproximation>
+random_expansions(const SharedBasisApproxData& shared_data, size_t num_terms,
+		  size_t num_exp, unsigned int seed)
+{
+  Teuchos::ScalarTraits<Real>::seedrandom(seed);
+  std::vector<BasisApproximation> poly_approxs(num_exp);
+  for (size_t e=0; e<num_exp; ++e) {
+    RealVector coeffs(num_terms, false);
+    coeffs.random();
+    poly_approxs[e] = expansion(shared_data, coeffs);
+  }
+  return poly_approxs;
+}
+
+/// return the PolynomialApproximation instance of poly_approx
+inline PolynomialApproximation* poly_approx_rep(BasisApproximation& poly_approx)
+{
+  return std::static_pointer_cast<PolynomialApproximation>
+    (poly_approx.approx_rep()).get();
+}
+
+#endif
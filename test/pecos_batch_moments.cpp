@@ -0,0 +1,179 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_batch_moments.cpp
+    \brief Consistency of batched all-variables moments with pointwise
+    moments and with quadrature over the random variables */
+
+#define BOOST_TEST_MODULE pecos_batch_moments
+#include <boost/test/included/unit_test.hpp>
+
+#include "ExpansionTestHelpers.hpp"
+#include "Teuchos_SerialDenseHelpers.hpp"
+
+namespace {
+
+const size_t NUMVARS = 4;
+const unsigned short ORDER = 4;
+const size_t NUMPTS = 12;
+const unsigned short QUAD_PTS = 5; // exact for products of ORDER terms
+const Real TOL = 1.e-12;
+
+/// two total-order expansions over Legendre random variables {0,2} and
+/// Legendre/Hermite non-random variables {1,3}, assigned random
+/// coefficients
+struct ContractionFixture
+{
+  ContractionFixture()
+  {
+    std::vector<BasisPolynomial> poly_basis(NUMVARS);
+    for (size_t v=0; v<NUMVARS; ++v)
+      poly_basis[v] = BasisPolynomial((v == 3) ? HERMITE_ORTHOG :
+				      LEGENDRE_ORTHOG);
+    BitArray random_vars_key(NUMVARS);
+    random_vars_key.set(0);  random_vars_key.set(2);
+    UShort2DArray mi;
+    SharedPolyApproxData::
+      total_order_multi_index(UShortArray(NUMVARS, ORDER), mi);
+    expansion_shared_data(poly_basis, ORDER, mi, shared_data,
+			  random_vars_key);
+    poly_approxs = random_expansions(shared_data, mi.size(), 2, 2718);
+
+    // non-random variables vary over the batch; random variables are
+    // ignored by the moments
+    samples.shapeUninitialized(NUMVARS, NUMPTS);
+    samples.random();
+    // augmented derivatives with respect to the non-random variables
+    dvv.resize(2);  dvv[0] = 2;  dvv[1] = 4;
+  }
+
+  SharedBasisApproxData shared_data;
+  std::vector<BasisApproximation> poly_approxs;
+  RealMatrix samples;
+  SizetArray dvv;
+};
+
+/// pointwise moments and moment gradients over the columns of samples
+struct PointwiseMoments
+{
+  PointwiseMoments(ContractionFixture& fix):
+    means(NUMPTS), vars(NUMPTS), covars(NUMPTS),
+    mean_grads(fix.dvv.size(), NUMPTS), var_grads(fix.dvv.size(), NUMPTS)
+  {
+    PolynomialApproximation *opa_0 = poly_approx_rep(fix.poly_approxs[0]),
+      *opa_1 = poly_approx_rep(fix.poly_approxs[1]);
+    for (size_t j=0; j<NUMPTS; ++j) {
+      RealVector x
+	= Teuchos::getCol<int,Real>(Teuchos::View, fix.samples, (int)j);
+      means[j]  = opa_0->mean(x);
+      vars[j]   = opa_0->covariance(x, opa_0);
+      covars[j] = opa_0->covariance(x, opa_1);
+      const RealVector& mean_grad = opa_0->mean_gradient(x, fix.dvv);
+      const RealVector& var_grad = opa_0->variance_gradient(x, fix.dvv);
+      for (size_t i=0; i<fix.dvv.size(); ++i)
+	{ mean_grads(i,j) = mean_grad[i];  var_grads(i,j) = var_grad[i]; }
+    }
+  }
+
+  RealVector means, vars, covars;
+  RealMatrix mean_grads, var_grads;
+};
+
+void check_batch(ContractionFixture& fix, const PointwiseMoments& pw)
+{
+  PolynomialApproximation *opa_0 = poly_approx_rep(fix.poly_approxs[0]),
+    *opa_1 = poly_approx_rep(fix.poly_approxs[1]);
+  RealVector means, vars, covars;  RealMatrix mean_grads, var_grads;
+  opa_0->batch_mean(fix.samples, means);
+  opa_0->batch_covariance(fix.samples, opa_0, vars);
+  opa_0->batch_covariance(fix.samples, opa_1, covars);
+  opa_0->batch_mean_gradient(fix.samples, fix.dvv, mean_grads);
+  opa_0->batch_variance_gradient(fix.samples, fix.dvv, var_grads);
+  BOOST_REQUIRE( means.length() == (int)NUMPTS );
+  BOOST_REQUIRE( mean_grads.numCols() == (int)NUMPTS );
+  BOOST_REQUIRE( var_grads.numRows() == (int)fix.dvv.size() );
+  for (size_t j=0; j<NUMPTS; ++j) {
+    BOOST_CHECK( rel_diff(means[j],  pw.means[j])  < TOL );
+    BOOST_CHECK( rel_diff(vars[j],   pw.vars[j])   < TOL );
+    BOOST_CHECK( rel_diff(covars[j], pw.covars[j]) < TOL );
+    for (size_t i=0; i<fix.dvv.size(); ++i) {
+      BOOST_CHECK( rel_diff(mean_grads(i,j), pw.mean_grads(i,j)) < TOL );
+      BOOST_CHECK( rel_diff(var_grads(i,j),  pw.var_grads(i,j))  < TOL );
+    }
+  }
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_batch_moments_pointwise)
+{
+  // pointwise statistics fill the cached contractions, which are then
+  // reused by the batched statistics
+  ContractionFixture fix;
+  PointwiseMoments pw(fix);
+  check_batch(fix, pw);
+
+  // the batched statistics leave the cached contractions valid for
+  // subsequent pointwise statistics
+  PointwiseMoments pw_2(fix);
+  for (size_t j=0; j<NUMPTS; ++j) {
+    BOOST_CHECK( rel_diff(pw_2.means[j],  pw.means[j])  < TOL );
+    BOOST_CHECK( rel_diff(pw_2.covars[j], pw.covars[j]) < TOL );
+  }
+
+  // updated coefficients invalidate the cached contraction
+  RealVector coeffs = fix.poly_approxs[0].approximation_coefficients(false);
+  coeffs.scale(2.);
+  fix.poly_approxs[0].approximation_coefficients(coeffs, false);
+  RealVector means;
+  poly_approx_rep(fix.poly_approxs[0])->batch_mean(fix.samples, means);
+  for (size_t j=0; j<NUMPTS; ++j)
+    BOOST_CHECK( rel_diff(means[j], 2. * pw.means[j]) < TOL );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_batch_moments_quadrature)
+{
+  // tensor Gauss-Legendre integration over the random variables is exact
+  // for the mean and for products of the two expansions
+  ContractionFixture fix;
+  PolynomialApproximation *opa_0 = poly_approx_rep(fix.poly_approxs[0]),
+    *opa_1 = poly_approx_rep(fix.poly_approxs[1]);
+  RealVector means, vars, covars;
+  opa_0->batch_mean(fix.samples, means);
+  opa_0->batch_covariance(fix.samples, opa_0, vars);
+  opa_0->batch_covariance(fix.samples, opa_1, covars);
+
+  BasisPolynomial legendre(LEGENDRE_ORTHOG);
+  const RealArray& gauss_pts = legendre.collocation_points(QUAD_PTS);
+  const RealArray& gauss_wts = legendre.type1_collocation_weights(QUAD_PTS);
+  Real wt_sum = 0.;
+  for (size_t q=0; q<QUAD_PTS; ++q)
+    wt_sum += gauss_wts[q];
+
+  RealVector x(NUMVARS, false);
+  for (size_t j=0; j<NUMPTS; ++j) {
+    for (size_t v=0; v<NUMVARS; ++v)
+      x[v] = fix.samples(v,j);
+    Real f_mean = 0., g_mean = 0., f_sq = 0., fg = 0.;
+    for (size_t q0=0; q0<QUAD_PTS; ++q0)
+      for (size_t q2=0; q2<QUAD_PTS; ++q2) {
+	x[0] = gauss_pts[q0];  x[2] = gauss_pts[q2];
+	Real wt = gauss_wts[q0] * gauss_wts[q2] / (wt_sum * wt_sum),
+	  f = opa_0->value(x), g = opa_1->value(x);
+	f_mean += wt * f;  g_mean += wt * g;
+	f_sq += wt * f * f;  fg += wt * f * g;
+      }
+    BOOST_CHECK( rel_diff(means[j],  f_mean) < 1.e-10 );
+    BOOST_CHECK( rel_diff(vars[j],   f_sq - f_mean * f_mean) < 1.e-10 );
+    BOOST_CHECK( rel_diff(covars[j], fg - f_mean * g_mean)   < 1.e-10 );
+  }
+}
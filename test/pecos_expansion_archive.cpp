@@ -0,0 +1,274 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_expansion_archive.cpp
+    \brief Round trip of orthogonal polynomial expansions through
+    ExpansionArchive, including files of opposite byte order */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PECOS_TEST_FORK
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define BOOST_TEST_MODULE pecos_expansion_archive
+#include <boost/test/included/unit_test.hpp>
+
+#include "ExpansionArchive.hpp"
+#include "ExpansionTestHelpers.hpp"
+#include "Teuchos_SerialDenseHelpers.hpp"
+
+namespace {
+
+const size_t NUMVARS = 3;
+const unsigned short ORDER = 3;
+const Real TOL = 1.e-12;
+const char* NATIVE_FILE  = "pecos_expansion_archive_native.bin";
+const char* SWAPPED_FILE = "pecos_expansion_archive_swapped.bin";
+const char* CORRUPT_FILE = "pecos_expansion_archive_corrupt.bin";
+
+// archive layout (see ExpansionArchive.cpp): byte offsets of header
+// fields and sizes of basis and directory records
+const size_t NUM_VARS_POS = 16, NUM_EXP_POS = 24, BASIS_POS = 32,
+  DIR_POS = 40, HEADER_SIZE = 48, BASIS_SIZE = 32, DIR_SIZE = 56;
+
+std::vector<char> read_file(const char* filename)
+{
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in),
+			   std::istreambuf_iterator<char>());
+}
+
+void write_file(const char* filename, const std::vector<char>& buffer)
+{
+  std::ofstream out(filename, std::ios::out | std::ios::binary);
+  out.write(buffer.data(), buffer.size());
+}
+
+template <typename T> T get(const std::vector<char>& buffer, size_t pos)
+{ T val; std::memcpy(&val, &buffer[pos], sizeof(T)); return val; }
+
+template <typename T> void put(std::vector<char>& buffer, size_t pos, T val)
+{ std::memcpy(&buffer[pos], &val, sizeof(T)); }
+
+/// reverse the bytes of len values of type T starting at pos
+template <typename T>
+void swap_at(std::vector<char>& buffer, size_t pos, size_t len)
+{
+  for (size_t i=0; i<len; ++i, pos+=sizeof(T))
+    std::reverse(&buffer[pos], &buffer[pos] + sizeof(T));
+}
+
+/// convert a native archive to the opposite byte order, as written on a
+/// host of opposite endianness
+void swap_archive(std::vector<char>& buffer)
+{
+  uint64_t v, e, num_v = get<uint64_t>(buffer, NUM_VARS_POS),
+    num_exp = get<uint64_t>(buffer, NUM_EXP_POS),
+    basis_pos = get<uint64_t>(buffer, BASIS_POS),
+    dir_pos = get<uint64_t>(buffer, DIR_POS);
+  for (v=0; v<num_v; ++v) {
+    size_t rec_pos = basis_pos + v * BASIS_SIZE;
+    swap_at<int16_t>(buffer, rec_pos, 2);
+    swap_at<double>(buffer, rec_pos + 8, 3);
+  }
+  for (e=0; e<num_exp; ++e) {
+    size_t de_pos = dir_pos + e * DIR_SIZE;
+    uint64_t key_pos = get<uint64_t>(buffer, de_pos),
+      key_words = get<uint64_t>(buffer, de_pos + 8),
+      num_terms = get<uint64_t>(buffer, de_pos + 16),
+      grad_rows = get<uint64_t>(buffer, de_pos + 24),
+      mi_pos    = get<uint64_t>(buffer, de_pos + 32),
+      coeff_pos = get<uint64_t>(buffer, de_pos + 40),
+      grad_pos  = get<uint64_t>(buffer, de_pos + 48);
+    swap_at<uint64_t>(buffer, key_pos, key_words);
+    swap_at<uint16_t>(buffer, mi_pos, num_terms * num_v);
+    swap_at<double>(buffer, coeff_pos, num_terms);
+    swap_at<double>(buffer, grad_pos, grad_rows * num_terms);
+    swap_at<uint64_t>(buffer, de_pos, 7);
+  }
+  swap_at<uint32_t>(buffer, 8, 2);                // version, byte order
+  swap_at<uint64_t>(buffer, NUM_VARS_POS, 4);     // counts, offsets
+}
+
+/// Legendre/Hermite/Jacobi basis with two expansions of different
+/// lengths and keys, the first with coefficient gradients
+struct ArchiveFixture
+{
+  ArchiveFixture(): poly_basis(NUMVARS), keys(2), mi(2), coeffs(2),
+    coeff_grads(2)
+  {
+    poly_basis[0] = BasisPolynomial(LEGENDRE_ORTHOG);
+    poly_basis[1] = BasisPolynomial(HERMITE_ORTHOG);
+    poly_basis[2] = BasisPolynomial(JACOBI_ORTHOG);
+    poly_basis[2].push_parameter(JACOBI_ALPHA, 0.5);
+    poly_basis[2].push_parameter(JACOBI_BETA,  1.5);
+
+    UShortArray approx_order(NUMVARS, ORDER);
+    SharedPolyApproxData::total_order_multi_index(approx_order, mi[0]);
+    mi[1].assign(mi[0].begin(), mi[0].begin() + mi[0].size() / 2);
+    keys[0].form_key(1, 0, 2);  keys[1].form_key(2, 1, 0);
+
+    Teuchos::ScalarTraits<Real>::seedrandom(4321);
+    for (size_t e=0; e<2; ++e) {
+      coeffs[e].sizeUninitialized(mi[e].size());  coeffs[e].random();
+    }
+    coeff_grads[0].shapeUninitialized(NUMVARS, mi[0].size());
+    coeff_grads[0].random();
+
+    ExpansionArchive archive;
+    archive.polynomial_basis(poly_basis);
+    for (size_t e=0; e<2; ++e)
+      archive.add_expansion(keys[e], mi[e], coeffs[e], coeff_grads[e]);
+    archive.write(NATIVE_FILE);
+  }
+
+  ~ArchiveFixture()
+  {
+    std::remove(NATIVE_FILE);  std::remove(SWAPPED_FILE);
+    std::remove(CORRUPT_FILE);
+  }
+
+  /// verify the contents of a loaded archive against the fixture
+  void check_archive(ExpansionArchive& archive)
+  {
+    BOOST_REQUIRE( archive.num_variables()  == NUMVARS );
+    BOOST_REQUIRE( archive.num_expansions() == 2 );
+    for (size_t v=0; v<NUMVARS; ++v)
+      BOOST_CHECK( archive.polynomial_basis()[v].basis_type() ==
+		   poly_basis[v].basis_type() );
+
+    RealMatrix samples(NUMVARS, 10, false);
+    samples.random(); // within the Legendre and Jacobi supports
+    for (size_t e=0; e<2; ++e) {
+      BOOST_CHECK( archive.key(e) == keys[e] );
+      BOOST_CHECK( archive.find(keys[e]) == e );
+      size_t t, v, num_terms = mi[e].size();
+      BOOST_REQUIRE( archive.num_terms(e) == num_terms );
+
+      const unsigned short* packed_mi = archive.multi_index(e);
+      for (t=0; t<num_terms; ++t)
+	for (v=0; v<NUMVARS; ++v)
+	  BOOST_CHECK( packed_mi[t*NUMVARS+v] == mi[e][t][v] );
+      RealVector a_coeffs = archive.coefficients(e);
+      for (t=0; t<num_terms; ++t)
+	BOOST_CHECK( a_coeffs[t] == coeffs[e][t] );
+      RealMatrix a_grads = archive.coefficient_gradients(e);
+      BOOST_REQUIRE( a_grads.numRows() == coeff_grads[e].numRows() );
+      for (t=0; t<(size_t)a_grads.numCols(); ++t)
+	for (v=0; v<(size_t)a_grads.numRows(); ++v)
+	  BOOST_CHECK( a_grads(v,t) == coeff_grads[e](v,t) );
+
+      // evaluation against an expansion built from the original data
+      SharedBasisApproxData shared_data;
+      expansion_shared_data(poly_basis, ORDER, mi[e], shared_data);
+      BasisApproximation poly_approx = expansion(shared_data, coeffs[e]);
+      PolynomialApproximation* opa = poly_approx_rep(poly_approx);
+      for (int i=0; i<samples.numCols(); ++i) {
+	RealVector x = Teuchos::getCol<int,Real>(Teuchos::View, samples, i);
+	BOOST_CHECK( rel_diff(archive.value(x, e), opa->value(x)) < TOL );
+      }
+    }
+    BOOST_CHECK( archive.find(ActiveKey(3, RAW_DATA, 0, 0)) == SZ_MAX );
+  }
+
+#ifdef PECOS_TEST_FORK
+  /// return true if opening filename terminates the process with an
+  /// error status (as opposed to loading or crashing)
+  bool open_aborts(const char* filename)
+  {
+    pid_t pid = fork();
+    if (pid == 0) {
+      ExpansionArchive archive;
+      archive.open(filename);
+      _exit(0);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    return (WIFEXITED(status) && WEXITSTATUS(status) != 0);
+  }
+#endif
+
+  std::vector<BasisPolynomial> poly_basis;
+  std::vector<ActiveKey> keys;
+  std::vector<UShort2DArray> mi;
+  RealVectorArray coeffs;
+  RealMatrixArray coeff_grads;
+};
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_expansion_archive_round_trip)
+{
+  ArchiveFixture fix;
+  ExpansionArchive archive;
+  archive.open(NATIVE_FILE);
+  fix.check_archive(archive);
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_expansion_archive_byte_swapped)
+{
+  ArchiveFixture fix;
+  std::vector<char> buffer = read_file(NATIVE_FILE);
+  BOOST_REQUIRE( buffer.size() > HEADER_SIZE );
+  swap_archive(buffer);
+  write_file(SWAPPED_FILE, buffer);
+
+  ExpansionArchive archive;
+  archive.open(SWAPPED_FILE);
+  fix.check_archive(archive);
+}
+
+//----------------------------------------------------------------
+
+#ifdef PECOS_TEST_FORK
+BOOST_AUTO_TEST_CASE(test_expansion_archive_corrupt_directory)
+{
+  ArchiveFixture fix;
+  std::vector<char> buffer = read_file(NATIVE_FILE);
+  size_t de_pos = get<uint64_t>(buffer, DIR_POS);
+
+  // a term count for which the multi-index size overflows 64 bits
+  std::vector<char> corrupt(buffer);
+  put<uint64_t>(corrupt, de_pos + 16, (uint64_t)1 << 62);
+  write_file(CORRUPT_FILE, corrupt);
+  BOOST_CHECK( fix.open_aborts(CORRUPT_FILE) );
+
+  // a gradient row count for which the gradient size overflows
+  corrupt = buffer;
+  put<uint64_t>(corrupt, de_pos + 24, ~(uint64_t)0 / 8 + 1);
+  write_file(CORRUPT_FILE, corrupt);
+  BOOST_CHECK( fix.open_aborts(CORRUPT_FILE) );
+
+  // a key length beyond the file
+  corrupt = buffer;
+  put<uint64_t>(corrupt, de_pos + 8, (uint64_t)1 << 61);
+  write_file(CORRUPT_FILE, corrupt);
+  BOOST_CHECK( fix.open_aborts(CORRUPT_FILE) );
+
+  // a multi-index misaligned for unsigned short
+  corrupt = buffer;
+  put<uint64_t>(corrupt, de_pos + 32, get<uint64_t>(buffer, de_pos + 32) + 1);
+  write_file(CORRUPT_FILE, corrupt);
+  BOOST_CHECK( fix.open_aborts(CORRUPT_FILE) );
+
+  // the unmodified archive loads
+  BOOST_CHECK( !fix.open_aborts(NATIVE_FILE) );
+}
+#endif
@@ -0,0 +1,106 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_gauss_rule_cache.cpp
+    \brief Reuse of numerically generated Gauss rules, recursions and
+    norms across distribution parameter updates */
+
+#define BOOST_TEST_MODULE pecos_gauss_rule_cache
+#include <boost/test/included/unit_test.hpp>
+
+#include "BasisPolynomial.hpp"
+#include "NumericGenOrthogPolynomial.hpp"
+#include "GaussRuleCache.hpp"
+
+using namespace Pecos;
+
+namespace {
+
+const unsigned short ORDER = 5;
+const Real X = 0.4;
+
+/// numerically generated polynomial for a triangular distribution on
+/// [0,1], requiring polynomial coefficients and norms (as for PCE)
+std::shared_ptr<NumericGenOrthogPolynomial>
+triangular_poly(BasisPolynomial& poly_basis, Real mode)
+{
+  poly_basis = BasisPolynomial(NUM_GEN_ORTHOG);
+  std::shared_ptr<NumericGenOrthogPolynomial> ptr =
+    std::dynamic_pointer_cast<NumericGenOrthogPolynomial>
+    (poly_basis.polynomial_rep());
+  ptr->coefficients_norms_flag(true);
+  ptr->triangular_distribution(0., mode, 1.);
+  return ptr;
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_gauss_rule_cache_repeated_parameters)
+{
+  GaussRuleCache::clear();
+  BasisPolynomial poly_basis;
+  std::shared_ptr<NumericGenOrthogPolynomial> ptr
+    = triangular_poly(poly_basis, 0.3);
+
+  Real norm_sq = poly_basis.norm_squared(ORDER),
+    val = poly_basis.type1_value(X, ORDER);
+  RealArray pts = poly_basis.collocation_points(ORDER),
+    wts = poly_basis.type1_collocation_weights(ORDER);
+  size_t num_solves = ptr->eigen_solves();
+  BOOST_CHECK( num_solves == 1 );
+
+  // a new parameter set requires a new eigensolution
+  ptr->triangular_distribution(0., 0.6, 1.);
+  BOOST_CHECK( poly_basis.norm_squared(ORDER) != norm_sq );
+  BOOST_CHECK( ptr->eigen_solves() == num_solves + 1 );
+  num_solves = ptr->eigen_solves();
+
+  // norms, values and rules of the recurring parameter set are retrieved
+  ptr->triangular_distribution(0., 0.3, 1.);
+  BOOST_CHECK( poly_basis.norm_squared(ORDER)   == norm_sq );
+  BOOST_CHECK( poly_basis.type1_value(X, ORDER) == val );
+  BOOST_CHECK( poly_basis.collocation_points(ORDER)        == pts );
+  BOOST_CHECK( poly_basis.type1_collocation_weights(ORDER) == wts );
+  BOOST_CHECK( ptr->eigen_solves() == num_solves );
+
+  // other instances share the cached rules
+  BasisPolynomial poly_basis2;
+  std::shared_ptr<NumericGenOrthogPolynomial> ptr2
+    = triangular_poly(poly_basis2, 0.3);
+  BOOST_CHECK( poly_basis2.norm_squared(ORDER)   == norm_sq );
+  BOOST_CHECK( poly_basis2.type1_value(X, ORDER) == val );
+  BOOST_CHECK( poly_basis2.collocation_points(ORDER) == pts );
+  BOOST_CHECK( ptr2->eigen_solves() == 0 );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_gauss_rule_cache_disabled)
+{
+  GaussRuleCache::clear();
+  BasisPolynomial poly_basis;
+  std::shared_ptr<NumericGenOrthogPolynomial> ptr
+    = triangular_poly(poly_basis, 0.3);
+  Real norm_sq = poly_basis.norm_squared(ORDER),
+    val = poly_basis.type1_value(X, ORDER);
+
+  // without caching, a recurring parameter set is regenerated with
+  // consistent results
+  size_t max_rules = GaussRuleCache::capacity();
+  GaussRuleCache::capacity(0);
+  BOOST_CHECK( GaussRuleCache::size() == 0 );
+  BasisPolynomial poly_basis2;
+  std::shared_ptr<NumericGenOrthogPolynomial> ptr2
+    = triangular_poly(poly_basis2, 0.3);
+  BOOST_CHECK_CLOSE( poly_basis2.norm_squared(ORDER), norm_sq, 1.e-10 );
+  BOOST_CHECK_CLOSE( poly_basis2.type1_value(X, ORDER), val, 1.e-10 );
+  BOOST_CHECK( ptr2->eigen_solves() == 1 );
+  GaussRuleCache::capacity(max_rules);
+}
@@ -38,6 +38,7 @@ using namespace std;
 #define VERBOSE            1
 #define FCNTYPE            "gerstner-iso1"
 #define VARTHRLD           1.e-2
+#define NBATCH             0
 
 #ifdef GSGREST
 inline bool fileExist (const char *fname) {
@@ -60,6 +61,7 @@ int usage(){
   printf(" -d <nvar>  : dimensionality of parameter space (default=%d) \n",NUMVARS);
   printf(" -e <veps>  : tolerance for incremental variance threshold  (default=%lg) \n",VARTHRLD);
   printf(" -i <niter> : maximum no. of iterations (default=%d) \n",NITER);
+  printf(" -k <nbat>  : no. of candidate sets evaluated per batch, 0 = one at a time (default=%d) \n",NBATCH);
   printf(" -l <stlev> : starting quadrature level (default=%d) \n",STARTLEV);
   printf(" -m <mord>  : not used - maximum order for shared-poly-data (default=%d) \n",MAXORD);
   printf(" -n <nqoi>  : no. of outputs (default=%d) \n",NQOI);
@@ -86,6 +88,7 @@ int main(int argc, char* argv[])
   unsigned short strtlev  = STARTLEV ;  /* starting quadrature level */
   unsigned short verb     = VERBOSE  ;  /* verbosity  */
   double         varEps   = VARTHRLD ;
+  size_t         nBatch   = NBATCH   ;  /* candidate sets per batch */
   String         ftype    = String(FCNTYPE);
   bool           extFunc  = false ;
   short btype = (short) BTYPE;
@@ -93,7 +96,7 @@ int main(int argc, char* argv[])
   String pstring, qstring;
   // Command-line arguments: read user input
   int c; 
-  while ((c=getopt(argc,(char **)argv,"hfd:e:i:l:m:n:p:t:v:"))!=-1){
+  while ((c=getopt(argc,(char **)argv,"hfd:e:i:k:l:m:n:p:t:v:"))!=-1){
      switch (c) {
      case 'h':
        usage();
@@ -110,6 +113,16 @@ int main(int argc, char* argv[])
      case 'i':
        nIter   = strtol(optarg, (char **)NULL,0);
        break;
+     case 'k': {
+       char* end;  long n_batch = strtol(optarg, &end, 0);
+       if (*optarg == '\0' || *end != '\0' || n_batch < 0) {
+	 PCerr << "Error: invalid number of candidate sets per batch (-k "
+	       << optarg << ")." << std::endl;
+	 abort_handler(-1);
+       }
+       nBatch  = n_batch;
+       break;
+     }
      case 'l':
        strtlev = strtol(optarg, (char **)NULL,0);
        break;
@@ -312,8 +325,30 @@ int main(int argc, char* argv[])
 #endif    
 
     int choose = 0;
+#ifndef GSGREST
+    // batch mode: the trial points for the next nBatch candidate sets are
+    // computed and evaluated together, and then scored one at a time below
+    RealMatrix fev_batch;  SizetArray batch_offsets;
+    size_t cand_index = 0, batch_start = 0;
+#endif
     for (UShortArraySet::iterator it=a.begin(); it!=a.end(); ++it) {
 
+#ifndef GSGREST
+      if (nBatch && cand_index % nBatch == 0) {
+	UShort2DArray batch_sets;  UShortArraySet::iterator b_it = it;
+	for (size_t b=0; b<nBatch && b_it!=a.end(); ++b, ++b_it)
+	  batch_sets.push_back(*b_it);
+	csg_driver->compute_trial_grids(batch_sets, var_sets, batch_offsets);
+	if (verb > 1)
+	  PCout << "Evaluating batch of " << batch_sets.size()
+		<< " candidate sets (" << var_sets.numCols() << " points)\n";
+	if (var_sets.numCols())
+	  fev_batch = feval(var_sets,nQoI,ftype);
+	batch_start = cand_index;
+      }
+      ++cand_index;
+#endif
+
       csg_driver->increment_smolyak_multi_index(*it);
 
       // Update surrogate data
@@ -353,7 +388,18 @@ int main(int argc, char* argv[])
 	  return (0);
 	} 
 #else
-        fev = feval(var_sets,nQoI,ftype);
+	if (nBatch) { // extract the responses for this candidate from the batch
+	  size_t b = cand_index - 1 - batch_start;
+	  if (numPts != batch_offsets[b+1] - batch_offsets[b]) {
+	    PCerr << "Error: batched trial grid for candidate " << cand_index
+		  << " inconsistent with compute_trial_grid()." << std::endl;
+	    abort_handler(-1);
+	  }
+	  fev = RealMatrix(Teuchos::Copy, fev_batch, numPts, nQoI,
+			   batch_offsets[b], 0);
+	}
+	else
+	  fev = feval(var_sets,nQoI,ftype);
 #endif
 
 	for ( int iQoI=0; iQoI<nQoI; iQoI++) {
@@ -0,0 +1,428 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_hierarch_eval.cpp
+    \brief Evaluation benchmark for local hierarchical interpolants */
+
+#include <iostream>
+#include <ctime>
+
+#include "HierarchSparseGridDriver.hpp"
+#include "SharedHierarchInterpPolyApproxData.hpp"
+#include "HierarchInterpPolyApproximation.hpp"
+#include "SurrogateData.hpp"
+#include "pecos_data_types.hpp"
+#include "Teuchos_SerialDenseHelpers.hpp"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+using namespace std;
+
+#define NUMVARS  3
+#define LEVEL    4
+#define NSAMPLES 1000
+#define TOL      1.e-10
+#define STEP      0.3 // discontinuity location, not a grid point
+#define NREFINE   6   // point-local refinement iterations
+#define MAXLEVEL  12  // bound on set-based refinement levels
+
+int usage(){
+  printf("usage: pecos_hierarch_eval [options]\n");
+  printf(" -h         : print out this help message \n");
+  printf(" -d <nvar>  : dimensionality of parameter space (default=%d) \n",NUMVARS);
+  printf(" -l <lev>   : sparse grid level (default=%d); increase for\n",LEVEL);
+  printf("              benchmarking on grids of O(10^5) points \n");
+  printf(" -s <nsamp> : no. of evaluation samples (default=%d) \n",NSAMPLES);
+  exit(0);
+  return (0);
+}
+
+/// multilinear test function, reproduced exactly by piecewise linear
+/// hierarchical interpolation once level >= nvar
+Pecos::Real multilinear(const Pecos::Real* x, size_t nvar)
+{
+  Pecos::Real f = 1.;
+  for (size_t i=0; i<nvar; ++i)
+    f *= 1. + 0.5 * x[i] / (i+1);
+  return f;
+}
+
+/// step function in the first variable; interpolants of it are
+/// independent of all other variables
+Pecos::Real step(const Pecos::Real* x)
+{ return (x[0] > STEP) ? 1. : 0.; }
+
+/// gradient of multilinear()
+void multilinear_gradient(const Pecos::Real* x, size_t nvar,
+			  Pecos::RealVector& grad)
+{
+  grad.sizeUninitialized(nvar);
+  for (size_t i=0; i<nvar; ++i) {
+    grad[i] = 0.5 / (i+1);
+    for (size_t j=0; j<nvar; ++j)
+      if (j != i)
+	grad[i] *= 1. + 0.5 * x[j] / (j+1);
+  }
+}
+
+/// construct a piecewise hierarchical interpolant in nvar variables on an
+/// isotropic sparse grid of level lev: a PIECEWISE_LINEAR_INTERP basis
+/// interpolates step(), while a PIECEWISE_CUBIC_INTERP basis interpolates
+/// the values and gradients of multilinear() using type2 surpluses
+void hierarch_interpolant(size_t nvar, unsigned short lev, short refine_cntl,
+  short basis_type,
+  std::shared_ptr<Pecos::HierarchSparseGridDriver>& hsg_driver,
+  std::shared_ptr<Pecos::SharedHierarchInterpPolyApproxData>& shared_poly_data,
+  Pecos::BasisApproximation& poly_approx)
+{
+  using namespace Pecos;
+
+  bool use_derivs = (basis_type == PIECEWISE_CUBIC_INTERP);
+  IntegrationDriver int_driver;
+  hsg_driver = std::make_shared<HierarchSparseGridDriver>(lev);
+  int_driver.assign_rep(hsg_driver);
+  std::vector<BasisPolynomial> poly_basis(nvar);
+  for (size_t i=0; i<nvar; ++i)
+    poly_basis[i] = BasisPolynomial(basis_type, NEWTON_COTES);
+  hsg_driver->mode(INTERPOLATION_MODE);
+  hsg_driver->refinement_control(refine_cntl);
+  int_driver.initialize_grid(poly_basis);
+  RealMatrix var_sets;
+  hsg_driver->compute_grid(var_sets);
+
+  ExpansionConfigOptions ec_options;
+  ec_options.expCoeffsSolnApproach = HIERARCHICAL_SPARSE_GRID;
+  ec_options.expBasisType          = HIERARCHICAL_INTERPOLANT;
+  ec_options.refineControl         = refine_cntl;
+  BasisConfigOptions bc_options;
+  bc_options.piecewiseBasis = true;
+  bc_options.useDerivs      = use_derivs;
+  SharedBasisApproxData shared_data;
+  shared_poly_data = std::make_shared<SharedHierarchInterpPolyApproxData>
+    (PIECEWISE_HIERARCHICAL_INTERPOLATION_POLYNOMIAL, nvar, ec_options,
+     bc_options);
+  shared_data.assign_rep(shared_poly_data);
+  shared_poly_data->integration_driver_rep(hsg_driver);
+  poly_approx.assign_rep(
+    std::make_shared<HierarchInterpPolyApproximation>(shared_data));
+
+  SurrogateData surr_data(true);
+  RealVector grad;
+  for (int i=0; i<var_sets.numCols(); ++i) {
+    SurrogateDataVars sdv(nvar, 0, 0);
+    SurrogateDataResp sdr((use_derivs) ? 3 : 1, nvar);
+    sdv.continuous_variables(
+      Teuchos::getCol<int,double>(Teuchos::Copy, var_sets, i));
+    if (use_derivs) {
+      sdr.response_function(multilinear(var_sets[i], nvar));
+      multilinear_gradient(var_sets[i], nvar, grad);
+      sdr.response_gradient(grad);
+    }
+    else
+      sdr.response_function(step(var_sets[i]));
+    surr_data.push_back(sdv, sdr);
+  }
+  poly_approx.surrogate_data(surr_data);
+  std::static_pointer_cast<SharedPolyApproxData>(shared_poly_data)->
+    allocate_data();
+  poly_approx.compute_coefficients();
+}
+
+/// maximum difference between the packed evaluation of the active
+/// expansion (value, gradient, and mean) and the level/set evaluation of
+/// the expansion stored for key, over nsamp random points
+Pecos::Real packed_difference(size_t nvar, size_t nsamp,
+  const Pecos::ActiveKey& key, Pecos::PolynomialApproximation& approx)
+{
+  using namespace Pecos;
+
+  boost::mt19937 rng(7654321);
+  boost::uniform_real<> unif(-1., 1.);
+  boost::variate_generator<boost::mt19937&, boost::uniform_real<> >
+    sampler(rng, unif);
+
+  // with no non-random variables, mean(x) integrates the level/set arrays
+  RealVector x(nvar);  x = 0.;
+  Real diff = std::abs(approx.mean() - approx.mean(x));
+  for (size_t s=0; s<nsamp; ++s) {
+    for (size_t v=0; v<nvar; ++v)
+      x[v] = sampler();
+    diff = std::max(diff,
+		    std::abs(approx.value(x) - approx.stored_value(x, key)));
+    RealVector grad = approx.gradient_basis_variables(x); // copy
+    const RealVector& ref_grad
+      = approx.stored_gradient_basis_variables(x, key);
+    for (size_t v=0; v<nvar; ++v)
+      diff = std::max(diff, std::abs(grad[v] - ref_grad[v]));
+  }
+  return diff;
+}
+
+/// mean absolute error of an interpolant of step(), sampled along a line
+/// in the first variable at points offset from the collocation points
+Pecos::Real step_error(size_t nvar, Pecos::BasisApproximation& poly_approx)
+{
+  size_t i, num_x = 4000;
+  Pecos::RealVector x(nvar);  x = 0.37;
+  Pecos::Real sum = 0.;
+  for (i=0; i<num_x; ++i) {
+    x[0] = -1. + 2. * (i + 0.5) / num_x;
+    sum += std::abs(poly_approx.value(x) - step(x.values()));
+  }
+  return sum / num_x;
+}
+
+/// point-local refinement of a step function in two variables: the new
+/// points must cluster at the discontinuity, and the refined interpolant
+/// must require fewer truth evaluations than the isotropic grid of
+/// equivalent accuracy
+int local_refinement_test()
+{
+  using namespace Pecos;
+
+  size_t nvar = 2, i, it, num_new, num_near = 0, num_added = 0;
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver;
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> shared_poly_data;
+  BasisApproximation poly_approx;
+  hierarch_interpolant(nvar, 3, LOCAL_ADAPTIVE_CONTROL,
+		       PIECEWISE_LINEAR_INTERP, hsg_driver, shared_poly_data,
+		       poly_approx);
+  std::shared_ptr<HierarchInterpPolyApproximation> poly_approx_rep =
+    std::static_pointer_cast<HierarchInterpPolyApproximation>
+    (poly_approx.approx_rep());
+  size_t num_local = poly_approx.surrogate_data().points();
+
+  // surpluses vanish (exactly) away from the discontinuity
+  RealMatrix var_sets;
+  for (it=0; it<NREFINE; ++it) {
+    Sizet2DArray refine_pts;
+    poly_approx_rep->local_refinement_candidates(1.e-8, refine_pts);
+    hsg_driver->compute_local_refinement(refine_pts, var_sets);
+    num_new = var_sets.numCols();
+    if (!num_new) break;
+    for (i=0; i<num_new; ++i) {
+      SurrogateDataVars sdv(nvar, 0, 0);
+      SurrogateDataResp sdr(1, nvar);
+      sdv.continuous_variables(
+	Teuchos::getCol<int,double>(Teuchos::Copy, var_sets, (int)i));
+      sdr.response_function(step(var_sets[i]));
+      poly_approx.surrogate_data().push_back(sdv, sdr);
+      if (std::abs(var_sets(0,i) - STEP) <= 0.25) ++num_near;
+    }
+    num_added += num_new;
+    std::static_pointer_cast<SharedPolyApproxData>(shared_poly_data)->
+      increment_data();
+    poly_approx.increment_coefficients();
+  }
+  num_local += num_added;
+  Real local_err = step_error(nvar, poly_approx);
+  PCout << "Point-local refinement: " << num_local << " points ("
+	<< num_near << " of " << num_added << " added near the step), "
+	<< "error = " << local_err << '\n';
+
+  int status = 0;
+  if (it < NREFINE || 10 * num_near < 9 * num_added) status = 1;
+
+  // packed evaluation over the partial sets added by refinement
+  Real packed_diff = packed_difference(nvar, NSAMPLES,
+    std::static_pointer_cast<SharedPolyApproxData>(shared_poly_data)->
+    active_key(), *poly_approx_rep);
+  PCout << "Max packed/level-set difference after refinement = "
+	<< packed_diff << '\n';
+  if (packed_diff > TOL) status = 1;
+
+  // isotropic refinement to the same accuracy
+  unsigned short lev;  Real set_err = 1.;  size_t num_set = 0;
+  for (lev=3; lev<=MAXLEVEL; ++lev) {
+    BasisApproximation set_approx;
+    hierarch_interpolant(nvar, lev, UNIFORM_CONTROL, PIECEWISE_LINEAR_INTERP,
+			 hsg_driver, shared_poly_data, set_approx);
+    num_set = set_approx.surrogate_data().points();
+    set_err = step_error(nvar, set_approx);
+    if (set_err <= local_err * (1. + 1.e-6)) break;
+  }
+  PCout << "Set-based refinement: " << num_set << " points at level " << lev
+	<< ", error = " << set_err << '\n';
+  if (lev > MAXLEVEL || num_local >= num_set) status = 1;
+
+  return status;
+}
+
+/// packed evaluation of a piecewise cubic interpolant with type2
+/// surpluses must match its level/set evaluation
+int type2_packed_test()
+{
+  using namespace Pecos;
+
+  size_t nvar = 2;
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver;
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> shared_poly_data;
+  BasisApproximation poly_approx;
+  hierarch_interpolant(nvar, 3, UNIFORM_CONTROL, PIECEWISE_CUBIC_INTERP,
+		       hsg_driver, shared_poly_data, poly_approx);
+  std::shared_ptr<HierarchInterpPolyApproximation> poly_approx_rep =
+    std::static_pointer_cast<HierarchInterpPolyApproximation>
+    (poly_approx.approx_rep());
+
+  Real packed_diff = packed_difference(nvar, NSAMPLES,
+    std::static_pointer_cast<SharedPolyApproxData>(shared_poly_data)->
+    active_key(), *poly_approx_rep);
+  PCout << "Max packed/level-set difference on type2 grid = "
+	<< packed_diff << '\n';
+  return (packed_diff > TOL) ? 1 : 0;
+}
+
+/// A driver program for PECOS.
+
+/** Builds a piecewise linear hierarchical interpolant on a sparse grid
+    and times its evaluation, point-wise and batched, at random samples.
+    Evaluation is verified at the collocation points and against the
+    multilinear test function.  Point-local refinement of a step
+    function is verified against set-based refinement, and the packed
+    evaluation is verified against the level/set evaluation on the
+    locally refined grid and on a grid with type2 surpluses. */
+
+int main(int argc, char* argv[])
+{
+  using namespace Pecos;
+
+  size_t         nvar  = NUMVARS;
+  unsigned short lev   = LEVEL;
+  size_t         nsamp = NSAMPLES;
+
+  int c;
+  while ((c=getopt(argc,(char **)argv,"hd:l:s:"))!=-1){
+    switch (c) {
+    case 'h':
+      usage();
+      break;
+    case 'd':
+      nvar  = strtol(optarg, (char **)NULL,0);
+      break;
+    case 'l':
+      lev   = strtol(optarg, (char **)NULL,0);
+      break;
+    case 's':
+      nsamp = strtol(optarg, (char **)NULL,0);
+      break;
+    default :
+      break;
+    }
+  }
+
+  // hierarchical sparse grid with piecewise linear basis on equidistant pts
+  IntegrationDriver int_driver; // empty envelope
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver =
+    std::make_shared<HierarchSparseGridDriver>(lev);
+  int_driver.assign_rep(hsg_driver);
+  std::vector<BasisPolynomial> poly_basis(nvar);
+  for (size_t i=0; i<nvar; ++i)
+    poly_basis[i] = BasisPolynomial(PIECEWISE_LINEAR_INTERP, NEWTON_COTES);
+  hsg_driver->mode(INTERPOLATION_MODE);
+  int_driver.initialize_grid(poly_basis);
+
+  RealMatrix var_sets;
+  hsg_driver->compute_grid(var_sets);
+  size_t i, num_pts = var_sets.numCols();
+  PCout << "Sparse grid with " << num_pts << " points in " << nvar
+	<< " dimensions at level " << lev << '\n';
+
+  ExpansionConfigOptions ec_options;
+  ec_options.expCoeffsSolnApproach = HIERARCHICAL_SPARSE_GRID;
+  ec_options.expBasisType          = HIERARCHICAL_INTERPOLANT;
+  BasisConfigOptions bc_options;
+  bc_options.piecewiseBasis = true;
+  SharedBasisApproxData shared_data;
+  std::shared_ptr<SharedHierarchInterpPolyApproxData> shared_poly_data =
+    std::make_shared<SharedHierarchInterpPolyApproxData>
+    (PIECEWISE_HIERARCHICAL_INTERPOLATION_POLYNOMIAL, nvar, ec_options,
+     bc_options);
+  shared_data.assign_rep(shared_poly_data);
+  shared_poly_data->integration_driver_rep(hsg_driver);
+
+  std::shared_ptr<HierarchInterpPolyApproximation> poly_approx_rep =
+    std::make_shared<HierarchInterpPolyApproximation>(shared_data);
+  BasisApproximation poly_approx;
+  poly_approx.assign_rep(poly_approx_rep);
+
+  SurrogateData surr_data(true);
+  RealVector fn_vals(num_pts);
+  for (i=0; i<num_pts; ++i) {
+    SurrogateDataVars sdv(nvar, 0, 0);
+    SurrogateDataResp sdr(1, nvar); // no gradient or hessian
+    sdv.continuous_variables(
+      Teuchos::getCol<int,double>(Teuchos::Copy, var_sets, (int)i));
+    sdr.response_function(fn_vals[i] = multilinear(var_sets[i], nvar));
+    surr_data.push_back(sdv, sdr);
+  }
+  poly_approx.surrogate_data(surr_data);
+
+  std::static_pointer_cast<SharedPolyApproxData>(shared_poly_data)->
+    allocate_data();
+  clock_t start = clock();
+  poly_approx.compute_coefficients();
+  PCout << "Coefficients computed in "
+	<< Real(clock() - start) / CLOCKS_PER_SEC << " s\n";
+
+  int status = 0;
+  Real err, max_err = 0.;
+
+  // interpolation at the collocation points (batched)
+  RealVector approx_vals;
+  poly_approx_rep->values(var_sets, approx_vals);
+  for (i=0; i<num_pts; ++i) {
+    err = std::abs(approx_vals[i] - fn_vals[i]);
+    if (err > max_err) max_err = err;
+  }
+  PCout << "Max error at collocation points = " << max_err << '\n';
+  if (max_err > TOL) status = 1;
+
+  // random samples: point-wise and batched evaluation
+  boost::mt19937 rng(1234567);
+  boost::uniform_real<> unif(-1., 1.);
+  boost::variate_generator<boost::mt19937&, boost::uniform_real<> >
+    sampler(rng, unif);
+  RealMatrix samples(nvar, nsamp, false);
+  for (i=0; i<nsamp; ++i)
+    for (size_t j=0; j<nvar; ++j)
+      samples(j,i) = sampler();
+
+  RealVector pt_vals(nsamp);
+  start = clock();
+  for (i=0; i<nsamp; ++i)
+    pt_vals[i] = poly_approx.value(
+      Teuchos::getCol<int,double>(Teuchos::View, samples, (int)i));
+  Real pt_time = Real(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  poly_approx_rep->values(samples, approx_vals);
+  Real batch_time = Real(clock() - start) / CLOCKS_PER_SEC;
+
+  Real max_diff = 0.;  max_err = 0.;
+  for (i=0; i<nsamp; ++i) {
+    err = std::abs(approx_vals[i] - pt_vals[i]);
+    if (err > max_diff) max_diff = err;
+    err = std::abs(approx_vals[i] - multilinear(samples[i], nvar));
+    if (err > max_err) max_err = err;
+  }
+  PCout << "Evaluation of " << nsamp << " samples: point-wise " << pt_time
+	<< " s, batched " << batch_time << " s\n"
+	<< "Max point-wise/batched difference = " << max_diff << '\n';
+  if (max_diff > TOL) status = 1;
+  if (lev >= nvar) {
+    PCout << "Max error against multilinear function = " << max_err << '\n';
+    if (max_err > TOL) status = 1;
+  }
+
+  if (local_refinement_test()) status = 1;
+  if (type2_packed_test())      status = 1;
+
+  return status;
+}
@@ -0,0 +1,174 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_hierarch_refinement_metrics.cpp
+    \brief Batched delta statistics of generalized refinement candidates */
+
+#include <map>
+
+#define BOOST_TEST_MODULE pecos_hierarch_refinement_metrics
+#include <boost/test/included/unit_test.hpp>
+
+#include "HierarchSparseGridDriver.hpp"
+#include "SharedHierarchInterpPolyApproxData.hpp"
+#include "HierarchInterpPolyApproximation.hpp"
+#include "HierarchRefinementMetrics.hpp"
+#include "SurrogateData.hpp"
+#include "Teuchos_SerialDenseHelpers.hpp"
+#include "ExpansionTestHelpers.hpp"
+
+namespace {
+
+const size_t NUMVARS = 2;
+const size_t NUMQOI  = 2;
+const Real   TOL     = 1.e-12;
+
+/// smooth QoI with interacting variables
+Real qoi(size_t q, const Real* x)
+{
+  return (q == 0) ? x[0] * x[0] + 0.5 * x[1] + x[0] * x[1]
+                  : std::exp(0.3 * x[0] - 0.4 * x[1]);
+}
+
+/// append the points in var_sets to the surrogate data of each QoI
+void append_data(RealMatrix& var_sets,
+		 std::vector<BasisApproximation>& poly_approxs, bool pop_count)
+{
+  int i, num_pts = var_sets.numCols();
+  for (size_t q=0; q<NUMQOI; ++q) {
+    SurrogateData& sd = poly_approxs[q].surrogate_data();
+    for (i=0; i<num_pts; ++i) {
+      SurrogateDataVars sdv(NUMVARS, 0, 0);
+      SurrogateDataResp sdr(1, NUMVARS); // no gradient or hessian
+      sdv.continuous_variables(
+	Teuchos::getCol<int,double>(Teuchos::Copy, var_sets, i));
+      sdr.response_function(qoi(q, var_sets[i]));
+      sd.push_back(sdv, sdr);
+    }
+    if (pop_count) sd.pop_count(num_pts);
+  }
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+/** Each candidate of the first generalized refinement iteration is
+    evaluated and scored one at a time (increment, delta statistics,
+    pop), as in a dimension-adaptive refinement loop.  The batched
+    metrics computed afterwards from the popped data must reproduce
+    these delta statistics for every candidate and thread count. */
+BOOST_AUTO_TEST_CASE(test_hierarch_refinement_metrics_candidates)
+{
+  short refine_cntl = DIMENSION_ADAPTIVE_CONTROL_GENERALIZED;
+  IntegrationDriver int_driver;
+  std::shared_ptr<HierarchSparseGridDriver> hsg_driver =
+    std::make_shared<HierarchSparseGridDriver>(1, RealVector(),
+      MODERATE_RESTRICTED_GROWTH, refine_cntl);
+  int_driver.assign_rep(hsg_driver);
+  std::vector<BasisPolynomial> poly_basis(NUMVARS);
+  for (size_t i=0; i<NUMVARS; ++i)
+    poly_basis[i] = BasisPolynomial(PIECEWISE_LINEAR_INTERP, NEWTON_COTES);
+  hsg_driver->mode(INTERPOLATION_MODE);
+  int_driver.initialize_grid(poly_basis);
+
+  ExpansionConfigOptions ec_options;
+  ec_options.expCoeffsSolnApproach = HIERARCHICAL_SPARSE_GRID;
+  ec_options.expBasisType          = HIERARCHICAL_INTERPOLANT;
+  ec_options.refineControl         = refine_cntl;
+  ec_options.refineMetric          = COVARIANCE_METRIC;
+  ec_options.refineStatsType       = ACTIVE_EXPANSION_STATS;
+  BasisConfigOptions bc_options;
+  bc_options.piecewiseBasis = true;
+  SharedBasisApproxData shared_data;
+  // data management is invoked through the public base interface
+  std::shared_ptr<SharedPolyApproxData> shared_poly_data =
+    std::make_shared<SharedHierarchInterpPolyApproxData>
+    (PIECEWISE_HIERARCHICAL_INTERPOLATION_POLYNOMIAL, NUMVARS, ec_options,
+     bc_options);
+  shared_data.assign_rep(shared_poly_data);
+  shared_poly_data->integration_driver_rep(hsg_driver);
+
+  size_t q, q2;
+  std::vector<BasisApproximation> poly_approxs(NUMQOI);
+  std::vector<PolynomialApproximation*> pa_reps(NUMQOI);
+  for (q=0; q<NUMQOI; ++q) {
+    poly_approxs[q].assign_rep(
+      std::make_shared<HierarchInterpPolyApproximation>(shared_data));
+    pa_reps[q] = std::static_pointer_cast<PolynomialApproximation>
+      (poly_approxs[q].approx_rep()).get();
+  }
+  for (q=0; q<NUMQOI; ++q)
+    for (q2=q; q2<NUMQOI; ++q2)
+      pa_reps[q]->initialize_covariance(pa_reps[q2]);
+
+  RealMatrix var_sets;
+  hsg_driver->compute_grid(var_sets);
+  for (q=0; q<NUMQOI; ++q)
+    poly_approxs[q].surrogate_data(SurrogateData(true));
+  append_data(var_sets, poly_approxs, false);
+  shared_poly_data->allocate_data();
+  for (q=0; q<NUMQOI; ++q)
+    poly_approxs[q].compute_coefficients();
+
+  // score each candidate in turn, recording its delta statistics
+  hsg_driver->initialize_sets();
+  UShortArraySet candidates = hsg_driver->active_multi_index();
+  BOOST_REQUIRE( !candidates.empty() );
+  std::map<UShortArray, RealVector>    ref_delta_means;
+  std::map<UShortArray, RealSymMatrix> ref_delta_covs;
+  for (UShortArraySet::const_iterator it=candidates.begin();
+       it!=candidates.end(); ++it) {
+    hsg_driver->increment_smolyak_multi_index(*it);
+    hsg_driver->compute_trial_grid(var_sets);
+    append_data(var_sets, poly_approxs, true);
+    shared_poly_data->increment_data();
+    for (q=0; q<NUMQOI; ++q)
+      poly_approxs[q].increment_coefficients();
+
+    RealVector&    d_means = ref_delta_means[*it];
+    RealSymMatrix& d_covs  = ref_delta_covs[*it];
+    d_means.sizeUninitialized(NUMQOI);  d_covs.shapeUninitialized(NUMQOI);
+    for (q=0; q<NUMQOI; ++q) {
+      d_means[q] = pa_reps[q]->delta_mean();
+      d_covs(q,q) = pa_reps[q]->delta_variance();
+      for (q2=q+1; q2<NUMQOI; ++q2)
+	d_covs(q,q2) = pa_reps[q]->delta_covariance(pa_reps[q2]);
+    }
+
+    shared_poly_data->decrement_data();
+    for (q=0; q<NUMQOI; ++q) {
+      poly_approxs[q].pop_coefficients(true);
+      poly_approxs[q].surrogate_data().pop(true);
+    }
+    hsg_driver->pop_set();
+  }
+
+  // all candidates are scored at once from the popped data
+  size_t num_threads[] = { 1, 3 };
+  for (size_t t=0; t<2; ++t) {
+    HierarchRefinementMetrics metrics;
+    metrics.max_threads(num_threads[t]);
+    metrics.compute(shared_data, poly_approxs, true, true);
+    BOOST_REQUIRE( metrics.num_candidates() == candidates.size() );
+    for (size_t c=0; c<metrics.num_candidates(); ++c) {
+      const UShortArray& cand = metrics.candidate(c);
+      BOOST_REQUIRE( ref_delta_means.count(cand) );
+      const RealVector&    d_means = ref_delta_means[cand];
+      const RealSymMatrix& d_covs  = ref_delta_covs[cand];
+      for (q=0; q<NUMQOI; ++q) {
+	BOOST_CHECK( rel_diff(metrics.delta_means()(q,c), d_means[q]) < TOL );
+	BOOST_CHECK(
+	  rel_diff(metrics.delta_variances()(q,c), d_covs(q,q)) < TOL );
+	for (q2=q; q2<NUMQOI; ++q2)
+	  BOOST_CHECK( rel_diff(metrics.delta_covariances()[c](q,q2),
+				d_covs(q,q2)) < TOL );
+      }
+    }
+  }
+}
@@ -0,0 +1,107 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_streaming_regression.cpp
+    \brief Consistency of streaming (TSQR) least squares regression with
+    the assembled least squares solution */
+
+#include <cmath>
+
+#define BOOST_TEST_MODULE pecos_streaming_regression
+#include <boost/test/included/unit_test.hpp>
+
+#include "RegressOrthogPolyApproximation.hpp"
+#include "SharedRegressOrthogPolyApproxData.hpp"
+#include "SurrogateData.hpp"
+#include "Teuchos_SerialDenseHelpers.hpp"
+
+using namespace Pecos;
+
+namespace {
+
+const size_t NUMVARS = 3;
+const unsigned short ORDER = 3;
+const size_t NUMPTS = 200;
+const Real TOL = 1.e-10;
+
+/// non-polynomial response, such that the least squares residual is
+/// nonzero and the solution depends on all of the data
+Real response(const Real* x)
+{ return std::exp(0.5 * x[0]) * std::sin(x[1] + 0.3) + x[0] * x[2] * x[2]; }
+
+/// compute the total-order Legendre expansion coefficients of response()
+/// using dense least squares on the data in samples, streaming the linear
+/// system in blocks of block_size points if nonzero
+void regression_coefficients(const RealMatrix& samples, size_t block_size,
+			     RealVector& coeffs)
+{
+  UShortArray approx_order(NUMVARS, ORDER);
+  ExpansionConfigOptions ec_options;
+  ec_options.expCoeffsSolnApproach = DEFAULT_LEAST_SQ_REGRESSION;
+  BasisConfigOptions bc_options;
+  RegressionConfigOptions rc_options;
+  rc_options.streamBlockSize = block_size;
+  std::shared_ptr<SharedRegressOrthogPolyApproxData> shared_poly_data =
+    std::make_shared<SharedRegressOrthogPolyApproxData>
+    (GLOBAL_ORTHOGONAL_POLYNOMIAL, approx_order, NUMVARS, ec_options,
+     bc_options, rc_options);
+  SharedBasisApproxData shared_data;
+  shared_data.assign_rep(shared_poly_data);
+  std::vector<BasisPolynomial> poly_basis(NUMVARS);
+  for (size_t v=0; v<NUMVARS; ++v)
+    poly_basis[v] = BasisPolynomial(LEGENDRE_ORTHOG);
+  shared_poly_data->polynomial_basis(poly_basis);
+
+  BasisApproximation poly_approx;
+  poly_approx.assign_rep(
+    std::make_shared<RegressOrthogPolyApproximation>(shared_data));
+  SurrogateData surr_data(true);
+  RealVector x(NUMVARS, false);
+  for (int i=0; i<samples.numCols(); ++i) {
+    SurrogateDataVars sdv(NUMVARS, 0, 0);
+    SurrogateDataResp sdr(1, NUMVARS); // no gradient or hessian
+    for (size_t v=0; v<NUMVARS; ++v)
+      x[v] = samples(v,i);
+    sdv.continuous_variables(x, DEEP_COPY);
+    sdr.response_function(response(x.values()));
+    surr_data.push_back(sdv, sdr);
+  }
+  poly_approx.surrogate_data(surr_data);
+
+  std::static_pointer_cast<SharedPolyApproxData>(shared_poly_data)->
+    allocate_data();
+  poly_approx.compute_coefficients();
+  coeffs = poly_approx.approximation_coefficients(false);
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_streaming_regression_coefficients)
+{
+  RealMatrix samples(NUMVARS, NUMPTS, false);
+  Teuchos::ScalarTraits<Real>::seedrandom(31415);
+  samples.random(); // [-1,1] within the Legendre support
+
+  RealVector batch_coeffs;
+  regression_coefficients(samples, 0, batch_coeffs);
+  BOOST_REQUIRE( batch_coeffs.length() > 0 );
+
+  // block sizes that divide the data evenly, that leave a partial final
+  // block, and that fit the data within a single block
+  size_t block_sizes[] = { 20, 23, 1000 };
+  for (size_t b=0; b<3; ++b) {
+    RealVector stream_coeffs;
+    regression_coefficients(samples, block_sizes[b], stream_coeffs);
+    BOOST_REQUIRE( stream_coeffs.length() == batch_coeffs.length() );
+    for (int i=0; i<batch_coeffs.length(); ++i)
+      BOOST_CHECK( std::abs(stream_coeffs[i] - batch_coeffs[i]) <
+		   TOL * std::max(1., std::abs(batch_coeffs[i])) );
+  }
+}
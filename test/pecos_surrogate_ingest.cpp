@@ -0,0 +1,173 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_surrogate_ingest.cpp
+    \brief Concurrent staging of truth data and ordered commits into
+    SurrogateData */
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PECOS_TEST_FORK
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define BOOST_TEST_MODULE pecos_surrogate_ingest
+#include <boost/test/included/unit_test.hpp>
+
+#include "SurrogateDataIngest.hpp"
+
+using namespace Pecos;
+
+namespace {
+
+const size_t NUMVARS = 2;
+const int NUM_PRODUCERS = 4;
+const int NUM_EVALS = 400;
+const int COMMIT_INTERVAL = 37; // bounds not aligned with producer blocks
+
+/// stage a point whose variables and response encode its id
+void append_point(SurrogateDataIngest& ingest, int id)
+{
+  SurrogateDataVars sdv(NUMVARS, 0, 0);
+  SurrogateDataResp sdr(1, NUMVARS); // no gradient or hessian
+  RealVector c_vars(NUMVARS);  c_vars[0] = id;
+  sdv.continuous_variables(c_vars, DEEP_COPY);
+  sdr.response_function(2. * id);
+  ingest.append(id, sdv, sdr);
+}
+
+/// evaluation worker: appends its share of the ids in random order
+void produce(SurrogateDataIngest& ingest, int producer,
+	     std::vector<std::atomic<bool> >& appended)
+{
+  std::vector<int> ids;
+  for (int id=producer; id<NUM_EVALS; id+=NUM_PRODUCERS)
+    ids.push_back(id);
+  std::mt19937 rng(97 + producer);
+  std::shuffle(ids.begin(), ids.end(), rng);
+  for (size_t i=0; i<ids.size(); ++i) {
+    append_point(ingest, ids[i]);
+    appended[ids[i]].store(true, std::memory_order_release);
+  }
+}
+
+#ifdef PECOS_TEST_FORK
+/// return true if commit() terminates the process with an error status
+/// after the ids in first are committed and the ids in second are staged
+bool commit_aborts(const std::vector<int>& first,
+		   const std::vector<int>& second)
+{
+  pid_t pid = fork();
+  if (pid == 0) {
+    SurrogateDataIngest ingest;  SurrogateData sd(true);
+    for (size_t i=0; i<first.size(); ++i)
+      append_point(ingest, first[i]);
+    ingest.commit(sd);
+    for (size_t i=0; i<second.size(); ++i)
+      append_point(ingest, second[i]);
+    ingest.commit(sd);
+    _exit(0);
+  }
+  int status;
+  waitpid(pid, &status, 0);
+  return (WIFEXITED(status) && WEXITSTATUS(status) != 0);
+}
+#endif
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_surrogate_ingest_concurrent_commits)
+{
+  SurrogateDataIngest ingest;  SurrogateData sd(true);
+  std::vector<std::atomic<bool> > appended(NUM_EVALS);
+  for (int id=0; id<NUM_EVALS; ++id)
+    appended[id].store(false);
+
+  std::vector<std::thread> producers;
+  for (int p=0; p<NUM_PRODUCERS; ++p)
+    producers.push_back(std::thread(produce, std::ref(ingest), p,
+				    std::ref(appended)));
+
+  // bounded commits interleave with the appends: each bound is committed
+  // once all ids up to it are staged, while later ids continue to arrive
+  SizetArray counts;  int bound, ready = 0;
+  for (bound=COMMIT_INTERVAL-1; bound<NUM_EVALS; bound+=COMMIT_INTERVAL) {
+    while (ready <= bound)
+      if (appended[ready].load(std::memory_order_acquire)) ++ready;
+      else std::this_thread::yield();
+    size_t num_merged = ingest.commit(sd, bound);
+    BOOST_CHECK( num_merged > 0 );
+    if (num_merged) counts.push_back(num_merged);
+    BOOST_CHECK( sd.points() == (size_t)bound + 1 );
+  }
+  for (int p=0; p<NUM_PRODUCERS; ++p)
+    producers[p].join();
+  size_t num_merged = ingest.commit(sd);
+  if (num_merged) counts.push_back(num_merged);
+  BOOST_CHECK( ingest.empty() );
+
+  // data are ordered by id independent of the order of arrival
+  const IntArray& ids = sd.data_ids();
+  BOOST_REQUIRE( sd.points() == (size_t)NUM_EVALS );
+  BOOST_REQUIRE( ids.size()  == (size_t)NUM_EVALS );
+  for (int i=0; i<NUM_EVALS; ++i) {
+    BOOST_CHECK( ids[i] == i );
+    BOOST_CHECK( sd.variables_data()[i].continuous_variables()[0] == i );
+    BOOST_CHECK( sd.response_data()[i].response_function() == 2. * i );
+  }
+
+  // one pop count per nonempty commit
+  BOOST_CHECK( sd.pop_count_stack() == counts );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_surrogate_ingest_retained_ids)
+{
+  SurrogateDataIngest ingest;  SurrogateData sd(true);
+  int staged[] = { 7, 2, 9, 4, 0 };
+  for (size_t i=0; i<5; ++i)
+    append_point(ingest, staged[i]);
+
+  BOOST_CHECK( ingest.commit(sd, 4) == 3 );
+  BOOST_CHECK( !ingest.empty() );
+  BOOST_CHECK( ingest.commit(sd, 5) == 0 ); // no pop count recorded
+  BOOST_CHECK( ingest.commit(sd, INT_MAX, false) == 2 );
+  BOOST_CHECK( ingest.empty() );
+
+  int expected[] = { 0, 2, 4, 7, 9 };
+  BOOST_REQUIRE( sd.data_ids().size() == 5 );
+  for (size_t i=0; i<5; ++i)
+    BOOST_CHECK( sd.data_ids()[i] == expected[i] );
+  BOOST_REQUIRE( sd.pop_count_stack().size() == 1 );
+  BOOST_CHECK( sd.pop_count_stack()[0] == 3 );
+}
+
+//----------------------------------------------------------------
+
+#ifdef PECOS_TEST_FORK
+BOOST_AUTO_TEST_CASE(test_surrogate_ingest_invalid_ids)
+{
+  std::vector<int> none, ids_1(1, 3), ids_2(2, 3), ids_3(1, 5);
+  // duplicates within a commit
+  BOOST_CHECK( commit_aborts(none, ids_2) );
+  // an id repeating a previous commit
+  BOOST_CHECK( commit_aborts(ids_1, ids_1) );
+  // a late id below a previous commit
+  BOOST_CHECK( commit_aborts(ids_3, ids_1) );
+  // increasing ids across commits are accepted
+  BOOST_CHECK( !commit_aborts(ids_1, ids_3) );
+}
+#endif
@@ -0,0 +1,138 @@
+/*  _______________________________________________________________________
+
+    PECOS: Parallel Environment for Creation Of Stochastics
+    Copyright (c) 2011, Sandia National Laboratories.
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Pecos directory.
+    _______________________________________________________________________ */
+
+/** \file pecos_vector_opa.cpp
+    \brief Consistency of VectorOrthogPolyApproximation with per-QoI
+    OrthogPolyApproximation instances */
+
+#define BOOST_TEST_MODULE pecos_vector_opa
+#include <boost/test/included/unit_test.hpp>
+
+#include "ExpansionTestHelpers.hpp"
+#include "VectorOrthogPolyApproximation.hpp"
+#include "Teuchos_SerialDenseHelpers.hpp"
+
+namespace {
+
+const size_t NUMVARS = 3;
+const size_t NUMQOI  = 4;
+const unsigned short ORDER = 4;
+const Real TOL = 1.e-12;
+
+/// shared total-order Legendre/Hermite basis with NUMQOI scalar
+/// expansions assigned random coefficients
+struct ExpansionFixture
+{
+  ExpansionFixture()
+  {
+    std::vector<BasisPolynomial> poly_basis(NUMVARS);
+    for (size_t v=0; v<NUMVARS; ++v)
+      poly_basis[v] = BasisPolynomial((v % 2) ? HERMITE_ORTHOG :
+				      LEGENDRE_ORTHOG);
+    UShort2DArray mi;
+    SharedPolyApproxData::
+      total_order_multi_index(UShortArray(NUMVARS, ORDER), mi);
+    expansion_shared_data(poly_basis, ORDER, mi, shared_data);
+    num_terms = mi.size();
+    poly_approxs = random_expansions(shared_data, num_terms, NUMQOI, 12345);
+  }
+
+  SharedBasisApproxData shared_data;
+  std::vector<BasisApproximation> poly_approxs;
+  size_t num_terms;
+};
+
+} // anonymous namespace
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_vector_opa_values_gradients)
+{
+  ExpansionFixture fix;
+  VectorOrthogPolyApproximation vopa(fix.shared_data);
+  vopa.gather_coefficients(fix.poly_approxs);
+  BOOST_CHECK( vopa.num_qoi() == NUMQOI );
+  BOOST_CHECK( vopa.expansion_coefficients().numRows() == (int)fix.num_terms );
+
+  size_t i, q, v, num_samples = 20;
+  RealMatrix samples(NUMVARS, num_samples, false);
+  samples.random(); // [-1,1] within the Legendre support
+
+  RealMatrix batch_vals, grads;  RealVector x_vals;
+  vopa.values(samples, batch_vals);
+  for (i=0; i<num_samples; ++i) {
+    RealVector x = Teuchos::getCol<int,Real>(Teuchos::View, samples, (int)i);
+    vopa.values(x, x_vals);
+    vopa.gradients(x, grads);
+    BOOST_CHECK( grads.numRows() == (int)NUMVARS );
+    BOOST_CHECK( grads.numCols() == (int)NUMQOI );
+    for (q=0; q<NUMQOI; ++q) {
+      PolynomialApproximation* opa_q = poly_approx_rep(fix.poly_approxs[q]);
+      Real val = opa_q->value(x);
+      BOOST_CHECK( rel_diff(x_vals[q], val) < TOL );
+      BOOST_CHECK( rel_diff(batch_vals(i,q), val) < TOL );
+      const RealVector& grad = opa_q->gradient_basis_variables(x);
+      for (v=0; v<NUMVARS; ++v)
+	BOOST_CHECK( rel_diff(grads(v,q), grad[v]) < TOL );
+    }
+  }
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_vector_opa_moments)
+{
+  ExpansionFixture fix;
+  VectorOrthogPolyApproximation vopa(fix.shared_data);
+  vopa.gather_coefficients(fix.poly_approxs);
+
+  RealVector means, vars;  RealSymMatrix covar;
+  vopa.means(means);
+  vopa.variances(vars);
+  vopa.covariance(covar);
+  BOOST_CHECK( means.length() == (int)NUMQOI );
+  BOOST_CHECK( covar.numRows() == (int)NUMQOI );
+
+  for (size_t q=0; q<NUMQOI; ++q) {
+    PolynomialApproximation* opa_q = poly_approx_rep(fix.poly_approxs[q]);
+    BOOST_CHECK( rel_diff(means[q], opa_q->mean()) < TOL );
+    BOOST_CHECK( rel_diff(vars[q],  opa_q->variance()) < TOL );
+    for (size_t p=0; p<=q; ++p) {
+      Real covar_pq
+	= opa_q->covariance(poly_approx_rep(fix.poly_approxs[p]));
+      BOOST_CHECK( rel_diff(covar(q,p), covar_pq) < TOL );
+      BOOST_CHECK( rel_diff(covar(p,q), covar_pq) < TOL );
+    }
+  }
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_vector_opa_scatter)
+{
+  ExpansionFixture fix;
+  VectorOrthogPolyApproximation vopa(fix.shared_data);
+  vopa.gather_coefficients(fix.poly_approxs);
+
+  // scale the coefficient matrix and redistribute to the scalar expansions
+  RealMatrix coeffs(vopa.expansion_coefficients());
+  coeffs.scale(2.);
+  vopa.expansion_coefficients(coeffs);
+  vopa.scatter_coefficients(fix.poly_approxs);
+
+  RealVector x(NUMVARS);  x.random();
+  RealVector x_vals;
+  vopa.values(x, x_vals);
+  for (size_t q=0; q<NUMQOI; ++q) {
+    RealVector coeffs_q = fix.poly_approxs[q].approximation_coefficients(false);
+    for (size_t i=0; i<fix.num_terms; ++i)
+      BOOST_CHECK( rel_diff(coeffs_q[i], coeffs(i,q)) < TOL );
+    Real val = poly_approx_rep(fix.poly_approxs[q])->value(x);
+    BOOST_CHECK( rel_diff(x_vals[q], val) < TOL );
+  }
+}
@@ -461,6 +461,91 @@ void svd_solve( const RealMatrix &A, const RealMatrix &B, RealMatrix &result_0,
   delete [] work;
 };
 
+/// throw on an illegal argument reported by a LAPACK routine within
+/// tsqr_update() (GEQRF and ORMQR report no other failures)
+static void tsqr_lapack_error( const char* routine, int info )
+{
+  std::stringstream msg;
+  msg << "tsqr_update() " << routine << " failed. ";
+  msg << "The " << std::abs( info ) << "-th argument had an ";
+  msg << "illegal value";
+  throw( std::runtime_error( msg.str() ) );
+}
+
+void tsqr_update( RealMatrix &R, RealMatrix &QtB, const RealMatrix &A,
+		  const RealMatrix &B )
+{
+  Teuchos::LAPACK<int, Real> la;
+
+  int M_A( A.numRows() ), N( A.numCols() ), num_rhs( B.numCols() );
+  if ( B.numRows() != M_A )
+    throw( std::runtime_error("tsqr_update() A and B are inconsistent") );
+  if ( R.numRows() == 0 )
+    { R.shape( N, N ); QtB.shape( N, num_rhs ); }
+  else if ( R.numRows() != N || R.numCols() != N || QtB.numRows() != N ||
+	    QtB.numCols() != num_rhs )
+    throw( std::runtime_error("tsqr_update() R and QtB are inconsistent") );
+  if ( M_A == 0 ) return;
+
+  //-----------------//
+  // Allocate memory //
+  //-----------------//
+
+  // stack [R; A] and [QtB; B]
+  int M = N + M_A, K = N;
+  RealMatrix qr_data( M, N ), rhs( M, num_rhs, false );
+  for ( int j = 0; j < N; j++ )
+    {
+      for ( int i = 0; i <= j; i++ )
+	qr_data(i,j) = R(i,j);
+      for ( int i = 0; i < M_A; i++ )
+	qr_data(N+i,j) = A(i,j);
+    }
+  for ( int j = 0; j < num_rhs; j++ )
+    {
+      for ( int i = 0; i < N; i++ )
+	rhs(i,j) = QtB(i,j);
+      for ( int i = 0; i < M_A; i++ )
+	rhs(N+i,j) = B(i,j);
+    }
+
+  //---------------------------------//
+  // Get the optimal work array size //
+  //---------------------------------//
+
+  int lwork, lwork_ormqr, info;
+  Real work_query;
+  RealVector tau( K, false );
+  la.GEQRF( M, N, qr_data.values(), qr_data.stride(), tau.values(),
+	    &work_query, -1, &info );
+  if ( info != 0 ) tsqr_lapack_error( "GEQRF", info );
+  lwork = (int)work_query;
+  la.ORMQR( 'L', 'T', M, num_rhs, K, qr_data.values(), qr_data.stride(),
+	    tau.values(), rhs.values(), rhs.stride(), &work_query, -1, &info );
+  if ( info != 0 ) tsqr_lapack_error( "ORMQR", info );
+  lwork_ormqr = (int)work_query;
+  RealVector work( std::max( lwork, lwork_ormqr ), false );
+
+  //------------------------------------------------------//
+  // Factor [R; A] = QR and apply Q' to the stacked rhs   //
+  //------------------------------------------------------//
+
+  la.GEQRF( M, N, qr_data.values(), qr_data.stride(), tau.values(),
+	    work.values(), work.length(), &info );
+  if ( info != 0 ) tsqr_lapack_error( "GEQRF", info );
+  la.ORMQR( 'L', 'T', M, num_rhs, K, qr_data.values(), qr_data.stride(),
+	    tau.values(), rhs.values(), rhs.stride(), work.values(),
+	    work.length(), &info );
+  if ( info != 0 ) tsqr_lapack_error( "ORMQR", info );
+
+  for ( int j = 0; j < N; j++ )
+    for ( int i = 0; i <= j; i++ )
+      R(i,j) = qr_data(i,j);
+  for ( int j = 0; j < num_rhs; j++ )
+    for ( int i = 0; i < N; i++ )
+      QtB(i,j) = rhs(i,j);
+}
+
 int cholesky_factorization_update_insert_column( RealMatrix &A, RealMatrix &U, 
 						 RealMatrix &col, int iter,
 						 Real delta )
@@ -561,6 +646,48 @@ void cholesky_factorization_update_delete_column( RealMatrix &U,
   for ( int n = 0; n < N; n++ ) U(N-1,n) = 0.0;
 };
 
+void qr_factorization_update_delete_column( RealMatrix &Q, RealMatrix &R,
+					    int col_index, int N )
+{
+  int M( Q.numRows() );
+  if ( col_index != N - 1 )
+    {
+      // delete column but do not resize the matrix R
+      delete_column( col_index, R, false );
+    };
+
+  RealVector x( 2, false );
+  for ( int n = col_index; n < N-1; n++ )
+    {
+      RealMatrix givens_matrix;
+      RealVector x_rot;
+      x[0] = R(n,n); x[1] = R(n+1,n);
+      givens_rotation( x, x_rot, givens_matrix );
+      R(n,n) = x_rot[0]; R(n+1,n) = x_rot[1];
+      Real g00 = givens_matrix(0,0), g01 = givens_matrix(0,1),
+	g10 = givens_matrix(1,0), g11 = givens_matrix(1,1);
+      // apply G to rows n and n+1 of R
+      for ( int j = n + 1; j < N - 1; j++ )
+	{
+	  Real r0 = R(n,j), r1 = R(n+1,j);
+	  R(n,j)   = g00 * r0 + g01 * r1;
+	  R(n+1,j) = g10 * r0 + g11 * r1;
+	}
+      // apply G' to columns n and n+1 of Q such that QR is unchanged
+      for ( int m = 0; m < M; m++ )
+	{
+	  Real q0 = Q(m,n), q1 = Q(m,n+1);
+	  Q(m,n)   = g00 * q0 + g01 * q1;
+	  Q(m,n+1) = g10 * q0 + g11 * q1;
+	}
+    }
+
+  // Zero out last row and column of R and last column of Q
+  for ( int m = 0; m < N; m++ ) R(m,N-1) = 0.0;
+  for ( int n = 0; n < N; n++ ) R(N-1,n) = 0.0;
+  for ( int m = 0; m < M; m++ ) Q(m,N-1) = 0.0;
+};
+
 int conjugate_gradients_solve( const RealMatrix &A, const RealVector &b, RealVector &x, 
 			       Real &relative_residual_norm,
 			       int &iters_taken,
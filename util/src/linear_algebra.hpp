@@ -560,6 +560,32 @@ void qr_solve( const RealMatrix &A, const RealMatrix &B, RealMatrix &result,
 void svd_solve( const RealMatrix &A, const RealMatrix &B, RealMatrix &result_0,
 		RealVector &result_1, int &rank, Real rcond = -1 );
 
+/** \brief Update the triangular factor and the projected right hand sides
+ * of a least squares problem when a block of rows is appended.
+ *
+ * Given the N-by-N upper triangular factor R and the N-by-NRHS projected
+ * right hand sides Q'*B of the rows processed so far, the QR factorization
+ * of [R; A] replaces them with those of the augmented problem. Repeated
+ * application (or application to the factors of another set of rows)
+ * implements a tall-skinny QR (TSQR) reduction, which factors a least
+ * squares problem with arbitrarily many rows in O(N^2) memory. The
+ * solution is then obtained from svd_solve( R, QtB, ... ).
+ *
+ *  \param R (input/output) DOUBLE PRECISION matrix, dimension (N,N)
+ *          The upper triangular factor. Initialized to zero if empty.
+ *
+ *  \param QtB (input/output) DOUBLE PRECISION matrix, dimension (N,NRHS)
+ *          The projected right hand sides. Initialized to zero if empty.
+ *
+ *  \param A (input) DOUBLE PRECISION matrix, dimension (M,N)
+ *          The rows to append.
+ *
+ *  \param B (input) DOUBLE PRECISION matrix, dimension (M,NRHS)
+ *          The right hand sides of the rows to append.
+ */
+void tsqr_update( RealMatrix &R, RealMatrix &QtB, const RealMatrix &A,
+		  const RealMatrix &B );
+
 /** \brief Solves a triangular system
  *
  *  Solves a triangular system of the form
@@ -666,7 +692,12 @@ void substitution_solve( const Teuchos::SerialDenseMatrix<int,ScalarType> &A,
  * \param iter specifies the size of the original Q and R matricies.
  *
  * \return info = 0 update sucessful. If info = 1, the new column was colinear
- * with the active set.
+ * with the active set, i.e. the norm of its component orthogonal to Q is
+ * below sqrt(machine epsilon) times its own norm.
+ *
+ * The column is orthogonalized by classical Gram-Schmidt with one
+ * reorthogonalization pass, which keeps Q orthogonal to working precision
+ * for ill-conditioned [A a].
  *
  * If A is invertible, then the factorization is unique if we require 
  * that the diagonal elements of R are positive.
@@ -696,41 +727,51 @@ int qr_factorization_update_insert_column( Teuchos::SerialDenseMatrix<int,Scalar
   
   int info( 0 );
   int M( col.length() );
-  Real col_norm = col.normFrobenius();
+  Real col_norm = col.normFrobenius(),
+    colinear_tol = std::sqrt( std::numeric_limits<Real>::epsilon() );
 
   if ( iter == 0 ){
+    if ( col_norm == 0. )
+      return 1;
     R(0,0) = col_norm;
     for ( int m = 0; m < M; m++ )
       Q(m,0) = col[m] / col_norm;
   }else{
     MatrixType Q_old( Teuchos::View, Q, M, iter, 0, 0 );
-    VectorType w( iter, false ); 
+    VectorType w( iter, false ), dw( iter, false ),
+      r( Teuchos::Copy, col.values(), M );
     
-    // w=Q'*col
+    // Classical Gram-Schmidt loses orthogonality in proportion to the
+    // conditioning of [A a], so the projection is repeated once
+    // (reorthogonalization): w = Q'*col, r = col - Q*w, dw = Q'*r,
+    // r -= Q*dw, w += dw
     GEMV(Teuchos::TRANS, true, Teuchos::ScalarTraits<ScalarType>::one(),
 	 Q_old, col, Teuchos::ScalarTraits<ScalarType>::zero(), w); // assumes conjugate transpose is needed
-    Real w_norm = w.normFrobenius();
-
-    if ( col_norm * col_norm - w_norm*w_norm <= 
-	 std::numeric_limits<Real>::epsilon() ){
-      // New column is colinear. That is, it is in the span of the active
-      // set
+    GEMV(Teuchos::NO_TRANS, false, -Teuchos::ScalarTraits<ScalarType>::one(),
+	 Q_old, w, Teuchos::ScalarTraits<ScalarType>::one(), r);
+    GEMV(Teuchos::TRANS, true, Teuchos::ScalarTraits<ScalarType>::one(),
+	 Q_old, r, Teuchos::ScalarTraits<ScalarType>::zero(), dw);
+    GEMV(Teuchos::NO_TRANS, false, -Teuchos::ScalarTraits<ScalarType>::one(),
+	 Q_old, dw, Teuchos::ScalarTraits<ScalarType>::one(), r);
+    for ( int i = 0; i < iter; i++ )
+      w[i] += dw[i];
+    Real r_norm = r.normFrobenius();
+
+    if ( r_norm <= colinear_tol * col_norm ){
+      // New column is colinear (relative to its own norm). That is, it is
+      // in the span of the active set
       info = 1;
     }else{
       // Ensure QR unique by setting diagonal entries of R to always be
       // positivie
-      R(iter,iter) = std::sqrt( col_norm * col_norm - w_norm * w_norm );
+      R(iter,iter) = r_norm;
       VectorType R_col( Teuchos::View, R[iter], iter );
       // must use assign below because operator= will not work
       // because it will call deleteArrays when w is a copy 
       // ( which it is here )
       R_col.assign( w ); 
-      VectorType Qw( M, false );
-      GEMV(Teuchos::NO_TRANS,false,
-	   Teuchos::ScalarTraits<ScalarType>::one(),
-	   Q_old, w, Teuchos::ScalarTraits<ScalarType>::zero(), Qw);
       for ( int m = 0; m < M; m ++ )
-	Q(m,iter) = ( col[m] - Qw[m] ) / R(iter,iter);
+	Q(m,iter) = r[m] / r_norm;
     }
   }
   return info;
@@ -794,6 +835,29 @@ void cholesky_factorization_update_delete_column( RealMatrix &U,
 						  int col_index,
 						  int N);
 
+/**
+ * \brief Update the QR factorization of a matrix A when a column is deleted
+ * from A. This is the counterpart of qr_factorization_update_insert_column.
+ *
+ * Deleting column k leaves R upper Hessenberg in columns k to N-2, which is
+ * restored to upper triangular form by N-k-1 Givens rotations that are also
+ * applied to the columns of Q. The cost is \f$O((M+N)(N-k))\f$.
+ *
+ * \param Q (input/output) The ( M x N ) orthonormal factor.
+ * On exit the first N-1 columns contain the updated factor and the Nth
+ * column is set to zero.
+ *
+ * \param R (input/output) The ( N x N ) upper triangular matrix.
+ * On exit contains the ( N-1 x N-1 ) new matrix R with all entries in the
+ * Nth row and column set to zero.
+ *
+ * \param col_index The index of the column to be deleted from A
+ *
+ * \param N the number of columns of A
+ */
+void qr_factorization_update_delete_column( RealMatrix &Q, RealMatrix &R,
+					    int col_index, int N );
+
 // For qr updating for deleting and including a row go to
 // http://www.maths.manchester.ac.uk/~clucas/updating/
 // This code is in fortran and must be compiled and wrapped correctly
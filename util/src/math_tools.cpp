@@ -622,5 +622,345 @@ void tensor_product_indices(const IntVector levels, IntMatrix &indices){
   cartesian_product( index_sets_1d, indices, 1 );
 }
 
+namespace {
+
+/// Binomial coefficient in exact integer arithmetic (0 if k < 0 or k > n)
+size_t binomial( int n, int k )
+{
+  if ( k < 0 || n < k ) return 0;
+  k = std::min( k, n-k );
+  size_t value = 1;
+  for ( int i = 1; i <= k; i++ )
+    value = value * (size_t)(n-k+i) / (size_t)i;
+  return value;
+}
+
+}  // anonymous namespace
+
+IndexSetGenerator::IndexSetGenerator( int num_dims, int max_level ) :
+  numDims_( num_dims ), maxLevel_( max_level ), level_( 0 ),
+  firstNonZero_( num_dims ), numGenerated_( 0 ), levelCount_( 0 ),
+  status_( 0 )
+{
+  if ( num_dims < 1 )
+    error( "IndexSetGenerator() num_dims must be positive" );
+  if ( max_level < 0 )
+    error( "IndexSetGenerator() max_level must be nonnegative" );
+  index_.size( num_dims );
+}
+
+IndexSetGenerator::~IndexSetGenerator(){}
+
+bool IndexSetGenerator::admissible( int /* num_changed */ )
+{ return true; }
+
+bool IndexSetGenerator::trailing_admissible( int /* k */ )
+{ return true; }
+
+bool IndexSetGenerator::completion_admissible( int /* k */, int /* r */ )
+{ return true; }
+
+void IndexSetGenerator::reset()
+{
+  index_.putScalar( 0 );
+  level_ = 0; firstNonZero_ = numDims_;
+  numGenerated_ = levelCount_ = 0; status_ = 0;
+}
+
+bool IndexSetGenerator::next()
+{
+  if ( status_ == 2 ) return false;
+  if ( status_ == 0 )
+    {
+      // the zero index belongs to any nonempty downward-closed set
+      status_ = 1;
+      if ( !admissible( numDims_ ) )
+	{ status_ = 2; return false; }
+      numGenerated_ = levelCount_ = 1;
+      return true;
+    }
+
+  int num_changed = 0;
+  while ( true )
+    {
+      if ( !advance( num_changed ) )
+	{ status_ = 2; return false; }
+      if ( admissible( num_changed ) )
+	{ numGenerated_++; levelCount_++; return true; }
+      num_changed = 0;
+      prune( num_changed );
+    }
+}
+
+bool IndexSetGenerator::advance( int &num_changed )
+{
+  int h = firstNonZero_;
+  if ( h >= numDims_ - 1 )
+    {
+      // current level complete: a downward-closed set has no admissible
+      // indices beyond the first empty level
+      if ( !levelCount_ || level_ >= maxLevel_ ) return false;
+      if ( h < numDims_ ) index_[h] = 0;
+      index_[0] = ++level_; firstNonZero_ = 0; levelCount_ = 0;
+      num_changed = numDims_;
+      return true;
+    }
+  // successor within the level (see compute_next_combination())
+  int t = index_[h];
+  index_[h] = 0; index_[0] = t - 1; index_[h+1]++;
+  firstNonZero_ = ( t > 1 ) ? 0 : h + 1;
+  num_changed = std::max( num_changed, h + 2 );
+  return true;
+}
+
+void IndexSetGenerator::prune( int &num_changed )
+{
+  // the rejected candidate is the first of those sharing components
+  // [q,num_dims), with the remainder of the level in component 0
+  int q = 1;
+  while ( q < numDims_ && !index_[q] ) q++;
+  if ( q < numDims_ && !trailing_admissible( q ) )
+    {
+      // every remaining candidate sharing components (q,num_dims) dominates
+      // the inadmissible trailing index: jump to the last of these, which
+      // assigns the remainder of the level to component q
+      index_[q] += index_[0]; index_[0] = 0; firstNonZero_ = q;
+      num_changed = std::max( num_changed, q + 1 );
+    }
+  else if ( q > 1 && index_[0] > 0 && !completion_admissible( q, index_[0] ) )
+    {
+      // no candidate sharing components [q,num_dims) is admissible: jump to
+      // the last of these, which assigns the remainder to component q-1
+      index_[q-1] = index_[0]; index_[0] = 0; firstNonZero_ = q - 1;
+      num_changed = std::max( num_changed, q );
+    }
+}
+
+size_t IndexSetGenerator::next_chunk( size_t max_indices, IntMatrix &result )
+{
+  result.shapeUninitialized( numDims_, (int)max_indices );
+  size_t num_indices = 0;
+  while ( num_indices < max_indices && next() )
+    {
+      for ( int d = 0; d < numDims_; d++ )
+	result( d, (int)num_indices ) = index_[d];
+      num_indices++;
+    }
+  if ( num_indices < max_indices )
+    result.reshape( numDims_, (int)num_indices );
+  return num_indices;
+}
+
+void IndexSetGenerator::save_traversal()
+{
+  savedIndex_ = index_; savedLevel_ = level_;
+  savedFirstNonZero_ = firstNonZero_; savedNumGenerated_ = numGenerated_;
+  savedLevelCount_ = levelCount_; savedStatus_ = status_;
+}
+
+void IndexSetGenerator::restore_traversal()
+{
+  index_ = savedIndex_; level_ = savedLevel_;
+  firstNonZero_ = savedFirstNonZero_; numGenerated_ = savedNumGenerated_;
+  levelCount_ = savedLevelCount_; status_ = savedStatus_;
+  // resynchronize any state cached by derived classes
+  if ( status_ == 1 ) admissible( numDims_ );
+}
+
+size_t IndexSetGenerator::count()
+{
+  save_traversal();
+  reset();
+  size_t num_indices = 0;
+  while ( next() ) num_indices++;
+  restore_traversal();
+  return num_indices;
+}
+
+size_t IndexSetGenerator::rank( const IntVector &index )
+{
+  if ( index.length() != numDims_ )
+    error( "IndexSetGenerator::rank() index has incorrect size" );
+  save_traversal();
+  reset();
+  bool found = false;
+  while ( !found && next() )
+    {
+      found = true;
+      for ( int d = 0; d < numDims_ && found; d++ )
+	found = ( index_[d] == index[d] );
+    }
+  size_t r = numGenerated_ - 1;
+  restore_traversal();
+  if ( !found )
+    error( "IndexSetGenerator::rank() index is not in the set" );
+  return r;
+}
+
+void IndexSetGenerator::unrank( size_t r, IntVector &index )
+{
+  save_traversal();
+  reset();
+  bool found = false;
+  while ( !found && next() )
+    found = ( numGenerated_ == r + 1 );
+  if ( found ) index = index_;
+  restore_traversal();
+  if ( !found )
+    error( "IndexSetGenerator::unrank() rank exceeds the set size" );
+}
+
+TotalOrderIndexSetGenerator::
+TotalOrderIndexSetGenerator( int num_dims, int level ) :
+  IndexSetGenerator( num_dims, level )
+{}
+
+TotalOrderIndexSetGenerator::~TotalOrderIndexSetGenerator(){}
+
+size_t TotalOrderIndexSetGenerator::count()
+{ return binomial( numDims_ + maxLevel_, numDims_ ); }
+
+size_t TotalOrderIndexSetGenerator::rank( const IntVector &index )
+{
+  if ( index.length() != numDims_ )
+    error( "TotalOrderIndexSetGenerator::rank() index has incorrect size" );
+  int n = 0;
+  for ( int d = 0; d < numDims_; d++ )
+    {
+      if ( index[d] < 0 )
+	error( "TotalOrderIndexSetGenerator::rank() index is negative" );
+      n += index[d];
+    }
+  if ( n > maxLevel_ )
+    error( "TotalOrderIndexSetGenerator::rank() index is not in the set" );
+  // indices of lower total degree, then compositions of n preceding index
+  // (the last component varies slowest)
+  size_t r = binomial( numDims_ + n - 1, numDims_ );
+  for ( int k = numDims_ - 1; k > 0; k-- )
+    {
+      r += binomial( n + k, k ) - binomial( n - index[k] + k, k );
+      n -= index[k];
+    }
+  return r;
+}
+
+void TotalOrderIndexSetGenerator::unrank( size_t r, IntVector &index )
+{
+  if ( r >= count() )
+    error( "TotalOrderIndexSetGenerator::unrank() rank exceeds the set size" );
+  int n = 0;
+  while ( binomial( numDims_ + n, numDims_ ) <= r ) n++;
+  r -= binomial( numDims_ + n - 1, numDims_ );
+  index.size( numDims_ );
+  for ( int k = numDims_ - 1; k > 0; k-- )
+    {
+      size_t num_compositions = binomial( n + k, k );
+      int v = 0;
+      while ( v < n && num_compositions - binomial( n - v - 1 + k, k ) <= r )
+	v++;
+      r -= num_compositions - binomial( n - v + k, k );
+      index[k] = v; n -= v;
+    }
+  index[0] = n;
+}
+
+HyperbolicIndexSetGenerator::
+HyperbolicIndexSetGenerator( int num_dims, int level, Real p ) :
+  IndexSetGenerator( num_dims, level ), p_( p )
+{
+  initialize( level );
+}
+
+HyperbolicIndexSetGenerator::
+HyperbolicIndexSetGenerator( int num_dims, int level, Real p,
+			     const RealVector &weights ) :
+  IndexSetGenerator( num_dims, level ), p_( p ), weights_( weights )
+{
+  if ( weights.length() != num_dims )
+    error( "HyperbolicIndexSetGenerator() weights has incorrect size" );
+  for ( int d = 0; d < num_dims; d++ )
+    if ( weights[d] <= 0. )
+      error( "HyperbolicIndexSetGenerator() weights must be positive" );
+  initialize( level );
+}
+
+HyperbolicIndexSetGenerator::~HyperbolicIndexSetGenerator(){}
+
+void HyperbolicIndexSetGenerator::initialize( int level )
+{
+  if ( p_ <= 0. )
+    error( "HyperbolicIndexSetGenerator() p must be positive" );
+  // tolerance consistent with compute_hyperbolic_level_subdim_indices()
+  Real eps = 100 * std::numeric_limits<double>::epsilon();
+  costBound_ = std::pow( (Real)level + eps, p_ );
+
+  // bound the total degree: |i|_1 <= max(1,d^{1-1/p}) |i|_p and
+  // |i|_p <= L / min_k(w_k)^{1/p}
+  Real min_weight = 1.;
+  for ( int d = 0; d < weights_.length(); d++ )
+    min_weight = std::min( min_weight, weights_[d] );
+  Real max_l1 = (Real)level * std::pow( min_weight, -1. / p_ ) *
+    std::max( 1., std::pow( (Real)numDims_, 1. - 1. / p_ ) );
+  maxLevel_ = (int)std::floor( max_l1 + eps );
+
+  minWeights_.sizeUninitialized( numDims_ + 1 );
+  minWeights_[0] = std::numeric_limits<Real>::max();
+  for ( int k = 0; k < numDims_; k++ )
+    minWeights_[k+1] = ( weights_.length() ) ?
+      std::min( minWeights_[k], weights_[k] ) : 1.;
+
+  powers_.sizeUninitialized( maxLevel_ + 1 );
+  for ( int i = 0; i <= maxLevel_; i++ )
+    powers_[i] = std::pow( (Real)i, p_ );
+  trailingCost_.size( numDims_ + 1 );
+}
+
+bool HyperbolicIndexSetGenerator::admissible( int num_changed )
+{
+  // partial sums are accumulated in a fixed order, such that the cost of
+  // an index does not depend on the traversal history
+  for ( int k = std::min( num_changed, numDims_ ) - 1; k >= 0; k-- )
+    {
+      Real cost = powers_[index_[k]];
+      if ( weights_.length() ) cost *= weights_[k];
+      trailingCost_[k] = cost + trailingCost_[k+1];
+    }
+  return ( trailingCost_[0] <= costBound_ );
+}
+
+bool HyperbolicIndexSetGenerator::trailing_admissible( int k )
+{ return ( trailingCost_[k] <= costBound_ ); }
+
+bool HyperbolicIndexSetGenerator::completion_admissible( int k, int r )
+{
+  // lower bound on the cost of r units over components [0,k): attained by
+  // concentrating them in the component of minimum weight for p <= 1, and
+  // by spreading them evenly (power mean inequality) for p > 1
+  Real min_cost = minWeights_[k] * powers_[r];
+  if ( p_ > 1. )
+    min_cost *= std::pow( (Real)k, 1. - p_ ) * ( 1. - 1.e-12 );
+  return ( trailingCost_[k] + min_cost <= costBound_ );
+}
+
+DownwardClosedIndexSetGenerator::
+DownwardClosedIndexSetGenerator( int num_dims, int max_level,
+				 const Predicate &predicate ) :
+  IndexSetGenerator( num_dims, max_level ), predicate_( predicate )
+{
+  trailingIndex_.size( num_dims );
+}
+
+DownwardClosedIndexSetGenerator::~DownwardClosedIndexSetGenerator(){}
+
+bool DownwardClosedIndexSetGenerator::admissible( int /* num_changed */ )
+{ return predicate_( index_ ); }
+
+bool DownwardClosedIndexSetGenerator::trailing_admissible( int k )
+{
+  for ( int d = 0; d < numDims_; d++ )
+    trailingIndex_[d] = ( d < k ) ? 0 : index_[d];
+  return predicate_( trailingIndex_ );
+}
+
 }  // namespace util
 }  // namespace Pecos
@@ -26,6 +26,7 @@
 #include "Teuchos_SerialDenseHelpers.hpp"
 #include "OptionsList.hpp"
 #include <set>
+#include <limits>
 
 #include <boost/version.hpp>
 #if (BOOST_VERSION < 107000) && !defined(BOOST_ALLOW_DEPRECATED_HEADERS)
@@ -1153,6 +1154,256 @@ void tensor_product_indices(const IntVector levels,
 			    IntMatrix &result);
 
 
+/**
+ * \class IndexSetGenerator
+ * \brief Lazy generator of a downward-closed multi-index set.
+ *
+ * Indices are streamed in graded order: by increasing total degree
+ * (l1 norm) and, within a total degree, in the order of
+ * compute_combinations(). Only the current index is stored, such that
+ * sets too large to materialize (e.g., for 50+ dimensions) may be
+ * traversed index by index or consumed in chunks using next_chunk().
+ * Successive indices differ in O(1) amortized components, as for
+ * compute_next_combination(). Candidates are tested with admissible();
+ * when a rejected candidate's trailing components already violate the
+ * admissibility condition (see trailing_admissible()), the remaining
+ * candidates that share them are skipped. Traversal stops at the maximum
+ * level or at the first total degree without admissible indices.
+ *
+ * count(), rank() and unrank() default to (state preserving) traversal;
+ * derived classes may override them with closed forms.
+ */
+class IndexSetGenerator{
+protected:
+  /// The number of dimensions
+  int numDims_;
+
+  /// The maximum total degree of the set
+  int maxLevel_;
+
+  /// The current index
+  IntVector index_;
+
+  /// The total degree of the current index
+  int level_;
+
+  /// The first nonzero component of the current index (numDims_ if none)
+  int firstNonZero_;
+
+  /// The number of indices generated so far
+  size_t numGenerated_;
+
+  /// The number of indices generated at the current level
+  size_t levelCount_;
+
+  /// Traversal status: 0 = not started, 1 = active, 2 = exhausted
+  short status_;
+
+  /**
+   * \brief Return true if the current index belongs to the set
+   * \param num_changed - Only components [0,num_changed) of the current
+   *        index have changed since the previous call
+   */
+  virtual bool admissible(int num_changed);
+
+  /**
+   * \brief Return true if the current index with components [0,k) set to
+   * zero belongs to the set. Called only after admissible().
+   */
+  virtual bool trailing_admissible(int k);
+
+  /**
+   * \brief Return false if no index of the set shares components
+   * [k,num_dims) with the current index while its components [0,k) sum to
+   * r. Called only after admissible(); the default is true.
+   */
+  virtual bool completion_admissible(int k, int r);
+
+private:
+  /// Advance to the next candidate in graded order, returning false when
+  /// the traversal is complete
+  bool advance(int &num_changed);
+
+  /// Skip the candidates that dominate an inadmissible trailing index
+  void prune(int &num_changed);
+
+  /// Store the traversal state prior to a state-preserving traversal
+  void save_traversal();
+
+  /// Restore the traversal state stored by save_traversal()
+  void restore_traversal();
+
+  /// Stored traversal state: index_, level_, firstNonZero_
+  IntVector savedIndex_;
+  int savedLevel_, savedFirstNonZero_;
+  /// Stored traversal state: numGenerated_, levelCount_, status_
+  size_t savedNumGenerated_, savedLevelCount_;
+  short savedStatus_;
+
+public:
+
+  /**
+   * \brief Constructor
+   * \param num_dims - The number of dimensions
+   * \param max_level - The maximum total degree
+   */
+  IndexSetGenerator(int num_dims, int max_level);
+
+  /// Destructor
+  virtual ~IndexSetGenerator();
+
+  /// Restart the traversal at the zero index
+  void reset();
+
+  /**
+   * \brief Advance to the next index of the set
+   * \return false once the set is exhausted
+   */
+  bool next();
+
+  /**
+   * \brief Generate up to max_indices further indices
+   * \param max_indices - The maximum number of indices to generate
+   * \param result - ( num_dims x num_generated ) matrix of indices
+   * \return the number of indices generated (0 once exhausted)
+   */
+  size_t next_chunk(size_t max_indices, IntMatrix &result);
+
+  /// Return the current index
+  const IntVector& index() const;
+
+  /// Return the total degree of the current index
+  int level() const;
+
+  /// Return the rank (position in the traversal) of the current index
+  size_t position() const;
+
+  /// Return the number of dimensions
+  int num_dims() const;
+
+  /// Return the number of indices in the set
+  virtual size_t count();
+
+  /// Return the position of index in the traversal; error if not in the set
+  virtual size_t rank(const IntVector &index);
+
+  /// Return the index at position r of the traversal; error if r >= count()
+  virtual void unrank(size_t r, IntVector &index);
+};
+
+/**
+ * \class TotalOrderIndexSetGenerator
+ * \brief Lazy generator of the total-order index set \f$ |i|_1 \le L \f$
+ * with closed-form count, rank and unrank.
+ */
+class TotalOrderIndexSetGenerator : public IndexSetGenerator{
+public:
+  /// Constructor for total degree level
+  TotalOrderIndexSetGenerator(int num_dims, int level);
+
+  /// Destructor
+  ~TotalOrderIndexSetGenerator();
+
+  size_t count();
+  size_t rank(const IntVector &index);
+  void unrank(size_t r, IntVector &index);
+};
+
+/**
+ * \class HyperbolicIndexSetGenerator
+ * \brief Lazy generator of the (anisotropic) hyperbolic-cross index set
+ * \f$ \sum_k w_k i_k^p \le L^p \f$.
+ *
+ * The isotropic set (unit weights) matches compute_hyperbolic_indices().
+ * Partial sums of the weighted powers are cached per trailing component,
+ * such that admissibility is tested in O(1) amortized time, and candidates
+ * are skipped when the minimum cost of their leading components is
+ * already inadmissible.
+ */
+class HyperbolicIndexSetGenerator : public IndexSetGenerator{
+protected:
+  /// The power p of the hyperbolic cross (p <= 1 for sparse sets)
+  Real p_;
+
+  /// The (positive) dimension weights; empty for isotropic sets
+  RealVector weights_;
+
+  /// Powers i^p for i = 0,...,maxLevel_
+  RealVector powers_;
+
+  /// Weighted power sums of components [k,num_dims) of the current index
+  RealVector trailingCost_;
+
+  /// Minimum weights over components [0,k), for k = 0,...,num_dims
+  RealVector minWeights_;
+
+  /// The bound L^p on the weighted power sum
+  Real costBound_;
+
+  bool admissible(int num_changed);
+  bool trailing_admissible(int k);
+  bool completion_admissible(int k, int r);
+
+  /// Set the maximum total degree and the power table
+  void initialize(int level);
+
+public:
+  /// Constructor for the isotropic hyperbolic cross of level L
+  HyperbolicIndexSetGenerator(int num_dims, int level, Real p);
+
+  /// Constructor for the anisotropic hyperbolic cross of level L
+  HyperbolicIndexSetGenerator(int num_dims, int level, Real p,
+			      const RealVector &weights);
+
+  /// Destructor
+  ~HyperbolicIndexSetGenerator();
+};
+
+/**
+ * \class DownwardClosedIndexSetGenerator
+ * \brief Lazy generator of the lower (downward-closed) index set defined by
+ * an arbitrary admissibility predicate, truncated at a maximum total degree.
+ *
+ * The predicate must define a downward-closed set: if it accepts an index,
+ * it must accept every index obtained by decrementing a component.
+ */
+class DownwardClosedIndexSetGenerator : public IndexSetGenerator{
+public:
+  /// Type of the admissibility predicate
+  typedef std::function<bool(const IntVector&)> Predicate;
+
+protected:
+  /// The admissibility predicate
+  Predicate predicate_;
+
+  /// Work space for trailing_admissible()
+  IntVector trailingIndex_;
+
+  bool admissible(int num_changed);
+  bool trailing_admissible(int k);
+
+public:
+  /// Constructor
+  DownwardClosedIndexSetGenerator(int num_dims, int max_level,
+				  const Predicate &predicate);
+
+  /// Destructor
+  ~DownwardClosedIndexSetGenerator();
+};
+
+inline const IntVector& IndexSetGenerator::index() const
+{ return index_; }
+
+inline int IndexSetGenerator::level() const
+{ return level_; }
+
+inline size_t IndexSetGenerator::position() const
+{ return numGenerated_ - 1; }
+
+inline int IndexSetGenerator::num_dims() const
+{ return numDims_; }
+
+
 }  // namespace util
 }  // namespace Pecos
 
@@ -274,6 +274,113 @@ BOOST_AUTO_TEST_CASE(test_linear_algebra_svd)
 
 //----------------------------------------------------------------
 
+BOOST_AUTO_TEST_CASE(test_linear_algebra_tsqr_update)
+{
+  // least squares solution of an overdetermined system, accumulated over
+  // blocks of rows, should match the solution of the full system
+  const int num_rows = 23, num_cols = 4, num_rhs = 2, block_size = 5;
+  RealMatrix A(num_rows, num_cols), B(num_rows, num_rhs);
+  A.random();  B.random();
+
+  int rank;
+  RealMatrix full_soln, tsqr_soln, R, QtB;
+  RealVector sing_vals;
+  Pecos::util::svd_solve(A, B, full_soln, sing_vals, rank);
+
+  for (int first = 0; first < num_rows; first += block_size) {
+    int num_block_rows = std::min(block_size, num_rows - first);
+    RealMatrix A_block(Teuchos::View, A, num_block_rows, num_cols, first, 0),
+      B_block(Teuchos::View, B, num_block_rows, num_rhs, first, 0);
+    Pecos::util::tsqr_update(R, QtB, A_block, B_block);
+  }
+  BOOST_CHECK( R.numRows() == num_cols && QtB.numRows() == num_cols );
+  Pecos::util::svd_solve(R, QtB, tsqr_soln, sing_vals, rank);
+
+  tsqr_soln -= full_soln;
+  Real shifted_diff_norm = tsqr_soln.normFrobenius() + 1.0;
+  BOOST_CHECK_CLOSE( 1.0, shifted_diff_norm, 1.0e-8 );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_linear_algebra_qr_update_columns)
+{
+  // build a thin QR factorization column by column, delete an interior
+  // column and check that QR reproduces the reduced matrix
+  const int num_rows = 9, num_cols = 5, del_col = 1;
+  RealMatrix A(num_rows, num_cols), Q(num_rows, num_cols),
+    R(num_cols, num_cols);
+  A.random();
+  for (int j = 0; j < num_cols; ++j) {
+    RealVector col(Teuchos::Copy, A[j], num_rows);
+    BOOST_CHECK( qr_factorization_update_insert_column(Q, R, col, j) == 0 );
+  }
+  qr_factorization_update_delete_column(Q, R, del_col, num_cols);
+
+  RealMatrix Q_red(Teuchos::View, Q, num_rows, num_cols-1),
+    R_red(Teuchos::View, R, num_cols-1, num_cols-1),
+    QR(num_rows, num_cols-1), QtQ(num_cols-1, num_cols-1);
+  QR.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, Q_red, R_red, 0.0);
+  QtQ.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1.0, Q_red, Q_red, 0.0);
+  Real max_diff = 0.;
+  for (int j = 0, k = 0; j < num_cols; ++j) {
+    if (j == del_col) continue;
+    for (int i = 0; i < num_rows; ++i)
+      max_diff = std::max(max_diff, std::abs(QR(i,k) - A(i,j)));
+    ++k;
+  }
+  for (int j = 0; j < num_cols-1; ++j) {
+    for (int i = 0; i < num_cols-1; ++i)
+      max_diff = std::max(max_diff, std::abs(QtQ(i,j) - (i == j ? 1. : 0.)));
+    for (int i = j+1; i < num_cols-1; ++i)
+      max_diff = std::max(max_diff, std::abs(R(i,j)));
+  }
+  BOOST_CHECK_SMALL( max_diff, 1.0e-12 );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_linear_algebra_qr_insert_ill_conditioned)
+{
+  // colinearity is judged relative to the column norm and Q remains
+  // orthogonal when a column is nearly dependent on the factored columns
+  const int num_rows = 9;
+  RealMatrix A(num_rows, 3), Q(num_rows, 4), R(4, 4);
+  A.random();
+  RealVector col(num_rows, false);
+  int num_cols = 0;
+  for (int j = 0; j < 2; ++j) {
+    RealVector a_j(Teuchos::View, A[j], num_rows);
+    BOOST_CHECK( qr_factorization_update_insert_column(Q, R, a_j,
+						       num_cols++) == 0 );
+  }
+  // a large dependent column is colinear
+  for (int i = 0; i < num_rows; ++i)
+    col[i] = 1.e+6 * (A(i,0) + A(i,1));
+  BOOST_CHECK( qr_factorization_update_insert_column(Q, R, col,
+						     num_cols) == 1 );
+  // a small independent column is not
+  for (int i = 0; i < num_rows; ++i)
+    col[i] = 1.e-6 * A(i,2);
+  BOOST_CHECK( qr_factorization_update_insert_column(Q, R, col,
+						     num_cols++) == 0 );
+  // a nearly dependent column is inserted with orthogonal Q
+  for (int i = 0; i < num_rows; ++i)
+    col[i] = A(i,0) + 1.e-7 * A(i,2) * (i+1);
+  BOOST_CHECK( qr_factorization_update_insert_column(Q, R, col,
+						     num_cols++) == 0 );
+
+  RealMatrix QtQ(num_cols, num_cols);
+  QtQ.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1.0, Q, Q, 0.0);
+  Real max_diff = 0.;
+  for (int j = 0; j < num_cols; ++j)
+    for (int i = 0; i < num_cols; ++i)
+      max_diff = std::max(max_diff, std::abs(QtQ(i,j) - (i == j ? 1. : 0.)));
+  BOOST_CHECK_SMALL( max_diff, 1.0e-12 );
+}
+
+//----------------------------------------------------------------
+
 BOOST_AUTO_TEST_CASE(test_linear_algebra_conj_grad_solv)
 {
   // Might need to try a rank-deficient system for better testing
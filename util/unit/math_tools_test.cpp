@@ -52,3 +52,85 @@ BOOST_AUTO_TEST_CASE(test_math_tools_multi_index)
     }
   }
 }
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_math_tools_total_order_generator)
+{
+  for(int dim = 1; dim < 6; ++dim)
+  {
+    for(int degree = 0; degree < 6; ++degree)
+    {
+      TotalOrderIndexSetGenerator generator(dim, degree);
+      size_t num_indices = Pecos::util::nchoosek(dim+degree, dim);
+      BOOST_CHECK( num_indices == generator.count() );
+
+      // graded order, matching compute_combinations() within each level
+      size_t r = 0;
+      for(int level = 0; level <= degree; ++level)
+      {
+        IntMatrix level_indices;
+        Pecos::util::compute_combinations( dim, level, level_indices );
+        for( int i=0; i<level_indices.numRows(); ++i, ++r )
+        {
+          BOOST_REQUIRE( generator.next() );
+          BOOST_CHECK( generator.level() == level );
+          BOOST_CHECK( generator.position() == r );
+          IntVector index;
+          generator.unrank( r, index );
+          for( int d=0; d<dim; ++d )
+          {
+            BOOST_CHECK( generator.index()[d] == level_indices(i,d) );
+            BOOST_CHECK( index[d] == level_indices(i,d) );
+          }
+          BOOST_CHECK( generator.rank(generator.index()) == r );
+        }
+      }
+      BOOST_CHECK( !generator.next() );
+    }
+  }
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_math_tools_hyperbolic_generator)
+{
+  const int dim = 4, level = 5;
+  const Real p = 0.5;
+  IntMatrix indices;
+  Pecos::util::compute_hyperbolic_indices( dim, level, p, indices );
+  std::set<std::vector<int> > reference;
+  for( int i=0; i<indices.numCols(); ++i )
+    reference.insert( std::vector<int>(indices[i], indices[i]+dim) );
+
+  // consume in chunks
+  HyperbolicIndexSetGenerator generator(dim, level, p);
+  std::set<std::vector<int> > generated;
+  IntMatrix chunk;
+  size_t num_chunk, num_generated = 0;
+  while( (num_chunk = generator.next_chunk(7, chunk)) > 0 )
+  {
+    BOOST_CHECK( chunk.numCols() == (int)num_chunk );
+    for( int i=0; i<chunk.numCols(); ++i )
+      generated.insert( std::vector<int>(chunk[i], chunk[i]+dim) );
+    num_generated += num_chunk;
+  }
+  BOOST_CHECK( num_generated == generated.size() );
+  BOOST_CHECK( generated == reference );
+  BOOST_CHECK( generator.count() == reference.size() );
+
+  // an arbitrary lower set with the same predicate
+  DownwardClosedIndexSetGenerator::Predicate predicate =
+    [&](const IntVector &index) {
+      Real sum = 0.;
+      for( int d=0; d<index.length(); ++d )
+        sum += std::pow( (Real)index[d], p );
+      return std::pow( sum, 1./p ) <= level + 1.e-12;
+    };
+  DownwardClosedIndexSetGenerator lower_generator(dim, level, predicate);
+  generated.clear();
+  while( lower_generator.next() )
+    generated.insert( std::vector<int>(lower_generator.index().values(),
+                                       lower_generator.index().values()+dim) );
+  BOOST_CHECK( generated == reference );
+}